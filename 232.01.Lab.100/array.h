@@ -9,17 +9,26 @@
  *      | |   | |    | | | |    | |   / / _
  *     _| |_  |  `--'  | |  `--'  |  / / (_)
  *    |_____|  '.____.'   '.____.'  /_/
- *    
+ *
+ *    Every member is constexpr, so an array can be filled, swapped,
+ *    and compared at compile time: a lookup table built by a
+ *    constexpr function costs nothing at startup.  The optional
+ *    third parameter aligns the storage, say to 64 bytes so it
+ *    starts on a cache line for SIMD loads or to keep two arrays
+ *    from sharing a line between threads.
+ *
  *    This will contain the class definition of:
- *       array             : similar to std::array
- *       array :: iterator : an iterator through the array
+ *       array                   : similar to std::array
+ *       array :: iterator       : an iterator through the array
+ *       array :: const_iterator : the same, read only
  * Author
  *    Ryan Whitehead
  ************************************************************************/
 
 #pragma once
 
-#include <stdexcept>
+#include <cstddef>     // for size_t
+#include <stdexcept>   // for std::out_of_range
 #include <iostream>
 class TestArray;
 
@@ -28,12 +37,19 @@ namespace custom
 
 /************************************************
  * ARRAY
- * A class that holds stuff
+ * N elements of T, aligned to Align bytes.  It is an
+ * aggregate, so it is built with braces:
+ *    constexpr custom::array<int, 3> a{26, 49, 67};
  ***********************************************/
-template <int N>
+template <typename T, size_t N, size_t Align = alignof(T)>
 struct array
 {
+   static_assert(Align >= alignof(T), "the alignment cannot be less than T needs");
+   static_assert((Align & (Align - 1)) == 0, "the alignment must be a power of two");
+
 public:
+   using value_type = T;
+
    //
    // Construct
    //
@@ -44,85 +60,68 @@ public:
    // Assign
    //
 
-   // No assignment operators needed here
+   constexpr void fill(const T & t)
+   {
+      for (size_t i = 0; i < N; i++)
+         __elems_[i] = t;
+   }
+   constexpr void swap(array & rhs)
+   {
+      for (size_t i = 0; i < N; i++)
+      {
+         T t = static_cast<T &&>(__elems_[i]);
+         __elems_[i] = static_cast<T &&>(rhs.__elems_[i]);
+         rhs.__elems_[i] = static_cast<T &&>(t);
+      }
+   }
 
    //
    // Iterator
    //
 
-   // Forward declaration for the iterator class
    class iterator;
+   class const_iterator;
+   constexpr iterator       begin()        { return iterator(__elems_);           }
+   constexpr iterator       end()          { return iterator(__elems_ + N);       }
+   constexpr const_iterator begin()  const { return const_iterator(__elems_);     }
+   constexpr const_iterator end()    const { return const_iterator(__elems_ + N); }
+   constexpr const_iterator cbegin() const { return const_iterator(__elems_);     }
+   constexpr const_iterator cend()   const { return const_iterator(__elems_ + N); }
 
-   // Begin and end methods
-   iterator begin() 
-   { 
-      /* your code goes here; it should return an iterator referring to the first element in the array */
-      return iterator(__elems_); 
-   }
-   iterator end()   
-   { 
-      /* your code goes here; it should return an iterator referring to the first element off the end of the array */
-      return iterator(__elems_+N);
-   }
-
-   // 
+   //
    // Access
    //
 
-   // Subscript
-   int& operator [] (size_t index)       
-   { 
-      /*your code goes here; it should return the i-th element in the array */
-      if (index < 0 || index > N - 1) throw std::out_of_range("index is out of range");
-      return __elems_[index]; 
-   }
-   const int& operator [] (size_t index) const 
-   { 
-      /*your code goes here; it should return the i-th element in the array */
-      if (index < 0 || index > N - 1) throw std::out_of_range("index is out of range");
-      return __elems_[index];
-   }
+   // Subscript: not checked, just like a C array
+   constexpr       T& operator [] (size_t index)       { return __elems_[index]; }
+   constexpr const T& operator [] (size_t index) const { return __elems_[index]; }
 
    friend std::ostream& operator<<(std::ostream & os, array& arr)
    {
        return os << arr[0] << std::endl;
    }
 
-   // At
-   int& at(size_t index)
+   // At: checked, throwing when out of range
+   constexpr T& at(size_t index)
    {
-      /*your code goes here; it should return the i-th element in the array */
-      if (index < 0 || index > N - 1) throw std::out_of_range("index is out of range");
+      if (index >= N) throw std::out_of_range("index is out of range");
       return __elems_[index];
    }
-   const int& at(size_t index) const
+   constexpr const T& at(size_t index) const
    {
-      /*your code goes here; it should return the i-th element in the array */
-      if (index < 0 || index > N - 1) throw std::out_of_range("index is out of range");
+      if (index >= N) throw std::out_of_range("index is out of range");
       return __elems_[index];
    }
 
    // Front and Back
-   int& front()       
-   { 
-      /* your code goes here; it should return the first element in the array */
-      return __elems_[0]; 
-   }
-   int& back()        
-   { 
-      /* your code goes here; it should return the last element in the array */
-      return __elems_[N-1];
-   }
-   const int& front() const 
-   { 
-      return __elems_[0];
-   }
-   const int& back()  const 
-   { 
-      /* your code goes here; it should return the last element in the array */
-      if (N < 1) return 0;
-      return __elems_[N-1];
-   }
+   constexpr       T& front()       { return __elems_[0];     }
+   constexpr       T& back()        { return __elems_[N - 1]; }
+   constexpr const T& front() const { return __elems_[0];     }
+   constexpr const T& back()  const { return __elems_[N - 1]; }
+
+   // the elements themselves, for code that wants a pointer
+   constexpr       T* data()       { return __elems_; }
+   constexpr const T* data() const { return __elems_; }
 
    //
    // Remove
@@ -134,101 +133,141 @@ public:
    //
 
    // number of elements in the array
-   size_t size()  const 
-   { 
-      /* your code goes here, this should not always return 999 */
-      return N;           
-   }
-   bool empty() const { 
-      /* your code goes here; this should not always return TRUE */
-      if (N < 1) return true;
-      return false; 
-   }
-   
+   constexpr size_t size()  const { return N;      }
+   constexpr bool   empty() const { return N == 0; }
+
+   // the alignment of the storage
+   static constexpr size_t alignment() { return Align; }
+
    //
    // Member Variable
    //
 
-   // statically allocated array of T
-   int __elems_[N];          /* your code goes here */
+   // statically allocated array of T; one slot even when N is zero
+   alignas(Align) T __elems_[N > 0 ? N : 1];
 };
 
+/************************************************
+ * ARRAY :: COMPARISONS
+ * Element by element; the first difference decides
+ ***********************************************/
+template <typename T, size_t N, size_t Align>
+constexpr bool operator == (const array<T, N, Align> & lhs, const array<T, N, Align> & rhs)
+{
+   for (size_t i = 0; i < N; i++)
+      if (!(lhs[i] == rhs[i]))
+         return false;
+   return true;
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator < (const array<T, N, Align> & lhs, const array<T, N, Align> & rhs)
+{
+   for (size_t i = 0; i < N; i++)
+   {
+      if (lhs[i] < rhs[i])
+         return true;
+      if (rhs[i] < lhs[i])
+         return false;
+   }
+   return false;
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator != (const array<T, N, Align> & lhs, const array<T, N, Align> & rhs) { return !(lhs == rhs); }
+template <typename T, size_t N, size_t Align>
+constexpr bool operator >  (const array<T, N, Align> & lhs, const array<T, N, Align> & rhs) { return rhs < lhs;    }
+template <typename T, size_t N, size_t Align>
+constexpr bool operator <= (const array<T, N, Align> & lhs, const array<T, N, Align> & rhs) { return !(rhs < lhs); }
+template <typename T, size_t N, size_t Align>
+constexpr bool operator >= (const array<T, N, Align> & lhs, const array<T, N, Align> & rhs) { return !(lhs < rhs); }
+
+template <typename T, size_t N, size_t Align>
+constexpr void swap(array<T, N, Align> & lhs, array<T, N, Align> & rhs)
+{
+   lhs.swap(rhs);
+}
+
 
 /**************************************************
  * ARRAY ITERATOR
  * An iterator through array
  *************************************************/
-template <int N>
-class array <N> :: iterator
+template <typename T, size_t N, size_t Align>
+class array <T, N, Align> :: iterator
 {
    friend class ::TestArray;
+   friend class const_iterator;
 public:
    // constructors, destructors, and assignment operator
-   iterator()     
-   { 
-      /* your code goes here; it should initialize an iterator */
-      this->p = nullptr;
-   }
-   iterator(int * p)   
-   { 
-      /* your code goes here; it should point to an element in the array */
-      this->p = p;
-   }
-   iterator(const iterator & rhs) 
-   {  
-      /* your code goes here; it should copy an iterator */
-      this->p = rhs.p;
-   }
-   iterator & operator = (const iterator & rhs)
+   constexpr iterator()                        : p(nullptr) {}
+   constexpr iterator(T * p)                   : p(p)       {}
+   constexpr iterator(const iterator & rhs)    : p(rhs.p)   {}
+   constexpr iterator & operator = (const iterator & rhs)
    {
-      /* your code goes here; it should copy an iterator */
-      this->p = rhs.p;
+      p = rhs.p;
       return *this;
    }
-   
+
    // equals, not equals operator
-   bool operator != (const iterator & rhs) const 
-   { 
-      /* your code goes here; it should not always return TRUE */
-      return p != rhs.p; 
-   }
-   bool operator == (const iterator & rhs) const 
-   { 
-      /* your code goes here; it should not always return TRUE */
-      return p == rhs.p;
-   }
-   
+   constexpr bool operator != (const iterator & rhs) const { return p != rhs.p; }
+   constexpr bool operator == (const iterator & rhs) const { return p == rhs.p; }
+
    // dereference operator
-   int & operator * ()       
-   { 
-      /* your code goes here; it should fetch the element referred to by p */
-      return *p; 
-   }
-   const int & operator * () const 
-   { 
-      /* your code goes here; it should fetch the element referred to by p */
-      return *p; 
-   }
-   
+   constexpr       T & operator * ()       { return *p; }
+   constexpr const T & operator * () const { return *p; }
+
    // prefix increment
-   iterator & operator ++ ()
+   constexpr iterator & operator ++ ()
    {
-      /* your code goes here; it should advance the iterator by one */
-      this->p++;
+      p++;
       return *this;
    }
-   
+
    // postfix increment
-   iterator operator ++ (int postfix)
+   constexpr iterator operator ++ (int postfix)
    {
-      /* your code goes here; it should advance the iterator by one */
       iterator result = *this;
-      this->p++;
+      p++;
       return result;
    }
-   
+
+private:
+   T * p;
+};
+
+/**************************************************
+ * ARRAY CONST ITERATOR
+ * The same, for reading only
+ *************************************************/
+template <typename T, size_t N, size_t Align>
+class array <T, N, Align> :: const_iterator
+{
+   friend class ::TestArray;
+public:
+   constexpr const_iterator()                     : p(nullptr) {}
+   constexpr const_iterator(const T * p)          : p(p)       {}
+   constexpr const_iterator(const iterator & rhs) : p(rhs.p)   {}
+
+   constexpr bool operator != (const const_iterator & rhs) const { return p != rhs.p; }
+   constexpr bool operator == (const const_iterator & rhs) const { return p == rhs.p; }
+
+   constexpr const T & operator * () const { return *p; }
+
+   constexpr const_iterator & operator ++ ()
+   {
+      p++;
+      return *this;
+   }
+   constexpr const_iterator operator ++ (int postfix)
+   {
+      const_iterator result = *this;
+      p++;
+      return result;
+   }
+
 private:
-   int * p;
+   const T * p;
 };
 
 
@@ -0,0 +1,289 @@
+/***********************************************************************
+ * Header:
+ *    MATRIX
+ * Summary:
+ *    A fixed-size R x C matrix stored row by row in a custom::array.
+ *    The dimensions are template parameters, so every loop has a
+ *    trip count the compiler knows: a 4x4 multiply unrolls
+ *    completely, and the unit-stride inner loops vectorize.
+ *
+ *    The bigger products are cache blocked.  Multiply and transpose
+ *    work one TILE x TILE block at a time, so the rows of the right
+ *    hand side they touch stay in L1 rather than being streamed
+ *    through it once per output row.  A tile is 32 on a side: 4KB
+ *    of float, and wide enough that the compiler keeps the inner
+ *    loop a vector loop instead of unrolling it.  The multiply runs in i-k-j
+ *    order: its inner loop adds a multiple of one row of rhs to one
+ *    row of the result, which is contiguous on both sides.  A
+ *    matrix-vector product is one dot product per row; long rows
+ *    of int, float, or double go to the simd::dot kernel.
+ *
+ *    Everything but the SIMD path is constexpr, so small transforms
+ *    can be worked out at compile time.
+ *
+ *    This will contain the definition of:
+ *        matrix            : R rows of C elements
+ *        transpose         : the C x R matrix, a tile at a time
+ *        operator *        : matrix times matrix, and matrix times vector
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include "array.h"   // for the storage
+#include "simd.h"    // for simd::dot
+
+#include <cstddef>      // for size_t
+#include <type_traits>  // for std::integral_constant
+
+class TestMatrix;
+
+namespace custom
+{
+
+/************************************************
+ * MATRIX
+ * R rows of C elements of T, row-major, in one array
+ * aligned to Align bytes.  Like array it is an
+ * aggregate, built with braces a row at a time:
+ *    custom::matrix<int, 2, 3> m{{1, 2, 3,
+ *                                4, 5, 6}};
+ ***********************************************/
+template <typename T, size_t R, size_t C, size_t Align = alignof(T)>
+struct matrix
+{
+   static_assert(R > 0 && C > 0, "a matrix needs at least one row and column");
+
+public:
+   using value_type = T;
+
+   // the blocks the products work in, in elements on a side
+   static const size_t TILE = 32;
+
+   //
+   // Construct
+   //
+
+   // the identity, for square matrices
+   static constexpr matrix identity()
+   {
+      static_assert(R == C, "only a square matrix has an identity");
+      matrix m{};
+      for (size_t i = 0; i < R; i++)
+         m(i, i) = T(1);
+      return m;
+   }
+
+   //
+   // Assign
+   //
+
+   constexpr void fill(const T & t) { elems.fill(t); }
+
+   //
+   // Access
+   //
+
+   constexpr       T& operator () (size_t row, size_t col)       { return elems[row * C + col]; }
+   constexpr const T& operator () (size_t row, size_t col) const { return elems[row * C + col]; }
+
+   // the start of one row, C contiguous elements
+   constexpr       T* row(size_t r)       { return elems.data() + r * C; }
+   constexpr const T* row(size_t r) const { return elems.data() + r * C; }
+
+   constexpr       T* data()       { return elems.data(); }
+   constexpr const T* data() const { return elems.data(); }
+
+   //
+   // Status
+   //
+
+   static constexpr size_t rows() { return R;     }
+   static constexpr size_t cols() { return C;     }
+   static constexpr size_t size() { return R * C; }
+
+   //
+   // Member Variable
+   //
+
+   array<T, R * C, Align> elems;
+};
+
+/************************************************
+ * MATRIX :: EQUALITY
+ ***********************************************/
+template <typename T, size_t R, size_t C, size_t Align>
+constexpr bool operator == (const matrix<T, R, C, Align> & lhs, const matrix<T, R, C, Align> & rhs)
+{
+   return lhs.elems == rhs.elems;
+}
+
+template <typename T, size_t R, size_t C, size_t Align>
+constexpr bool operator != (const matrix<T, R, C, Align> & lhs, const matrix<T, R, C, Align> & rhs)
+{
+   return !(lhs == rhs);
+}
+
+/************************************************
+ * MATRIX :: ADD, SUBTRACT
+ * One element at a time, straight down the storage
+ ***********************************************/
+template <typename T, size_t R, size_t C, size_t Align>
+constexpr matrix<T, R, C, Align> operator + (const matrix<T, R, C, Align> & lhs, const matrix<T, R, C, Align> & rhs)
+{
+   matrix<T, R, C, Align> out{};
+   for (size_t i = 0; i < R * C; i++)
+      out.elems[i] = lhs.elems[i] + rhs.elems[i];
+   return out;
+}
+
+template <typename T, size_t R, size_t C, size_t Align>
+constexpr matrix<T, R, C, Align> operator - (const matrix<T, R, C, Align> & lhs, const matrix<T, R, C, Align> & rhs)
+{
+   matrix<T, R, C, Align> out{};
+   for (size_t i = 0; i < R * C; i++)
+      out.elems[i] = lhs.elems[i] - rhs.elems[i];
+   return out;
+}
+
+/************************************************
+ * TRANSPOSE
+ * Rows become columns.  Reading a row and writing a
+ * column strides through one side, so work a tile at
+ * a time: both tiles fit in cache together.
+ *     INPUT  : m the R x C matrix
+ *     OUTPUT : the C x R matrix
+ ***********************************************/
+template <typename T, size_t R, size_t C, size_t Align>
+constexpr matrix<T, C, R, Align> transpose(const matrix<T, R, C, Align> & m)
+{
+   const size_t TILE = matrix<T, R, C, Align>::TILE;
+   matrix<T, C, R, Align> out{};
+   for (size_t ii = 0; ii < R; ii += TILE)
+      for (size_t jj = 0; jj < C; jj += TILE)
+      {
+         size_t iEnd = ii + TILE < R ? ii + TILE : R;
+         size_t jEnd = jj + TILE < C ? jj + TILE : C;
+         for (size_t i = ii; i < iEnd; i++)
+            for (size_t j = jj; j < jEnd; j++)
+               out(j, i) = m(i, j);
+      }
+   return out;
+}
+
+/************************************************
+ * MULTIPLY ROW
+ * One row of one tile of the product: W columns of
+ * the result starting at dest, plus the sum over the
+ * rows k of rhs of lhs(i, k) times that row.  W is a
+ * compile-time width, a whole tile or the leftover
+ * edge, so the inner loop has a known trip count.  It
+ * adds into a local row that nothing else can alias,
+ * so the compiler vectorizes it without checks.
+ ***********************************************/
+template <size_t W, typename T>
+constexpr void multiplyRow(T * dest, const T * a, const T * src, size_t stride, size_t num)
+{
+   T sum[W] = {};
+   for (size_t j = 0; j < W; j++)
+      sum[j] = dest[j];
+   for (size_t k = 0; k < num; k++, src += stride)
+      for (size_t j = 0; j < W; j++)
+         sum[j] += a[k] * src[j];
+   for (size_t j = 0; j < W; j++)
+      dest[j] = sum[j];
+}
+
+/************************************************
+ * MULTIPLY
+ * R x K times K x C.  When all three fit in one tile
+ * it is a plain dot product per element: every bound
+ * is known, so the inner loop unrolls and the compiler
+ * vectorizes across j.  Bigger ones are blocked over
+ * all three loops, ii-jj-kk, so one TILE x TILE block
+ * of rhs serves every row of the i tile.  Within a
+ * block it is i-k-j, so the inner loop runs along a
+ * row of rhs and a row of the result at once: unit
+ * stride on both.
+ *     INPUT  : lhs R x K, rhs K x C
+ *     OUTPUT : the R x C product
+ ***********************************************/
+template <typename T, size_t R, size_t K, size_t C, size_t Align>
+constexpr matrix<T, R, C, Align> operator * (const matrix<T, R, K, Align> & lhs,
+                                             const matrix<T, K, C, Align> & rhs)
+{
+   const size_t TILE = matrix<T, R, C, Align>::TILE;
+   const size_t EDGE = C % TILE;   // the width of the last, partial tile
+   matrix<T, R, C, Align> out{};
+   if (R <= TILE && K <= TILE && C <= TILE)
+   {
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+         {
+            T sum = T();
+            for (size_t k = 0; k < K; k++)
+               sum += lhs(i, k) * rhs(k, j);
+            out(i, j) = sum;
+         }
+      return out;
+   }
+   for (size_t ii = 0; ii < R; ii += TILE)
+   {
+      size_t iEnd = ii + TILE < R ? ii + TILE : R;
+      for (size_t jj = 0; jj < C; jj += TILE)
+         for (size_t kk = 0; kk < K; kk += TILE)
+         {
+            // the same num x TILE block of rhs for every row of this tile
+            size_t num = kk + TILE < K ? TILE : K - kk;
+            for (size_t i = ii; i < iEnd; i++)
+               if (jj + TILE <= C)
+                  multiplyRow<TILE>(out.row(i) + jj, lhs.row(i) + kk, rhs.row(kk) + jj, C, num);
+               else
+                  multiplyRow<EDGE ? EDGE : 1>(out.row(i) + jj, lhs.row(i) + kk, rhs.row(kk) + jj, C, num);
+         }
+   }
+   return out;
+}
+
+/************************************************
+ * DOT ROW
+ * One row of a matrix-vector product.  Long rows of
+ * a type simd.h handles go to its dot kernel; short
+ * ones stay a plain loop the compiler can unroll.
+ ***********************************************/
+template <typename T, size_t C>
+constexpr T dotRow(const T * row, const T * v, std::false_type)
+{
+   T sum = T();
+   for (size_t j = 0; j < C; j++)
+      sum += row[j] * v[j];
+   return sum;
+}
+
+template <typename T, size_t C>
+T dotRow(const T * row, const T * v, std::true_type)
+{
+   return simd::dot(row, v, C);
+}
+
+/************************************************
+ * MULTIPLY BY VECTOR
+ * R x C times a C-element array: one dot product per
+ * row.  Rows of 16 or more int, float, or double use
+ * the SIMD kernel.
+ *     INPUT  : m R x C, v C elements
+ *     OUTPUT : R elements
+ ***********************************************/
+template <typename T, size_t R, size_t C, size_t Align, size_t VAlign>
+constexpr array<T, R, VAlign> operator * (const matrix<T, R, C, Align> & m,
+                                          const array<T, C, VAlign> & v)
+{
+   array<T, R, VAlign> out{};
+   for (size_t i = 0; i < R; i++)
+      out[i] = dotRow<T, C>(m.row(i), v.data(),
+                            std::integral_constant<bool, (C >= 16) && simd::is_supported<T>::value>());
+   return out;
+}
+
+} // namespace custom
@@ -14,6 +14,7 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testArray.h"     // for the array unit tests
+#include "testMatrix.h"    // for the matrix unit tests
 
 
 /**********************************************************************
@@ -26,6 +27,7 @@ int main()
 #ifdef DEBUG
    // unit tests
    TestArray().run();
+   TestMatrix().run();
 #endif // DEBUG
    
    return 0;
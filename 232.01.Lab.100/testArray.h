@@ -12,6 +12,7 @@
 #ifdef DEBUG
 
 #include <array>
+#include <string>
 #include "array.h"      // class under test
 #include "unitTest.h"   // unit test baseclass
 
@@ -65,6 +66,15 @@ public:
       test_iterator_dereferenceWrite();
       test_iterator_incrementPrefix();
       test_iterator_incrementPostfix();
+      test_iterator_const();
+
+      // Generic and constexpr
+      test_generic_string();
+      test_constexpr_table();
+      test_fill();
+      test_swap();
+      test_compare();
+      test_align_cacheLine();
 
       report("Array");
    }
@@ -72,7 +82,7 @@ public:
 
    void test_overload_insertion()
    {  // setup
-       custom::array<1> a{};
+       custom::array<int, 1> a{};
        a[0] = 999;
        std::cout << a;
    }  // teardown
@@ -84,7 +94,7 @@ public:
    // size of a one-element array
    void test_size_one()
    {  // setup
-      const custom::array<1> a{};
+      const custom::array<int, 1> a{};
       // exercise
       size_t size = a.size();
       // verify
@@ -98,9 +108,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> aRW;
+      custom::array<int, 4> aRW;
       setupStandardFixture(aRW);
-      const custom::array<4> a(aRW);
+      const custom::array<int, 4> a(aRW);
       // exercise
       size_t size = a.size();
       // verify
@@ -115,7 +125,7 @@ public:
    // one-element array empty?
    void test_empty_one()
    {  // setup
-      const custom::array<1> a{};
+      const custom::array<int, 1> a{};
       // exercise
       bool empty = a.empty();
       // verify
@@ -129,9 +139,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> aRW;
+      custom::array<int, 4> aRW;
       setupStandardFixture(aRW);
-      const custom::array<4> a(aRW);
+      const custom::array<int, 4> a(aRW);
       // exercise
       bool empty = a.empty();
       // verify
@@ -155,9 +165,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> aRW;
+      custom::array<int, 4> aRW;
       setupStandardFixture(aRW);
-      const custom::array<4> a(aRW);
+      const custom::array<int, 4> a(aRW);
       int s = 0;
       // exercise
       s = a[1];
@@ -177,7 +187,7 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
       int s = 99;
       // exercise
@@ -199,9 +209,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> aRW;
+      custom::array<int, 4> aRW;
       setupStandardFixture(aRW);
-      const custom::array<4> a(aRW);
+      const custom::array<int, 4> a(aRW);
       int s = 0;
       // exercise
       s = a.at(1);
@@ -221,7 +231,7 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
       int s = 99;
       // exercise
@@ -243,9 +253,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> aRW;
+      custom::array<int, 4> aRW;
       setupStandardFixture(aRW);
-      const custom::array<4> a(aRW);
+      const custom::array<int, 4> a(aRW);
       int s = 0;
       // exercise
       try
@@ -273,7 +283,7 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
       int s = 99;
       // exercise
@@ -305,9 +315,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> aRW;
+      custom::array<int, 4> aRW;
       setupStandardFixture(aRW);
-      const custom::array<4> a(aRW);
+      const custom::array<int, 4> a(aRW);
       int s = 99;
       // exerciase
       s = a.front();
@@ -323,7 +333,7 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
       int s = 99;
       // exerciase
@@ -345,9 +355,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> aRW;
+      custom::array<int, 4> aRW;
       setupStandardFixture(aRW);
-      const custom::array<4> a(aRW);
+      const custom::array<int, 4> a(aRW);
       int s = 99;
       // exerciase
       s = a.back();
@@ -363,7 +373,7 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
       int s = 99;
       // exerciase
@@ -390,9 +400,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator it;
+      custom::array<int, 4>::iterator it;
       // exercise
       it = a.begin();
       // verify
@@ -411,9 +421,9 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator it;
+      custom::array<int, 4>::iterator it;
       // exercise
       it = a.end();
       // verify
@@ -432,10 +442,10 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
       // exercise
-      custom::array<4>::iterator it;
+      custom::array<int, 4>::iterator it;
       // verify
       assertUnit(it.p == nullptr);
       //      0    1    2    3
@@ -452,10 +462,10 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
       // exercise
-      custom::array<4>::iterator it(&(a.__elems_[2]));
+      custom::array<int, 4>::iterator it(&(a.__elems_[2]));
       // verify
       assertUnit(it.p == &(a.__elems_[2]));
       //      0    1    2    3
@@ -474,12 +484,12 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //               itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);    
       // exercise
-      custom::array<4>::iterator itLHS(itRHS);
+      custom::array<int, 4>::iterator itLHS(itRHS);
       // verify
       assertUnit(itLHS.p == itRHS.p);
       //      0    1    2    3
@@ -497,11 +507,11 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //               itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       // exercise
       itLHS = itRHS;
       // verify
@@ -522,11 +532,11 @@ public:
       //    +----+----+----+----+
       //               itLHS
       //               itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       itLHS.p = &(a.__elems_[2]);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);
       bool b;
       // exercise
@@ -548,11 +558,11 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //    itLHS      itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       itLHS.p = &(a.__elems_[0]);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);
       bool b;
       // exercise
@@ -574,18 +584,18 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //    itLHS      
-      custom::array<4> aLHS;
+      custom::array<int, 4> aLHS;
       setupStandardFixture(aLHS);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       itLHS.p = &(aLHS.__elems_[0]);
       //      0    1    2    3
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //    itRHS      
-      custom::array<4> aRHS;
+      custom::array<int, 4> aRHS;
       setupStandardFixture(aRHS);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(aRHS.__elems_[0]);
       bool b;
       // exercise
@@ -609,11 +619,11 @@ public:
       //    +----+----+----+----+
       //               itLHS
       //               itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       itLHS.p = &(a.__elems_[2]);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);
       bool b;
       // exercise
@@ -635,11 +645,11 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //    itLHS      itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       itLHS.p = &(a.__elems_[0]);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);
       bool b;
       // exercise
@@ -661,18 +671,18 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //    itLHS      
-      custom::array<4> aLHS;
+      custom::array<int, 4> aLHS;
       setupStandardFixture(aLHS);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       itLHS.p = &(aLHS.__elems_[0]);
       //      0    1    2    3
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //    itRHS      
-      custom::array<4> aRHS;
+      custom::array<int, 4> aRHS;
       setupStandardFixture(aRHS);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(aRHS.__elems_[0]);
       bool b;
       // exercise
@@ -695,9 +705,9 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //               it
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator it;
+      custom::array<int, 4>::iterator it;
       it.p = &(a.__elems_[2]);
       int s;
       // exercise
@@ -720,9 +730,9 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //               it
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator it;
+      custom::array<int, 4>::iterator it;
       it.p = &(a.__elems_[2]);
       int s = 99;
       // exercise
@@ -746,11 +756,11 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //               itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       // exercise
       itLHS = ++itRHS;
       // verify
@@ -773,11 +783,11 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //               itRHS
-      custom::array<4> a;
+      custom::array<int, 4> a;
       setupStandardFixture(a);
-      custom::array<4>::iterator itRHS;
+      custom::array<int, 4>::iterator itRHS;
       itRHS.p = &(a.__elems_[2]);
-      custom::array<4>::iterator itLHS;
+      custom::array<int, 4>::iterator itLHS;
       // exercise
       itLHS = itRHS++;
       // verify
@@ -792,6 +802,130 @@ public:
       assertStandardFixture(a);
    }  // teardown
 
+   // walk a const array with its const iterators
+   void test_iterator_const()
+   {  // setup
+      custom::array<int, 4> aRW;
+      setupStandardFixture(aRW);
+      const custom::array<int, 4> a(aRW);
+      int sum = 0;
+      // exercise
+      for (const int & value : a)
+         sum += value;
+      // verify
+      assertUnit(sum == 26 + 49 + 67 + 89);
+      assertUnit(*a.cbegin() == 26);
+      assertUnit(a.data() == &a.__elems_[0]);
+      assertStandardFixture(a);
+   }  // teardown
+
+   /***************************************
+    * GENERIC AND CONSTEXPR
+    ***************************************/
+
+   // any element type, not just int
+   void test_generic_string()
+   {  // setup
+      custom::array<std::string, 3> a{"twenty-six", "forty-nine", "sixty-seven"};
+      // exercise
+      a[1] += "!";
+      a.back() = a.front();
+      // verify
+      assertUnit(a.size() == 3);
+      assertUnit(a[1] == "forty-nine!");
+      assertUnit(a.at(2) == "twenty-six");
+   }  // teardown
+
+   // squares, worked out by the compiler
+   static constexpr custom::array<int, 8> squares()
+   {
+      custom::array<int, 8> table{};
+      for (size_t i = 0; i < table.size(); i++)
+         table[i] = static_cast<int>(i * i);
+      return table;
+   }
+
+   // a lookup table built entirely at compile time
+   void test_constexpr_table()
+   {  // setup
+      // exercise
+      constexpr custom::array<int, 8> table = squares();
+      static_assert(table[7] == 49, "built at compile time");
+      static_assert(table.at(3) == 9, "checked access at compile time");
+      static_assert(table.size() == 8 && !table.empty(), "status at compile time");
+      // verify
+      assertUnit(table.front() == 0);
+      assertUnit(table.back() == 49);
+   }  // teardown
+
+   // fill sets every element, at run time or compile time
+   static constexpr custom::array<int, 4> filled(int value)
+   {
+      custom::array<int, 4> a{};
+      a.fill(value);
+      return a;
+   }
+   void test_fill()
+   {  // setup
+      custom::array<int, 4> a;
+      setupStandardFixture(a);
+      // exercise
+      a.fill(99);
+      // verify
+      static_assert(filled(26)[3] == 26, "fill at compile time");
+      assertUnit(a.__elems_[0] == 99);
+      assertUnit(a.__elems_[3] == 99);
+   }  // teardown
+
+   // swap trades every element
+   static constexpr int swapped()
+   {
+      custom::array<int, 2> a{1, 2};
+      custom::array<int, 2> b{3, 4};
+      a.swap(b);
+      return a[0] * 10 + b[1];
+   }
+   void test_swap()
+   {  // setup
+      custom::array<int, 4> aLHS;
+      setupStandardFixture(aLHS);
+      custom::array<int, 4> aRHS{};
+      // exercise
+      swap(aLHS, aRHS);
+      // verify
+      static_assert(swapped() == 32, "swap at compile time");
+      assertUnit(aLHS.__elems_[0] == 0);
+      assertUnit(aLHS.__elems_[3] == 0);
+      assertStandardFixture(aRHS);
+   }  // teardown
+
+   // comparisons are lexicographic, like std::array
+   void test_compare()
+   {  // setup
+      constexpr custom::array<int, 3> a{26, 49, 67};
+      constexpr custom::array<int, 3> b{26, 49, 89};
+      // exercise and verify
+      static_assert(a == a && a != b, "equality at compile time");
+      static_assert(a < b && b > a && a <= a && b >= a, "ordering at compile time");
+      assertUnit(!(b < a));
+      assertUnit(!(a == b));
+   }  // teardown
+
+   // aligned to a cache line, the storage starts on one
+   void test_align_cacheLine()
+   {  // setup
+      // exercise
+      custom::array<int, 4, 64> a{};
+      custom::array<int, 4, 64> b{};
+      // verify
+      assertUnit(alignof(custom::array<int, 4, 64>) == 64);
+      assertUnit(sizeof(a) == 64);
+      assertUnit(reinterpret_cast<size_t>(a.data()) % 64 == 0);
+      assertUnit(reinterpret_cast<size_t>(b.data()) % 64 == 0);
+      assertUnit(a.alignment() == 64);
+      assertUnit((custom::array<int, 4>::alignment() == alignof(int)));
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *      0    1    2    3
@@ -799,7 +933,7 @@ public:
     *    | 26 | 49 | 67 | 89 |
     *    +----+----+----+----+
     *************************************************************/
-   void setupStandardFixture(custom::array<4> & a)
+   void setupStandardFixture(custom::array<int, 4> & a)
    {
       a.__elems_[0] = 26;
       a.__elems_[1] = 49;
@@ -814,7 +948,7 @@ public:
     *    | 26 | 49 | 67 | 89 |
     *    +----+----+----+----+
     *************************************************************/
-   void assertStandardFixtureParameters(const custom::array<4> & a, int line, const char * function)
+   void assertStandardFixtureParameters(const custom::array<int, 4> & a, int line, const char * function)
    {
       assertIndirect(a.size() == 4);
       assertIndirect(a.__elems_[0] == 26);
@@ -0,0 +1,283 @@
+/***********************************************************************
+ * Header:
+ *    TEST MATRIX
+ * Summary:
+ *    Unit tests for matrix.  The big products are checked against a
+ *    plain triple loop, with sizes that do not divide into tiles.
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "matrix.h"
+#include "unitTest.h"
+
+#include <cassert>
+
+class TestMatrix : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct and access
+      test_construct_rowMajor();
+      test_identity();
+      test_align_cacheLine();
+
+      // Transpose
+      test_transpose_small();
+      test_transpose_acrossTiles();
+
+      // Multiply
+      test_multiply_small();
+      test_multiply_identity();
+      test_multiply_acrossTiles();
+      test_multiply_acrossInnerTiles();
+      test_multiply_constexpr();
+      test_addSubtract();
+
+      // Matrix-vector
+      test_vector_small();
+      test_vector_simd();
+
+      report("Matrix");
+   }
+
+   /***************************************
+    * CONSTRUCT AND ACCESS
+    ***************************************/
+
+   // braces fill a row at a time
+   void test_construct_rowMajor()
+   {  // setup
+      // exercise
+      custom::matrix<int, 2, 3> m{{26, 49, 67,
+                                   89, 11, 31}};
+      // verify
+      assertUnit(m.rows() == 2);
+      assertUnit(m.cols() == 3);
+      assertUnit(m(0, 2) == 67);
+      assertUnit(m(1, 0) == 89);
+      assertUnit(m.row(1) == m.data() + 3);
+      assertUnit(sizeof(m) == sizeof(int) * 6);
+   }  // teardown
+
+   // ones down the diagonal
+   void test_identity()
+   {  // setup
+      // exercise
+      constexpr custom::matrix<int, 3, 3> i = custom::matrix<int, 3, 3>::identity();
+      // verify
+      static_assert(i(1, 1) == 1 && i(1, 2) == 0, "identity at compile time");
+      assertUnit(i(0, 0) == 1);
+      assertUnit(i(2, 2) == 1);
+      assertUnit(i(2, 0) == 0);
+   }  // teardown
+
+   // the storage can start on a cache line
+   void test_align_cacheLine()
+   {  // setup
+      // exercise
+      custom::matrix<float, 4, 4, 64> m{};
+      // verify
+      assertUnit(reinterpret_cast<size_t>(m.data()) % 64 == 0);
+      assertUnit(sizeof(m) == 64);
+   }  // teardown
+
+   /***************************************
+    * TRANSPOSE
+    ***************************************/
+
+   // a 2 x 3 becomes a 3 x 2
+   void test_transpose_small()
+   {  // setup
+      custom::matrix<int, 2, 3> m{{1, 2, 3,
+                                   4, 5, 6}};
+      // exercise
+      custom::matrix<int, 3, 2> t = custom::transpose(m);
+      // verify
+      assertUnit(t(0, 0) == 1 && t(0, 1) == 4);
+      assertUnit(t(1, 0) == 2 && t(1, 1) == 5);
+      assertUnit(t(2, 0) == 3 && t(2, 1) == 6);
+      assertUnit(custom::transpose(t) == m);
+   }  // teardown
+
+   // partial tiles on both edges land in the right place
+   void test_transpose_acrossTiles()
+   {  // setup
+      custom::matrix<int, 37, 21> m{};
+      for (size_t i = 0; i < m.rows(); i++)
+         for (size_t j = 0; j < m.cols(); j++)
+            m(i, j) = static_cast<int>(i * 100 + j);
+      // exercise
+      custom::matrix<int, 21, 37> t = custom::transpose(m);
+      // verify
+      bool same = true;
+      for (size_t i = 0; i < m.rows(); i++)
+         for (size_t j = 0; j < m.cols(); j++)
+            same = same && t(j, i) == m(i, j);
+      assertUnit(same);
+   }  // teardown
+
+   /***************************************
+    * MULTIPLY
+    ***************************************/
+
+   // 2 x 3 times 3 x 2 worked by hand
+   void test_multiply_small()
+   {  // setup
+      custom::matrix<int, 2, 3> a{{1, 2, 3,
+                                   4, 5, 6}};
+      custom::matrix<int, 3, 2> b{{ 7,  8,
+                                    9, 10,
+                                   11, 12}};
+      // exercise
+      custom::matrix<int, 2, 2> c = a * b;
+      // verify
+      assertUnit(c(0, 0) == 58);
+      assertUnit(c(0, 1) == 64);
+      assertUnit(c(1, 0) == 139);
+      assertUnit(c(1, 1) == 154);
+   }  // teardown
+
+   // the identity changes nothing, on either side
+   void test_multiply_identity()
+   {  // setup
+      custom::matrix<double, 4, 4> m{};
+      for (size_t i = 0; i < m.size(); i++)
+         m.elems[i] = 0.5 * i;
+      custom::matrix<double, 4, 4> id = custom::matrix<double, 4, 4>::identity();
+      // exercise
+      custom::matrix<double, 4, 4> left  = id * m;
+      custom::matrix<double, 4, 4> right = m * id;
+      // verify
+      assertUnit(left == m);
+      assertUnit(right == m);
+   }  // teardown
+
+   // the blocked product matches a plain triple loop
+   void test_multiply_acrossTiles()
+   {  // setup
+      custom::matrix<int, 35, 19> a{};
+      custom::matrix<int, 19, 41> b{};
+      for (size_t i = 0; i < a.size(); i++)
+         a.elems[i] = static_cast<int>(i % 7) - 3;
+      for (size_t i = 0; i < b.size(); i++)
+         b.elems[i] = static_cast<int>(i % 5) - 2;
+      // exercise
+      custom::matrix<int, 35, 41> c = a * b;
+      // verify
+      bool same = true;
+      for (size_t i = 0; i < 35; i++)
+         for (size_t j = 0; j < 41; j++)
+         {
+            int sum = 0;
+            for (size_t k = 0; k < 19; k++)
+               sum += a(i, k) * b(k, j);
+            same = same && c(i, j) == sum;
+         }
+      assertUnit(same);
+   }  // teardown
+
+   // K past one tile: each block of the result sums over three kk blocks
+   void test_multiply_acrossInnerTiles()
+   {  // setup
+      custom::matrix<int, 37, 70> a{};
+      custom::matrix<int, 70, 45> b{};
+      for (size_t i = 0; i < a.size(); i++)
+         a.elems[i] = static_cast<int>(i % 11) - 5;
+      for (size_t i = 0; i < b.size(); i++)
+         b.elems[i] = static_cast<int>(i % 13) - 6;
+      // exercise
+      custom::matrix<int, 37, 45> c = a * b;
+      // verify
+      bool same = true;
+      for (size_t i = 0; i < 37; i++)
+         for (size_t j = 0; j < 45; j++)
+         {
+            int sum = 0;
+            for (size_t k = 0; k < 70; k++)
+               sum += a(i, k) * b(k, j);
+            same = same && c(i, j) == sum;
+         }
+      assertUnit(same);
+   }  // teardown
+
+   // a small transform can be worked out by the compiler
+   static constexpr custom::matrix<int, 2, 2> rotate()
+   {
+      custom::matrix<int, 2, 2> quarter{{0, -1,
+                                         1,  0}};
+      return quarter * quarter;
+   }
+   void test_multiply_constexpr()
+   {  // setup
+      // exercise
+      constexpr custom::matrix<int, 2, 2> half = rotate();
+      // verify
+      static_assert(half(0, 0) == -1 && half(1, 1) == -1, "multiply at compile time");
+      static_assert(half(0, 1) == 0 && half(1, 0) == 0, "multiply at compile time");
+      assertUnit(half(0, 0) == -1);
+   }  // teardown
+
+   // element by element
+   void test_addSubtract()
+   {  // setup
+      custom::matrix<int, 2, 2> a{{1, 2, 3, 4}};
+      custom::matrix<int, 2, 2> b{{4, 3, 2, 1}};
+      // exercise
+      custom::matrix<int, 2, 2> sum  = a + b;
+      custom::matrix<int, 2, 2> diff = sum - b;
+      // verify
+      assertUnit(sum(0, 0) == 5 && sum(1, 1) == 5);
+      assertUnit(diff == a);
+      assertUnit(diff != b);
+   }  // teardown
+
+   /***************************************
+    * MATRIX-VECTOR
+    ***************************************/
+
+   // short rows use the plain loop
+   void test_vector_small()
+   {  // setup
+      custom::matrix<int, 2, 3> m{{1, 2, 3,
+                                   4, 5, 6}};
+      custom::array<int, 3> v{1, 0, -1};
+      // exercise
+      custom::array<int, 2> out = m * v;
+      // verify
+      assertUnit(out[0] == -2);
+      assertUnit(out[1] == -2);
+   }  // teardown
+
+   // long rows go through simd::dot and agree with a plain loop
+   void test_vector_simd()
+   {  // setup
+      custom::matrix<float, 5, 64> m{};
+      custom::array<float, 64> v{};
+      for (size_t i = 0; i < m.size(); i++)
+         m.elems[i] = static_cast<float>(i % 9);
+      for (size_t j = 0; j < v.size(); j++)
+         v[j] = static_cast<float>(j % 4);
+      // exercise
+      custom::array<float, 5> out = m * v;
+      // verify
+      bool same = true;
+      for (size_t i = 0; i < 5; i++)
+      {
+         float sum = 0.0f;
+         for (size_t j = 0; j < 64; j++)
+            sum += m(i, j) * v[j];
+         same = same && out[i] == sum;
+      }
+      assertUnit(same);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,123 @@
+/***********************************************************************
+ * Program:
+ *    Benchmark Iterator
+ * Summary:
+ *    Run standard algorithms through custom::vector's iterators and
+ *    through plain pointers into the same buffer.  The iterator is a
+ *    pointer in a class, so with optimization on the two columns
+ *    should match.  A ratio well above 1.0 means something in the
+ *    iterator is getting in the optimizer's way.  The one expected
+ *    gap is copy at -O2: the library turns a pointer copy into
+ *    memmove, while the iterator copy is a loop that -O3 vectorizes.
+ *    This is its own program, not part of the unit test build:
+ *       g++ -std=c++14 -O3 benchmarkIterator.cpp -o benchmarkIterator
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#include "vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+
+using namespace std;
+
+const size_t NUM_ELEMENTS = 1 << 20;  // 4MB of ints
+const int    NUM_REPEATS  = 20;
+
+// keeps the optimizer from throwing away a result we never look at
+volatile long long sink;
+
+/*****************************************
+ * TIME
+ * Run setup then kernel NUM_REPEATS times and return the
+ * average nanoseconds per element, counting only the kernel
+ ****************************************/
+template <class Setup, class Kernel>
+double time(Setup setup, Kernel kernel)
+{
+   double total = 0.0;
+   setup();
+   kernel();  // warm up the cache
+   for (int i = 0; i < NUM_REPEATS; i++)
+   {
+      setup();
+      auto begin = chrono::steady_clock::now();
+      kernel();
+      auto end = chrono::steady_clock::now();
+      total += chrono::duration<double, nano>(end - begin).count();
+   }
+   return total / (double(NUM_REPEATS) * NUM_ELEMENTS);
+}
+
+/*****************************************
+ * REPORT
+ * One row: pointers, iterators, and their ratio
+ ****************************************/
+template <class Setup, class Pointer, class Iterator>
+void report(const char * name, Setup setup, Pointer pointer, Iterator iterator)
+{
+   double base = time(setup, pointer);
+   double t    = time(setup, iterator);
+   cout << "   " << left << setw(14) << name << right << fixed << setprecision(3)
+        << setw(10) << base << setw(10) << t
+        << setprecision(2) << setw(8) << t / base << endl;
+}
+
+/**********************************************************************
+ * MAIN
+ ***********************************************************************/
+int main()
+{
+   custom::vector<int> scrambled(NUM_ELEMENTS);
+   unsigned seed = 26;
+   for (size_t i = 0; i < NUM_ELEMENTS; i++)
+   {
+      seed = seed * 1103515245u + 12345u;
+      scrambled[i] = static_cast<int>(seed >> 1);
+   }
+   custom::vector<int> v(NUM_ELEMENTS);
+   custom::vector<int> w(NUM_ELEMENTS);
+   // the pointers' end comes from size() too, as the iterators' does,
+   // so the optimizer knows exactly as much about the trip count
+   int * pv = &v[0];
+   int * pe = pv + v.size();
+   int * pw = &w[0];
+
+   auto restore = [&]() { copy(scrambled.begin(), scrambled.end(), v.begin()); };
+   auto nothing = []() {};
+
+   cout << "ns per element\n   " << left << setw(14) << "algorithm" << right
+        << setw(10) << "pointer" << setw(10) << "iterator" << setw(8) << "ratio" << endl;
+
+   report("sort", restore,
+      [&]() { sort(pv, pe); },
+      [&]() { sort(v.begin(), v.end()); });
+   report("stable_sort", restore,
+      [&]() { stable_sort(pv, pe); },
+      [&]() { stable_sort(v.begin(), v.end()); });
+
+   sort(v.begin(), v.end());
+   report("lower_bound", nothing,
+      [&]() { long long n = 0;
+              for (size_t i = 0; i < NUM_ELEMENTS; i += 64)
+                 n += lower_bound(pv, pe, scrambled[i]) - pv;
+              sink = n; },
+      [&]() { long long n = 0;
+              for (size_t i = 0; i < NUM_ELEMENTS; i += 64)
+                 n += lower_bound(v.begin(), v.end(), scrambled[i]) - v.begin();
+              sink = n; });
+   report("copy", nothing,
+      [&]() { copy(pv, pe, pw); sink = pw[NUM_ELEMENTS / 2]; },
+      [&]() { copy(v.begin(), v.end(), w.begin()); sink = w[NUM_ELEMENTS / 2]; });
+   report("accumulate", nothing,
+      [&]() { sink = accumulate(pv, pe, 0LL); },
+      [&]() { sink = accumulate(v.begin(), v.end(), 0LL); });
+   report("reverse", nothing,
+      [&]() { reverse(pv, pe); sink = pv[0]; },
+      [&]() { reverse(v.begin(), v.end()); sink = v[0]; });
+   return 0;
+}
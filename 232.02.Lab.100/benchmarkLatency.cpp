@@ -0,0 +1,120 @@
+/***********************************************************************
+ * Program:
+ *    Benchmark Latency
+ * Summary:
+ *    Time every push_back on its own, then report the percentiles.
+ *    The plain vector copies the whole buffer on the push that fills
+ *    it, so its worst pushes cost O(n).  Those are only 22 of the 4M
+ *    pushes, so they show in the p99.99 and max columns, not at p99.
+ *    With grow_incremental each push moves only a few old elements,
+ *    while the mean stays about the same.  That takes the copy out
+ *    of the max column, but not everything: the push that empties
+ *    the old buffer frees it, which the heap hands back to the system
+ *    in time proportional to its pages, and the page faults on the
+ *    new buffer now land on more of the pushes, so p99 and p99.9 get
+ *    a little worse.  The clock is read around each push, so every
+ *    column includes its overhead, some tens of nanoseconds.
+ *    This is its own program, not part of the unit test build:
+ *       g++ -std=c++14 -O2 benchmarkLatency.cpp -o benchmarkLatency
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#include "vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const size_t NUM_PUSHES  = 1 << 22;  // 4M pushes, 22 reallocations
+const int    NUM_REPEATS = 5;
+
+/*****************************************
+ * MEASURE
+ * Push NUM_PUSHES copies of value into a fresh vector,
+ * NUM_REPEATS times, and record how long each push took
+ ****************************************/
+template <class Vector, class T>
+std::vector<double> measure(const T & value)
+{
+   std::vector<double> samples;
+   samples.reserve(NUM_PUSHES * NUM_REPEATS);
+   for (int r = 0; r < NUM_REPEATS; r++)
+   {
+      // the last repeat just freed millions of small strings, and glibc
+      // sorts them out on the next allocation of a kilobyte or more.  That
+      // takes tens of ms; let it happen here rather than inside a push.
+      char * volatile pFlush = new char[4096];
+      delete [] pFlush;
+
+      Vector v;
+      for (size_t i = 0; i < NUM_PUSHES; i++)
+      {
+         auto begin = chrono::steady_clock::now();
+         v.push_back(value);
+         auto end = chrono::steady_clock::now();
+         samples.push_back(chrono::duration<double, nano>(end - begin).count());
+      }
+   }
+   return samples;
+}
+
+/*****************************************
+ * PERCENTILE
+ * The sample below which fraction of them fall
+ ****************************************/
+double percentile(std::vector<double> & samples, double fraction)
+{
+   size_t index = static_cast<size_t>(fraction * (samples.size() - 1));
+   nth_element(samples.begin(), samples.begin() + index, samples.end());
+   return samples[index];
+}
+
+/*****************************************
+ * REPORT
+ * One row: the mean, the median, the tail, and the worst
+ ****************************************/
+void report(const char * name, std::vector<double> samples)
+{
+   double total = 0.0;
+   for (double sample : samples)
+      total += sample;
+   double mean = total / samples.size();
+
+   cout << "   " << left << setw(22) << name << right << fixed << setprecision(0)
+        << setw(9) << mean
+        << setw(9) << percentile(samples, 0.50)
+        << setw(9) << percentile(samples, 0.99)
+        << setw(9) << percentile(samples, 0.999)
+        << setw(9) << percentile(samples, 0.9999)
+        << setw(12) << *max_element(samples.begin(), samples.end()) << endl;
+}
+
+/**********************************************************************
+ * MAIN
+ ***********************************************************************/
+int main()
+{
+   typedef custom::vector<int>    IntVector;
+   typedef custom::vector<string> StringVector;
+   typedef custom::vector<int,    allocator<int>,    custom::grow_incremental<>> IntIncremental;
+   typedef custom::vector<string, allocator<string>, custom::grow_incremental<>> StringIncremental;
+
+   // long enough to live on the heap, so every move is a real object
+   string text(32, 'x');
+
+   cout << "ns per push_back\n   " << left << setw(22) << "vector" << right
+        << setw(9) << "mean" << setw(9) << "p50" << setw(9) << "p99"
+        << setw(9) << "p99.9" << setw(9) << "p99.99" << setw(12) << "max" << endl;
+
+   report("int",                  measure<IntVector>(26));
+   report("int incremental",      measure<IntIncremental>(26));
+   report("string",               measure<StringVector>(text));
+   report("string incremental",   measure<StringIncremental>(text));
+   return 0;
+}
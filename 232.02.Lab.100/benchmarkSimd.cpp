@@ -0,0 +1,166 @@
+/***********************************************************************
+ * Program:
+ *    Benchmark SIMD
+ * Summary:
+ *    Time the simd kernels against the loops we used to write by
+ *    hand: walking custom::vector with its iterator, one element at
+ *    a time.  Each kernel runs at every level the CPU supports.
+ *    This is its own program, not part of the unit test build:
+ *       g++ -std=c++14 -O2 benchmarkSimd.cpp -o benchmarkSimd
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#include "vector.h"
+#include "simd.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+const size_t NUM_ELEMENTS = 1 << 16;  // 256KB of floats: stays in cache
+const int    NUM_REPEATS  = 2000;
+
+// keeps the optimizer from throwing away a result we never look at
+volatile double sink;
+
+/*****************************************
+ * TIME
+ * Run the kernel NUM_REPEATS times and return the
+ * average nanoseconds per element
+ ****************************************/
+template <class Kernel>
+double time(Kernel kernel)
+{
+   kernel();  // warm up the cache
+   auto begin = chrono::steady_clock::now();
+   for (int i = 0; i < NUM_REPEATS; i++)
+      kernel();
+   auto end = chrono::steady_clock::now();
+   return chrono::duration<double, nano>(end - begin).count() /
+          (double(NUM_REPEATS) * NUM_ELEMENTS);
+}
+
+/*****************************************
+ * LEVEL NAME
+ ****************************************/
+const char * levelName(custom::simd::isa level)
+{
+   switch (level)
+   {
+      case custom::simd::isa::avx2: return "avx2";
+      case custom::simd::isa::sse2: return "sse2";
+      default:                      return "scalar";
+   }
+}
+
+/*****************************************
+ * REPORT
+ * One row: the iterator loop, then each simd level
+ ****************************************/
+template <class Loop, class Kernel>
+void report(const char * name, Loop loop, Kernel kernel)
+{
+   double base = time(loop);
+   cout << "   " << left << setw(8) << name << right << fixed << setprecision(3)
+        << setw(10) << base;
+
+   for (custom::simd::isa level : { custom::simd::isa::scalar,
+                                    custom::simd::isa::sse2,
+                                    custom::simd::isa::avx2 })
+      if (level <= custom::simd::detect())
+      {
+         custom::simd::set_level(level);
+         double t = time(kernel);
+         cout << setw(10) << t << " (" << setprecision(1) << setw(4) << base / t
+              << "x)" << setprecision(3);
+      }
+   custom::simd::set_level(custom::simd::detect());
+   cout << endl;
+}
+
+/*****************************************
+ * BENCHMARK
+ * Every kernel for one element type
+ ****************************************/
+template <class T>
+void benchmark(const char * type)
+{
+   typedef typename custom::vector<T>::iterator iterator;
+
+   custom::vector<T> a(NUM_ELEMENTS);
+   custom::vector<T> b(NUM_ELEMENTS);
+   for (size_t i = 0; i < NUM_ELEMENTS; i++)
+   {
+      a[i] = T(i % 100);
+      b[i] = T(i % 100);
+   }
+   const T missing = T(-1);
+
+   cout << type << " (ns per element)\n   " << left << setw(8) << "kernel" << right
+        << setw(10) << "iterator";
+   for (custom::simd::isa level : { custom::simd::isa::scalar,
+                                    custom::simd::isa::sse2,
+                                    custom::simd::isa::avx2 })
+      if (level <= custom::simd::detect())
+         cout << setw(18) << levelName(level);
+   cout << endl;
+
+   report("find",
+      [&]() { size_t i = 0; for (iterator it = a.begin(); it != a.end(); ++it, ++i)
+                 if (*it == missing) break;
+              sink = double(i); },
+      [&]() { sink = double(custom::simd::find(a, missing)); });
+   report("count",
+      [&]() { size_t n = 0; for (iterator it = a.begin(); it != a.end(); ++it)
+                 if (*it == T(7)) n++;
+              sink = double(n); },
+      [&]() { sink = double(custom::simd::count(a, T(7))); });
+   report("min",
+      [&]() { T m = a[0]; for (iterator it = a.begin(); it != a.end(); ++it)
+                 if (*it < m) m = *it;
+              sink = double(m); },
+      [&]() { sink = double(custom::simd::min(a)); });
+   report("max",
+      [&]() { T m = a[0]; for (iterator it = a.begin(); it != a.end(); ++it)
+                 if (*it > m) m = *it;
+              sink = double(m); },
+      [&]() { sink = double(custom::simd::max(a)); });
+   report("sum",
+      [&]() { T s = T(); for (iterator it = a.begin(); it != a.end(); ++it)
+                 s += *it;
+              sink = double(s); },
+      [&]() { sink = double(custom::simd::sum(a)); });
+   report("dot",
+      [&]() { T s = T(); iterator itB = b.begin();
+              for (iterator it = a.begin(); it != a.end(); ++it, ++itB)
+                 s += *it * *itB;
+              sink = double(s); },
+      [&]() { sink = double(custom::simd::dot(a, b)); });
+   report("equal",
+      [&]() { bool same = true; iterator itB = b.begin();
+              for (iterator it = a.begin(); it != a.end() && same; ++it, ++itB)
+                 same = (*it == *itB);
+              sink = same; },
+      [&]() { sink = custom::simd::equal(a, b); });
+   report("fill",
+      [&]() { for (iterator it = b.begin(); it != b.end(); ++it)
+                 *it = T(3);
+              sink = double(b[0]); },
+      [&]() { custom::simd::fill(b, T(3)); sink = double(b[0]); });
+   cout << endl;
+}
+
+/**********************************************************************
+ * MAIN
+ ***********************************************************************/
+int main()
+{
+   cout << "best level: " << levelName(custom::simd::detect()) << "\n\n";
+   benchmark<int>("int");
+   benchmark<float>("float");
+   benchmark<double>("double");
+   return 0;
+}
@@ -0,0 +1,436 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT VECTOR
+ * Summary:
+ *    An append-only vector that many threads can push_back into at
+ *    once without a lock.  Each push claims a slot with one atomic
+ *    increment.  The slots live in segments that double in size and
+ *    are allocated on first use, so a full vector is never copied and
+ *    an element never moves.
+ *
+ *    size() counts the published prefix: the slots from zero up to
+ *    the first one still under construction.  Readers may index and
+ *    iterate that prefix, lock free, while writers keep appending.
+ *    Each slot carries a ready flag; whichever writer finishes next
+ *    moves the published count past every ready slot, so no writer
+ *    ever waits for another.
+ *
+ *    A constructor that throws in push_back would leave a slot that
+ *    is never ready, and nothing past it would ever be published, so
+ *    T's copy and move constructors should not throw.  clear() and
+ *    the destructor are not safe to call while others push.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_vector                 : a lock-free append-only vector
+ *        concurrent_vector::iterator       : an iterator through it
+ *        concurrent_vector::const_iterator : the same, read only
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>       // for std::atomic
+#include <cassert>      // because I am paranoid
+#include <cstddef>      // for size_t
+#include <iterator>     // for std::random_access_iterator_tag
+#include <memory>       // for std::allocator
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::forward
+
+class TestConcurrentVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * CONCURRENT VECTOR
+ * push_back and emplace_back may run on any number of
+ * threads at once, alongside any number of readers.
+ * Segment k holds F << k slots.
+ ****************************************/
+template <typename T, size_t F = 64, typename A = std::allocator<T>>
+class concurrent_vector
+{
+   static_assert(F > 0 && (F & (F - 1)) == 0, "the first segment size must be a power of two");
+   friend class ::TestConcurrentVector; // give unit tests access to the privates
+
+   // one slot: room for an element and whether it is built yet
+   struct cell
+   {
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+      std::atomic<bool> ready;
+   };
+
+public:
+   using value_type     = T;
+   using allocator_type = A;
+
+   //
+   // Construct
+   //
+
+   concurrent_vector(const A & a = A());
+   concurrent_vector(const concurrent_vector &) = delete;
+   concurrent_vector & operator = (const concurrent_vector &) = delete;
+   ~concurrent_vector();
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   class const_iterator;
+   iterator       begin()        { return iterator(this, 0);              }
+   iterator       end()          { return iterator(this, size());         }
+   const_iterator begin()  const { return const_iterator(this, 0);        }
+   const_iterator end()    const { return const_iterator(this, size());   }
+   const_iterator cbegin() const { return const_iterator(this, 0);        }
+   const_iterator cend()   const { return const_iterator(this, size());   }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index)       { assert(index < size()); return element(index); }
+   const T& operator [] (size_t index) const { assert(index < size()); return element(index); }
+         T& front()       { assert(size() > 0); return element(0);          }
+   const T& front() const { assert(size() > 0); return element(0);          }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T & t) { emplace_back(t);            }
+   void push_back(T && t)      { emplace_back(std::move(t)); }
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   void reserve(size_t newCapacity);
+
+   //
+   // Remove
+   //
+
+   void clear();
+
+   //
+   // Status
+   //
+
+   // the published prefix; it only ever grows
+   size_t size()   const { return published.load(std::memory_order_acquire); }
+   bool   empty()  const { return size() == 0; }
+   size_t capacity() const;
+
+private:
+
+   // the cell allocator, rebound from A
+   using cell_alloc = typename std::allocator_traits<A>::template rebind_alloc<cell>;
+   using traits     = std::allocator_traits<cell_alloc>;
+
+   // more segments than a size_t index could ever reach
+   static const size_t MAX_SEGMENTS = sizeof(size_t) * 8;
+
+   // the number of slots in segment k, and the index of its first slot
+   static size_t segmentSize(size_t k)  { return F << k; }
+   static size_t segmentBase(size_t k)  { return F * ((size_t(1) << k) - 1); }
+
+   // which segment index falls in: the top bit of index / F + 1
+   static size_t segmentOf(size_t index)
+   {
+      size_t b = index / F + 1;
+#if defined(__GNUC__) || defined(__clang__)
+      return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(b);
+#else
+      size_t k = 0;
+      while (b >>= 1)
+         k++;
+      return k;
+#endif
+   }
+
+   // the cell for index, whose segment must already exist
+   cell & at(size_t index) const
+   {
+      size_t k = segmentOf(index);
+      return segments[k].load(std::memory_order_acquire)[index - segmentBase(k)];
+   }
+   T & element(size_t index) const
+   {
+      return *reinterpret_cast<T *>(&at(index).storage);
+   }
+
+   // whether the element at index is built; a slot whose
+   // segment its writer has not allocated yet is not
+   bool isReady(size_t index) const
+   {
+      size_t k = segmentOf(index);
+      cell * segment = segments[k].load(std::memory_order_acquire);
+      return segment && segment[index - segmentBase(k)].ready.load();
+   }
+
+   // make sure segment k exists: the first thread to install it wins
+   void allocateSegment(size_t k);
+
+   // move the published count past every ready slot
+   void publish();
+
+   cell_alloc                  alloc;
+   std::atomic<cell *>         segments[MAX_SEGMENTS];
+   std::atomic<size_t>         claimed;     // slots handed out to writers
+   std::atomic<size_t>         published;   // slots readers may see
+};
+
+/**************************************************
+ * CONCURRENT VECTOR ITERATOR
+ * The vector and an index.  end() is the published
+ * size when it was taken; elements pushed later are
+ * not part of that range.
+ *************************************************/
+template <typename T, size_t F, typename A>
+class concurrent_vector <T, F, A> :: iterator
+{
+   friend class concurrent_vector <T, F, A>;
+   friend class const_iterator;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = T *;
+   using reference         = T &;
+
+   iterator() : v(nullptr), index(0) {}
+   iterator(concurrent_vector * v, size_t index) : v(v), index(index) {}
+
+   // comparison operators
+   bool operator == (const iterator& rhs) const { return index == rhs.index; }
+   bool operator != (const iterator& rhs) const { return index != rhs.index; }
+   bool operator <  (const iterator& rhs) const { return index <  rhs.index; }
+   bool operator >  (const iterator& rhs) const { return index >  rhs.index; }
+   bool operator <= (const iterator& rhs) const { return index <= rhs.index; }
+   bool operator >= (const iterator& rhs) const { return index >= rhs.index; }
+
+   // dereference operators
+   T& operator *  () const { return v->element(index);  }
+   T* operator -> () const { return &v->element(index); }
+   T& operator [] (difference_type n) const { return v->element(index + n); }
+
+   // increment and decrement
+   iterator& operator ++ ()    { ++index; return *this; }
+   iterator& operator -- ()    { --index; return *this; }
+   iterator  operator ++ (int) { iterator t = *this; ++index; return t; }
+   iterator  operator -- (int) { iterator t = *this; --index; return t; }
+
+   // arithmetic
+   iterator& operator += (difference_type n)       { index += n; return *this; }
+   iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   iterator  operator +  (difference_type n) const { return iterator(v, index + n); }
+   iterator  operator -  (difference_type n) const { return iterator(v, index - n); }
+   difference_type operator - (const iterator& rhs) const
+   {
+      return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index);
+   }
+   friend iterator operator + (difference_type n, const iterator& it) { return it + n; }
+
+private:
+   concurrent_vector * v;
+   size_t index;
+};
+
+/**************************************************
+ * CONCURRENT VECTOR CONST ITERATOR
+ * The same, for reading only
+ *************************************************/
+template <typename T, size_t F, typename A>
+class concurrent_vector <T, F, A> :: const_iterator
+{
+   friend class concurrent_vector <T, F, A>;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = const T *;
+   using reference         = const T &;
+
+   const_iterator() : v(nullptr), index(0) {}
+   const_iterator(const concurrent_vector * v, size_t index) : v(v), index(index) {}
+   const_iterator(const iterator & it) : v(it.v), index(it.index) {}
+
+   // comparison operators; an iterator on either side converts
+   friend bool operator == (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index == rhs.index; }
+   friend bool operator != (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index != rhs.index; }
+   friend bool operator <  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <  rhs.index; }
+   friend bool operator >  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >  rhs.index; }
+   friend bool operator <= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <= rhs.index; }
+   friend bool operator >= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >= rhs.index; }
+
+   // dereference operators
+   const T& operator *  () const { return v->element(index);  }
+   const T* operator -> () const { return &v->element(index); }
+   const T& operator [] (difference_type n) const { return v->element(index + n); }
+
+   // increment and decrement
+   const_iterator& operator ++ ()    { ++index; return *this; }
+   const_iterator& operator -- ()    { --index; return *this; }
+   const_iterator  operator ++ (int) { const_iterator t = *this; ++index; return t; }
+   const_iterator  operator -- (int) { const_iterator t = *this; --index; return t; }
+
+   // arithmetic
+   const_iterator& operator += (difference_type n)       { index += n; return *this; }
+   const_iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   const_iterator  operator +  (difference_type n) const { return const_iterator(v, index + n); }
+   const_iterator  operator -  (difference_type n) const { return const_iterator(v, index - n); }
+   friend difference_type operator - (const const_iterator& lhs, const const_iterator& rhs)
+   {
+      return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+   }
+   friend const_iterator operator + (difference_type n, const const_iterator& it) { return it + n; }
+
+private:
+   const concurrent_vector * v;
+   size_t index;
+};
+
+/*****************************************
+ * CONCURRENT VECTOR :: CONSTRUCTOR
+ * No segments until the first push
+ ****************************************/
+template <typename T, size_t F, typename A>
+concurrent_vector <T, F, A> :: concurrent_vector(const A & a) :
+   alloc(a), claimed(0), published(0)
+{
+   for (size_t k = 0; k < MAX_SEGMENTS; k++)
+      segments[k].store(nullptr, std::memory_order_relaxed);
+}
+
+/*****************************************
+ * CONCURRENT VECTOR :: DESTRUCTOR
+ ****************************************/
+template <typename T, size_t F, typename A>
+concurrent_vector <T, F, A> :: ~concurrent_vector()
+{
+   clear();
+   for (size_t k = 0; k < MAX_SEGMENTS; k++)
+   {
+      cell * segment = segments[k].load(std::memory_order_relaxed);
+      if (segment)
+         traits::deallocate(alloc, segment, segmentSize(k));
+   }
+}
+
+/*****************************************
+ * CONCURRENT VECTOR :: CAPACITY
+ * Slots in the segments allocated so far
+ ****************************************/
+template <typename T, size_t F, typename A>
+size_t concurrent_vector <T, F, A> :: capacity() const
+{
+   size_t num = 0;
+   for (size_t k = 0; k < MAX_SEGMENTS && segments[k].load(std::memory_order_acquire); k++)
+      num += segmentSize(k);
+   return num;
+}
+
+/*****************************************
+ * CONCURRENT VECTOR :: ALLOCATE SEGMENT
+ * Several writers may reach an empty segment at once.
+ * Each allocates; one installs its segment, the rest
+ * give theirs back.
+ *     INPUT  : k the segment that must exist
+ *     OUTPUT :
+ ****************************************/
+template <typename T, size_t F, typename A>
+void concurrent_vector <T, F, A> :: allocateSegment(size_t k)
+{
+   if (segments[k].load(std::memory_order_acquire))
+      return;
+
+   cell * fresh = traits::allocate(alloc, segmentSize(k));
+   for (size_t i = 0; i < segmentSize(k); i++)
+      ::new (static_cast<void *>(&fresh[i].ready)) std::atomic<bool>(false);
+
+   cell * expected = nullptr;
+   if (!segments[k].compare_exchange_strong(expected, fresh,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire))
+      traits::deallocate(alloc, fresh, segmentSize(k));
+}
+
+/*****************************************
+ * CONCURRENT VECTOR :: PUBLISH
+ * Push the published count forward while the next slot
+ * is ready.  Losing the race means another writer moved
+ * it, and that writer will keep going past our slot.
+ * The ready flags and the count are sequentially
+ * consistent: a writer that stops at a slot not yet
+ * ready is ordered before that slot's writer checks
+ * the slots after its own.
+ ****************************************/
+template <typename T, size_t F, typename A>
+void concurrent_vector <T, F, A> :: publish()
+{
+   size_t num = published.load();
+   while (num < claimed.load() && isReady(num))
+   {
+      if (published.compare_exchange_weak(num, num + 1))
+         num++;
+   }
+}
+
+/***************************************
+ * CONCURRENT VECTOR :: EMPLACE BACK
+ * Claim a slot, make sure its segment exists, build
+ * the element there, then mark it ready and publish.
+ *     INPUT  : args the constructor arguments
+ *     OUTPUT : the new element
+ **************************************/
+template <typename T, size_t F, typename A>
+template <class ... Args>
+T & concurrent_vector <T, F, A> :: emplace_back(Args && ... args)
+{
+   size_t index = claimed.fetch_add(1, std::memory_order_acq_rel);
+   allocateSegment(segmentOf(index));
+
+   cell & c = at(index);
+   ::new (static_cast<void *>(&c.storage)) T(std::forward<Args>(args)...);
+   c.ready.store(true);
+
+   publish();
+   return *reinterpret_cast<T *>(&c.storage);
+}
+
+/***************************************
+ * CONCURRENT VECTOR :: RESERVE
+ * Allocate the segments for newCapacity slots now,
+ * so the pushes that fill them never allocate.
+ * Safe to call while others push.
+ **************************************/
+template <typename T, size_t F, typename A>
+void concurrent_vector <T, F, A> :: reserve(size_t newCapacity)
+{
+   if (newCapacity == 0)
+      return;
+   for (size_t k = 0; k <= segmentOf(newCapacity - 1); k++)
+      allocateSegment(k);
+}
+
+/***************************************
+ * CONCURRENT VECTOR :: CLEAR
+ * Destroy every element.  The segments are kept.
+ * Nobody else may be pushing.
+ **************************************/
+template <typename T, size_t F, typename A>
+void concurrent_vector <T, F, A> :: clear()
+{
+   assert(published.load() == claimed.load());
+   size_t num = published.load(std::memory_order_acquire);
+   for (size_t i = 0; i < num; i++)
+   {
+      element(i).~T();
+      at(i).ready.store(false, std::memory_order_relaxed);
+   }
+   published.store(0, std::memory_order_release);
+   claimed.store(0, std::memory_order_release);
+}
+
+} // namespace custom
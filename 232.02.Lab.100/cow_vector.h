@@ -0,0 +1,286 @@
+/***********************************************************************
+ * Header:
+ *    COW VECTOR
+ * Summary:
+ *    A vector whose copies share one buffer until one of them
+ *    changes.  Copying is a reference count increment; the first
+ *    write to a shared buffer clones it.  The count is atomic, so
+ *    copies may be handed to other threads and used there, just as
+ *    with std::shared_ptr.  One cow_vector object is still not safe
+ *    to use from two threads at once.
+ *
+ *    A reference or iterator from a non-const accessor points into
+ *    the buffer, so it is only good until this vector is next copied
+ *    or snapshotted: after that, writing through it would be seen
+ *    by the copy too.  Read through the const accessors when in doubt.
+ *
+ *    This will contain the class definition of:
+ *        cow_vector                : A vector with copy-on-write sharing
+ *        cow_vector::snapshot_type : A read-only handle on the contents
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include "vector.h"  // for the elements and their iterators
+
+#include <atomic>    // for std::atomic
+
+class TestCowVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * COW VECTOR
+ * The interface of custom::vector.  The const members
+ * read the shared buffer; the rest make it ours first.
+ ****************************************/
+template <typename T, typename A = std::allocator<T>>
+class cow_vector
+{
+   friend class ::TestCowVector; // give unit tests access to the privates
+
+   // the buffer the copies share, and how many share it
+   struct buffer
+   {
+      buffer(const vector<T, A> & elements) : refs(1), elements(elements) {}
+      buffer(vector<T, A> && elements) : refs(1), elements(std::move(elements)) {}
+      std::atomic<size_t> refs;
+      vector<T, A> elements;
+   };
+
+public:
+   using value_type     = T;
+   using allocator_type = A;
+   class snapshot_type;
+
+   //
+   // Construct
+   //
+
+   cow_vector(const A & a = A()) : shared(new buffer(vector<T, A>(a))), alloc(a) {}
+   cow_vector(size_t num,                   const A & a = A()) : shared(new buffer(vector<T, A>(num, a))), alloc(a)    {}
+   cow_vector(size_t num, const T & t,      const A & a = A()) : shared(new buffer(vector<T, A>(num, t, a))), alloc(a) {}
+   cow_vector(const std::initializer_list<T> & l, const A & a = A()) : shared(new buffer(vector<T, A>(l, a))), alloc(a) {}
+   cow_vector(const cow_vector & rhs) : shared(acquire(rhs.shared)), alloc(rhs.alloc) {}
+   cow_vector(cow_vector && rhs)      : shared(rhs.shared), alloc(rhs.alloc) { rhs.shared = nullptr; }
+   cow_vector(const snapshot_type & s) : shared(acquire(s.shared)), alloc(s.shared->elements.get_allocator()) {}
+   ~cow_vector() { release(shared); }
+
+   //
+   // Assign
+   //
+
+   cow_vector & operator = (const cow_vector & rhs);
+   cow_vector & operator = (cow_vector && rhs);
+   void swap(cow_vector & rhs)
+   {
+      std::swap(shared, rhs.shared);
+      std::swap(alloc, rhs.alloc);
+   }
+
+   //
+   // Iterator
+   //
+
+   using iterator       = typename vector<T, A>::iterator;
+   using const_iterator = typename vector<T, A>::const_iterator;
+   iterator       begin()        { return elements().begin(); }
+   iterator       end()          { return elements().end();   }
+   const_iterator begin()  const { return read().begin();     }
+   const_iterator end()    const { return read().end();       }
+   const_iterator cbegin() const { return read().begin();     }
+   const_iterator cend()   const { return read().end();       }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index)       { return elements()[index]; }
+   const T& operator [] (size_t index) const { return read()[index];     }
+         T& front()                          { return elements().front(); }
+   const T& front() const                    { return read().front();     }
+         T& back()                           { return elements().back();  }
+   const T& back()  const                    { return read().back();      }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T & t)                   { elements().push_back(t);                          }
+   void push_back(T && t)                        { elements().push_back(std::move(t));               }
+   template <class ... Args>
+   T &  emplace_back(Args && ... args)           { return elements().emplace_back(std::forward<Args>(args)...); }
+   void reserve(size_t newCapacity)              { elements().reserve(newCapacity);                  }
+   void resize(size_t newElements)               { elements().resize(newElements);                   }
+   void resize(size_t newElements, const T & t)  { elements().resize(newElements, t);                }
+
+   //
+   // Remove
+   //
+
+   void clear();
+   void pop_back()                               { elements().pop_back();                            }
+   void shrink_to_fit()                          { elements().shrink_to_fit();                       }
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return read().size();     }
+   size_t  capacity()      const { return read().capacity(); }
+   bool empty()            const { return read().empty();    }
+   A    get_allocator()    const { return shared ? shared->elements.get_allocator() : alloc; }
+
+   // cow-vector-specific interfaces
+
+   // a read-only handle on the contents as they are right now
+   snapshot_type snapshot() const { return snapshot_type(shared, alloc); }
+
+   // how many vectors and snapshots share our buffer
+   size_t use_count() const { return shared ? shared->refs.load(std::memory_order_acquire) : 0; }
+
+private:
+
+   // one more owner for b
+   static buffer * acquire(buffer * b)
+   {
+      if (b)
+         b->refs.fetch_add(1, std::memory_order_relaxed);
+      return b;
+   }
+
+   // one fewer owner for b; the last one out frees it
+   static void release(buffer * b)
+   {
+      if (b && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+         delete b;
+   }
+
+   // the elements for reading; a moved-from vector reads as empty
+   const vector<T, A> & read() const
+   {
+      static const vector<T, A> none;
+      return shared ? shared->elements : none;
+   }
+
+   // the elements for writing: ours alone, cloning if need be
+   vector<T, A> & elements();
+
+   // an empty buffer on the same allocator as our elements
+   buffer * fresh() const { return new buffer(vector<T, A>(get_allocator())); }
+
+   buffer * shared;
+   A alloc;        // builds our buffer again after we have been moved from
+};
+
+/*****************************************
+ * COW VECTOR :: SNAPSHOT TYPE
+ * A read-only view that keeps the buffer alive.  Writes
+ * to the vector afterward clone the buffer, so the
+ * snapshot never changes.  Cheap to copy and to keep.
+ ****************************************/
+template <typename T, typename A>
+class cow_vector <T, A> :: snapshot_type
+{
+   friend class cow_vector <T, A>;
+public:
+   using const_iterator = typename vector<T, A>::const_iterator;
+
+   snapshot_type(const snapshot_type & rhs) : shared(acquire(rhs.shared)) {}
+   ~snapshot_type() { release(shared); }
+   snapshot_type & operator = (const snapshot_type & rhs)
+   {
+      buffer * old = shared;
+      shared = acquire(rhs.shared);
+      release(old);
+      return *this;
+   }
+
+   const_iterator begin() const { return shared->elements.begin(); }
+   const_iterator end()   const { return shared->elements.end();   }
+   const T& operator [] (size_t index) const { return shared->elements[index]; }
+   const T& front() const { return shared->elements.front(); }
+   const T& back()  const { return shared->elements.back();  }
+   size_t size()    const { return shared->elements.size();  }
+   bool   empty()   const { return shared->elements.empty(); }
+
+private:
+   // a moved-from vector has no buffer, so its snapshot gets an empty one
+   snapshot_type(buffer * b, const A & a) : shared(b ? acquire(b) : new buffer(vector<T, A>(a))) {}
+   buffer * shared;
+};
+
+/*****************************************
+ * COW VECTOR :: ASSIGN
+ * Share rhs's buffer.  Take the new reference before
+ * dropping the old one so self-assignment is harmless.
+ ****************************************/
+template <typename T, typename A>
+cow_vector <T, A> & cow_vector <T, A> :: operator = (const cow_vector & rhs)
+{
+   buffer * old = shared;
+   shared = acquire(rhs.shared);
+   release(old);
+   return *this;
+}
+
+/*****************************************
+ * COW VECTOR :: ASSIGN MOVE
+ * Take rhs's buffer; rhs is left empty
+ ****************************************/
+template <typename T, typename A>
+cow_vector <T, A> & cow_vector <T, A> :: operator = (cow_vector && rhs)
+{
+   if (this != &rhs)
+   {
+      release(shared);
+      shared = rhs.shared;
+      rhs.shared = nullptr;
+   }
+   return *this;
+}
+
+/*****************************************
+ * COW VECTOR :: CLEAR
+ * A shared buffer is just let go, not cloned and then emptied.
+ * The empty one that replaces it keeps the same allocator.
+ ****************************************/
+template <typename T, typename A>
+void cow_vector <T, A> :: clear()
+{
+   if (shared && shared->refs.load(std::memory_order_acquire) == 1)
+      shared->elements.clear();
+   else
+   {
+      buffer * empty = fresh();
+      release(shared);
+      shared = empty;
+   }
+}
+
+/*****************************************
+ * COW VECTOR :: ELEMENTS
+ * Make the buffer ours before anyone writes to it.  If we
+ * are the only owner nobody else can add one: a copy
+ * would have to be made from this very object.
+ *     INPUT  :
+ *     OUTPUT : the elements, not shared with anyone
+ ****************************************/
+template <typename T, typename A>
+vector<T, A> & cow_vector <T, A> :: elements()
+{
+   if (!shared)
+      shared = fresh();
+   else if (shared->refs.load(std::memory_order_acquire) != 1)
+   {
+      buffer * clone = new buffer(shared->elements);
+      release(shared);
+      shared = clone;
+   }
+   return shared->elements;
+}
+
+} // namespace custom
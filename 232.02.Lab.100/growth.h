@@ -0,0 +1,122 @@
+/***********************************************************************
+ * Header:
+ *    GROWTH
+ * Summary:
+ *    How much a container's buffer grows when it runs out of room,
+ *    and counters for how often that happens.  A container takes
+ *    the policy as a template parameter and asks it for the next
+ *    capacity each time it is full.
+ *
+ *    This will contain the definition of:
+ *        grow_double     : twice the capacity, the classic choice
+ *        grow_by_half    : one and a half times, less slack per buffer
+ *        grow_page       : one and a half times, rounded up to what
+ *                          the heap would hand out anyway
+ *        grow_incremental: another policy's size, but the elements
+ *                          move over a few per push, not all at once
+ *        growth_stats    : reallocations, bytes moved, and peak capacity
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>  // for size_t
+
+namespace custom
+{
+
+/*****************************************
+ * GROW DOUBLE
+ * Double the capacity.  Fewest reallocations,
+ * but up to half the buffer may sit unused.
+ ****************************************/
+struct grow_double
+{
+   static size_t next(size_t capacity, size_t needed, size_t /* elementSize */)
+   {
+      size_t newCapacity = capacity * 2;
+      return newCapacity < needed ? needed : newCapacity;
+   }
+};
+
+/*****************************************
+ * GROW BY HALF
+ * Add half again.  At most a third of the buffer
+ * sits unused, at the cost of more reallocations.
+ ****************************************/
+struct grow_by_half
+{
+   static size_t next(size_t capacity, size_t needed, size_t /* elementSize */)
+   {
+      size_t newCapacity = capacity + capacity / 2;
+      if (newCapacity == capacity)
+         newCapacity++;
+      return newCapacity < needed ? needed : newCapacity;
+   }
+};
+
+/*****************************************
+ * GROW PAGE
+ * Grow by half, then round the buffer up to the block
+ * the heap will really hand out: a power of two for small
+ * buffers, whole pages for big ones.  The rounding would
+ * be wasted anyway, so this turns it into capacity.
+ ****************************************/
+struct grow_page
+{
+   static const size_t PAGE_SIZE   = 4096;
+   static const size_t MIN_BUCKET  = 16;
+
+   static size_t next(size_t capacity, size_t needed, size_t elementSize)
+   {
+      size_t bytes = grow_by_half::next(capacity, needed, elementSize) * elementSize;
+
+      size_t block;
+      if (bytes <= PAGE_SIZE)
+         for (block = MIN_BUCKET; block < bytes; block *= 2)
+            ;
+      else
+         block = (bytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+
+      return block / elementSize;
+   }
+};
+
+/*****************************************
+ * GROW INCREMENTAL
+ * Size the new buffer with G, but do not move everything
+ * into it at once.  vector<T, A, grow_incremental<G>> keeps
+ * the old buffer live and moves at least K of its elements
+ * on each push that follows, more if that is what it takes
+ * to finish before the new buffer fills.  No single push
+ * pays for the whole copy, though the one that frees the
+ * drained buffer still pays for that.  See vector_incremental.h.
+ ****************************************/
+template <typename G = grow_double, size_t K = 4>
+struct grow_incremental
+{
+   static const size_t STEP = K;
+
+   static size_t next(size_t capacity, size_t needed, size_t elementSize)
+   {
+      return G::next(capacity, needed, elementSize);
+   }
+};
+
+/*****************************************
+ * GROWTH STATS
+ * What the growth policy cost one container.  The counters
+ * belong to the container object, not to its buffer, so
+ * moves and swaps leave them where they are.
+ ****************************************/
+struct growth_stats
+{
+   growth_stats() : reallocations(0), bytesCopied(0), peakCapacity(0) {}
+
+   size_t reallocations;   // times the elements moved to a new buffer
+   size_t bytesCopied;     // bytes of elements moved in those reallocations
+   size_t peakCapacity;    // the biggest the buffer has ever been
+};
+
+} // namespace custom
@@ -0,0 +1,428 @@
+/***********************************************************************
+ * Header:
+ *    MMAP VECTOR
+ * Summary:
+ *    A vector whose buffer is a memory-mapped file.  Opening the
+ *    file maps the elements that are already there, so a big table
+ *    built once is ready the moment it is opened, and every process
+ *    that maps it shares the same pages in the OS cache.
+ *
+ *    The file is nothing but the elements, back to back.  While it is
+ *    open the file is stretched to the capacity; closing trims it back
+ *    to the size.  Only trivially copyable types can live in a file.
+ *    A file opened read_only is mapped copy-on-write: the elements can
+ *    still be changed, but the changes stay in this process and never
+ *    reach the file.
+ *    Needs POSIX mmap.  On Linux the mapping grows with mremap, which
+ *    can move it without copying; elsewhere it is unmapped and mapped
+ *    again.
+ *
+ *    This will contain the class definition of:
+ *        mmap_vector           : A vector stored in a mapped file
+ *        mmap_vector::iterator : the same iterators as vector
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include "vector.h"      // for vector::iterator and the growth policies
+
+#include <cerrno>        // for errno
+#include <system_error>  // for std::system_error
+#include <type_traits>   // for std::is_trivially_copyable
+
+#include <fcntl.h>       // for open
+#include <sys/mman.h>    // for mmap, mremap, msync, and madvise
+#include <sys/stat.h>    // for fstat
+#include <unistd.h>      // for ftruncate and close
+
+class TestMmapVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * MMAP VECTOR
+ * The vector interface over a mapped file.  It owns
+ * the file descriptor, so it moves but never copies.
+ ****************************************/
+template <typename T, typename G = grow_double>
+class mmap_vector
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "only trivially copyable types can be stored in a file");
+   friend class ::TestMmapVector; // give unit tests access to the privates
+public:
+   using value_type = T;
+
+   // how the file is opened
+   enum class mode { read_write, read_only };
+
+   // how we expect to touch the pages, so the kernel can read ahead
+   enum class access { normal, sequential, random, willneed };
+
+   //
+   // Construct
+   //
+
+   explicit mmap_vector(const char * path, mode m = mode::read_write);
+   mmap_vector(const mmap_vector &  rhs) = delete;
+   mmap_vector(      mmap_vector && rhs);
+   ~mmap_vector();
+
+   //
+   // Assign
+   //
+
+   mmap_vector & operator = (const mmap_vector &  rhs) = delete;
+   mmap_vector & operator = (      mmap_vector && rhs);
+   void swap(mmap_vector & rhs);
+
+   //
+   // Iterator
+   //
+
+   using iterator       = typename vector<T>::iterator;
+   using const_iterator = typename vector<T>::const_iterator;
+   iterator       begin()        { return iterator(data); }
+   iterator       end()          { return iterator(data+numElements); }
+   const_iterator begin()  const { return const_iterator(data); }
+   const_iterator end()    const { return const_iterator(data+numElements); }
+   const_iterator cbegin() const { return const_iterator(data); }
+   const_iterator cend()   const { return const_iterator(data+numElements); }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index)       { assert(index < numElements); return data[index]; }
+   const T& operator [] (size_t index) const { assert(index < numElements); return data[index]; }
+         T& front()       { assert(numElements > 0); return data[0];               }
+   const T& front() const { assert(numElements > 0); return data[0];               }
+         T& back()        { assert(numElements > 0); return data[numElements - 1]; }
+   const T& back()  const { assert(numElements > 0); return data[numElements - 1]; }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T& t);
+   void reserve(size_t newCapacity)
+   {
+      if (newCapacity > numCapacity)
+         remap(newCapacity);
+   }
+   void resize(size_t newElements, const T& t = T());
+
+   //
+   // Remove
+   //
+
+   void clear()                       { numElements = 0; }
+   void pop_back()                    { if (numElements > 0) numElements--; }
+   void shrink_to_fit()               { if (numCapacity != numElements) remap(numElements); }
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return numElements; }
+   size_t  capacity()      const { return numCapacity; }
+   bool empty()            const { return (numElements == 0); }
+
+   // mmap-vector-specific interfaces
+
+   // write the dirty pages back to the file before returning
+   void sync();
+
+   // tell the kernel how the pages will be read; it survives growing
+   void advise(access a);
+
+private:
+
+   // move the mapping to cover newCapacity elements, stretching the file
+   void remap(size_t newCapacity);
+
+   // apply the current advice to the whole mapping
+   void applyAdvice();
+
+   // unmap, trim the file to the elements, and close it
+   void release();
+
+   // report a failed system call
+   static void fail(const char * what)
+   {
+      throw std::system_error(errno, std::generic_category(), what);
+   }
+
+   int     fd;                // the open file
+   bool    readOnly;          // opened with mode::read_only
+   access  advice;            // the last advice, reapplied after a remap
+   T *     data;              // the mapping, or nullptr when there is none
+   size_t  numCapacity;       // elements the mapping (and file) can hold
+   size_t  numElements;       // the number of items currently used
+};
+
+/*****************************************
+ * MMAP VECTOR :: CONSTRUCTOR
+ * Open or create the file and map what is already in it.
+ * A new file starts out empty.
+ *     INPUT  : path the file holding the elements
+ *              m    read_write, or read_only to share a finished table
+ ****************************************/
+template <typename T, typename G>
+mmap_vector <T, G> :: mmap_vector(const char * path, mode m) :
+   readOnly(m == mode::read_only), advice(access::normal), data(nullptr),
+   numCapacity(0), numElements(0)
+{
+   fd = readOnly ? ::open(path, O_RDONLY) : ::open(path, O_RDWR | O_CREAT, 0644);
+   if (fd < 0)
+      fail("mmap_vector: open");
+
+   struct stat info;
+   if (::fstat(fd, &info) != 0)
+   {
+      ::close(fd);
+      fail("mmap_vector: fstat");
+   }
+
+   // a partial element at the end of the file is not an element
+   size_t num = static_cast<size_t>(info.st_size) / sizeof(T);
+   if (num > 0)
+   {
+      void * p = ::mmap(nullptr, num * sizeof(T), PROT_READ | PROT_WRITE,
+                        readOnly ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+      if (p == MAP_FAILED)
+      {
+         ::close(fd);
+         fail("mmap_vector: mmap");
+      }
+      data = static_cast<T *>(p);
+   }
+   numCapacity = numElements = num;
+}
+
+/*****************************************
+ * MMAP VECTOR :: MOVE CONSTRUCTOR
+ * Take over the file and the mapping
+ ****************************************/
+template <typename T, typename G>
+mmap_vector <T, G> :: mmap_vector(mmap_vector && rhs) :
+   fd(rhs.fd), readOnly(rhs.readOnly), advice(rhs.advice), data(rhs.data),
+   numCapacity(rhs.numCapacity), numElements(rhs.numElements)
+{
+   rhs.fd = -1;
+   rhs.data = nullptr;
+   rhs.numCapacity = rhs.numElements = 0;
+}
+
+/*****************************************
+ * MMAP VECTOR :: DESTRUCTOR
+ * Leave a file holding exactly the elements
+ ****************************************/
+template <typename T, typename G>
+mmap_vector <T, G> :: ~mmap_vector()
+{
+   release();
+}
+
+/*****************************************
+ * MMAP VECTOR :: MOVE ASSIGNMENT
+ * Close our file, then take over rhs's
+ ****************************************/
+template <typename T, typename G>
+mmap_vector <T, G> & mmap_vector <T, G> :: operator = (mmap_vector && rhs)
+{
+   if (this != &rhs)
+   {
+      release();
+      fd          = rhs.fd;
+      readOnly    = rhs.readOnly;
+      advice      = rhs.advice;
+      data        = rhs.data;
+      numCapacity = rhs.numCapacity;
+      numElements = rhs.numElements;
+
+      rhs.fd = -1;
+      rhs.data = nullptr;
+      rhs.numCapacity = rhs.numElements = 0;
+   }
+   return *this;
+}
+
+/*****************************************
+ * MMAP VECTOR :: SWAP
+ * Trade files and mappings
+ ****************************************/
+template <typename T, typename G>
+void mmap_vector <T, G> :: swap(mmap_vector & rhs)
+{
+   std::swap(fd,          rhs.fd);
+   std::swap(readOnly,    rhs.readOnly);
+   std::swap(advice,      rhs.advice);
+   std::swap(data,        rhs.data);
+   std::swap(numCapacity, rhs.numCapacity);
+   std::swap(numElements, rhs.numElements);
+}
+
+/***************************************
+ * MMAP VECTOR :: REMAP
+ * Stretch (or trim) the file to newCapacity elements and
+ * map all of it.  Touching a mapped page past the end of
+ * the file is a SIGBUS, so a growing file is stretched
+ * before it is mapped and a shrinking one is trimmed only
+ * after.  If a call fails, we are left mapping either the
+ * old capacity or the new one, never nothing.
+ *     INPUT  : newCapacity the number of elements to map
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename G>
+void mmap_vector <T, G> :: remap(size_t newCapacity)
+{
+   assert(!readOnly);
+   assert(newCapacity >= numElements);
+   size_t oldBytes = numCapacity * sizeof(T);
+   size_t newBytes = newCapacity * sizeof(T);
+
+   if (newBytes > oldBytes && ::ftruncate(fd, static_cast<off_t>(newBytes)) != 0)
+      fail("mmap_vector: ftruncate");
+
+   void * p = nullptr;
+   if (newBytes == 0)
+   {
+      if (data)
+         ::munmap(data, oldBytes);
+   }
+#ifdef MREMAP_MAYMOVE
+   else if (data)
+   {
+      p = ::mremap(data, oldBytes, newBytes, MREMAP_MAYMOVE);
+      if (p == MAP_FAILED)
+         fail("mmap_vector: mremap");
+   }
+#endif
+   else
+   {
+      // the new mapping first, so a failure leaves the old one in place
+      p = ::mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (p == MAP_FAILED)
+         fail("mmap_vector: mmap");
+      if (data)
+         ::munmap(data, oldBytes);
+   }
+
+   data = static_cast<T *>(p);
+   numCapacity = newCapacity;
+
+   // the pages are gone from the mapping, so the file can let them go
+   if (newBytes < oldBytes && ::ftruncate(fd, static_cast<off_t>(newBytes)) != 0)
+      fail("mmap_vector: ftruncate");
+
+   applyAdvice();
+}
+
+/***************************************
+ * MMAP VECTOR :: PUSH BACK
+ * Add 't' to the end, growing the file by the policy
+ * G when it is full.  't' is copied first, since it
+ * may live in the mapping that is about to move.
+ *     INPUT  : 't' the new element to be added
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename G>
+void mmap_vector <T, G> :: push_back(const T & t)
+{
+   // t may be one of ours, and growing can move the mapping
+   T copy = t;
+   if (numElements == numCapacity)
+      remap(G::next(numCapacity, numElements + 1, sizeof(T)));
+   data[numElements++] = copy;
+}
+
+/***************************************
+ * MMAP VECTOR :: RESIZE
+ * Grow or shrink to newElements, filling any new
+ * elements with t
+ *     INPUT  : newElements the new size
+ *              t           the value of the new elements
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename G>
+void mmap_vector <T, G> :: resize(size_t newElements, const T & t)
+{
+   T copy = t;
+   reserve(newElements);
+   for (size_t i = numElements; i < newElements; i++)
+      data[i] = copy;
+   numElements = newElements;
+}
+
+/***************************************
+ * MMAP VECTOR :: SYNC
+ * Block until the mapped pages are on disk
+ *     INPUT  :
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename G>
+void mmap_vector <T, G> :: sync()
+{
+   if (data && ::msync(data, numCapacity * sizeof(T), MS_SYNC) != 0)
+      fail("mmap_vector: msync");
+}
+
+/***************************************
+ * MMAP VECTOR :: ADVISE
+ * Remember how the pages will be used and tell the kernel
+ *     INPUT  : a normal, sequential, random, or willneed
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename G>
+void mmap_vector <T, G> :: advise(access a)
+{
+   advice = a;
+   applyAdvice();
+}
+
+template <typename T, typename G>
+void mmap_vector <T, G> :: applyAdvice()
+{
+   if (!data)
+      return;
+
+   int flag = MADV_NORMAL;
+   switch (advice)
+   {
+      case access::sequential: flag = MADV_SEQUENTIAL; break;
+      case access::random:     flag = MADV_RANDOM;     break;
+      case access::willneed:   flag = MADV_WILLNEED;   break;
+      default:                 flag = MADV_NORMAL;     break;
+   }
+   if (::madvise(static_cast<void *>(data), numCapacity * sizeof(T), flag) != 0)
+      fail("mmap_vector: madvise");
+}
+
+/***************************************
+ * MMAP VECTOR :: RELEASE
+ * Unmap, trim the file to the elements we hold, and
+ * close it.  Errors are ignored: this runs in the destructor.
+ *     INPUT  :
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename G>
+void mmap_vector <T, G> :: release()
+{
+   if (data)
+      ::munmap(data, numCapacity * sizeof(T));
+   if (fd >= 0)
+   {
+      if (!readOnly)
+         (void)::ftruncate(fd, static_cast<off_t>(numElements * sizeof(T)));
+      ::close(fd);
+   }
+   fd = -1;
+   data = nullptr;
+   numCapacity = numElements = 0;
+}
+
+} // namespace custom
@@ -0,0 +1,546 @@
+/***********************************************************************
+ * Header:
+ *    PARALLEL
+ * Summary:
+ *    Run sort, stable_sort, for_each, transform, and reduce on every
+ *    core.  They work on anything indexed with operator[] and
+ *    measured with size(), so custom::vector and custom::deque both
+ *    qualify.  Below a threshold the work is too small to be worth
+ *    handing out, and everything runs on the calling thread.
+ *
+ *    The threads come from a work-stealing pool: each worker keeps
+ *    its own queue, works on the newest task in it, and when it runs
+ *    dry steals the oldest task from someone else.  A thread waiting
+ *    for its tasks to finish runs tasks too, so nesting cannot deadlock.
+ *
+ *    This will contain the definition of:
+ *        parallel::thread_pool    : the workers and their queues
+ *        parallel::task_group     : a batch of tasks to wait for
+ *        parallel::index_iterator : a random access iterator over operator[]
+ *        parallel :: <algorithm>  : the algorithms themselves
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <algorithm>          // for std::sort, std::stable_sort, std::inplace_merge
+#include <atomic>             // for std::atomic
+#include <cassert>            // because I am paranoid
+#include <condition_variable> // for std::condition_variable
+#include <cstddef>            // for size_t
+#include <deque>              // for std::deque, each worker's queue
+#include <exception>          // for std::exception_ptr
+#include <functional>         // for std::function and std::less
+#include <iterator>           // for std::random_access_iterator_tag
+#include <memory>             // for std::unique_ptr
+#include <mutex>              // for std::mutex
+#include <thread>             // for std::thread
+#include <type_traits>        // for std::decay
+#include <vector>             // for std::vector
+
+namespace custom
+{
+namespace parallel
+{
+
+/*****************************************
+ * THRESHOLD
+ * Containers smaller than this are handled on the calling
+ * thread.  It is also the smallest piece a task gets.
+ ****************************************/
+inline size_t & currentThreshold()
+{
+   static size_t threshold = 1 << 14;
+   return threshold;
+}
+
+inline size_t threshold()
+{
+   return currentThreshold();
+}
+
+inline void set_threshold(size_t newThreshold)
+{
+   currentThreshold() = newThreshold ? newThreshold : 1;
+}
+
+/*****************************************
+ * THREAD POOL
+ * A fixed set of workers, each with its own queue of tasks.
+ * The owner takes from the back, thieves from the front.
+ ****************************************/
+class thread_pool
+{
+public:
+   explicit thread_pool(size_t numThreads = std::thread::hardware_concurrency());
+   ~thread_pool();
+
+   thread_pool(const thread_pool &) = delete;
+   thread_pool & operator = (const thread_pool &) = delete;
+
+   size_t size() const { return workers.size(); }
+
+   // queue a task: on our own queue if we are a worker, otherwise round robin
+   void submit(std::function<void()> task);
+
+   // run one queued task on the calling thread; false if there was none
+   bool run_one();
+
+private:
+   struct queue
+   {
+      std::mutex lock;
+      std::deque<std::function<void()>> tasks;
+   };
+
+   // take the newest task from queue i, or the oldest from anyone else
+   bool pop(size_t i, std::function<void()> & task);
+   void work(size_t i);
+
+   // the index of the calling thread's queue in this pool, or size()
+   size_t self() const;
+
+   std::vector<std::thread>             workers;
+   std::vector<std::unique_ptr<queue>>  queues;
+   std::atomic<size_t>                  next;      // round robin for outsiders
+   std::mutex                           sleepLock;
+   std::condition_variable              wake;
+   size_t                               queued;    // guarded by sleepLock
+   bool                                 stop;      // guarded by sleepLock
+};
+
+// which pool, and which queue in it, the calling thread works for
+struct worker_id
+{
+   const thread_pool * pool;
+   size_t index;
+};
+
+inline worker_id & currentWorker()
+{
+   static thread_local worker_id id = { nullptr, 0 };
+   return id;
+}
+
+/*****************************************
+ * THREAD POOL :: CONSTRUCTOR
+ * Start the workers.  The calling thread helps whenever
+ * it waits, so a pool of one worker still has two threads.
+ ****************************************/
+inline thread_pool :: thread_pool(size_t numThreads) : next(0), queued(0), stop(false)
+{
+   if (numThreads == 0)
+      numThreads = 1;
+   for (size_t i = 0; i < numThreads; i++)
+      queues.push_back(std::unique_ptr<queue>(new queue));
+   for (size_t i = 0; i < numThreads; i++)
+      workers.push_back(std::thread(&thread_pool::work, this, i));
+}
+
+/*****************************************
+ * THREAD POOL :: DESTRUCTOR
+ * Finish what is queued, then join
+ ****************************************/
+inline thread_pool :: ~thread_pool()
+{
+   {
+      std::lock_guard<std::mutex> guard(sleepLock);
+      stop = true;
+   }
+   wake.notify_all();
+   for (size_t i = 0; i < workers.size(); i++)
+      workers[i].join();
+}
+
+inline size_t thread_pool :: self() const
+{
+   const worker_id & id = currentWorker();
+   return id.pool == this ? id.index : size();
+}
+
+/*****************************************
+ * THREAD POOL :: SUBMIT
+ * Queue a task and wake a sleeping worker
+ ****************************************/
+inline void thread_pool :: submit(std::function<void()> task)
+{
+   size_t i = self();
+   if (i == size())
+      i = next++ % size();
+   {
+      std::lock_guard<std::mutex> guard(queues[i]->lock);
+      queues[i]->tasks.push_back(std::move(task));
+   }
+   {
+      std::lock_guard<std::mutex> guard(sleepLock);
+      queued++;
+   }
+   wake.notify_one();
+}
+
+/*****************************************
+ * THREAD POOL :: POP
+ * Our own newest task is the one whose data is still
+ * in cache.  The oldest task elsewhere is the biggest
+ * piece of work, so stealing it means stealing less often.
+ ****************************************/
+inline bool thread_pool :: pop(size_t i, std::function<void()> & task)
+{
+   if (i < size())
+   {
+      std::lock_guard<std::mutex> guard(queues[i]->lock);
+      if (!queues[i]->tasks.empty())
+      {
+         task = std::move(queues[i]->tasks.back());
+         queues[i]->tasks.pop_back();
+         return true;
+      }
+   }
+
+   for (size_t j = 1; j <= size(); j++)
+   {
+      queue & victim = *queues[(i + j) % size()];
+      std::lock_guard<std::mutex> guard(victim.lock);
+      if (!victim.tasks.empty())
+      {
+         task = std::move(victim.tasks.front());
+         victim.tasks.pop_front();
+         return true;
+      }
+   }
+   return false;
+}
+
+/*****************************************
+ * THREAD POOL :: RUN ONE
+ ****************************************/
+inline bool thread_pool :: run_one()
+{
+   std::function<void()> task;
+   if (!pop(self(), task))
+      return false;
+   {
+      std::lock_guard<std::mutex> guard(sleepLock);
+      queued--;
+   }
+   task();
+   return true;
+}
+
+/*****************************************
+ * THREAD POOL :: WORK
+ * A worker's life: run tasks until there are none,
+ * then sleep until one is queued or the pool stops
+ ****************************************/
+inline void thread_pool :: work(size_t i)
+{
+   currentWorker().pool = this;
+   currentWorker().index = i;
+   for (;;)
+   {
+      {
+         std::unique_lock<std::mutex> guard(sleepLock);
+         wake.wait(guard, [this]() { return stop || queued > 0; });
+         if (stop && queued == 0)
+            return;
+      }
+      while (run_one())
+         ;
+   }
+}
+
+/*****************************************
+ * POOL
+ * The pool the algorithms use, one worker per core,
+ * started the first time it is needed
+ ****************************************/
+inline thread_pool & pool()
+{
+   static thread_pool threads;
+   return threads;
+}
+
+/*****************************************
+ * TASK GROUP
+ * Tasks submitted together and waited for together.
+ * The first exception a task throws comes back out of wait().
+ ****************************************/
+class task_group
+{
+public:
+   explicit task_group(thread_pool & pool = parallel::pool()) : threads(pool), pending(0) {}
+   ~task_group() { finish(); }
+
+   task_group(const task_group &) = delete;
+   task_group & operator = (const task_group &) = delete;
+
+   template <class F>
+   void run(F f)
+   {
+      pending++;
+      threads.submit([this, f]()
+      {
+         try
+         {
+            f();
+         }
+         catch (...)
+         {
+            std::lock_guard<std::mutex> guard(errorLock);
+            if (!error)
+               error = std::current_exception();
+         }
+         pending--;
+      });
+   }
+
+   // help until every task is done, then rethrow the first failure
+   void wait()
+   {
+      finish();
+      if (error)
+      {
+         std::exception_ptr e = error;
+         error = nullptr;
+         std::rethrow_exception(e);
+      }
+   }
+
+private:
+   void finish()
+   {
+      while (pending > 0)
+         if (!threads.run_one())
+            std::this_thread::yield();
+   }
+
+   thread_pool &       threads;
+   std::atomic<size_t> pending;
+   std::mutex          errorLock;
+   std::exception_ptr  error;
+};
+
+/*****************************************
+ * INDEX ITERATOR
+ * A random access iterator made of a container and an
+ * index, so the standard sorts and merges can work on
+ * anything with operator[], contiguous or not.
+ ****************************************/
+template <class Container>
+class index_iterator
+{
+public:
+   using reference         = decltype(std::declval<Container &>()[0]);
+   using value_type        = typename std::decay<reference>::type;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = typename std::remove_reference<reference>::type *;
+   using iterator_category = std::random_access_iterator_tag;
+
+   index_iterator() : c(nullptr), i(0) {}
+   index_iterator(Container & c, size_t i) : c(&c), i(i) {}
+
+   reference operator * () const { return (*c)[i]; }
+   pointer  operator -> () const { return &(*c)[i]; }
+   reference operator [] (difference_type n) const { return (*c)[i + n]; }
+
+   index_iterator & operator ++ ()    { ++i; return *this; }
+   index_iterator & operator -- ()    { --i; return *this; }
+   index_iterator   operator ++ (int) { index_iterator tmp(*this); ++i; return tmp; }
+   index_iterator   operator -- (int) { index_iterator tmp(*this); --i; return tmp; }
+   index_iterator & operator += (difference_type n) { i += n; return *this; }
+   index_iterator & operator -= (difference_type n) { i -= n; return *this; }
+   index_iterator   operator +  (difference_type n) const { return index_iterator(*c, i + n); }
+   index_iterator   operator -  (difference_type n) const { return index_iterator(*c, i - n); }
+   friend index_iterator operator + (difference_type n, const index_iterator & it) { return it + n; }
+   difference_type  operator - (const index_iterator & rhs) const
+   {
+      return static_cast<difference_type>(i) - static_cast<difference_type>(rhs.i);
+   }
+
+   bool operator == (const index_iterator & rhs) const { return i == rhs.i; }
+   bool operator != (const index_iterator & rhs) const { return i != rhs.i; }
+   bool operator <  (const index_iterator & rhs) const { return i <  rhs.i; }
+   bool operator >  (const index_iterator & rhs) const { return i >  rhs.i; }
+   bool operator <= (const index_iterator & rhs) const { return i <= rhs.i; }
+   bool operator >= (const index_iterator & rhs) const { return i >= rhs.i; }
+
+private:
+   Container * c;
+   size_t      i;
+};
+
+/*****************************************
+ * CHUNKS
+ * Cut [0, n) into pieces of at least threshold()
+ * elements, a few per worker so a slow piece does not
+ * hold everyone up.  Returns the piece boundaries.
+ ****************************************/
+inline std::vector<size_t> chunks(size_t n)
+{
+   size_t num = n / threshold();
+   size_t most = pool().size() * 4;
+   if (num > most)
+      num = most;
+   if (num == 0)
+      num = 1;
+
+   std::vector<size_t> bounds(num + 1);
+   for (size_t i = 0; i <= num; i++)
+      bounds[i] = n / num * i + (i < n % num ? i : n % num);
+   return bounds;
+}
+
+// run body(begin, end) on each piece of [0, n) and wait
+template <class Body>
+void forChunks(size_t n, Body body)
+{
+   std::vector<size_t> bounds = chunks(n);
+   if (bounds.size() == 2)
+   {
+      body(size_t(0), n);
+      return;
+   }
+
+   task_group group;
+   for (size_t i = 0; i + 1 < bounds.size(); i++)
+   {
+      size_t begin = bounds[i];
+      size_t end   = bounds[i + 1];
+      group.run([&body, begin, end]() { body(begin, end); });
+   }
+   group.wait();
+}
+
+/*****************************************
+ * FOR EACH
+ * Call f on every element.  f must not touch the
+ * other elements: they are being visited at the same time.
+ ****************************************/
+template <class Container, class F>
+void for_each(Container & c, F f)
+{
+   forChunks(c.size(), [&c, &f](size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         f(c[i]);
+   });
+}
+
+/*****************************************
+ * TRANSFORM
+ * dest[i] = f(src[i]).  dest must already hold
+ * at least src.size() elements.
+ ****************************************/
+template <class Source, class Dest, class F>
+void transform(const Source & src, Dest & dest, F f)
+{
+   assert(dest.size() >= src.size());
+   forChunks(src.size(), [&src, &dest, &f](size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         dest[i] = f(src[i]);
+   });
+}
+
+/*****************************************
+ * REDUCE
+ * Combine every element into init with op, which must be
+ * associative.  The pieces are combined left to right, so
+ * the answer is the same every run for a given threshold.
+ ****************************************/
+template <class Container, class T, class Op = std::plus<T>>
+T reduce(const Container & c, T init, Op op = Op())
+{
+   std::vector<size_t> bounds = chunks(c.size());
+   std::vector<T> partial(bounds.size() - 1, init);
+   forChunks(c.size(), [&](size_t begin, size_t end)
+   {
+      if (begin == end)
+         return;
+      size_t piece = std::upper_bound(bounds.begin(), bounds.end(), begin) - bounds.begin() - 1;
+      T sum = c[begin];
+      for (size_t i = begin + 1; i < end; i++)
+         sum = op(sum, c[i]);
+      partial[piece] = sum;
+   });
+
+   for (size_t i = 0; i + 1 < bounds.size(); i++)
+      if (bounds[i] != bounds[i + 1])
+         init = op(init, partial[i]);
+   return init;
+}
+
+/*****************************************
+ * SORT RUNS
+ * The heart of both sorts: sort each piece on its own,
+ * then merge neighboring runs pairwise, every pair at a
+ * level at the same time, until one run is left.
+ ****************************************/
+template <class Container, class SortRun, class Compare>
+void sortRuns(Container & c, SortRun sortRun, Compare comp)
+{
+   typedef index_iterator<Container> iterator;
+   std::vector<size_t> bounds = chunks(c.size());
+
+   forChunks(c.size(), [&](size_t begin, size_t end)
+   {
+      sortRun(iterator(c, begin), iterator(c, end), comp);
+   });
+
+   while (bounds.size() > 2)
+   {
+      std::vector<size_t> merged;
+      task_group group;
+      size_t i = 0;
+      for (; i + 2 < bounds.size(); i += 2)
+      {
+         size_t begin = bounds[i], middle = bounds[i + 1], end = bounds[i + 2];
+         merged.push_back(begin);
+         group.run([&c, &comp, begin, middle, end]()
+         {
+            std::inplace_merge(iterator(c, begin), iterator(c, middle),
+                               iterator(c, end), comp);
+         });
+      }
+      // an odd run out waits for the next level
+      for (; i < bounds.size(); i++)
+         merged.push_back(bounds[i]);
+      group.wait();
+      bounds.swap(merged);
+   }
+}
+
+/*****************************************
+ * SORT
+ * Sort with comp, on every core for a large container.
+ * Equal elements may end up in any order.
+ ****************************************/
+template <class Container, class Compare = std::less<typename index_iterator<Container>::value_type>>
+void sort(Container & c, Compare comp = Compare())
+{
+   typedef index_iterator<Container> iterator;
+   sortRuns(c, [](iterator begin, iterator end, Compare & comp)
+   {
+      std::sort(begin, end, comp);
+   }, comp);
+}
+
+/*****************************************
+ * STABLE SORT
+ * Sort with comp, keeping equal elements in the order
+ * they started in.  Merging only ever takes from the
+ * left run on a tie, so the runs stay stable too.
+ ****************************************/
+template <class Container, class Compare = std::less<typename index_iterator<Container>::value_type>>
+void stable_sort(Container & c, Compare comp = Compare())
+{
+   typedef index_iterator<Container> iterator;
+   sortRuns(c, [](iterator begin, iterator end, Compare & comp)
+   {
+      std::stable_sort(begin, end, comp);
+   }, comp);
+}
+
+} // namespace parallel
+} // namespace custom
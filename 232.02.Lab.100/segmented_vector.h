@@ -0,0 +1,509 @@
+/***********************************************************************
+ * Header:
+ *    SEGMENTED VECTOR
+ * Summary:
+ *    A vector made of fixed-size blocks found through a block table.
+ *    Growing adds a block and never moves an element, so pointers,
+ *    references, and iterators stay good for as long as the element
+ *    does, and no push_back ever pays for copying the whole vector.
+ *    The block size B is a power of two, so finding element i is a
+ *    shift and a mask: still O(1).  Only the block table, a vector
+ *    of pointers, is ever reallocated.
+ *
+ *    This will contain the class definition of:
+ *        segmented_vector                 : A vector of fixed blocks
+ *        segmented_vector::iterator       : An iterator through it
+ *        segmented_vector::const_iterator : The same, read only
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include "vector.h"  // for the block table
+
+class TestSegmentedVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * LOG2 OF
+ * The shift that divides by a power of two
+ ****************************************/
+template <size_t N>
+struct log2_of { static const size_t value = 1 + log2_of<N / 2>::value; };
+template <>
+struct log2_of<1> { static const size_t value = 0; };
+
+/*****************************************
+ * SEGMENTED VECTOR
+ * The interface of custom::vector, minus data():
+ * the elements are not contiguous.  Capacity is a
+ * whole number of blocks.
+ ****************************************/
+template <typename T, size_t B = 1024, typename A = std::allocator<T>>
+class segmented_vector
+{
+   static_assert(B > 0 && (B & (B - 1)) == 0, "the block size must be a power of two");
+   friend class ::TestSegmentedVector; // give unit tests access to the privates
+public:
+   using value_type     = T;
+   using allocator_type = A;
+
+   //
+   // Construct
+   //
+
+   segmented_vector(const A & a = A()) : alloc(a), blocks(block_alloc(a)), numElements(0) {}
+   segmented_vector(size_t num,                    const A & a = A());
+   segmented_vector(size_t num, const T & t,       const A & a = A());
+   segmented_vector(const std::initializer_list<T>& l, const A & a = A());
+   segmented_vector(const segmented_vector &  rhs);
+   segmented_vector(      segmented_vector && rhs);
+   ~segmented_vector();
+
+   //
+   // Assign
+   //
+
+   void swap(segmented_vector & rhs)
+   {
+      // unequal allocators that do not propagate cannot trade blocks
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+      blocks.swap(rhs.blocks);
+      std::swap(numElements, rhs.numElements);
+   }
+   segmented_vector & operator = (const segmented_vector & rhs);
+   segmented_vector & operator = (segmented_vector && rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   class const_iterator;
+   iterator       begin()        { return iterator(this, 0);                  }
+   iterator       end()          { return iterator(this, numElements);        }
+   const_iterator begin()  const { return const_iterator(this, 0);            }
+   const_iterator end()    const { return const_iterator(this, numElements);  }
+   const_iterator cbegin() const { return const_iterator(this, 0);            }
+   const_iterator cend()   const { return const_iterator(this, numElements);  }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index)       { assert(index < numElements); return slot(index); }
+   const T& operator [] (size_t index) const { assert(index < numElements); return slot(index); }
+         T& front()       { assert(numElements > 0); return slot(0);               }
+   const T& front() const { assert(numElements > 0); return slot(0);               }
+         T& back()        { assert(numElements > 0); return slot(numElements - 1); }
+   const T& back()  const { assert(numElements > 0); return slot(numElements - 1); }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T & t) { emplace_back(t);            }
+   void push_back(T && t)      { emplace_back(std::move(t)); }
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   void reserve(size_t newCapacity);
+   void resize(size_t newElements);
+   void resize(size_t newElements, const T & t);
+
+   //
+   // Remove
+   //
+
+   void clear()
+   {
+      destroy(0, numElements);
+      numElements = 0;
+   }
+   void pop_back()
+   {
+      if (numElements > 0)
+      {
+         numElements--;
+         traits::destroy(alloc, &slot(numElements));
+      }
+   }
+   void shrink_to_fit();
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return numElements;        }
+   size_t  capacity()      const { return blocks.size() * B;  }
+   bool empty()            const { return (numElements == 0); }
+   A    get_allocator()    const { return alloc;              }
+
+   // segmented-vector-specific interfaces
+
+   // the elements per block
+   static size_t block_size() { return B; }
+
+private:
+
+   using traits      = std::allocator_traits<A>;
+   using block_alloc = typename traits::template rebind_alloc<T *>;
+
+   // hand over the allocator only when its traits say to
+   void copyAlloc(const A & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const A &,     std::false_type) {                         }
+   void moveAlloc(A & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(A &,           std::false_type) {                         }
+   void swapAlloc(A & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(A &,           std::false_type) {                         }
+
+   // element i: pick the block, then the slot in it
+         T & slot(size_t i)       { return blocks[i >> log2_of<B>::value][i & (B - 1)]; }
+   const T & slot(size_t i) const { return blocks[i >> log2_of<B>::value][i & (B - 1)]; }
+
+   // call the destructor on the elements [begin, end)
+   void destroy(size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         traits::destroy(alloc, &slot(i));
+   }
+
+   // add blocks until num elements fit
+   void addBlocks(size_t num)
+   {
+      while (capacity() < num)
+         blocks.push_back(traits::allocate(alloc, B));
+   }
+
+   // free the blocks past the first numBlocks
+   void freeBlocks(size_t numBlocks)
+   {
+      while (blocks.size() > numBlocks)
+      {
+         traits::deallocate(alloc, blocks.back(), B);
+         blocks.pop_back();
+      }
+   }
+
+   A alloc;                         // hands out the blocks and, rebound, the table
+   vector<T *, block_alloc> blocks; // the block table; only these pointers ever move
+   size_t numElements;              // the number of items currently used
+};
+
+/**************************************************
+ * SEGMENTED VECTOR ITERATOR
+ * The vector and an index, so growing the block
+ * table never leaves an iterator pointing at the old one
+ *************************************************/
+template <typename T, size_t B, typename A>
+class segmented_vector <T, B, A> :: iterator
+{
+   friend class ::TestSegmentedVector;
+   friend class segmented_vector <T, B, A>;
+   friend class const_iterator;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = T *;
+   using reference         = T &;
+
+   iterator() : v(nullptr), index(0) {}
+   iterator(segmented_vector * v, size_t index) : v(v), index(index) {}
+
+   // comparison operators
+   bool operator == (const iterator& rhs) const { return index == rhs.index; }
+   bool operator != (const iterator& rhs) const { return index != rhs.index; }
+   bool operator <  (const iterator& rhs) const { return index <  rhs.index; }
+   bool operator >  (const iterator& rhs) const { return index >  rhs.index; }
+   bool operator <= (const iterator& rhs) const { return index <= rhs.index; }
+   bool operator >= (const iterator& rhs) const { return index >= rhs.index; }
+
+   // dereference operators
+   T& operator *  () const { return v->slot(index);  }
+   T* operator -> () const { return &v->slot(index); }
+   T& operator [] (difference_type n) const { return v->slot(index + n); }
+
+   // increment and decrement
+   iterator& operator ++ ()    { ++index; return *this; }
+   iterator& operator -- ()    { --index; return *this; }
+   iterator  operator ++ (int) { iterator t = *this; ++index; return t; }
+   iterator  operator -- (int) { iterator t = *this; --index; return t; }
+
+   // arithmetic
+   iterator& operator += (difference_type n)       { index += n; return *this; }
+   iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   iterator  operator +  (difference_type n) const { return iterator(v, index + n); }
+   iterator  operator -  (difference_type n) const { return iterator(v, index - n); }
+   difference_type operator - (const iterator& rhs) const
+   {
+      return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index);
+   }
+   friend iterator operator + (difference_type n, const iterator& it) { return it + n; }
+
+private:
+   segmented_vector * v;
+   size_t index;
+};
+
+/**************************************************
+ * SEGMENTED VECTOR CONST ITERATOR
+ * The same, for reading only
+ *************************************************/
+template <typename T, size_t B, typename A>
+class segmented_vector <T, B, A> :: const_iterator
+{
+   friend class ::TestSegmentedVector;
+   friend class segmented_vector <T, B, A>;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = const T *;
+   using reference         = const T &;
+
+   const_iterator() : v(nullptr), index(0) {}
+   const_iterator(const segmented_vector * v, size_t index) : v(v), index(index) {}
+   const_iterator(const iterator & it) : v(it.v), index(it.index) {}
+
+   // comparison operators; an iterator on either side converts
+   friend bool operator == (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index == rhs.index; }
+   friend bool operator != (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index != rhs.index; }
+   friend bool operator <  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <  rhs.index; }
+   friend bool operator >  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >  rhs.index; }
+   friend bool operator <= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <= rhs.index; }
+   friend bool operator >= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >= rhs.index; }
+
+   // dereference operators
+   const T& operator *  () const { return v->slot(index);  }
+   const T* operator -> () const { return &v->slot(index); }
+   const T& operator [] (difference_type n) const { return v->slot(index + n); }
+
+   // increment and decrement
+   const_iterator& operator ++ ()    { ++index; return *this; }
+   const_iterator& operator -- ()    { --index; return *this; }
+   const_iterator  operator ++ (int) { const_iterator t = *this; ++index; return t; }
+   const_iterator  operator -- (int) { const_iterator t = *this; --index; return t; }
+
+   // arithmetic
+   const_iterator& operator += (difference_type n)       { index += n; return *this; }
+   const_iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   const_iterator  operator +  (difference_type n) const { return const_iterator(v, index + n); }
+   const_iterator  operator -  (difference_type n) const { return const_iterator(v, index - n); }
+   friend difference_type operator - (const const_iterator& lhs, const const_iterator& rhs)
+   {
+      return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+   }
+   friend const_iterator operator + (difference_type n, const const_iterator& it) { return it + n; }
+
+private:
+   const segmented_vector * v;
+   size_t index;
+};
+
+/*****************************************
+ * SEGMENTED VECTOR :: CONSTRUCTORS
+ * Default-construct or fill num elements
+ ****************************************/
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> :: segmented_vector(size_t num, const A & a) : segmented_vector(a)
+{
+   resize(num);
+}
+
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> :: segmented_vector(size_t num, const T & t, const A & a) : segmented_vector(a)
+{
+   resize(num, t);
+}
+
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> :: segmented_vector(const std::initializer_list<T> & l, const A & a)
+   : segmented_vector(a)
+{
+   reserve(l.size());
+   for (const T & t : l)
+      emplace_back(t);
+}
+
+/*****************************************
+ * SEGMENTED VECTOR :: COPY CONSTRUCTOR
+ * Copy the elements into blocks of our own
+ ****************************************/
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> :: segmented_vector(const segmented_vector & rhs) :
+   segmented_vector(traits::select_on_container_copy_construction(rhs.alloc))
+{
+   reserve(rhs.numElements);
+   for (size_t i = 0; i < rhs.numElements; i++)
+      emplace_back(rhs.slot(i));
+}
+
+/*****************************************
+ * SEGMENTED VECTOR :: MOVE CONSTRUCTOR
+ * Steal the block table
+ ****************************************/
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> :: segmented_vector(segmented_vector && rhs) :
+   alloc(std::move(rhs.alloc)), blocks(std::move(rhs.blocks)), numElements(rhs.numElements)
+{
+   rhs.numElements = 0;
+}
+
+/*****************************************
+ * SEGMENTED VECTOR :: DESTRUCTOR
+ ****************************************/
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> :: ~segmented_vector()
+{
+   clear();
+   freeBlocks(0);
+}
+
+/*****************************************
+ * SEGMENTED VECTOR :: ASSIGN
+ * Assign over the elements we share, then construct
+ * or destroy the difference.  No block is freed.
+ ****************************************/
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> & segmented_vector <T, B, A> :: operator = (const segmented_vector & rhs)
+{
+   if (this != &rhs)
+   {
+      // a propagating allocator that differs cannot free our old blocks
+      if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+      {
+         clear();
+         freeBlocks(0);
+         const vector<T *, block_alloc> empty(block_alloc(rhs.alloc));
+         blocks = empty;
+      }
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+
+      size_t common = numElements < rhs.numElements ? numElements : rhs.numElements;
+      for (size_t i = 0; i < common; i++)
+         slot(i) = rhs.slot(i);
+      if (rhs.numElements < numElements)
+      {
+         destroy(rhs.numElements, numElements);
+         numElements = rhs.numElements;
+      }
+      else
+      {
+         reserve(rhs.numElements);
+         for (size_t i = common; i < rhs.numElements; i++)
+            emplace_back(rhs.slot(i));
+      }
+   }
+   return *this;
+}
+
+/*****************************************
+ * SEGMENTED VECTOR :: ASSIGN MOVE
+ ****************************************/
+template <typename T, size_t B, typename A>
+segmented_vector <T, B, A> & segmented_vector <T, B, A> :: operator = (segmented_vector && rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+
+      // cannot adopt blocks our allocator did not hand out: move each element
+      if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+      {
+         reserve(rhs.numElements);
+         for (size_t i = 0; i < rhs.numElements; i++)
+            emplace_back(std::move(rhs.slot(i)));
+         rhs.clear();
+         return *this;
+      }
+
+      freeBlocks(0);
+      moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+      blocks = std::move(rhs.blocks);
+      numElements = rhs.numElements;
+      rhs.numElements = 0;
+   }
+   return *this;
+}
+
+/***************************************
+ * SEGMENTED VECTOR :: EMPLACE BACK
+ * Build a new element at the end, adding a block
+ * when the last one is full.  Nothing else moves.
+ *     INPUT  : args the constructor arguments
+ *     OUTPUT : the new element
+ **************************************/
+template <typename T, size_t B, typename A>
+template <class ... Args>
+T & segmented_vector <T, B, A> :: emplace_back(Args && ... args)
+{
+   addBlocks(numElements + 1);
+   traits::construct(alloc, &slot(numElements), std::forward<Args>(args)...);
+   return slot(numElements++);
+}
+
+/***************************************
+ * SEGMENTED VECTOR :: RESERVE
+ * Add the blocks for newCapacity elements now
+ **************************************/
+template <typename T, size_t B, typename A>
+void segmented_vector <T, B, A> :: reserve(size_t newCapacity)
+{
+   blocks.reserve((newCapacity + B - 1) / B);
+   addBlocks(newCapacity);
+}
+
+/***************************************
+ * SEGMENTED VECTOR :: RESIZE
+ * Grow with default or copied elements, or
+ * destroy the extras.  Blocks are kept either way.
+ **************************************/
+template <typename T, size_t B, typename A>
+void segmented_vector <T, B, A> :: resize(size_t newElements)
+{
+   if (newElements < numElements)
+   {
+      destroy(newElements, numElements);
+      numElements = newElements;
+   }
+   else
+   {
+      reserve(newElements);
+      while (numElements < newElements)
+         emplace_back();
+   }
+}
+
+template <typename T, size_t B, typename A>
+void segmented_vector <T, B, A> :: resize(size_t newElements, const T & t)
+{
+   if (newElements < numElements)
+   {
+      destroy(newElements, numElements);
+      numElements = newElements;
+   }
+   else
+   {
+      reserve(newElements);
+      while (numElements < newElements)
+         emplace_back(t);
+   }
+}
+
+/***************************************
+ * SEGMENTED VECTOR :: SHRINK TO FIT
+ * Give back the empty blocks at the end and trim the
+ * table.  The elements stay where they are.
+ **************************************/
+template <typename T, size_t B, typename A>
+void segmented_vector <T, B, A> :: shrink_to_fit()
+{
+   freeBlocks((numElements + B - 1) / B);
+   blocks.shrink_to_fit();
+}
+
+} // namespace custom
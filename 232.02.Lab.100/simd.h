@@ -0,0 +1,649 @@
+/***********************************************************************
+ * Header:
+ *    SIMD
+ * Summary:
+ *    Vectorized kernels for contiguous containers of int, float,
+ *    and double: find, count, min, max, sum, dot, fill, and equal.
+ *    Each kernel comes in three flavors, picked once at run time:
+ *        avx2   : eight ints or floats (four doubles) at a time
+ *        sse2   : four ints or floats (two doubles) at a time
+ *        scalar : one at a time, for every other CPU
+ *    The SIMD sums add the lanes in a different order than a
+ *    plain loop, so float and double sums may differ in the last bits.
+ *
+ *    This will contain the definition of:
+ *        simd::level()           : the instruction set in use
+ *        simd::scalar :: <kernel>: the one-at-a-time reference versions
+ *        simd :: <kernel>        : dispatch to the best version
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstddef>      // for size_t
+#include <type_traits>  // for std::is_same
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CUSTOM_SIMD_X86
+#include <immintrin.h>  // SSE2 and AVX2 intrinsics
+#ifdef _MSC_VER
+#include <intrin.h>     // for __cpuid and _xgetbv
+#endif
+#endif
+
+namespace custom
+{
+namespace simd
+{
+
+/*****************************************
+ * ISA
+ * The instruction sets we have kernels for, weakest first
+ ****************************************/
+enum class isa { scalar, sse2, avx2 };
+
+// only int, float, and double have kernels
+template <class T>
+struct is_supported : std::integral_constant<bool,
+   std::is_same<T, int>::value || std::is_same<T, float>::value ||
+   std::is_same<T, double>::value> {};
+
+/*****************************************
+ * SCALAR
+ * The reference kernels: plain loops over the pointer
+ ****************************************/
+namespace scalar
+{
+   // index of the first value, or n if there is none
+   template <class T>
+   size_t find(const T * p, size_t n, T value)
+   {
+      for (size_t i = 0; i < n; i++)
+         if (p[i] == value)
+            return i;
+      return n;
+   }
+
+   template <class T>
+   size_t count(const T * p, size_t n, T value)
+   {
+      size_t num = 0;
+      for (size_t i = 0; i < n; i++)
+         if (p[i] == value)
+            num++;
+      return num;
+   }
+
+   template <class T>
+   T min(const T * p, size_t n)
+   {
+      assert(n > 0);
+      T m = p[0];
+      for (size_t i = 1; i < n; i++)
+         if (p[i] < m)
+            m = p[i];
+      return m;
+   }
+
+   template <class T>
+   T max(const T * p, size_t n)
+   {
+      assert(n > 0);
+      T m = p[0];
+      for (size_t i = 1; i < n; i++)
+         if (p[i] > m)
+            m = p[i];
+      return m;
+   }
+
+   template <class T>
+   T sum(const T * p, size_t n)
+   {
+      T total = T();
+      for (size_t i = 0; i < n; i++)
+         total += p[i];
+      return total;
+   }
+
+   template <class T>
+   T dot(const T * a, const T * b, size_t n)
+   {
+      T total = T();
+      for (size_t i = 0; i < n; i++)
+         total += a[i] * b[i];
+      return total;
+   }
+
+   template <class T>
+   void fill(T * p, size_t n, T value)
+   {
+      for (size_t i = 0; i < n; i++)
+         p[i] = value;
+   }
+
+   template <class T>
+   bool equal(const T * a, const T * b, size_t n)
+   {
+      for (size_t i = 0; i < n; i++)
+         if (!(a[i] == b[i]))
+            return false;
+      return true;
+   }
+} // namespace scalar
+
+#ifdef CUSTOM_SIMD_X86
+
+// the number of set bits in a lane mask
+inline size_t maskCount(unsigned mask)
+{
+   size_t num = 0;
+   for (; mask; mask &= mask - 1)
+      num++;
+   return num;
+}
+
+// the index of the lowest set bit in a non-zero lane mask
+inline size_t maskFirst(unsigned mask)
+{
+   assert(mask != 0);
+   size_t i = 0;
+   while (!(mask & 1u))
+   {
+      mask >>= 1;
+      i++;
+   }
+   return i;
+}
+
+/*****************************************
+ * SIMD KERNELS
+ * The same eight kernels for every instruction set.  Each
+ * namespace supplies ops<T> with the register type, the
+ * number of lanes, and the handful of operations below,
+ * then expands this inside its own target region so the
+ * compiler may use that instruction set in the kernels.
+ ****************************************/
+#define CUSTOM_SIMD_KERNELS                                                  \
+   template <class T>                                                        \
+   size_t find(const T * p, size_t n, T value)                               \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      const typename V::reg v = V::set1(value);                              \
+      size_t i = 0;                                                          \
+      for (; i + V::width <= n; i += V::width)                               \
+      {                                                                      \
+         unsigned mask = V::equalMask(V::load(p + i), v);                    \
+         if (mask)                                                           \
+            return i + maskFirst(mask);                                      \
+      }                                                                      \
+      return i + scalar::find(p + i, n - i, value);                          \
+   }                                                                         \
+                                                                             \
+   template <class T>                                                        \
+   size_t count(const T * p, size_t n, T value)                              \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      const typename V::reg v = V::set1(value);                              \
+      size_t num = 0;                                                        \
+      size_t i = 0;                                                          \
+      for (; i + V::width <= n; i += V::width)                               \
+         num += maskCount(V::equalMask(V::load(p + i), v));                  \
+      return num + scalar::count(p + i, n - i, value);                       \
+   }                                                                         \
+                                                                             \
+   template <class T>                                                        \
+   T min(const T * p, size_t n)                                              \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      if (n < V::width)                                                      \
+         return scalar::min(p, n);                                           \
+      typename V::reg m = V::load(p);                                        \
+      size_t i = V::width;                                                   \
+      for (; i + V::width <= n; i += V::width)                               \
+         m = V::min(m, V::load(p + i));                                      \
+      T lanes[V::width];                                                     \
+      V::store(lanes, m);                                                    \
+      T result = scalar::min(lanes, V::width);                               \
+      for (; i < n; i++)                                                     \
+         if (p[i] < result)                                                  \
+            result = p[i];                                                   \
+      return result;                                                         \
+   }                                                                         \
+                                                                             \
+   template <class T>                                                        \
+   T max(const T * p, size_t n)                                              \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      if (n < V::width)                                                      \
+         return scalar::max(p, n);                                           \
+      typename V::reg m = V::load(p);                                        \
+      size_t i = V::width;                                                   \
+      for (; i + V::width <= n; i += V::width)                               \
+         m = V::max(m, V::load(p + i));                                      \
+      T lanes[V::width];                                                     \
+      V::store(lanes, m);                                                    \
+      T result = scalar::max(lanes, V::width);                               \
+      for (; i < n; i++)                                                     \
+         if (p[i] > result)                                                  \
+            result = p[i];                                                   \
+      return result;                                                         \
+   }                                                                         \
+                                                                             \
+   template <class T>                                                        \
+   T sum(const T * p, size_t n)                                              \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      /* two accumulators hide the latency of the add */                     \
+      typename V::reg s0 = V::set1(T());                                     \
+      typename V::reg s1 = V::set1(T());                                     \
+      size_t i = 0;                                                          \
+      for (; i + 2 * V::width <= n; i += 2 * V::width)                       \
+      {                                                                      \
+         s0 = V::add(s0, V::load(p + i));                                    \
+         s1 = V::add(s1, V::load(p + i + V::width));                         \
+      }                                                                      \
+      T lanes[V::width];                                                     \
+      V::store(lanes, V::add(s0, s1));                                       \
+      return scalar::sum(lanes, V::width) + scalar::sum(p + i, n - i);       \
+   }                                                                         \
+                                                                             \
+   template <class T>                                                        \
+   T dot(const T * a, const T * b, size_t n)                                 \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      typename V::reg s0 = V::set1(T());                                     \
+      typename V::reg s1 = V::set1(T());                                     \
+      size_t i = 0;                                                          \
+      for (; i + 2 * V::width <= n; i += 2 * V::width)                       \
+      {                                                                      \
+         s0 = V::add(s0, V::mul(V::load(a + i), V::load(b + i)));            \
+         s1 = V::add(s1, V::mul(V::load(a + i + V::width),                   \
+                                V::load(b + i + V::width)));                 \
+      }                                                                      \
+      T lanes[V::width];                                                     \
+      V::store(lanes, V::add(s0, s1));                                       \
+      return scalar::sum(lanes, V::width) + scalar::dot(a + i, b + i, n - i);\
+   }                                                                         \
+                                                                             \
+   template <class T>                                                        \
+   void fill(T * p, size_t n, T value)                                       \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      const typename V::reg v = V::set1(value);                              \
+      size_t i = 0;                                                          \
+      for (; i + V::width <= n; i += V::width)                               \
+         V::store(p + i, v);                                                 \
+      scalar::fill(p + i, n - i, value);                                     \
+   }                                                                         \
+                                                                             \
+   template <class T>                                                        \
+   bool equal(const T * a, const T * b, size_t n)                            \
+   {                                                                         \
+      typedef ops<T> V;                                                      \
+      size_t i = 0;                                                          \
+      for (; i + V::width <= n; i += V::width)                               \
+         if (V::equalMask(V::load(a + i), V::load(b + i)) != V::allLanes)    \
+            return false;                                                    \
+      return scalar::equal(a + i, b + i, n - i);                             \
+   }
+
+/*****************************************
+ * SSE2
+ * 128-bit registers.  SSE2 has no 32-bit integer min, max,
+ * or multiply, so those are built from what it does have.
+ ****************************************/
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#elif defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#endif
+namespace sse2
+{
+   template <class T>
+   struct ops;
+
+   template <>
+   struct ops <int>
+   {
+      typedef __m128i reg;
+      static const size_t width = 4;
+      static const unsigned allLanes = 0xF;
+      static reg  load(const int * p)       { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+      static void store(int * p, reg a)     { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a);          }
+      static reg  set1(int value)           { return _mm_set1_epi32(value);                                 }
+      static reg  add(reg a, reg b)         { return _mm_add_epi32(a, b);                                   }
+      static reg  min(reg a, reg b)
+      {
+         reg greater = _mm_cmpgt_epi32(a, b);
+         return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+      }
+      static reg  max(reg a, reg b)
+      {
+         reg greater = _mm_cmpgt_epi32(a, b);
+         return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+      }
+      static reg  mul(reg a, reg b)
+      {
+         // multiply the even lanes and the odd lanes, then zip the low halves
+         reg even = _mm_mul_epu32(a, b);
+         reg odd  = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+         return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                   _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+      }
+      static unsigned equalMask(reg a, reg b)
+      {
+         return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+      }
+   };
+
+   template <>
+   struct ops <float>
+   {
+      typedef __m128 reg;
+      static const size_t width = 4;
+      static const unsigned allLanes = 0xF;
+      static reg  load(const float * p)     { return _mm_loadu_ps(p);       }
+      static void store(float * p, reg a)   { _mm_storeu_ps(p, a);          }
+      static reg  set1(float value)         { return _mm_set1_ps(value);    }
+      static reg  add(reg a, reg b)         { return _mm_add_ps(a, b);      }
+      static reg  mul(reg a, reg b)         { return _mm_mul_ps(a, b);      }
+      static reg  min(reg a, reg b)         { return _mm_min_ps(a, b);      }
+      static reg  max(reg a, reg b)         { return _mm_max_ps(a, b);      }
+      static unsigned equalMask(reg a, reg b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+   };
+
+   template <>
+   struct ops <double>
+   {
+      typedef __m128d reg;
+      static const size_t width = 2;
+      static const unsigned allLanes = 0x3;
+      static reg  load(const double * p)    { return _mm_loadu_pd(p);       }
+      static void store(double * p, reg a)  { _mm_storeu_pd(p, a);          }
+      static reg  set1(double value)        { return _mm_set1_pd(value);    }
+      static reg  add(reg a, reg b)         { return _mm_add_pd(a, b);      }
+      static reg  mul(reg a, reg b)         { return _mm_mul_pd(a, b);      }
+      static reg  min(reg a, reg b)         { return _mm_min_pd(a, b);      }
+      static reg  max(reg a, reg b)         { return _mm_max_pd(a, b);      }
+      static unsigned equalMask(reg a, reg b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+   };
+
+   CUSTOM_SIMD_KERNELS
+} // namespace sse2
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#elif defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+/*****************************************
+ * AVX2
+ * 256-bit registers with a full set of integer operations
+ ****************************************/
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#elif defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#endif
+namespace avx2
+{
+   template <class T>
+   struct ops;
+
+   template <>
+   struct ops <int>
+   {
+      typedef __m256i reg;
+      static const size_t width = 8;
+      static const unsigned allLanes = 0xFF;
+      static reg  load(const int * p)       { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+      static void store(int * p, reg a)     { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a);          }
+      static reg  set1(int value)           { return _mm256_set1_epi32(value);   }
+      static reg  add(reg a, reg b)         { return _mm256_add_epi32(a, b);     }
+      static reg  mul(reg a, reg b)         { return _mm256_mullo_epi32(a, b);   }
+      static reg  min(reg a, reg b)         { return _mm256_min_epi32(a, b);     }
+      static reg  max(reg a, reg b)         { return _mm256_max_epi32(a, b);     }
+      static unsigned equalMask(reg a, reg b)
+      {
+         return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+      }
+   };
+
+   template <>
+   struct ops <float>
+   {
+      typedef __m256 reg;
+      static const size_t width = 8;
+      static const unsigned allLanes = 0xFF;
+      static reg  load(const float * p)     { return _mm256_loadu_ps(p);      }
+      static void store(float * p, reg a)   { _mm256_storeu_ps(p, a);         }
+      static reg  set1(float value)         { return _mm256_set1_ps(value);   }
+      static reg  add(reg a, reg b)         { return _mm256_add_ps(a, b);     }
+      static reg  mul(reg a, reg b)         { return _mm256_mul_ps(a, b);     }
+      static reg  min(reg a, reg b)         { return _mm256_min_ps(a, b);     }
+      static reg  max(reg a, reg b)         { return _mm256_max_ps(a, b);     }
+      static unsigned equalMask(reg a, reg b)
+      {
+         return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+      }
+   };
+
+   template <>
+   struct ops <double>
+   {
+      typedef __m256d reg;
+      static const size_t width = 4;
+      static const unsigned allLanes = 0xF;
+      static reg  load(const double * p)    { return _mm256_loadu_pd(p);      }
+      static void store(double * p, reg a)  { _mm256_storeu_pd(p, a);         }
+      static reg  set1(double value)        { return _mm256_set1_pd(value);   }
+      static reg  add(reg a, reg b)         { return _mm256_add_pd(a, b);     }
+      static reg  mul(reg a, reg b)         { return _mm256_mul_pd(a, b);     }
+      static reg  min(reg a, reg b)         { return _mm256_min_pd(a, b);     }
+      static reg  max(reg a, reg b)         { return _mm256_max_pd(a, b);     }
+      static unsigned equalMask(reg a, reg b)
+      {
+         return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+      }
+   };
+
+   CUSTOM_SIMD_KERNELS
+} // namespace avx2
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#elif defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#undef CUSTOM_SIMD_KERNELS
+
+/*****************************************
+ * SUPPORTS AVX2
+ * Ask the CPU, and the OS for the wide registers
+ ****************************************/
+inline bool supportsAvx2()
+{
+#ifdef _MSC_VER
+   int info[4];
+   __cpuid(info, 0);
+   if (info[0] < 7)
+      return false;
+   __cpuid(info, 1);
+   const int osxsave = 1 << 27;
+   const int avx     = 1 << 28;
+   if ((info[2] & (osxsave | avx)) != (osxsave | avx))
+      return false;
+   if ((_xgetbv(0) & 0x6) != 0x6)  // the OS saves the XMM and YMM registers
+      return false;
+   __cpuidex(info, 7, 0);
+   return (info[1] & (1 << 5)) != 0;
+#else
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+/*****************************************
+ * SUPPORTS SSE2
+ * Every x86-64 CPU has it; 32-bit x86 has to ask
+ ****************************************/
+inline bool supportsSse2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+   return true;
+#elif defined(_MSC_VER)
+   int info[4];
+   __cpuid(info, 1);
+   return (info[3] & (1 << 26)) != 0;
+#else
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+
+#endif // CUSTOM_SIMD_X86
+
+/*****************************************
+ * DETECT
+ * The best instruction set this CPU can run
+ ****************************************/
+inline isa detect()
+{
+#ifdef CUSTOM_SIMD_X86
+   if (supportsAvx2())
+      return isa::avx2;
+   if (supportsSse2())
+      return isa::sse2;
+#endif
+   return isa::scalar;
+}
+
+/*****************************************
+ * LEVEL
+ * The instruction set the kernels dispatch to.  It starts at
+ * the best the CPU can do.  set_level can lower it, to compare
+ * against the weaker kernels, but never raise it past detect().
+ ****************************************/
+inline isa & currentLevel()
+{
+   static isa level = detect();
+   return level;
+}
+
+inline isa level()
+{
+   return currentLevel();
+}
+
+inline void set_level(isa newLevel)
+{
+   isa best = detect();
+   currentLevel() = newLevel < best ? newLevel : best;
+}
+
+/*****************************************
+ * DISPATCH
+ * Send each kernel to the current level's version
+ ****************************************/
+#ifdef CUSTOM_SIMD_X86
+#define CUSTOM_SIMD_DISPATCH(kernel, ...)                                    \
+   static_assert(is_supported<T>::value, "simd kernels take int, float, or double"); \
+   switch (level())                                                          \
+   {                                                                         \
+      case isa::avx2: return avx2::kernel(__VA_ARGS__);                      \
+      case isa::sse2: return sse2::kernel(__VA_ARGS__);                      \
+      default:        return scalar::kernel(__VA_ARGS__);                    \
+   }
+#else
+#define CUSTOM_SIMD_DISPATCH(kernel, ...)                                    \
+   static_assert(is_supported<T>::value, "simd kernels take int, float, or double"); \
+   return scalar::kernel(__VA_ARGS__);
+#endif
+
+template <class T>
+size_t find(const T * p, size_t n, T value)      { CUSTOM_SIMD_DISPATCH(find, p, n, value)  }
+template <class T>
+size_t count(const T * p, size_t n, T value)     { CUSTOM_SIMD_DISPATCH(count, p, n, value) }
+template <class T>
+T min(const T * p, size_t n)                     { CUSTOM_SIMD_DISPATCH(min, p, n)          }
+template <class T>
+T max(const T * p, size_t n)                     { CUSTOM_SIMD_DISPATCH(max, p, n)          }
+template <class T>
+T sum(const T * p, size_t n)                     { CUSTOM_SIMD_DISPATCH(sum, p, n)          }
+template <class T>
+T dot(const T * a, const T * b, size_t n)        { CUSTOM_SIMD_DISPATCH(dot, a, b, n)       }
+template <class T>
+void fill(T * p, size_t n, T value)              { CUSTOM_SIMD_DISPATCH(fill, p, n, value)  }
+template <class T>
+bool equal(const T * a, const T * b, size_t n)   { CUSTOM_SIMD_DISPATCH(equal, a, b, n)     }
+
+#undef CUSTOM_SIMD_DISPATCH
+
+/*****************************************
+ * CONTAINER KERNELS
+ * The same kernels over a whole contiguous container, such
+ * as custom::vector or custom::array.  Anything with size()
+ * and a subscript that returns references into one buffer works.
+ ****************************************/
+// the first element, or null for an empty container
+template <class Container>
+auto elements(Container & c) -> decltype(&c[0])
+{
+   return c.size() ? &c[0] : nullptr;
+}
+
+template <class Container>
+auto find(const Container & c, typename std::decay<decltype(c[0])>::type value) -> size_t
+{
+   return find(elements(c), c.size(), value);
+}
+
+template <class Container>
+auto count(const Container & c, typename std::decay<decltype(c[0])>::type value) -> size_t
+{
+   return count(elements(c), c.size(), value);
+}
+
+template <class Container>
+auto min(const Container & c) -> typename std::decay<decltype(c[0])>::type
+{
+   return min(elements(c), c.size());
+}
+
+template <class Container>
+auto max(const Container & c) -> typename std::decay<decltype(c[0])>::type
+{
+   return max(elements(c), c.size());
+}
+
+template <class Container>
+auto sum(const Container & c) -> typename std::decay<decltype(c[0])>::type
+{
+   return sum(elements(c), c.size());
+}
+
+template <class Container>
+auto dot(const Container & a, const Container & b) -> typename std::decay<decltype(a[0])>::type
+{
+   assert(a.size() == b.size());
+   return dot(elements(a), elements(b), a.size());
+}
+
+template <class Container>
+auto fill(Container & c, typename std::decay<decltype(c[0])>::type value) -> void
+{
+   fill(elements(c), c.size(), value);
+}
+
+template <class Container>
+auto equal(const Container & a, const Container & b) -> decltype(a.size(), true)
+{
+   return a.size() == b.size() && equal(elements(a), elements(b), a.size());
+}
+
+} // namespace simd
+} // namespace custom
@@ -0,0 +1,292 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT VECTOR
+ * Summary:
+ *    Unit tests for concurrent_vector.  Most use a first segment of
+ *    four so a few dozen pushes already reach several segments.
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrent_vector.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestConcurrentVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_destructor_destroysAll();
+
+      // Segments
+      test_segmentOf_geometric();
+      test_reserve_allocatesSegments();
+
+      // Insert
+      test_pushback_neverMoves();
+      test_pushback_addressesStable();
+      test_pushback_manyThreads();
+      test_read_whilePushing();
+
+      // Remove
+      test_clear_keepsSegments();
+
+      // Iterator
+      test_iterator_publishedPrefix();
+      test_iterator_algorithms();
+
+      report("ConcurrentVector");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing allocated until the first element
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::concurrent_vector<int, 4> v;
+      // verify
+      assertUnit(v.size() == 0);
+      assertUnit(v.empty());
+      assertUnit(v.capacity() == 0);
+      assertUnit(v.segments[0].load() == nullptr);
+      assertUnit(v.begin() == v.end());
+   }  // teardown
+
+   // every element built is destroyed exactly once
+   void test_destructor_destroysAll()
+   {  // setup
+      Spy::reset();
+      {
+         custom::concurrent_vector<Spy, 4> v;
+         for (int i = 0; i < 30; i++)
+            v.emplace_back(i);
+         // exercise
+      }
+      // verify
+      assertUnit(Spy::numNondefault() == 30);
+      assertUnit(Spy::numDestructor() == 30);
+   }  // teardown
+
+   /***************************************
+    * SEGMENTS
+    ***************************************/
+
+   // segment k starts at 4(2^k - 1) and holds 4 << k slots
+   void test_segmentOf_geometric()
+   {  // setup
+      typedef custom::concurrent_vector<int, 4> cv;
+      // exercise and verify
+      assertUnit(cv::segmentOf(0) == 0);
+      assertUnit(cv::segmentOf(3) == 0);
+      assertUnit(cv::segmentOf(4) == 1);
+      assertUnit(cv::segmentOf(11) == 1);
+      assertUnit(cv::segmentOf(12) == 2);
+      assertUnit(cv::segmentOf(27) == 2);
+      assertUnit(cv::segmentOf(28) == 3);
+      assertUnit(cv::segmentBase(3) == 28);
+      assertUnit(cv::segmentSize(3) == 32);
+   }  // teardown
+
+   // reserve builds the segments up front and pushing reuses them
+   void test_reserve_allocatesSegments()
+   {  // setup
+      custom::concurrent_vector<int, 4> v;
+      // exercise
+      v.reserve(13);
+      auto * third = v.segments[2].load();
+      for (int i = 0; i < 28; i++)
+         v.push_back(i);
+      // verify
+      assertUnit(v.capacity() == 28);
+      assertUnit(v.segments[2].load() == third);
+      assertUnit(v.segments[3].load() == nullptr);
+      assertUnit(v.size() == 28);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // growing never copies or moves an element already there
+   void test_pushback_neverMoves()
+   {  // setup
+      custom::concurrent_vector<Spy, 4> v;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 100; i++)
+         v.emplace_back(i);
+      // verify
+      assertUnit(Spy::numNondefault() == 100);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.size() == 100);
+      assertUnit(v[99] == Spy(99));
+   }  // teardown
+
+   // a reference to an element is still good after thousands more
+   void test_pushback_addressesStable()
+   {  // setup
+      custom::concurrent_vector<int, 4> v;
+      int & r = v.emplace_back(26);
+      // exercise
+      for (int i = 0; i < 5000; i++)
+         v.push_back(i);
+      // verify
+      assertUnit(&r == &v[0]);
+      assertUnit(&v.front() == &r);
+      assertUnit(r == 26);
+      assertUnit(v[5000] == 4999);
+   }  // teardown
+
+   // eight producers at once: every value lands exactly once
+   void test_pushback_manyThreads()
+   {  // setup
+      custom::concurrent_vector<int, 4> v;
+      const int producers = 8;
+      const int each = 10000;
+      std::thread threads[producers];
+      // exercise
+      for (int p = 0; p < producers; p++)
+         threads[p] = std::thread([&v, p, each]()
+         {
+            for (int i = 0; i < each; i++)
+               v.push_back(p * each + i);
+         });
+      for (int p = 0; p < producers; p++)
+         threads[p].join();
+      // verify
+      assertUnit(v.size() == producers * each);
+      std::vector<int> seen(v.begin(), v.end());
+      std::sort(seen.begin(), seen.end());
+      bool everyOnce = true;
+      for (int i = 0; i < producers * each; i++)
+         everyOnce = everyOnce && seen[i] == i;
+      assertUnit(everyOnce);
+   }  // teardown
+
+   // a value whose two halves only agree once it is fully built
+   struct Checked
+   {
+      Checked(int value) : value(value), check(~value) {}
+      bool built() const { return check == ~value; }
+      int value;
+      int check;
+   };
+
+   // a reader never sees a slot that is not finished
+   void test_read_whilePushing()
+   {  // setup
+      custom::concurrent_vector<Checked, 4> v;
+      const int producers = 4;
+      std::thread threads[producers];
+      for (int p = 0; p < producers; p++)
+         threads[p] = std::thread([&v]()
+         {
+            for (int i = 0; i < 2000; i++)
+               v.emplace_back(i);
+         });
+      // exercise
+      bool allBuilt = true;
+      size_t lastSize = 0;
+      bool neverShrinks = true;
+      while (v.size() < producers * 2000)
+      {
+         size_t num = v.size();
+         neverShrinks = neverShrinks && num >= lastSize;
+         lastSize = num;
+         for (auto it = v.cbegin(); it != v.cbegin() + num; ++it)
+            allBuilt = allBuilt && it->built() && it->value < 2000;
+      }
+      for (int p = 0; p < producers; p++)
+         threads[p].join();
+      // verify
+      assertUnit(allBuilt);
+      assertUnit(neverShrinks);
+      assertUnit(v.size() == producers * 2000);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // clear destroys the elements but keeps the segments for reuse
+   void test_clear_keepsSegments()
+   {  // setup
+      custom::concurrent_vector<Spy, 4> v;
+      for (int i = 0; i < 10; i++)
+         v.emplace_back(i);
+      auto * first = v.segments[0].load();
+      Spy::reset();
+      // exercise
+      v.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 10);
+      assertUnit(v.size() == 0);
+      assertUnit(v.capacity() == 12);
+      v.emplace_back(26);
+      assertUnit(v.segments[0].load() == first);
+      assertUnit(v.size() == 1);
+      assertUnit(v[0] == Spy(26));
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // end() is fixed when taken; later pushes are past it
+   void test_iterator_publishedPrefix()
+   {  // setup
+      custom::concurrent_vector<int, 4> v;
+      for (int i = 1; i <= 10; i++)
+         v.push_back(i);
+      custom::concurrent_vector<int, 4>::iterator end = v.end();
+      // exercise
+      for (int i = 11; i <= 20; i++)
+         v.push_back(i);
+      // verify
+      int sum = 0;
+      for (auto it = v.begin(); it != end; ++it)
+         sum += *it;
+      assertUnit(sum == 55);
+      assertUnit(v.end() - end == 10);
+      custom::concurrent_vector<int, 4>::const_iterator cit = v.begin();
+      assertUnit(cit[19] == 20);
+   }  // teardown
+
+   // the standard algorithms work across segments
+   void test_iterator_algorithms()
+   {  // setup
+      custom::concurrent_vector<int, 4> v;
+      int values[] = {89, 26, 67, 11, 49, 31, 99, 5, 72};
+      for (int value : values)
+         v.push_back(value);
+      // exercise
+      std::sort(v.begin(), v.end());
+      // verify
+      assertUnit(v[0] == 5);
+      assertUnit(v[4] == 49);
+      assertUnit(v[8] == 99);
+      assertUnit(std::lower_bound(v.cbegin(), v.cend(), 67) - v.cbegin() == 5);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,336 @@
+/***********************************************************************
+ * Header:
+ *    TEST COW VECTOR
+ * Summary:
+ *    Unit tests for cow_vector
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "cow_vector.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*************************************************************
+ * TAGGED ALLOCATOR
+ * Hands out memory like std::allocator, but carries a tag
+ * so a test can tell whose allocator a buffer ended up on
+ *************************************************************/
+template <class T>
+struct TaggedAllocator
+{
+   using value_type = T;
+   TaggedAllocator(int tag = 0) : tag(tag) {}
+   template <class U>
+   TaggedAllocator(const TaggedAllocator<U> & rhs) : tag(rhs.tag) {}
+   T *  allocate(size_t n)            { return std::allocator<T>().allocate(n); }
+   void deallocate(T * p, size_t n)   { std::allocator<T>().deallocate(p, n);   }
+   int tag;
+};
+template <class T, class U>
+bool operator == (const TaggedAllocator<T> & lhs, const TaggedAllocator<U> & rhs) { return lhs.tag == rhs.tag; }
+template <class T, class U>
+bool operator != (const TaggedAllocator<T> & lhs, const TaggedAllocator<U> & rhs) { return lhs.tag != rhs.tag; }
+
+class TestCowVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_fill();
+      test_constructCopy_shares();
+      test_constructMove_steals();
+
+      // Assign
+      test_assign_sharesAndReleases();
+      test_assign_self();
+
+      // Write
+      test_write_clonesShared();
+      test_write_uniqueInPlace();
+      test_clear_shared();
+      test_clear_sharedKeepsAllocator();
+      test_write_movedFromKeepsAllocator();
+
+      // Snapshot
+      test_snapshot_unchangedByWrites();
+      test_snapshot_outlivesVector();
+      test_snapshot_toVector();
+      test_threads_shareCopies();
+
+      report("CowVector");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // the usual constructors give a buffer of our own
+   void test_construct_fill()
+   {  // setup
+      // exercise
+      custom::cow_vector<int> v(3, 26);
+      custom::cow_vector<int> w{26, 49, 67};
+      // verify
+      assertUnit(v.size() == 3);
+      assertUnit(v.use_count() == 1);
+      assertUnit(v[2] == 26);
+      assertUnit(w.size() == 3);
+      assertUnit(w.front() == 26);
+      assertUnit(w.back() == 67);
+   }  // teardown
+
+   // copying shares the buffer: not one element is copied
+   void test_constructCopy_shares()
+   {  // setup
+      custom::cow_vector<Spy> src;
+      src.push_back(Spy(26));
+      src.push_back(Spy(49));
+      Spy::reset();
+      // exercise
+      custom::cow_vector<Spy> dest(src);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(dest.shared == src.shared);
+      assertUnit(dest.use_count() == 2);
+      assertUnit(dest.size() == 2);
+   }  // teardown
+
+   // moving takes the buffer and leaves an empty vector behind
+   void test_constructMove_steals()
+   {  // setup
+      custom::cow_vector<int> src{26, 49};
+      // exercise
+      custom::cow_vector<int> dest(std::move(src));
+      // verify
+      assertUnit(dest.size() == 2);
+      assertUnit(dest.use_count() == 1);
+      assertUnit(src.shared == nullptr);
+      assertUnit(src.size() == 0);
+      assertUnit(src.empty());
+      src.push_back(67);
+      assertUnit(src.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assigning shares the new buffer and lets go of the old one
+   void test_assign_sharesAndReleases()
+   {  // setup
+      custom::cow_vector<Spy> a(2);
+      custom::cow_vector<Spy> b(3);
+      custom::cow_vector<Spy> keep(b);
+      Spy::reset();
+      // exercise
+      b = a;
+      a = keep;
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);  // every buffer is still owned
+      assertUnit(a.size() == 3);
+      assertUnit(b.size() == 2);
+      assertUnit(a.use_count() == 2);
+      assertUnit(b.use_count() == 1);
+   }  // teardown
+
+   // assigning a vector to itself keeps its buffer
+   void test_assign_self()
+   {  // setup
+      custom::cow_vector<int> v{26, 49};
+      custom::cow_vector<int> & alias = v;
+      // exercise
+      v = alias;
+      // verify
+      assertUnit(v.use_count() == 1);
+      assertUnit(v[1] == 49);
+   }  // teardown
+
+   /***************************************
+    * WRITE
+    ***************************************/
+
+   // the first write to a shared buffer clones it, once
+   void test_write_clonesShared()
+   {  // setup
+      custom::cow_vector<Spy> a;
+      a.push_back(Spy(26));
+      a.push_back(Spy(49));
+      custom::cow_vector<Spy> b(a);
+      Spy::reset();
+      // exercise
+      b[0] = Spy(67);
+      b[1] = Spy(89);
+      // verify
+      assertUnit(Spy::numCopy() == 2);        // the clone, and only one
+      assertUnit(a.shared != b.shared);
+      assertUnit(a.use_count() == 1);
+      assertUnit(b.use_count() == 1);
+      const custom::cow_vector<Spy> & ca = a;
+      assertUnit(ca[0] == Spy(26));
+      assertUnit(ca[1] == Spy(49));
+      assertUnit(b[0] == Spy(67));
+   }  // teardown
+
+   // nobody else holds the buffer: write straight into it
+   void test_write_uniqueInPlace()
+   {  // setup
+      custom::cow_vector<Spy> v(3);
+      void * before = v.shared;
+      Spy::reset();
+      // exercise
+      v[1] = Spy(26);
+      v.pop_back();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(v.shared == before);
+      assertUnit(v.size() == 2);
+   }  // teardown
+
+   // clearing a shared vector does not clone what it throws away
+   void test_clear_shared()
+   {  // setup
+      custom::cow_vector<Spy> a(4);
+      custom::cow_vector<Spy> b(a);
+      Spy::reset();
+      // exercise
+      b.clear();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(b.empty());
+      assertUnit(a.size() == 4);
+      assertUnit(a.use_count() == 1);
+   }  // teardown
+
+   // the empty buffer that replaces a shared one is on the same allocator
+   void test_clear_sharedKeepsAllocator()
+   {  // setup
+      custom::cow_vector<int, TaggedAllocator<int>> a({26, 49}, TaggedAllocator<int>(7));
+      custom::cow_vector<int, TaggedAllocator<int>> b(a);
+      // exercise
+      b.clear();
+      // verify
+      assertUnit(b.empty());
+      assertUnit(b.shared != a.shared);
+      assertUnit(b.shared->elements.get_allocator().tag == 7);
+      assertUnit(a.size() == 2);
+   }  // teardown
+
+   // a moved-from vector builds its new buffer on the allocator it was given
+   void test_write_movedFromKeepsAllocator()
+   {  // setup
+      custom::cow_vector<int, TaggedAllocator<int>> src({26}, TaggedAllocator<int>(7));
+      custom::cow_vector<int, TaggedAllocator<int>> dest(std::move(src));
+      // exercise
+      src.push_back(67);
+      // verify
+      assertUnit(src.size() == 1);
+      assertUnit(src.shared->elements.get_allocator().tag == 7);
+      assertUnit(src.get_allocator().tag == 7);
+      assertUnit(dest.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * SNAPSHOT
+    ***************************************/
+
+   // writes after a snapshot go to a clone, never to the snapshot
+   void test_snapshot_unchangedByWrites()
+   {  // setup
+      custom::cow_vector<int> v{26, 49, 67};
+      // exercise
+      custom::cow_vector<int>::snapshot_type s = v.snapshot();
+      assertUnit(v.use_count() == 2);
+      v[0] = 11;
+      v.push_back(89);
+      // verify
+      assertUnit(s.size() == 3);
+      assertUnit(s[0] == 26);
+      assertUnit(s.back() == 67);
+      assertUnit(v.size() == 4);
+      assertUnit(v.use_count() == 1);
+      int sum = 0;
+      for (custom::cow_vector<int>::snapshot_type::const_iterator it = s.begin(); it != s.end(); ++it)
+         sum += *it;
+      assertUnit(sum == 142);
+   }  // teardown
+
+   // a snapshot keeps the buffer alive after the vector is gone
+   void test_snapshot_outlivesVector()
+   {  // setup
+      custom::cow_vector<Spy> *p = new custom::cow_vector<Spy>(2);
+      custom::cow_vector<Spy>::snapshot_type s = p->snapshot();
+      Spy::reset();
+      // exercise
+      delete p;
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(s.size() == 2);
+      custom::cow_vector<Spy>::snapshot_type t = s;
+      s = t;
+      assertUnit(t.size() == 2);
+   }  // teardown
+
+   // a vector made from a snapshot shares it until written
+   void test_snapshot_toVector()
+   {  // setup
+      custom::cow_vector<int> v{26, 49};
+      custom::cow_vector<int>::snapshot_type s = v.snapshot();
+      // exercise
+      custom::cow_vector<int> w(s);
+      // verify
+      assertUnit(w.use_count() == 3);
+      w.push_back(67);
+      assertUnit(w.use_count() == 1);
+      assertUnit(s.size() == 2);
+      custom::cow_vector<int> moved(std::move(v));
+      assertUnit(v.snapshot().empty());
+   }  // teardown
+
+   // copies handed to other threads read and clone safely
+   void test_threads_shareCopies()
+   {  // setup
+      custom::cow_vector<int> config(1000, 26);
+      std::vector<std::thread> workers;
+      std::vector<long> sums(4, 0);
+      // exercise
+      for (size_t i = 0; i < sums.size(); i++)
+      {
+         custom::cow_vector<int> mine(config);
+         workers.push_back(std::thread([mine, i, &sums]() mutable
+         {
+            const custom::cow_vector<int> & read = mine;
+            for (size_t j = 0; j < read.size(); j++)
+               sums[i] += read[j];
+            if (i % 2)
+               mine[0] = 0;   // half of them clone
+         }));
+      }
+      for (size_t i = 0; i < workers.size(); i++)
+         workers[i].join();
+      // verify
+      bool allRead = true;
+      for (size_t i = 0; i < sums.size(); i++)
+         allRead = allRead && sums[i] == 26000;
+      assertUnit(allRead);
+      assertUnit(config.use_count() == 1);
+      assertUnit(config[0] == 26);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,353 @@
+/***********************************************************************
+ * Header:
+ *    TEST MMAP VECTOR
+ * Summary:
+ *    Unit tests for mmap_vector.  Each test works on a scratch file
+ *    in the current directory and removes it when done.
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "mmap_vector.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <cstdio>     // for std::remove
+#include <fcntl.h>    // for open
+#include <sys/stat.h> // for stat
+#include <system_error>
+#include <unistd.h>   // for close
+
+class TestMmapVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_newFileEmpty();
+      test_construct_reopenKeepsElements();
+      test_construct_readOnly();
+      test_construct_readOnlyWritesStayPrivate();
+      test_construct_move();
+
+      // Insert and remove
+      test_pushBack_growsFile();
+      test_pushBack_ownElement();
+      test_resize_fills();
+      test_shrinkToFit_trimsFile();
+      test_shrinkToFit_failureKeepsMapping();
+
+      // Access
+      test_iterator_walksElements();
+      test_advise_survivesGrowth();
+      test_sync_flushes();
+
+      report("MmapVector");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a file that did not exist is created, empty, with nothing mapped
+   void test_construct_newFileEmpty()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         assertUnit(v.size() == 0);
+         assertUnit(v.capacity() == 0);
+         assertUnit(v.empty());
+         assertUnit(v.data == nullptr);
+         assertUnit(v.fd >= 0);
+      }
+      assertUnit(fileSize() == 0);
+      std::remove(PATH);
+   }
+
+   // close, open again: the elements are still there and the file is exact
+   void test_construct_reopenKeepsElements()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<double> v(PATH);
+         v.push_back(2.6);
+         v.push_back(4.9);
+         v.push_back(6.7);
+      }
+      assertUnit(fileSize() == 3 * sizeof(double));
+      {
+         custom::mmap_vector<double> v(PATH);
+         assertUnit(v.size() == 3);
+         assertUnit(v.capacity() == 3);
+         assertUnit(v[0] == 2.6);
+         assertUnit(v[1] == 4.9);
+         assertUnit(v[2] == 6.7);
+         v.push_back(8.9);
+      }
+      assertUnit(fileSize() == 4 * sizeof(double));
+      std::remove(PATH);
+   }
+
+   // a read-only table sees the elements and leaves the file alone
+   void test_construct_readOnly()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.resize(100, 26);
+      }
+      {
+         custom::mmap_vector<int> v(PATH, custom::mmap_vector<int>::mode::read_only);
+         assertUnit(v.readOnly);
+         assertUnit(v.size() == 100);
+         assertUnit(v.front() == 26);
+         assertUnit(v.back() == 26);
+      }
+      assertUnit(fileSize() == 100 * sizeof(int));
+      std::remove(PATH);
+   }
+
+   // writing to a read-only table changes our copy, not the file
+   void test_construct_readOnlyWritesStayPrivate()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.resize(4, 26);
+      }
+      {
+         custom::mmap_vector<int> v(PATH, custom::mmap_vector<int>::mode::read_only);
+         v[1] = 49;
+         *v.begin() = 67;
+         assertUnit(v[0] == 67);
+         assertUnit(v[1] == 49);
+      }
+      {
+         custom::mmap_vector<int> v(PATH, custom::mmap_vector<int>::mode::read_only);
+         assertUnit(v[0] == 26);
+         assertUnit(v[1] == 26);
+      }
+      assertUnit(fileSize() == 4 * sizeof(int));
+      std::remove(PATH);
+   }
+
+   // moving hands over the file; the source is left with nothing
+   void test_construct_move()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> src(PATH);
+         src.push_back(26);
+         src.push_back(49);
+         int fd = src.fd;
+         custom::mmap_vector<int> dest(std::move(src));
+         assertUnit(dest.fd == fd);
+         assertUnit(dest.size() == 2);
+         assertUnit(dest[1] == 49);
+         assertUnit(src.fd == -1);
+         assertUnit(src.data == nullptr);
+         assertUnit(src.size() == 0);
+      }
+      assertUnit(fileSize() == 2 * sizeof(int));
+      std::remove(PATH);
+   }
+
+   /***************************************
+    * INSERT AND REMOVE
+    ***************************************/
+
+   // the file follows the growth policy while open
+   void test_pushBack_growsFile()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.push_back(1);
+         assertUnit(v.capacity() == 1);
+         v.push_back(2);
+         assertUnit(v.capacity() == 2);
+         v.push_back(3);
+         assertUnit(v.capacity() == 4);
+         assertUnit(fileSize() == 4 * sizeof(int));
+         for (int i = 4; i <= 1000; i++)
+            v.push_back(i);
+         assertUnit(v.size() == 1000);
+         assertUnit(v.capacity() == 1024);
+         assertUnit(v[0] == 1);
+         assertUnit(v[999] == 1000);
+      }
+      assertUnit(fileSize() == 1000 * sizeof(int));
+      std::remove(PATH);
+   }
+
+   // pushing our own element, even as the mapping moves
+   void test_pushBack_ownElement()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.push_back(26);
+         for (int i = 0; i < 100000; i++)
+            v.push_back(v[0]);
+         v.resize(200000, v.back());
+         bool allSame = true;
+         for (size_t i = 0; i < v.size(); i++)
+            if (v[i] != 26)
+               allSame = false;
+         assertUnit(allSame);
+         assertUnit(v.size() == 200000);
+      }
+      std::remove(PATH);
+   }
+
+   // growing fills with the value; shrinking keeps the front
+   void test_resize_fills()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.resize(5, 49);
+         assertUnit(v.size() == 5);
+         assertUnit(v[0] == 49);
+         assertUnit(v[4] == 49);
+         v.resize(2);
+         assertUnit(v.size() == 2);
+         assertUnit(v.capacity() == 5);
+         v.resize(3);
+         assertUnit(v[2] == 0);
+      }
+      assertUnit(fileSize() == 3 * sizeof(int));
+      std::remove(PATH);
+   }
+
+   // shrinking the mapping shrinks the file with it
+   void test_shrinkToFit_trimsFile()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.reserve(64);
+         v.push_back(26);
+         assertUnit(fileSize() == 64 * sizeof(int));
+         v.shrink_to_fit();
+         assertUnit(v.capacity() == 1);
+         assertUnit(v[0] == 26);
+         assertUnit(fileSize() == sizeof(int));
+         v.clear();
+         v.shrink_to_fit();
+         assertUnit(v.capacity() == 0);
+         assertUnit(v.data == nullptr);
+      }
+      assertUnit(fileSize() == 0);
+      std::remove(PATH);
+   }
+
+   // a file that will not shrink leaves the smaller mapping in place
+   void test_shrinkToFit_failureKeepsMapping()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.reserve(64);
+         v.push_back(26);
+         int fdWritable = v.fd;
+         v.fd = ::open(PATH, O_RDONLY);   // ftruncate fails on this one
+         bool thrown = false;
+         try
+         {
+            v.shrink_to_fit();
+         }
+         catch (const std::system_error &)
+         {
+            thrown = true;
+         }
+         assertUnit(thrown);
+         assertUnit(v.data != nullptr);
+         assertUnit(v.capacity() == 1);
+         assertUnit(v.size() == 1);
+         assertUnit(v[0] == 26);
+         ::close(v.fd);
+         v.fd = fdWritable;
+      }
+      assertUnit(fileSize() == sizeof(int));
+      std::remove(PATH);
+   }
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // the iterator is vector's, and it walks the mapping
+   void test_iterator_walksElements()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         for (int i = 1; i <= 10; i++)
+            v.push_back(i);
+         int sum = 0;
+         for (custom::mmap_vector<int>::iterator it = v.begin(); it != v.end(); ++it)
+            sum += *it;
+         assertUnit(sum == 55);
+         *v.begin() = 26;
+         assertUnit(v.front() == 26);
+      }
+      std::remove(PATH);
+   }
+
+   // the advice is remembered across a remap that may move the mapping
+   void test_advise_survivesGrowth()
+   {
+      typedef custom::mmap_vector<int>::access access;
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.advise(access::sequential);  // nothing mapped yet
+         v.push_back(26);
+         v.reserve(4096);
+         assertUnit(v.advice == access::sequential);
+         v.advise(access::random);
+         v.advise(access::willneed);
+         assertUnit(v.advice == access::willneed);
+         assertUnit(v[0] == 26);
+      }
+      std::remove(PATH);
+   }
+
+   // after sync, a second mapping of the file sees the writes
+   void test_sync_flushes()
+   {
+      std::remove(PATH);
+      {
+         custom::mmap_vector<int> v(PATH);
+         v.resize(4, 0);
+         v[2] = 67;
+         v.sync();
+         custom::mmap_vector<int> reader(PATH, custom::mmap_vector<int>::mode::read_only);
+         assertUnit(reader.size() == 4);
+         assertUnit(reader[2] == 67);
+      }
+      std::remove(PATH);
+   }
+
+private:
+   const char * PATH = "testMmapVector.tmp";
+
+   // bytes in the scratch file right now
+   size_t fileSize() const
+   {
+      struct stat info;
+      if (stat(PATH, &info) != 0)
+         return 0;
+      return static_cast<size_t>(info.st_size);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,264 @@
+/***********************************************************************
+ * Header:
+ *    TEST PARALLEL
+ * Summary:
+ *    Unit tests for the parallel algorithms and their thread pool.
+ *    The threshold is lowered so small containers still get split
+ *    across the workers.
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "parallel.h"
+#include "vector.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+class TestParallel : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+      size_t saved = custom::parallel::threshold();
+      custom::parallel::set_threshold(16);
+
+      // Pool
+      test_threadPool_runsEveryTask();
+      test_taskGroup_nested();
+      test_taskGroup_rethrows();
+      test_indexIterator_arithmetic();
+
+      // Algorithms
+      test_forEach_everyElement();
+      test_forEach_belowThreshold();
+      test_transform_intoOther();
+      test_reduce_keepsOrder();
+      test_sort_random();
+      test_sort_comparator();
+      test_sort_tiny();
+      test_stableSort_keepsTies();
+
+      custom::parallel::set_threshold(saved);
+      report("Parallel");
+   }
+
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // every task submitted to a group runs exactly once
+   void test_threadPool_runsEveryTask()
+   {
+      custom::parallel::thread_pool threads(3);
+      std::atomic<int> count(0);
+      {
+         custom::parallel::task_group group(threads);
+         for (int i = 0; i < 1000; i++)
+            group.run([&count]() { count++; });
+         group.wait();
+      }
+      assertUnit(threads.size() == 3);
+      assertUnit(count == 1000);
+   }
+
+   // a task may start and wait for its own group without deadlock
+   void test_taskGroup_nested()
+   {
+      custom::parallel::thread_pool threads(1);
+      std::atomic<int> count(0);
+      custom::parallel::task_group outer(threads);
+      for (int i = 0; i < 8; i++)
+         outer.run([&threads, &count]()
+         {
+            custom::parallel::task_group inner(threads);
+            for (int j = 0; j < 8; j++)
+               inner.run([&count]() { count++; });
+            inner.wait();
+         });
+      outer.wait();
+      assertUnit(count == 64);
+   }
+
+   // an exception in a task comes out of wait, after the rest finish
+   void test_taskGroup_rethrows()
+   {
+      std::atomic<int> count(0);
+      bool caught = false;
+      custom::parallel::task_group group;
+      for (int i = 0; i < 10; i++)
+         group.run([&count, i]()
+         {
+            if (i == 4)
+               throw std::runtime_error("four");
+            count++;
+         });
+      try
+      {
+         group.wait();
+      }
+      catch (const std::runtime_error &)
+      {
+         caught = true;
+      }
+      assertUnit(caught);
+      assertUnit(count == 9);
+   }
+
+   // the index iterator behaves like a pointer
+   void test_indexIterator_arithmetic()
+   {
+      custom::vector<int> v{26, 49, 67, 89};
+      typedef custom::parallel::index_iterator<custom::vector<int>> iterator;
+      iterator begin(v, 0);
+      iterator end(v, 4);
+      assertUnit(end - begin == 4);
+      assertUnit(*(begin + 2) == 67);
+      assertUnit(begin[3] == 89);
+      assertUnit(*(end - 1) == 89);
+      assertUnit(begin < end);
+      iterator it = begin++;
+      assertUnit(it == iterator(v, 0));
+      assertUnit(*begin == 49);
+      *begin = 11;
+      assertUnit(v[1] == 11);
+   }
+
+   /***************************************
+    * ALGORITHMS
+    ***************************************/
+
+   // each element is visited exactly once
+   void test_forEach_everyElement()
+   {
+      custom::vector<int> v(1000, 1);
+      custom::parallel::for_each(v, [](int & value) { value *= 2; });
+      bool allTwo = true;
+      for (size_t i = 0; i < v.size(); i++)
+         allTwo = allTwo && v[i] == 2;
+      assertUnit(allTwo);
+   }
+
+   // under the threshold the calling thread does all the work
+   void test_forEach_belowThreshold()
+   {
+      custom::vector<int> v(10, 0);
+      std::thread::id caller = std::this_thread::get_id();
+      bool allHere = true;
+      custom::parallel::for_each(v, [&](int & value)
+      {
+         allHere = allHere && std::this_thread::get_id() == caller;
+         value = 26;
+      });
+      assertUnit(allHere);
+      assertUnit(v[9] == 26);
+      custom::vector<int> empty;
+      custom::parallel::for_each(empty, [](int & value) { value = 0; });
+      assertUnit(empty.size() == 0);
+   }
+
+   // dest[i] = f(src[i]) into a container of another type
+   void test_transform_intoOther()
+   {
+      custom::vector<int> src(500);
+      for (size_t i = 0; i < src.size(); i++)
+         src[i] = static_cast<int>(i);
+      custom::vector<double> dest(500);
+      custom::parallel::transform(src, dest, [](int value) { return value * 0.5; });
+      assertUnit(dest[0] == 0.0);
+      assertUnit(dest[1] == 0.5);
+      assertUnit(dest[499] == 249.5);
+   }
+
+   // concatenation is associative but not commutative: order must hold
+   void test_reduce_keepsOrder()
+   {
+      custom::vector<int> v(1000);
+      for (size_t i = 0; i < v.size(); i++)
+         v[i] = static_cast<int>(i);
+      assertUnit(custom::parallel::reduce(v, 0) == 499500);
+      assertUnit(custom::parallel::reduce(v, 7) == 499507);
+
+      custom::vector<std::string> letters(100);
+      std::string expected;
+      for (size_t i = 0; i < letters.size(); i++)
+      {
+         letters[i] = std::string(1, static_cast<char>('a' + i % 26));
+         expected += letters[i];
+      }
+      assertUnit(custom::parallel::reduce(letters, std::string(">")) == ">" + expected);
+   }
+
+   // a scrambled vector comes out in order, nothing lost
+   void test_sort_random()
+   {
+      custom::vector<int> v(5000);
+      unsigned seed = 26;
+      long long before = 0;
+      for (size_t i = 0; i < v.size(); i++)
+      {
+         seed = seed * 1103515245u + 12345u;
+         v[i] = static_cast<int>(seed % 1000);
+         before += v[i];
+      }
+      custom::parallel::sort(v);
+      bool sorted = true;
+      long long after = v[0];
+      for (size_t i = 1; i < v.size(); i++)
+      {
+         sorted = sorted && v[i - 1] <= v[i];
+         after += v[i];
+      }
+      assertUnit(sorted);
+      assertUnit(before == after);
+   }
+
+   // a custom comparator sorts the other way
+   void test_sort_comparator()
+   {
+      custom::vector<int> v(300);
+      for (size_t i = 0; i < v.size(); i++)
+         v[i] = static_cast<int>((i * 37) % 300);
+      custom::parallel::sort(v, [](int lhs, int rhs) { return lhs > rhs; });
+      assertUnit(v[0] == 299);
+      assertUnit(v[150] == 149);
+      assertUnit(v[299] == 0);
+   }
+
+   // empty and single element containers are already sorted
+   void test_sort_tiny()
+   {
+      custom::vector<int> empty;
+      custom::parallel::sort(empty);
+      assertUnit(empty.size() == 0);
+      custom::vector<int> one{26};
+      custom::parallel::stable_sort(one);
+      assertUnit(one[0] == 26);
+   }
+
+   // equal keys keep the order they started in, across every run
+   void test_stableSort_keepsTies()
+   {
+      custom::vector<int> v(1000);
+      for (size_t i = 0; i < v.size(); i++)
+         v[i] = static_cast<int>((i % 10) * 1000 + i);  // key * 1000 + position
+      custom::parallel::stable_sort(v, [](int lhs, int rhs) { return lhs / 1000 < rhs / 1000; });
+      bool stable = true;
+      for (size_t i = 1; i < v.size(); i++)
+         stable = stable && (v[i - 1] / 1000 < v[i] / 1000 ||
+                             (v[i - 1] / 1000 == v[i] / 1000 && v[i - 1] < v[i]));
+      assertUnit(stable);
+      assertUnit(v[0] == 0);
+      assertUnit(v[999] == 9999);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,280 @@
+/***********************************************************************
+ * Header:
+ *    TEST SEGMENTED VECTOR
+ * Summary:
+ *    Unit tests for segmented_vector.  Most use blocks of four so a
+ *    handful of elements already spans several blocks.
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "segmented_vector.h"
+#include "unitTest.h"
+#include "spy.h"
+#include "testCowVector.h" // for TaggedAllocator
+
+#include <algorithm>
+#include <cassert>
+
+class TestSegmentedVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_fill();
+      test_constructCopy_ownBlocks();
+      test_constructMove_stealsTable();
+      test_construct_tableOnAllocator();
+
+      // Assign
+      test_assign_shrinks();
+
+      // Insert
+      test_pushback_neverMoves();
+      test_pushback_addressesStable();
+      test_reserve_wholeBlocks();
+
+      // Remove
+      test_popback_keepsBlock();
+      test_shrinkToFit_freesBlocks();
+
+      // Iterator
+      test_iterator_survivesGrowth();
+      test_iterator_sort();
+
+      report("SegmentedVector");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing allocated until the first element
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::segmented_vector<int, 4> v;
+      // verify
+      assertUnit(v.size() == 0);
+      assertUnit(v.capacity() == 0);
+      assertUnit(v.blocks.size() == 0);
+      assertUnit(custom::segmented_vector<int>::block_size() == 1024);
+   }  // teardown
+
+   // ten elements of four per block take three blocks
+   void test_construct_fill()
+   {  // setup
+      // exercise
+      custom::segmented_vector<int, 4> v(10, 26);
+      custom::segmented_vector<int, 4> l{26, 49, 67, 89, 11};
+      // verify
+      assertUnit(v.size() == 10);
+      assertUnit(v.blocks.size() == 3);
+      assertUnit(v.capacity() == 12);
+      assertUnit(v[0] == 26);
+      assertUnit(v[9] == 26);
+      assertUnit(l.size() == 5);
+      assertUnit(l[3] == 89);
+      assertUnit(l[4] == 11);
+      assertUnit(&l[4] == l.blocks[1]);
+   }  // teardown
+
+   // a copy has blocks of its own, with one copy per element
+   void test_constructCopy_ownBlocks()
+   {  // setup
+      custom::segmented_vector<Spy, 4> src;
+      for (int i = 0; i < 6; i++)
+         src.push_back(Spy(i));
+      Spy::reset();
+      // exercise
+      custom::segmented_vector<Spy, 4> dest(src);
+      // verify
+      assertUnit(Spy::numCopy() == 6);
+      assertUnit(dest.size() == 6);
+      assertUnit(dest.blocks[0] != src.blocks[0]);
+      assertUnit(dest[5] == Spy(5));
+   }  // teardown
+
+   // moving takes the block table; no element is touched
+   void test_constructMove_stealsTable()
+   {  // setup
+      custom::segmented_vector<Spy, 4> src(6);
+      Spy * first = &src[0];
+      Spy::reset();
+      // exercise
+      custom::segmented_vector<Spy, 4> dest(std::move(src));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(&dest[0] == first);
+      assertUnit(dest.size() == 6);
+      assertUnit(src.size() == 0);
+      assertUnit(src.blocks.size() == 0);
+   }  // teardown
+
+   // the block table comes from the same allocator as the blocks
+   void test_construct_tableOnAllocator()
+   {  // setup
+      TaggedAllocator<int> a(7);
+      // exercise
+      custom::segmented_vector<int, 4, TaggedAllocator<int>> v(6, a);
+      // verify
+      assertUnit(v.blocks.size() == 2);
+      assertUnit(v.blocks.get_allocator().tag == 7);
+      assertUnit(v.get_allocator().tag == 7);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assigning a shorter vector destroys the extras and keeps the blocks
+   void test_assign_shrinks()
+   {  // setup
+      custom::segmented_vector<Spy, 4> dest(9);
+      custom::segmented_vector<Spy, 4> src(2);
+      Spy::reset();
+      // exercise
+      dest = src;
+      // verify
+      assertUnit(Spy::numAssign() == 2);
+      assertUnit(Spy::numDestructor() == 7);
+      assertUnit(dest.size() == 2);
+      assertUnit(dest.blocks.size() == 3);
+      src = dest;
+      assertUnit(src.size() == 2);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // growing never copies or moves an element already there
+   void test_pushback_neverMoves()
+   {  // setup
+      custom::segmented_vector<Spy, 4> v;
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 100; i++)
+         v.emplace_back(i);
+      // verify
+      assertUnit(Spy::numNondefault() == 100);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.blocks.size() == 25);
+      assertUnit(v[99] == Spy(99));
+   }  // teardown
+
+   // a pointer to an element is still good after thousands more
+   void test_pushback_addressesStable()
+   {  // setup
+      custom::segmented_vector<int, 4> v;
+      v.push_back(26);
+      int * p = &v[0];
+      int & r = v.back();
+      // exercise
+      for (int i = 0; i < 5000; i++)
+         v.push_back(i);
+      // verify
+      assertUnit(p == &v[0]);
+      assertUnit(*p == 26);
+      assertUnit(&r == p);
+      assertUnit(v[5000] == 4999);
+   }  // teardown
+
+   // reserve adds whole blocks up front
+   void test_reserve_wholeBlocks()
+   {  // setup
+      custom::segmented_vector<int, 4> v;
+      // exercise
+      v.reserve(9);
+      int * last = v.blocks[2];
+      for (int i = 0; i < 12; i++)
+         v.push_back(i);
+      // verify
+      assertUnit(v.capacity() == 12);
+      assertUnit(v.blocks.size() == 3);
+      assertUnit(&v[8] == last);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // popping destroys the element but keeps its block for reuse
+   void test_popback_keepsBlock()
+   {  // setup
+      custom::segmented_vector<Spy, 4> v(5);
+      Spy::reset();
+      // exercise
+      v.pop_back();
+      v.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(v.size() == 3);
+      assertUnit(v.blocks.size() == 2);
+   }  // teardown
+
+   // shrink_to_fit frees the empty blocks at the end, nothing moves
+   void test_shrinkToFit_freesBlocks()
+   {  // setup
+      custom::segmented_vector<int, 4> v(16, 26);
+      v.resize(5);
+      int * first = &v[0];
+      // exercise
+      v.shrink_to_fit();
+      // verify
+      assertUnit(v.blocks.size() == 2);
+      assertUnit(v.capacity() == 8);
+      assertUnit(&v[0] == first);
+      v.clear();
+      v.shrink_to_fit();
+      assertUnit(v.capacity() == 0);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // an iterator taken before growth still walks the whole vector after
+   void test_iterator_survivesGrowth()
+   {  // setup
+      custom::segmented_vector<int, 4> v{1, 2, 3};
+      custom::segmented_vector<int, 4>::iterator it = v.begin();
+      // exercise
+      for (int i = 4; i <= 100; i++)
+         v.push_back(i);
+      // verify
+      int sum = 0;
+      for (; it != v.end(); ++it)
+         sum += *it;
+      assertUnit(sum == 5050);
+      custom::segmented_vector<int, 4>::const_iterator cit = v.cbegin();
+      assertUnit(cit[50] == 51);
+      assertUnit(v.end() - cit == 100);
+   }  // teardown
+
+   // the standard algorithms work across blocks
+   void test_iterator_sort()
+   {  // setup
+      custom::segmented_vector<int, 4> v{89, 26, 67, 11, 49, 31, 99};
+      // exercise
+      std::sort(v.begin(), v.end());
+      // verify
+      assertUnit(v[0] == 11);
+      assertUnit(v[3] == 49);
+      assertUnit(v[6] == 99);
+      assertUnit(std::lower_bound(v.cbegin(), v.cend(), 67) - v.cbegin() == 4);
+   }  // teardown
+};
+
+#endif // DEBUG
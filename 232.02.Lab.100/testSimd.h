@@ -0,0 +1,289 @@
+/***********************************************************************
+ * Header:
+ *    TEST SIMD
+ * Summary:
+ *    Unit tests for the simd kernels.  Every kernel at every
+ *    level the CPU supports must agree with the scalar loop.
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "simd.h"
+#include "vector.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <vector>
+
+class TestSimd : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Search
+      test_find_everyPosition();
+      test_find_missing();
+      test_count_mixed();
+
+      // Reduce
+      test_min_everyPosition();
+      test_max_everyPosition();
+      test_sum_everyLength();
+      test_dot_everyLength();
+
+      // Write and compare
+      test_fill_everyLength();
+      test_equal_everyPosition();
+
+      // Containers and dispatch
+      test_vector_kernels();
+      test_setLevel_neverRaises();
+
+      report("Simd");
+   }
+
+   /***************************************
+    * SEARCH
+    ***************************************/
+
+   // find the one marked element wherever it sits, including the tail
+   void test_find_everyPosition()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<int> v(37, 26);
+         for (size_t i = 0; i < v.size(); i++)
+         {
+            v[i] = 49;
+            assertUnit(custom::simd::find(v.data(), v.size(), 49) == i);
+            v[i] = 26;
+         }
+         std::vector<double> d(11, 2.5);
+         d[9] = 6.7;
+         assertUnit(custom::simd::find(d.data(), d.size(), 6.7) == 9);
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   // a missing value returns n, even for an empty range
+   void test_find_missing()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<float> v(19, 2.6f);
+         assertUnit(custom::simd::find(v.data(), v.size(), 4.9f) == 19);
+         assertUnit(custom::simd::find(v.data(), 0, 2.6f) == 0);
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   // count matches spread across whole registers and the tail
+   void test_count_mixed()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<int> v(35);
+         for (size_t i = 0; i < v.size(); i++)
+            v[i] = static_cast<int>(i % 3);
+         assertUnit(custom::simd::count(v.data(), v.size(), 0) == 12);
+         assertUnit(custom::simd::count(v.data(), v.size(), 2) == 11);
+         assertUnit(custom::simd::count(v.data(), v.size(), 7) == 0);
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   /***************************************
+    * REDUCE
+    ***************************************/
+
+   // the smallest element may be in any lane or in the tail
+   void test_min_everyPosition()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<int> v(21, 50);
+         std::vector<double> d(21, 5.0);
+         for (size_t i = 0; i < v.size(); i++)
+         {
+            v[i] = -26;
+            d[i] = -2.6;
+            assertUnit(custom::simd::min(v.data(), v.size()) == -26);
+            assertUnit(custom::simd::min(d.data(), d.size()) == -2.6);
+            v[i] = 50;
+            d[i] = 5.0;
+         }
+         assertUnit(custom::simd::min(v.data(), 1) == 50);
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   // the largest element may be in any lane or in the tail
+   void test_max_everyPosition()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<int> v(21, -50);
+         std::vector<float> f(21, -5.0f);
+         for (size_t i = 0; i < v.size(); i++)
+         {
+            v[i] = 26;
+            f[i] = 2.6f;
+            assertUnit(custom::simd::max(v.data(), v.size()) == 26);
+            assertUnit(custom::simd::max(f.data(), f.size()) == 2.6f);
+            v[i] = -50;
+            f[i] = -5.0f;
+         }
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   // whole numbers add exactly in any order, so compare to the scalar loop
+   void test_sum_everyLength()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<int>    v(40);
+         std::vector<float>  f(40);
+         std::vector<double> d(40);
+         for (size_t i = 0; i < v.size(); i++)
+         {
+            v[i] = static_cast<int>(i) - 7;
+            f[i] = static_cast<float>(i);
+            d[i] = static_cast<double>(i) * 2;
+         }
+         for (size_t n = 0; n <= v.size(); n++)
+         {
+            assertUnit(custom::simd::sum(v.data(), n) == custom::simd::scalar::sum(v.data(), n));
+            assertUnit(custom::simd::sum(f.data(), n) == custom::simd::scalar::sum(f.data(), n));
+            assertUnit(custom::simd::sum(d.data(), n) == custom::simd::scalar::sum(d.data(), n));
+         }
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   // dot products, including negative ints through SSE2's emulated multiply
+   void test_dot_everyLength()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<int>    a(40), b(40);
+         std::vector<double> x(40), y(40);
+         for (size_t i = 0; i < a.size(); i++)
+         {
+            a[i] = static_cast<int>(i) - 20;
+            b[i] = static_cast<int>(i % 5) - 2;
+            x[i] = static_cast<double>(i);
+            y[i] = 0.5;
+         }
+         for (size_t n = 0; n <= a.size(); n++)
+         {
+            assertUnit(custom::simd::dot(a.data(), b.data(), n) ==
+                       custom::simd::scalar::dot(a.data(), b.data(), n));
+            assertUnit(custom::simd::dot(x.data(), y.data(), n) ==
+                       custom::simd::scalar::dot(x.data(), y.data(), n));
+         }
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   /***************************************
+    * WRITE AND COMPARE
+    ***************************************/
+
+   // fill exactly n elements and not one past
+   void test_fill_everyLength()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         for (size_t n = 0; n < 20; n++)
+         {
+            std::vector<float> v(21, 0.0f);
+            custom::simd::fill(v.data(), n, 2.6f);
+            assertUnit(custom::simd::count(v.data(), v.size(), 2.6f) == n);
+            assertUnit(v[n] == 0.0f);
+         }
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   // a single difference anywhere makes the ranges unequal
+   void test_equal_everyPosition()
+   {
+      for (custom::simd::isa level : supportedLevels())
+      {
+         custom::simd::set_level(level);
+         std::vector<double> a(13, 2.6);
+         std::vector<double> b(13, 2.6);
+         assertUnit(custom::simd::equal(a.data(), b.data(), a.size()));
+         for (size_t i = 0; i < b.size(); i++)
+         {
+            b[i] = 4.9;
+            assertUnit(!custom::simd::equal(a.data(), b.data(), a.size()));
+            b[i] = 2.6;
+         }
+      }
+      custom::simd::set_level(custom::simd::detect());
+   }
+
+   /***************************************
+    * CONTAINERS AND DISPATCH
+    ***************************************/
+
+   // the container overloads work on custom::vector, empty or not
+   void test_vector_kernels()
+   {
+      custom::vector<double> v{2.6, 4.9, 6.7, 8.9, 1.1};
+      custom::vector<double> w{1.0, 1.0, 1.0, 1.0, 1.0};
+      custom::vector<double> empty;
+      assertUnit(custom::simd::find(v, 8.9) == 3);
+      assertUnit(custom::simd::count(v, 2.6) == 1);
+      assertUnit(custom::simd::min(v) == 1.1);
+      assertUnit(custom::simd::max(v) == 8.9);
+      assertUnit(custom::simd::dot(v, w) == custom::simd::sum(v));
+      assertUnit(!custom::simd::equal(v, w));
+      assertUnit(custom::simd::equal(empty, empty));
+      assertUnit(custom::simd::sum(empty) == 0.0);
+      custom::simd::fill(v, 1.0);
+      assertUnit(custom::simd::equal(v, w));
+   }
+
+   // asking for more than the CPU has gets what the CPU has
+   void test_setLevel_neverRaises()
+   {
+      custom::simd::isa saved = custom::simd::level();
+      custom::simd::set_level(custom::simd::isa::avx2);
+      assertUnit(custom::simd::level() == custom::simd::detect());
+      custom::simd::set_level(custom::simd::isa::scalar);
+      assertUnit(custom::simd::level() == custom::simd::isa::scalar);
+      custom::simd::set_level(saved);
+   }
+
+private:
+   // every level this CPU can run, weakest first
+   std::vector<custom::simd::isa> supportedLevels()
+   {
+      std::vector<custom::simd::isa> levels;
+      for (custom::simd::isa level : { custom::simd::isa::scalar,
+                                       custom::simd::isa::sse2,
+                                       custom::simd::isa::avx2 })
+         if (level <= custom::simd::detect())
+            levels.push_back(level);
+      return levels;
+   }
+};
+
+#endif // DEBUG
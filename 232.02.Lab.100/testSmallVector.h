@@ -0,0 +1,426 @@
+/***********************************************************************
+ * Header:
+ *    TEST SMALL VECTOR
+ * Summary:
+ *    Unit tests for small_vector
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "small_vector.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <iostream>
+
+class TestSmallVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_fitsInline();
+      test_construct_spills();
+      test_constructCopy_inline();
+      test_constructMove_inline();
+      test_constructMove_heap();
+
+      // Assign
+      test_assignMove_inlineToHeap();
+      test_swap_inlineToHeap();
+
+      // Iterator
+      test_iterator_sum();
+
+      // Insert
+      test_pushback_fillInline();
+      test_pushback_spill();
+      test_pushback_spillOwnElement();
+      test_pushback_growOwnElement();
+      test_emplaceback_inPlace();
+      test_insert_middleInline();
+      test_insert_rangeSpill();
+
+      // Remove
+      test_shrinkToFit_backInline();
+      test_clear_heap();
+      test_erase_range();
+
+      report("SmallVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> v;
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(v.is_inline());
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 0);
+   }  // teardown
+
+   // elements that fit stay in the object
+   void test_construct_fitsInline()
+   {  // setup
+      // exercise
+      custom::small_vector<int, 4> v{26, 49, 67};
+      // verify
+      assertUnit(v.is_inline());
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 3);
+      assertUnit(v[0] == 26);
+      assertUnit(v[1] == 49);
+      assertUnit(v[2] == 67);
+   }  // teardown
+
+   // more elements than slots goes to the heap
+   void test_construct_spills()
+   {  // setup
+      // exercise
+      custom::small_vector<int, 2> v(5, 99);
+      // verify
+      assertUnit(!v.is_inline());
+      assertUnit(v.numCapacity == 5);
+      assertUnit(v.numElements == 5);
+      assertUnit(v[0] == 99);
+      assertUnit(v[4] == 99);
+   }  // teardown
+
+   // copying an inline small vector copies each element into our slots
+   void test_constructCopy_inline()
+   {  // setup
+      custom::small_vector<Spy, 4> vSrc;
+      vSrc.push_back(Spy(26));
+      vSrc.push_back(Spy(49));
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> vDest(vSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 2);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(vDest.is_inline());
+      assertUnit(vDest.numElements == 2);
+      assertUnit(vDest[0] == Spy(26));
+      assertUnit(vDest[1] == Spy(49));
+      assertUnit(vSrc.numElements == 2);
+   }  // teardown
+
+   // inline elements cannot be stolen, they are moved one by one
+   void test_constructMove_inline()
+   {  // setup
+      custom::small_vector<Spy, 4> vSrc;
+      vSrc.push_back(Spy(26));
+      vSrc.push_back(Spy(49));
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> vDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numCopyMove() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(vDest.is_inline());
+      assertUnit(vDest.numElements == 2);
+      assertUnit(vDest[0] == Spy(26));
+      assertUnit(vDest[1] == Spy(49));
+      assertUnit(vSrc.is_inline());
+      assertUnit(vSrc.numElements == 0);
+   }  // teardown
+
+   // a heap buffer is stolen without touching the elements
+   void test_constructMove_heap()
+   {  // setup
+      custom::small_vector<Spy, 2> vSrc;
+      vSrc.push_back(Spy(26));
+      vSrc.push_back(Spy(49));
+      vSrc.push_back(Spy(67));
+      Spy * p = vSrc.data;
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 2> vDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(vDest.data == p);
+      assertUnit(vDest.numElements == 3);
+      assertUnit(vDest.numCapacity == 4);
+      assertUnit(vSrc.is_inline());
+      assertUnit(vSrc.numElements == 0);
+      assertUnit(vSrc.numCapacity == 2);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // moving inline elements onto a heap vector keeps them in order
+   void test_assignMove_inlineToHeap()
+   {  // setup
+      custom::small_vector<int, 2> vSrc{26};
+      custom::small_vector<int, 2> vDest{11, 22, 33};
+      // exercise
+      vDest = std::move(vSrc);
+      // verify
+      assertUnit(vDest.numElements == 1);
+      assertUnit(vDest[0] == 26);
+      assertUnit(vSrc.numElements == 0);
+      assertUnit(vSrc.is_inline());
+   }  // teardown
+
+   // swap one inline and one heap small vector
+   void test_swap_inlineToHeap()
+   {  // setup
+      custom::small_vector<int, 2> v1{26};
+      custom::small_vector<int, 2> v2{11, 22, 33};
+      // exercise
+      v1.swap(v2);
+      // verify
+      assertUnit(!v1.is_inline());
+      assertUnit(v1.numElements == 3);
+      assertUnit(v1[0] == 11);
+      assertUnit(v1[2] == 33);
+      assertUnit(v2.is_inline());
+      assertUnit(v2.numElements == 1);
+      assertUnit(v2[0] == 26);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // the vector iterator walks the inline slots
+   void test_iterator_sum()
+   {  // setup
+      custom::small_vector<int, 4> v{26, 49, 67};
+      int sum = 0;
+      // exercise
+      for (custom::small_vector<int, 4>::iterator it = v.begin(); it != v.end(); ++it)
+         sum += *it;
+      // verify
+      assertUnit(sum == 26 + 49 + 67);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // filling every inline slot never allocates
+   void test_pushback_fillInline()
+   {  // setup
+      custom::small_vector<Spy, 3> v;
+      Spy::reset();
+      // exercise
+      v.push_back(Spy(26));
+      v.push_back(Spy(49));
+      v.push_back(Spy(67));
+      // verify
+      assertUnit(Spy::numCopyMove() == 3);  // straight into the slots
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(v.is_inline());
+      assertUnit(v.numCapacity == 3);
+      assertUnit(v.numElements == 3);
+   }  // teardown
+
+   // one past the inline slots moves everything to a 2N heap buffer
+   void test_pushback_spill()
+   {  // setup
+      custom::small_vector<Spy, 2> v;
+      v.push_back(Spy(26));
+      v.push_back(Spy(49));
+      Spy s(67);
+      Spy::reset();
+      // exercise
+      v.push_back(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numCopyMove() == 2);
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(!v.is_inline());
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 3);
+      if (v.numElements == 3)
+      {
+         assertUnit(v[0] == Spy(26));
+         assertUnit(v[1] == Spy(49));
+         assertUnit(v[2] == Spy(67));
+      }
+   }  // teardown
+
+   // pushing one of our own elements as we spill copies it before it moves
+   void test_pushback_spillOwnElement()
+   {  // setup
+      custom::small_vector<std::string, 2> v;
+      v.push_back(std::string("twenty-six"));
+      v.push_back(std::string("forty-nine"));
+      // exercise
+      v.push_back(v[0]);
+      // verify
+      assertUnit(!v.is_inline());
+      assertUnit(v.numElements == 3);
+      if (v.numElements == 3)
+      {
+         assertUnit(v[0] == "twenty-six");
+         assertUnit(v[2] == "twenty-six");
+      }
+   }  // teardown
+
+   // the same when the old buffer is already on the heap and gets freed
+   void test_pushback_growOwnElement()
+   {  // setup
+      custom::small_vector<std::string, 2> v;
+      v.push_back(std::string("twenty-six"));
+      v.push_back(std::string("forty-nine"));
+      v.push_back(std::string("sixty-seven"));
+      v.push_back(std::string("eighty-nine"));
+      // exercise
+      v.push_back(v[3]);
+      v.push_back(std::move(v[0]));
+      // verify
+      assertUnit(v.numCapacity == 8);
+      assertUnit(v.numElements == 6);
+      if (v.numElements == 6)
+      {
+         assertUnit(v[4] == "eighty-nine");
+         assertUnit(v[5] == "twenty-six");
+      }
+   }  // teardown
+
+   // emplace_back builds the element in its inline slot: no temporary
+   void test_emplaceback_inPlace()
+   {  // setup
+      custom::small_vector<Spy, 2> v;
+      Spy::reset();
+      // exercise
+      v.emplace_back(26);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.is_inline());
+      assertUnit(v.numElements == 1);
+      if (v.numElements == 1)
+         assertUnit(v[0] == Spy(26));
+   }  // teardown
+
+   // insert one element in front of 49, shifting inside the object
+   void test_insert_middleInline()
+   {  // setup
+      custom::small_vector<int, 4> v{26, 49, 67};
+      // exercise
+      custom::small_vector<int, 4>::iterator it = v.insert(v.begin() + 1, 11);
+      // verify
+      assertUnit(it == v.begin() + 1);
+      assertUnit(v.is_inline());
+      assertUnit(v.numElements == 4);
+      if (v.numElements == 4)
+      {
+         assertUnit(v[0] == 26);
+         assertUnit(v[1] == 11);
+         assertUnit(v[2] == 49);
+         assertUnit(v[3] == 67);
+      }
+   }  // teardown
+
+   // a range that does not fit spills once, each old element moved once
+   void test_insert_rangeSpill()
+   {  // setup
+      custom::small_vector<Spy, 2> v;
+      v.push_back(Spy(26));
+      v.push_back(Spy(89));
+      std::vector<Spy> src{Spy(49), Spy(67), Spy(75)};
+      Spy::reset();
+      // exercise
+      v.insert(v.begin() + 1, src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numCopy() == 3);
+      assertUnit(Spy::numCopyMove() == 2);
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(!v.is_inline());
+      assertUnit(v.numElements == 5);
+      assertUnit(v.numCapacity == 5);
+      if (v.numElements == 5)
+      {
+         assertUnit(v[0] == Spy(26));
+         assertUnit(v[1] == Spy(49));
+         assertUnit(v[3] == Spy(75));
+         assertUnit(v[4] == Spy(89));
+      }
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // shrinking below N moves the elements back into the object
+   void test_shrinkToFit_backInline()
+   {  // setup
+      custom::small_vector<int, 2> v{26, 49, 67};
+      v.pop_back();
+      // exercise
+      v.shrink_to_fit();
+      // verify
+      assertUnit(v.is_inline());
+      assertUnit(v.numCapacity == 2);
+      assertUnit(v.numElements == 2);
+      assertUnit(v[0] == 26);
+      assertUnit(v[1] == 49);
+   }  // teardown
+
+   // clear keeps the heap buffer, like vector
+   void test_clear_heap()
+   {  // setup
+      custom::small_vector<Spy, 2> v;
+      v.push_back(Spy(26));
+      v.push_back(Spy(49));
+      v.push_back(Spy(67));
+      Spy::reset();
+      // exercise
+      v.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(!v.is_inline());
+      assertUnit(v.numElements == 0);
+      assertUnit(v.numCapacity == 4);
+   }  // teardown
+
+   // erase two elements: destroy them, then move the tail down once
+   void test_erase_range()
+   {  // setup
+      custom::small_vector<Spy, 4> v{Spy(26), Spy(49), Spy(67), Spy(89)};
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4>::iterator it = v.erase(v.begin() + 1, v.begin() + 3);
+      // verify
+      assertUnit(it == v.begin() + 1);
+      assertUnit(Spy::numDestructor() == 3);  // 49, 67, and the moved-from 89
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(v.is_inline());
+      assertUnit(v.numElements == 2);
+      if (v.numElements == 2)
+      {
+         assertUnit(v[0] == Spy(26));
+         assertUnit(v[1] == Spy(89));
+      }
+   }  // teardown
+};
+
+#endif // DEBUG
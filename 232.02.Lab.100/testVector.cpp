@@ -13,6 +13,17 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testVector.h"     // for the vector unit tests
+#include "testVectorBool.h"  // for the packed vector<bool> unit tests
+#include "testVectorIncremental.h" // for the incremental growth unit tests
+#include "testSmallVector.h" // for the small vector unit tests
+#include "testCowVector.h"   // for the copy-on-write vector unit tests
+#include "testSegmentedVector.h" // for the segmented vector unit tests
+#include "testConcurrentVector.h" // for the concurrent vector unit tests
+#ifndef _WIN32
+#include "testMmapVector.h"  // for the mmap vector unit tests
+#endif
+#include "testSimd.h"        // for the simd kernel unit tests
+#include "testParallel.h"    // for the parallel algorithm unit tests
 #include "testSpy.h"        // for the spy unit tests
 int Spy::counters[] = {};
 
@@ -27,6 +38,17 @@ int main()
    // unit tests
    TestSpy().run();
    TestVector().run();
+   TestVectorBool().run();
+   TestVectorIncremental().run();
+   TestSmallVector().run();
+   TestCowVector().run();
+   TestSegmentedVector().run();
+   TestConcurrentVector().run();
+#ifndef _WIN32
+   TestMmapVector().run();
+#endif
+   TestSimd().run();
+   TestParallel().run();
 #endif // DEBUG
    
    return 0;
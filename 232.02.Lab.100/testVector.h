@@ -14,13 +14,50 @@
 #include <vector>
 #include "vector.h"
 #include "unitTest.h"
+#include "spy.h"
 
 
 #include <cassert>
 #include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
 
 #include <iostream>
 
+/*************************************************************
+ * RELOCATABLE SPY
+ * A Spy that has opted into memcpy relocation
+ *************************************************************/
+struct RelocatableSpy
+{
+   RelocatableSpy(int value) : s(value) {}
+   Spy s;
+};
+namespace custom
+{
+   template <>
+   struct is_trivially_relocatable<RelocatableSpy> : std::true_type {};
+}
+
+/*************************************************************
+ * THROWING SPY
+ * A Spy whose copy throws when it holds a negative number
+ *************************************************************/
+struct ThrowingSpy
+{
+   ThrowingSpy(int value) : s(value) {}
+   ThrowingSpy(const ThrowingSpy & rhs) : s(rhs.s)
+   {
+      if (s.get() < 0)
+         throw std::invalid_argument("negative");
+   }
+   Spy s;
+};
+
 class TestVector : public UnitTest
 {
    
@@ -70,6 +107,11 @@ public:
       test_iterator_construct_default();
       test_iterator_construct_pointer();
       test_iterator_construct_index();
+      test_iterator_postfixReturnsOld();
+      test_iterator_randomAccess();
+      test_iterator_traits();
+      test_iterator_constFromConst();
+      test_iterator_standardAlgorithms();
 
       // Access
       test_subscript_read();
@@ -121,6 +163,33 @@ public:
       test_capacity_empty();
       test_capacity_full();
 
+      // Construction counts
+      test_spy_constructFill();
+      test_spy_reserve();
+      test_spy_pushbackReallocate();
+      test_spy_popback();
+      test_spy_clear();
+      test_spy_reserveRelocatable();
+
+      // Insert and erase in the middle
+      test_emplaceback_inPlace();
+      test_emplaceback_fromSelf();
+      test_insert_middle();
+      test_insert_rangeShiftInPlace();
+      test_insert_rangeOneReallocate();
+      test_insert_rangeRelocatable();
+      test_insert_inputIterator();
+      test_insert_rangeThrows();
+      test_erase_middle();
+      test_erase_range();
+
+      // Growth policies and their counters
+      test_growth_doubleStats();
+      test_growth_byHalf();
+      test_growth_pageSmall();
+      test_growth_pageLarge();
+      test_growth_statsStayWithObject();
+
       report("Vector");
    }
    
@@ -261,7 +330,7 @@ public:
          //    | 26 | 49 |    |    |
          //    +----+----+----+----+
          custom::vector<int> v;
-         v.data = new int[4];
+         v.data = std::allocator<int>().allocate(4);
          v.data[0] = 99;
          v.data[1] = 99;
          v.numElements = 2;
@@ -321,7 +390,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[4];
+      vSrc.data = std::allocator<int>().allocate(4);
       vSrc.data[0] = 26;
       vSrc.data[1] = 49;
       vSrc.numElements = 2;
@@ -405,7 +474,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[4];\
+      vSrc.data = std::allocator<int>().allocate(4);\
       vSrc.data[0] = 26;
       vSrc.data[1] = 49;
       vSrc.numElements = 2;
@@ -628,7 +697,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -652,7 +721,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -676,7 +745,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -755,7 +824,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -789,7 +858,7 @@ public:
       //    | 26 | 49 | 67 | 89 |    |    |
       //    +----+----+----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[6];
+      v.data = std::allocator<int>().allocate(6);
       v.data[0] = 26;
       v.data[1] = 49;
       v.data[2] = 67;
@@ -968,7 +1037,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vDest;
-      vDest.data = new int[2];
+      vDest.data = std::allocator<int>().allocate(2);
       vDest.data[0] = 99;
       vDest.data[1] = 99;
       vDest.numElements = 2;
@@ -1000,7 +1069,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[2];
+      vSrc.data = std::allocator<int>().allocate(2);
       vSrc.data[0] = 99;
       vSrc.data[1] = 99;
       vSrc.numElements = 2;
@@ -1105,7 +1174,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vDest;
-      vDest.data = new int[2];
+      vDest.data = std::allocator<int>().allocate(2);
       vDest.data[0] = 99;
       vDest.data[1] = 99;
       vDest.numElements = 2;
@@ -1132,7 +1201,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[2];
+      vSrc.data = std::allocator<int>().allocate(2);
       vSrc.data[0] = 99;
       vSrc.data[1] = 99;
       vSrc.numElements = 2;
@@ -1242,7 +1311,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vDest;
-      vDest.data = new int[2];
+      vDest.data = std::allocator<int>().allocate(2);
       vDest.data[0] = 99;
       vDest.data[1] = 99;
       vDest.numElements = 2;
@@ -1281,7 +1350,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[2];
+      vSrc.data = std::allocator<int>().allocate(2);
       vSrc.data[0] = 99;
       vSrc.data[1] = 99;
       vSrc.numElements = 2;
@@ -1481,7 +1550,7 @@ public:
       //    | 11 | 22 |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.data[0] = 11;
       v.data[1] = 22;
       v.numElements = 2;
@@ -1555,7 +1624,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.data[0] = 26;
       v.data[1] = 49;
       v.numElements = 2;
@@ -1622,7 +1691,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.data[0] = 26;
       v.data[1] = 49;
       v.numElements = 2;
@@ -1680,7 +1749,7 @@ public:
       //    | 26 | 49 | 67 |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.data[0] = 26;
       v.data[1] = 49;
       v.data[2] = 67;
@@ -1710,7 +1779,7 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<int> v;
-      v.data = new int[3];
+      v.data = std::allocator<int>().allocate(3);
       v.data[0] = 26;
       v.data[1] = 49;
       v.data[2] = 67;
@@ -1779,7 +1848,7 @@ public:
       //    | 26 | 49 | 67 |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       
       v.data[0] = 26;
       v.data[1] = 49;
@@ -1812,7 +1881,7 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<int> v;
-      v.data = new int[3];
+      v.data = std::allocator<int>().allocate(3);
       
       v.data[0] = 26;
       v.data[1] = 49;
@@ -2039,7 +2108,531 @@ public:
       teardownStandardFixture(v);
    }
 
-   
+   // postfix moves the iterator but hands back where it was
+   void test_iterator_postfixReturnsOld()
+   {  // setup
+      custom::vector<int> v;
+      setupStandardFixture(v);
+      custom::vector<int>::iterator it(1, v);
+      // exercise
+      custom::vector<int>::iterator before = it++;
+      custom::vector<int>::iterator after = it--;
+      // verify
+      assertUnit(before.p == v.data + 1);
+      assertUnit(after.p == v.data + 2);
+      assertUnit(it.p == v.data + 1);
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // everything a pointer can do
+   void test_iterator_randomAccess()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<int> v;
+      setupStandardFixture(v);
+      custom::vector<int>::iterator it = v.begin();
+      // exercise and verify
+      assertUnit(v.end() - v.begin() == 4);
+      assertUnit(*(it + 2) == 67);
+      assertUnit(*(2 + it) == 67);
+      assertUnit(it[3] == 89);
+      assertUnit(*(v.end() - 1) == 89);
+      assertUnit(it < v.end());
+      assertUnit(v.end() > it);
+      assertUnit(it <= v.begin());
+      assertUnit(it >= v.begin());
+      it += 3;
+      assertUnit(*it == 89);
+      it -= 2;
+      assertUnit(*it == 49);
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // the standard library sees a random access iterator
+   void test_iterator_traits()
+   {
+      typedef std::iterator_traits<custom::vector<int>::iterator> traits;
+      typedef std::iterator_traits<custom::vector<int>::const_iterator> constTraits;
+      assertUnit((std::is_same<traits::iterator_category, std::random_access_iterator_tag>::value));
+      assertUnit((std::is_same<traits::value_type, int>::value));
+      assertUnit((std::is_same<traits::reference, int &>::value));
+      assertUnit((std::is_same<traits::pointer, int *>::value));
+      assertUnit((std::is_same<traits::difference_type, std::ptrdiff_t>::value));
+      assertUnit((std::is_same<constTraits::iterator_category, std::random_access_iterator_tag>::value));
+      assertUnit((std::is_same<constTraits::value_type, int>::value));
+      assertUnit((std::is_same<constTraits::reference, const int &>::value));
+      assertUnit(std::is_trivially_copyable<custom::vector<int>::iterator>::value);
+      assertUnit(std::is_trivially_copyable<custom::vector<int>::const_iterator>::value);
+   }
+
+   // a const vector hands out const iterators, which compare with iterators
+   void test_iterator_constFromConst()
+   {  // setup
+      custom::vector<int> v;
+      setupStandardFixture(v);
+      const custom::vector<int> & cv = v;
+      // exercise
+      custom::vector<int>::const_iterator it = cv.begin();
+      custom::vector<int>::const_iterator fromMutable = v.begin();
+      // verify
+      assertUnit(it.p == v.data);
+      assertUnit(it == fromMutable);
+      assertUnit(v.begin() == it);
+      assertUnit(it != v.end());
+      assertUnit(cv.end() - it == 4);
+      assertUnit(v.cend() == cv.end());
+      assertUnit(*(it + 1) == 49);
+      assertUnit(it[2] == 67);
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // sort, search, and copy from the standard library
+   void test_iterator_standardAlgorithms()
+   {  // setup
+      custom::vector<int> v{89, 26, 67, 49};
+      custom::vector<int> w(4);
+      // exercise
+      std::sort(v.begin(), v.end());
+      std::copy(v.begin(), v.end(), w.begin());
+      std::reverse(w.begin(), w.end());
+      // verify
+      assertUnit(v[0] == 26);
+      assertUnit(v[1] == 49);
+      assertUnit(v[2] == 67);
+      assertUnit(v[3] == 89);
+      assertUnit(std::lower_bound(v.begin(), v.end(), 67) - v.begin() == 2);
+      assertUnit(std::binary_search(v.cbegin(), v.cend(), 49));
+      assertUnit(std::distance(v.begin(), v.end()) == 4);
+      assertUnit(w[0] == 89);
+      assertUnit(w[3] == 26);
+   }
+
+   /***************************************
+    * CONSTRUCTION COUNTS
+    ***************************************/
+
+   // fill constructor copies the value once per element and nothing else
+   void test_spy_constructFill()
+   {  // setup
+      Spy s(99);
+      Spy::reset();
+      {
+         // exercise
+         custom::vector<Spy> v(4, s);
+         // verify
+         assertUnit(Spy::numCopy() == 4);
+         assertUnit(Spy::numDefault() == 0);
+         assertUnit(Spy::numAssign() == 0);
+         assertUnit(v.numElements == 4);
+         assertUnit(v.numCapacity == 4);
+      }  // teardown
+      assertUnit(Spy::numDestructor() == 4);
+   }
+
+   // reserve only allocates: no element is constructed
+   void test_spy_reserve()
+   {  // setup
+      custom::vector<Spy> v;
+      Spy::reset();
+      // exercise
+      v.reserve(10);
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.numCapacity == 10);
+      assertUnit(v.numElements == 0);
+   }  // teardown
+
+   // growing moves each live element exactly once
+   void test_spy_pushbackReallocate()
+   {  // setup
+      custom::vector<Spy> v;
+      v.reserve(2);
+      v.push_back(Spy(26));
+      v.push_back(Spy(49));
+      Spy s(67);
+      Spy::reset();
+      // exercise
+      v.push_back(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);        // copy 67 into the new slot
+      assertUnit(Spy::numCopyMove() == 2);    // move 26 and 49 over
+      assertUnit(Spy::numDestructor() == 2);  // destroy the moved-from pair
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 3);
+   }  // teardown
+
+   // pop_back destroys the last element
+   void test_spy_popback()
+   {  // setup
+      custom::vector<Spy> v{Spy(26), Spy(49)};
+      Spy::reset();
+      // exercise
+      v.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(Spy::numDelete() == 1);
+      assertUnit(v.numElements == 1);
+      assertUnit(v.numCapacity == 2);
+   }  // teardown
+
+   // clear destroys every element but keeps the buffer
+   void test_spy_clear()
+   {  // setup
+      custom::vector<Spy> v{Spy(26), Spy(49), Spy(67)};
+      Spy::reset();
+      // exercise
+      v.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(Spy::numDelete() == 3);
+      assertUnit(v.numElements == 0);
+      assertUnit(v.numCapacity == 3);
+      assertUnit(v.data != nullptr);
+   }  // teardown
+
+
+   // a relocatable type grows with memcpy: no moves and no destructors
+   void test_spy_reserveRelocatable()
+   {  // setup
+      custom::vector<RelocatableSpy> v;
+      v.reserve(2);
+      v.push_back(RelocatableSpy(26));
+      v.push_back(RelocatableSpy(49));
+      Spy::reset();
+      // exercise
+      v.reserve(4);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 2);
+      if (v.numElements == 2)
+      {
+         assertUnit(v.data[0].s.get() == 26);
+         assertUnit(v.data[1].s.get() == 49);
+      }
+   }  // teardown
+
+   /***************************************
+    * INSERT AND ERASE
+    ***************************************/
+
+   // emplace_back builds the element in its slot: no temporary
+   void test_emplaceback_inPlace()
+   {  // setup
+      custom::vector<Spy> v;
+      v.reserve(2);
+      Spy::reset();
+      // exercise
+      v.emplace_back(26);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.numElements == 1);
+      assertUnit(v.numCapacity == 2);
+      if (v.numElements == 1)
+         assertUnit(v.data[0] == Spy(26));
+   }  // teardown
+
+   // growing while copying one of our own elements
+   void test_emplaceback_fromSelf()
+   {  // setup
+      custom::vector<std::string> v{"twenty six", "forty nine"};
+      // exercise
+      v.emplace_back(v[0]);
+      // verify
+      assertUnit(v.numElements == 3);
+      assertUnit(v.numCapacity == 4);
+      if (v.numElements == 3)
+      {
+         assertUnit(v.data[0] == "twenty six");
+         assertUnit(v.data[2] == "twenty six");
+      }
+   }  // teardown
+
+   // insert one element in front of 49
+   void test_insert_middle()
+   {  // setup
+      custom::vector<int> v{26, 49, 67};
+      // exercise
+      custom::vector<int>::iterator it = v.insert(custom::vector<int>::iterator(1, v), 11);
+      // verify
+      assertUnit(it.p == v.data + 1);
+      assertUnit(v.numElements == 4);
+      assertUnit(v.numCapacity == 6);
+      if (v.numElements == 4)
+      {
+         assertUnit(v.data[0] == 26);
+         assertUnit(v.data[1] == 11);
+         assertUnit(v.data[2] == 49);
+         assertUnit(v.data[3] == 67);
+      }
+   }  // teardown
+
+   // a range that fits shifts the tail without a new buffer
+   void test_insert_rangeShiftInPlace()
+   {  // setup
+      custom::vector<int> v;
+      v.reserve(8);
+      v.push_back(26);
+      v.push_back(49);
+      v.push_back(67);
+      int * p = v.data;
+      // exercise
+      v.insert(custom::vector<int>::iterator(1, v), {11, 22});
+      // verify
+      assertUnit(v.data == p);
+      assertUnit(v.numElements == 5);
+      assertUnit(v.numCapacity == 8);
+      if (v.numElements == 5)
+      {
+         assertUnit(v.data[0] == 26);
+         assertUnit(v.data[1] == 11);
+         assertUnit(v.data[2] == 22);
+         assertUnit(v.data[3] == 49);
+         assertUnit(v.data[4] == 67);
+      }
+   }  // teardown
+
+   // a range that does not fit: one new buffer, each old element moved once
+   void test_insert_rangeOneReallocate()
+   {  // setup
+      custom::vector<Spy> v;
+      v.reserve(2);
+      v.push_back(Spy(26));
+      v.push_back(Spy(89));
+      std::vector<Spy> src{Spy(49), Spy(67), Spy(75)};
+      Spy::reset();
+      // exercise
+      v.insert(custom::vector<Spy>::iterator(1, v), src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numCopy() == 3);
+      assertUnit(Spy::numCopyMove() == 2);
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(v.numElements == 5);
+      assertUnit(v.numCapacity == 5);
+      if (v.numElements == 5)
+      {
+         assertUnit(v.data[0] == Spy(26));
+         assertUnit(v.data[1] == Spy(49));
+         assertUnit(v.data[3] == Spy(75));
+         assertUnit(v.data[4] == Spy(89));
+      }
+   }  // teardown
+
+   // a relocatable tail shifts with memmove: no moves and no destructors
+   void test_insert_rangeRelocatable()
+   {  // setup
+      custom::vector<RelocatableSpy> v;
+      v.reserve(4);
+      v.push_back(RelocatableSpy(26));
+      v.push_back(RelocatableSpy(49));
+      std::vector<RelocatableSpy> src{RelocatableSpy(11)};
+      Spy::reset();
+      // exercise
+      v.insert(v.begin(), src.begin(), src.end());
+      // verify
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.numElements == 3);
+      if (v.numElements == 3)
+      {
+         assertUnit(v.data[0].s.get() == 11);
+         assertUnit(v.data[1].s.get() == 26);
+         assertUnit(v.data[2].s.get() == 49);
+      }
+   }  // teardown
+
+   // a one-pass range still lands in order
+   void test_insert_inputIterator()
+   {  // setup
+      custom::vector<int> v{26, 89};
+      std::istringstream sin("49 67");
+      // exercise
+      v.insert(custom::vector<int>::iterator(1, v),
+               std::istream_iterator<int>(sin), std::istream_iterator<int>());
+      // verify
+      assertUnit(v.numElements == 4);
+      if (v.numElements == 4)
+      {
+         assertUnit(v.data[0] == 26);
+         assertUnit(v.data[1] == 49);
+         assertUnit(v.data[2] == 67);
+         assertUnit(v.data[3] == 89);
+      }
+   }  // teardown
+
+   // a copy that throws partway through a reallocation leaves v as it was
+   void test_insert_rangeThrows()
+   {  // setup
+      custom::vector<ThrowingSpy> v;
+      v.reserve(2);
+      v.push_back(ThrowingSpy(26));
+      v.push_back(ThrowingSpy(89));
+      ThrowingSpy * p = v.data;
+      std::vector<ThrowingSpy> src;
+      src.reserve(3);
+      src.emplace_back(49);
+      src.emplace_back(67);
+      src.emplace_back(-1);
+      Spy::reset();
+      // exercise
+      bool thrown = false;
+      try
+      {
+         v.insert(v.begin() + 1, src.begin(), src.end());
+      }
+      catch (const std::invalid_argument &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(Spy::numDelete() == Spy::numAlloc());  // 49 and 67 were destroyed
+      assertUnit(v.data == p);
+      assertUnit(v.numElements == 2);
+      assertUnit(v.numCapacity == 2);
+      if (v.numElements == 2)
+      {
+         assertUnit(v.data[0].s.get() == 26);
+         assertUnit(v.data[1].s.get() == 89);
+      }
+   }  // teardown
+
+   // erase 49 and close the hole
+   void test_erase_middle()
+   {  // setup
+      custom::vector<int> v{26, 49, 67, 89};
+      // exercise
+      custom::vector<int>::iterator it = v.erase(custom::vector<int>::iterator(1, v));
+      // verify
+      assertUnit(it.p == v.data + 1);
+      assertUnit(v.numElements == 3);
+      assertUnit(v.numCapacity == 4);
+      if (v.numElements == 3)
+      {
+         assertUnit(v.data[0] == 26);
+         assertUnit(v.data[1] == 67);
+         assertUnit(v.data[2] == 89);
+      }
+   }  // teardown
+
+   // erase two elements: destroy them, then move the tail down once
+   void test_erase_range()
+   {  // setup
+      custom::vector<Spy> v{Spy(26), Spy(49), Spy(67), Spy(89)};
+      Spy::reset();
+      // exercise
+      v.erase(custom::vector<Spy>::iterator(1, v), custom::vector<Spy>::iterator(3, v));
+      // verify
+      assertUnit(Spy::numDestructor() == 3);  // 49, 67, and the moved-from 89
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(v.numElements == 2);
+      if (v.numElements == 2)
+      {
+         assertUnit(v.data[0] == Spy(26));
+         assertUnit(v.data[1] == Spy(89));
+      }
+   }  // teardown
+
+   /***************************************
+    * GROWTH
+    ***************************************/
+
+   // doubling: 1, 2, 4, 8 for five elements
+   void test_growth_doubleStats()
+   {  // setup
+      custom::vector<int> v;
+      // exercise
+      for (int i = 0; i < 5; i++)
+         v.push_back(i);
+      // verify
+      assertUnit(v.numCapacity == 8);
+      assertUnit(v.stats().reallocations == 4);
+      assertUnit(v.stats().bytesCopied == (0 + 1 + 2 + 4) * sizeof(int));
+      assertUnit(v.stats().peakCapacity == 8);
+   }  // teardown
+
+   // half again each time: 1, 2, 3, 4, 6, 9, 13
+   void test_growth_byHalf()
+   {  // setup
+      custom::vector<int, std::allocator<int>, custom::grow_by_half> v;
+      // exercise
+      for (int i = 0; i < 10; i++)
+         v.push_back(i);
+      // verify
+      assertUnit(v.numCapacity == 13);
+      assertUnit(v.numElements == 10);
+      assertUnit(v.stats().reallocations == 7);
+      assertUnit(v.stats().peakCapacity == 13);
+      if (v.numElements == 10)
+         assertUnit(v.data[9] == 9);
+   }  // teardown
+
+   // small buffers round up to a power of two, at least 16 bytes
+   void test_growth_pageSmall()
+   {  // setup
+      custom::vector<int, std::allocator<int>, custom::grow_page> v;
+      // exercise
+      v.push_back(26);
+      // verify
+      assertUnit(v.numCapacity == 16 / sizeof(int));
+      // exercise
+      for (size_t i = v.numElements; i <= 16 / sizeof(int); i++)
+         v.push_back(49);
+      // verify
+      assertUnit(v.numCapacity == 32 / sizeof(int));
+   }  // teardown
+
+   // big buffers round up to whole pages
+   void test_growth_pageLarge()
+   {  // setup
+      custom::vector<int, std::allocator<int>, custom::grow_page> v;
+      v.reserve(4096 / sizeof(int));
+      v.resize(4096 / sizeof(int));
+      // exercise
+      v.push_back(26);
+      // verify
+      assertUnit(v.numCapacity == 8192 / sizeof(int));
+      assertUnit(v.stats().bytesCopied == 4096);
+   }  // teardown
+
+   // moving the buffer out does not take the counters with it
+   void test_growth_statsStayWithObject()
+   {  // setup
+      custom::vector<int> vSrc;
+      for (int i = 0; i < 5; i++)
+         vSrc.push_back(i);
+      // exercise
+      custom::vector<int> vDest(std::move(vSrc));
+      // verify
+      assertUnit(vDest.stats().reallocations == 0);
+      assertUnit(vDest.stats().peakCapacity == 8);
+      assertUnit(vSrc.stats().reallocations == 4);
+      assertUnit(vSrc.stats().peakCapacity == 8);
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *      0    1    2    3
@@ -2052,7 +2645,7 @@ public:
       
       try
       {
-         v.data = new int[4];
+         v.data = std::allocator<int>().allocate(4);
          v.data[0] = 26;
          v.data[1] = 49;
          v.data[2] = 67;
@@ -0,0 +1,277 @@
+/***********************************************************************
+ * Header:
+ *    TEST VECTOR BOOL
+ * Summary:
+ *    Unit tests for the packed vector<bool>
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "vector.h"
+#include "unitTest.h"
+
+#include <algorithm>
+#include <cassert>
+
+class TestVectorBool : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_packed();
+      test_construct_fillTrue();
+      test_constructCopy_words();
+
+      // Access
+      test_reference_writesOneBit();
+      test_iterator_walksBits();
+
+      // Insert and remove
+      test_pushback_crossesWord();
+      test_resize_keepsTailClear();
+      test_popback_clearsBit();
+
+      // Word operations
+      test_count_acrossWords();
+      test_findNext_everyBit();
+      test_findNext_none();
+      test_bitwise_andOrXor();
+      test_flip_tailStaysClear();
+
+      report("VectorBool");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // 130 flags need three words, not 130 bytes
+   void test_construct_packed()
+   {  // setup
+      // exercise
+      custom::vector<bool> v(130);
+      // verify
+      assertUnit(v.size() == 130);
+      assertUnit(v.numWords == 3);
+      assertUnit(v.capacity() == 192);
+      assertUnit(v.words[0] == 0);
+      assertUnit(v.words[2] == 0);
+      assertUnit(v.count() == 0);
+   }  // teardown
+
+   // filling with true sets whole words and leaves the tail clear
+   void test_construct_fillTrue()
+   {  // setup
+      // exercise
+      custom::vector<bool> v(70, true);
+      custom::vector<bool> l{true, false, true};
+      // verify
+      assertUnit(v.words[0] == ~uint64_t(0));
+      assertUnit(v.words[1] == 0x3F);          // bits 64 through 69
+      assertUnit(v.count() == 70);
+      assertUnit(l.size() == 3);
+      assertUnit(l.words[0] == 0x5);
+   }  // teardown
+
+   // copying copies the words
+   void test_constructCopy_words()
+   {  // setup
+      custom::vector<bool> src(100);
+      src[3] = true;
+      src[99] = true;
+      // exercise
+      custom::vector<bool> dest(src);
+      custom::vector<bool> assigned;
+      assigned = src;
+      // verify
+      assertUnit(dest.size() == 100);
+      assertUnit(dest.words != src.words);
+      assertUnit(dest[3] && dest[99] && !dest[4]);
+      assertUnit(assigned.count() == 2);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // a proxy reference changes its own bit and nothing else
+   void test_reference_writesOneBit()
+   {  // setup
+      custom::vector<bool> v(128);
+      // exercise
+      v[65] = true;
+      v[0] = v[65];
+      v[1] = true;
+      v[1].flip();
+      custom::vector<bool>::reference r = v.back();
+      r = true;
+      // verify
+      assertUnit(v.words[0] == 0x1);
+      assertUnit(v.words[1] == ((uint64_t(1) << 1) | (uint64_t(1) << 63)));
+      assertUnit(v[65]);
+      assertUnit(!v[1]);
+      assertUnit(~v[2]);
+      const custom::vector<bool> & cv = v;
+      assertUnit(cv.front());
+      assertUnit(cv.back());
+   }  // teardown
+
+   // iterators read and write bits, and std algorithms take them
+   void test_iterator_walksBits()
+   {  // setup
+      custom::vector<bool> v{true, false, true, true, false};
+      // exercise
+      size_t num = std::count(v.cbegin(), v.cend(), true);
+      *v.begin() = false;
+      std::reverse(v.begin(), v.end());
+      // verify
+      assertUnit(num == 3);
+      assertUnit(v.end() - v.begin() == 5);
+      assertUnit(!v[0] && v[1] && v[2] && !v[3] && !v[4]);
+      custom::vector<bool>::const_iterator it = v.begin();
+      assertUnit(it[2]);
+      assertUnit(it == v.cbegin());
+   }  // teardown
+
+   /***************************************
+    * INSERT AND REMOVE
+    ***************************************/
+
+   // push_back into the next word and grow by the policy
+   void test_pushback_crossesWord()
+   {  // setup
+      custom::vector<bool> v;
+      // exercise
+      for (size_t i = 0; i < 200; i++)
+         v.push_back(i % 3 == 0);
+      // verify
+      assertUnit(v.size() == 200);
+      assertUnit(v.numWords == 4);
+      assertUnit(v.count() == 67);
+      assertUnit(v[198]);
+      assertUnit(!v[199]);
+      assertUnit(v.stats().reallocations == 2);  // 1 word, 2, then 4
+   }  // teardown
+
+   // shrink then grow: the flags that come back are the new value
+   void test_resize_keepsTailClear()
+   {  // setup
+      custom::vector<bool> v(100, true);
+      // exercise
+      v.resize(10);
+      v.resize(80);
+      // verify
+      assertUnit(v.count() == 10);
+      assertUnit(v.words[0] == 0x3FF);
+      assertUnit(v.words[1] == 0);
+      v.resize(90, true);
+      assertUnit(v.count() == 20);
+      assertUnit(v.find_next(10) == 80);
+   }  // teardown
+
+   // a popped flag is cleared, so pushing false really gives false
+   void test_popback_clearsBit()
+   {  // setup
+      custom::vector<bool> v(3, true);
+      // exercise
+      v.pop_back();
+      v.push_back(false);
+      // verify
+      assertUnit(v.size() == 3);
+      assertUnit(!v[2]);
+      assertUnit(v.count() == 2);
+   }  // teardown
+
+   /***************************************
+    * WORD OPERATIONS
+    ***************************************/
+
+   // count adds up one popcount per word
+   void test_count_acrossWords()
+   {  // setup
+      custom::vector<bool> v(1000);
+      for (size_t i = 0; i < v.size(); i += 7)
+         v[i] = true;
+      // exercise and verify
+      assertUnit(v.count() == 143);
+      assertUnit(custom::vector<bool>().count() == 0);
+   }  // teardown
+
+   // find_next reaches every set bit, in order, across words
+   void test_findNext_everyBit()
+   {  // setup
+      custom::vector<bool> v(300);
+      size_t positions[] = {0, 5, 63, 64, 130, 299};
+      for (size_t i : positions)
+         v[i] = true;
+      // exercise
+      size_t found[6] = {};
+      size_t num = 0;
+      for (size_t i = v.find_first(); i < v.size() && num < 6; i = v.find_next(i + 1))
+         found[num++] = i;
+      // verify
+      assertUnit(num == 6);
+      assertUnit(std::equal(found, found + 6, positions));
+      assertUnit(v.find_next(300) == 300);
+      assertUnit(v.find_next(131) == 299);
+   }  // teardown
+
+   // nothing set: find returns size(), and none() agrees
+   void test_findNext_none()
+   {  // setup
+      custom::vector<bool> v(150);
+      custom::vector<bool> empty;
+      // exercise and verify
+      assertUnit(v.find_first() == 150);
+      assertUnit(v.none());
+      assertUnit(empty.find_first() == 0);
+      v[149] = true;
+      assertUnit(v.any());
+      assertUnit(v.find_next(100) == 149);
+   }  // teardown
+
+   // and, or, and xor a word at a time
+   void test_bitwise_andOrXor()
+   {  // setup
+      custom::vector<bool> a(100);
+      custom::vector<bool> b(100);
+      for (size_t i = 0; i < 100; i++)
+      {
+         a[i] = (i % 2 == 0);
+         b[i] = (i % 3 == 0);
+      }
+      // exercise
+      custom::vector<bool> both   = a & b;
+      custom::vector<bool> either = a | b;
+      custom::vector<bool> one    = a ^ b;
+      // verify
+      assertUnit(both.count() == 17);      // multiples of 6
+      assertUnit(either.count() == 67);    // 50 + 34 - 17
+      assertUnit(one.count() == 50);
+      assertUnit(both[96] && !both[98]);
+      a &= b;
+      assertUnit(a.count() == 17);
+   }  // teardown
+
+   // flipping leaves the bits past size() clear
+   void test_flip_tailStaysClear()
+   {  // setup
+      custom::vector<bool> v(70);
+      v[3] = true;
+      // exercise
+      v.flip();
+      // verify
+      assertUnit(v.count() == 69);
+      assertUnit(!v[3]);
+      assertUnit(v.words[1] == 0x3F);
+   }  // teardown
+};
+
+#endif // DEBUG
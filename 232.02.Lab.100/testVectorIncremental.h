@@ -0,0 +1,299 @@
+/***********************************************************************
+ * Header:
+ *    TEST VECTOR INCREMENTAL
+ * Summary:
+ *    Unit tests for the vector specialization that grows a few
+ *    elements at a time
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "vector.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <algorithm>
+#include <cassert>
+
+class TestVectorIncremental : public UnitTest
+{
+   typedef custom::vector<int, std::allocator<int>, custom::grow_incremental<>> IntVector;
+   typedef custom::vector<Spy, std::allocator<Spy>, custom::grow_incremental<>> SpyVector;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_contiguous();
+      test_constructCopy_contiguous();
+      test_constructMove_takesDrain();
+
+      // Insert
+      test_pushback_keepsOldBuffer();
+      test_pushback_boundedMoves();
+      test_pushback_drainedBeforeFull();
+      test_pushback_selfReference();
+      test_reserve_drainsLater();
+      test_resize_drainsForEach();
+
+      // Remove
+      test_popback_intoPending();
+      test_clear_freesOld();
+      test_shrinkToFit_exact();
+
+      // Iterator
+      test_iterator_acrossBuffers();
+
+      report("VectorIncremental");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a filled vector starts with nothing to drain
+   void test_construct_contiguous()
+   {  // setup
+      // exercise
+      IntVector v(10, 26);
+      IntVector l{26, 49, 67};
+      // verify
+      assertUnit(v.size() == 10);
+      assertUnit(v.pending() == 0);
+      assertUnit(v.old == nullptr);
+      assertUnit(v[9] == 26);
+      assertUnit(l.size() == 3);
+      assertUnit(l.back() == 67);
+      assertUnit(l.pending() == 0);
+   }  // teardown
+
+   // copying a vector mid-drain gives one contiguous buffer
+   void test_constructCopy_contiguous()
+   {  // setup
+      IntVector src;
+      for (int i = 0; i < 65; i++)
+         src.push_back(i);
+      assert(src.pending() > 0);
+      // exercise
+      IntVector dest(src);
+      // verify
+      assertUnit(dest.size() == 65);
+      assertUnit(dest.pending() == 0);
+      assertUnit(dest.capacity() == 65);
+      assertUnit(dest[0] == 0);
+      assertUnit(dest[64] == 64);
+   }  // teardown
+
+   // moving takes both buffers and the drain under way
+   void test_constructMove_takesDrain()
+   {  // setup
+      IntVector src;
+      for (int i = 0; i < 65; i++)
+         src.push_back(i);
+      size_t pending = src.pending();
+      int * old = src.old;
+      // exercise
+      IntVector dest(std::move(src));
+      // verify
+      assertUnit(dest.pending() == pending);
+      assertUnit(dest.old == old);
+      assertUnit(dest[0] == 0);
+      assertUnit(src.size() == 0);
+      assertUnit(src.old == nullptr);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // growing leaves the elements in the old buffer and moves one step
+   void test_pushback_keepsOldBuffer()
+   {  // setup
+      IntVector v{0, 1, 2, 3, 4, 5, 6, 7};
+      int * first = v.data;
+      // exercise
+      v.push_back(8);
+      // verify
+      assertUnit(v.capacity() == 16);
+      assertUnit(v.old == first);
+      assertUnit(v.step == 4);
+      assertUnit(v.pending() == 4);
+      assertUnit(&v[0] == first);
+      assertUnit(&v[4] == v.data + 4);
+      assertUnit(v[8] == 8);
+      assertUnit(v.stats().reallocations == 2);
+   }  // teardown
+
+   // no push moves more than a step's worth of elements
+   void test_pushback_boundedMoves()
+   {  // setup
+      SpyVector v;
+      size_t most = 0;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         Spy s(i);
+         Spy::reset();
+         v.push_back(std::move(s));
+         size_t moved = Spy::numCopyMove() - 1;
+         most = std::max(most, moved);
+      }
+      // verify
+      assertUnit(most == 4);
+      assertUnit(v.size() == 1000);
+      assertUnit(v[0] == Spy(0));
+      assertUnit(v[999] == Spy(999));
+   }  // teardown
+
+   // the old buffer is always empty by the time the new one fills
+   void test_pushback_drainedBeforeFull()
+   {  // setup
+      custom::vector<int, std::allocator<int>, custom::grow_incremental<custom::grow_by_half, 1>> v;
+      bool drained = true;
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         if (v.size() == v.capacity())
+            drained = drained && v.pending() == 0;
+         v.push_back(i);
+      }
+      // verify
+      assertUnit(drained);
+      assertUnit(v.step >= 2);
+      assertUnit(v.stats().bytesCopied > 0);
+   }  // teardown
+
+   // pushing an element of the vector itself, in either buffer
+   void test_pushback_selfReference()
+   {  // setup
+      IntVector v{26, 49, 67, 89};
+      // exercise
+      v.push_back(v[0]);
+      v.push_back(v[1]);
+      // verify
+      assertUnit(v.size() == 6);
+      assertUnit(v[4] == 26);
+      assertUnit(v[5] == 49);
+      assertUnit(v[1] == 49);
+   }  // teardown
+
+   // reserve allocates now and moves the elements over the pushes to come
+   void test_reserve_drainsLater()
+   {  // setup
+      IntVector v(40, 26);
+      // exercise
+      v.reserve(50);
+      // verify
+      assertUnit(v.capacity() == 50);
+      assertUnit(v.pending() == 40);
+      assertUnit(v.step == 4);
+      v.push_back(1);
+      assertUnit(v.pending() == 36);
+      v.finish();
+      assertUnit(v.pending() == 0);
+      assertUnit(v.old == nullptr);
+      assertUnit(v[39] == 26);
+      assertUnit(v[40] == 1);
+   }  // teardown
+
+   // growing by resize moves a step for every new element
+   void test_resize_drainsForEach()
+   {  // setup
+      IntVector v(100, 26);
+      // exercise
+      v.resize(110, 49);
+      // verify
+      assertUnit(v.size() == 110);
+      assertUnit(v.pending() == 0);
+      assertUnit(v.step == 10);
+      assertUnit(v[99] == 26);
+      assertUnit(v[100] == 49);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // popping past the new buffer reaches into the old one
+   void test_popback_intoPending()
+   {  // setup
+      SpyVector v;
+      for (int i = 0; i < 9; i++)
+         v.emplace_back(i);
+      assert(v.pending() == 4);
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 6; i++)
+         v.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 6);
+      assertUnit(v.size() == 3);
+      assertUnit(v.pending() == 3);
+      assertUnit(v[2] == Spy(2));
+   }  // teardown
+
+   // clearing mid-drain frees the old buffer and keeps the new one
+   void test_clear_freesOld()
+   {  // setup
+      SpyVector v;
+      for (int i = 0; i < 9; i++)
+         v.emplace_back(i);
+      Spy::reset();
+      // exercise
+      v.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 9);
+      assertUnit(v.old == nullptr);
+      assertUnit(v.pending() == 0);
+      assertUnit(v.capacity() == 16);
+   }  // teardown
+
+   // shrink_to_fit drains what is left into an exact buffer
+   void test_shrinkToFit_exact()
+   {  // setup
+      IntVector v;
+      for (int i = 0; i < 9; i++)
+         v.push_back(i);
+      // exercise
+      v.shrink_to_fit();
+      // verify
+      assertUnit(v.capacity() == 9);
+      assertUnit(v.pending() == 0);
+      assertUnit(v.old == nullptr);
+      assertUnit(v[0] == 0);
+      assertUnit(v[8] == 8);
+      v.clear();
+      v.shrink_to_fit();
+      assertUnit(v.capacity() == 0);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // the iterators and the algorithms see one sequence across both buffers
+   void test_iterator_acrossBuffers()
+   {  // setup
+      IntVector v;
+      for (int i = 64; i >= 0; i--)
+         v.push_back(i);
+      assert(v.pending() > 0);
+      // exercise
+      std::sort(v.begin(), v.end());
+      // verify
+      assertUnit(v[0] == 0);
+      assertUnit(v[64] == 64);
+      assertUnit(std::is_sorted(v.cbegin(), v.cend()));
+      assertUnit(std::lower_bound(v.cbegin(), v.cend(), 40) - v.cbegin() == 40);
+      IntVector::const_iterator it = v.begin();
+      assertUnit(it[10] == 10);
+   }  // teardown
+};
+
+#endif // DEBUG
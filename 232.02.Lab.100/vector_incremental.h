@@ -0,0 +1,687 @@
+/***********************************************************************
+ * Header:
+ *    VECTOR INCREMENTAL
+ * Summary:
+ *    The vector specialization for the grow_incremental policy.  When
+ *    the buffer is full, the plain vector moves every element to the
+ *    new buffer inside one push_back, so that one push costs O(n).
+ *    This one allocates the new buffer and leaves the elements where
+ *    they are.  Each push that follows moves a few of them over, from
+ *    the top down, until the old buffer is empty and is freed.  No
+ *    push moves more than a step's worth of elements, at the price of
+ *    holding both buffers for a while and one compare on each access:
+ *
+ *        [0, numPending)            still in the old buffer
+ *        [numPending, numElements)  in the new buffer
+ *
+ *    The step is chosen when the buffer grows so the move always
+ *    finishes before the new buffer fills, whatever the policy.  Only
+ *    push_back() and emplace_back() are bounded this way: reserve() and
+ *    a growing resize() also leave the elements where they are, but
+ *    they finish any move still under way first, so in the middle of
+ *    one they are O(n).  Because the elements are in two buffers the
+ *    iterators are indices, not pointers.  shrink_to_fit() and copying
+ *    still touch every element.
+ *
+ *    This bounds the copying, not the whole cost of growing.  The push
+ *    that moves the last old element also frees the old buffer, and
+ *    handing a big block back to the system takes time in proportion
+ *    to its pages: a few ms for tens of MB, against tens of ms for the
+ *    copy it replaces.  And since the new buffer is now written at both
+ *    ends, its page faults land on more of the pushes, so p99 and p99.9
+ *    are a little worse than the plain vector's.  benchmarkLatency.cpp
+ *    measures both.
+ *
+ *    vector.h includes this at the bottom; there is no need to
+ *    include it directly.  vector<bool> with this policy matches both
+ *    specializations and will not compile.
+ *
+ *    This will contain the class definition of:
+ *        vector<T, A, grow_incremental>                 : a vector that grows in steps
+ *        vector<T, A, grow_incremental>::iterator       : an iterator through it
+ *        vector<T, A, grow_incremental>::const_iterator : the same, read only
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include "vector.h"
+
+class TestVectorIncremental; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * VECTOR INCREMENTAL
+ * The vector interface, with the old buffer kept live
+ * and drained a few elements per push after growing.
+ ****************************************/
+template <typename T, typename A, typename G, size_t K>
+class vector <T, A, grow_incremental<G, K>>
+{
+   friend class ::TestVectorIncremental; // give unit tests access to the privates
+   using policy = grow_incremental<G, K>;
+public:
+   using value_type     = T;
+   using allocator_type = A;
+
+   //
+   // Construct
+   //
+
+   vector(const A & a = A());
+   vector(size_t numElements,                const A & a = A());
+   vector(size_t numElements, const T& t,    const A & a = A());
+   vector(const std::initializer_list<T>& l, const A & a = A());
+   vector(const vector &  rhs);
+   vector(      vector && rhs);
+   ~vector() { release(); }
+
+   //
+   // Assign
+   //
+
+   void swap(vector& rhs)
+   {
+      // unequal allocators that do not propagate cannot trade buffers
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+      std::swap(data, rhs.data);
+      std::swap(numCapacity, rhs.numCapacity);
+      std::swap(numElements, rhs.numElements);
+      std::swap(old, rhs.old);
+      std::swap(oldCapacity, rhs.oldCapacity);
+      std::swap(numPending, rhs.numPending);
+      std::swap(step, rhs.step);
+   }
+   vector & operator = (const vector & rhs);
+   vector & operator = (vector && rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   class const_iterator;
+   iterator       begin()        { return iterator(this, 0);                  }
+   iterator       end()          { return iterator(this, numElements);        }
+   const_iterator begin()  const { return const_iterator(this, 0);            }
+   const_iterator end()    const { return const_iterator(this, numElements);  }
+   const_iterator cbegin() const { return const_iterator(this, 0);            }
+   const_iterator cend()   const { return const_iterator(this, numElements);  }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index)       { assert(index < numElements); return slot(index); }
+   const T& operator [] (size_t index) const { assert(index < numElements); return slot(index); }
+         T& front()       { assert(numElements > 0); return slot(0);               }
+   const T& front() const { assert(numElements > 0); return slot(0);               }
+         T& back()        { assert(numElements > 0); return slot(numElements - 1); }
+   const T& back()  const { assert(numElements > 0); return slot(numElements - 1); }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T& t) { emplace_back(t);            }
+   void push_back(T&& t)      { emplace_back(std::move(t)); }
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   void reserve(size_t newCapacity);
+   void resize(size_t newElements);
+   void resize(size_t newElements, const T& t);
+
+   //
+   // Remove
+   //
+
+   void clear()
+   {
+      destroy(0, numElements);
+      numElements = 0;
+      dropPending();
+   }
+   void pop_back()
+   {
+      if (numElements > 0)
+      {
+         destroy(numElements - 1, numElements);
+         numElements--;
+         dropPending();
+      }
+   }
+   void shrink_to_fit();
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return numElements; }
+   size_t  capacity()      const { return numCapacity; }
+   bool empty()            const { return (numElements == 0); }
+   A    get_allocator()    const { return alloc; }
+
+   // how the growth policy has done for this vector
+   const growth_stats & stats() const { return telemetry;          }
+   void reset_stats()                 { telemetry = growth_stats(); notePeak(); }
+
+   // incremental-specific interfaces
+
+   // elements still waiting in the old buffer
+   size_t pending() const { return numPending; }
+
+   // move everything that is left, so the elements are contiguous
+   void finish() { migrate(numPending); }
+
+private:
+
+   using traits = std::allocator_traits<A>;
+
+   // hand over the allocator only when its traits say to
+   void copyAlloc(const A & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const A &,     std::false_type) {                         }
+   void moveAlloc(A & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(A &,           std::false_type) {                         }
+   void swapAlloc(A & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(A &,           std::false_type) {                         }
+
+   // where the element at index lives right now
+   T & slot(size_t index) const
+   {
+      return index < numPending ? old[index] : data[index];
+   }
+
+   // call the destructor on the elements [begin, end), in either buffer
+   void destroy(size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         traits::destroy(alloc, &slot(i));
+   }
+
+   // allocate newCapacity and start moving into it
+   void grow(size_t newCapacity);
+
+   // move up to num elements from the old buffer to the new one
+   void migrate(size_t num);
+   void migrate(size_t num, std::true_type);
+   void migrate(size_t num, std::false_type);
+
+   // after a shrink fewer elements may be waiting; free the old buffer once none are
+   void dropPending()
+   {
+      if (numPending > numElements)
+         numPending = numElements;
+      if (numPending == 0 && old)
+      {
+         traits::deallocate(alloc, old, oldCapacity);
+         old = nullptr;
+         oldCapacity = 0;
+      }
+   }
+
+   // free both buffers, leaving an empty vector with no capacity
+   void release()
+   {
+      clear();
+      if (data)
+         traits::deallocate(alloc, data, numCapacity);
+      data = nullptr;
+      numCapacity = 0;
+   }
+
+   // remember the biggest the buffer has been
+   void notePeak()
+   {
+      if (numCapacity > telemetry.peakCapacity)
+         telemetry.peakCapacity = numCapacity;
+   }
+
+   A alloc;                   // hands out the raw, unconstructed buffers
+   T *  data;                 // the new buffer, where every element ends up
+   size_t  numCapacity;       // the capacity of data
+   size_t  numElements;       // the number of items currently used
+   T *  old;                  // the buffer being drained, or nullptr
+   size_t  oldCapacity;       // the capacity of old
+   size_t  numPending;        // elements [0, numPending) are still in old
+   size_t  step;              // how many to move on each push
+   growth_stats telemetry;    // reallocations, bytes moved, and peak capacity
+};
+
+/**************************************************
+ * VECTOR INCREMENTAL ITERATOR
+ * The vector and an index.  An element may move from
+ * one buffer to the other while the iterator is held,
+ * so it looks the element up each time.
+ *************************************************/
+template <typename T, typename A, typename G, size_t K>
+class vector <T, A, grow_incremental<G, K>> :: iterator
+{
+   friend class ::TestVectorIncremental;
+   friend class vector <T, A, grow_incremental<G, K>>;
+   friend class const_iterator;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = T *;
+   using reference         = T &;
+
+   iterator() : v(nullptr), index(0) {}
+   iterator(vector * v, size_t index) : v(v), index(index) {}
+
+   // comparison operators
+   bool operator == (const iterator& rhs) const { return index == rhs.index; }
+   bool operator != (const iterator& rhs) const { return index != rhs.index; }
+   bool operator <  (const iterator& rhs) const { return index <  rhs.index; }
+   bool operator >  (const iterator& rhs) const { return index >  rhs.index; }
+   bool operator <= (const iterator& rhs) const { return index <= rhs.index; }
+   bool operator >= (const iterator& rhs) const { return index >= rhs.index; }
+
+   // dereference operators
+   T& operator *  () const { return v->slot(index);  }
+   T* operator -> () const { return &v->slot(index); }
+   T& operator [] (difference_type n) const { return v->slot(index + n); }
+
+   // increment and decrement
+   iterator& operator ++ ()    { ++index; return *this; }
+   iterator& operator -- ()    { --index; return *this; }
+   iterator  operator ++ (int) { iterator t = *this; ++index; return t; }
+   iterator  operator -- (int) { iterator t = *this; --index; return t; }
+
+   // arithmetic
+   iterator& operator += (difference_type n)       { index += n; return *this; }
+   iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   iterator  operator +  (difference_type n) const { return iterator(v, index + n); }
+   iterator  operator -  (difference_type n) const { return iterator(v, index - n); }
+   difference_type operator - (const iterator& rhs) const
+   {
+      return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index);
+   }
+   friend iterator operator + (difference_type n, const iterator& it) { return it + n; }
+
+private:
+   vector * v;
+   size_t   index;
+};
+
+/**************************************************
+ * VECTOR INCREMENTAL CONST ITERATOR
+ * The same, for reading only
+ *************************************************/
+template <typename T, typename A, typename G, size_t K>
+class vector <T, A, grow_incremental<G, K>> :: const_iterator
+{
+   friend class vector <T, A, grow_incremental<G, K>>;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = const T *;
+   using reference         = const T &;
+
+   const_iterator() : v(nullptr), index(0) {}
+   const_iterator(const vector * v, size_t index) : v(v), index(index) {}
+   const_iterator(const iterator & it) : v(it.v), index(it.index) {}
+
+   // comparison operators; an iterator on either side converts
+   friend bool operator == (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index == rhs.index; }
+   friend bool operator != (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index != rhs.index; }
+   friend bool operator <  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <  rhs.index; }
+   friend bool operator >  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >  rhs.index; }
+   friend bool operator <= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <= rhs.index; }
+   friend bool operator >= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >= rhs.index; }
+
+   // dereference operators
+   const T& operator *  () const { return v->slot(index);  }
+   const T* operator -> () const { return &v->slot(index); }
+   const T& operator [] (difference_type n) const { return v->slot(index + n); }
+
+   // increment and decrement
+   const_iterator& operator ++ ()    { ++index; return *this; }
+   const_iterator& operator -- ()    { --index; return *this; }
+   const_iterator  operator ++ (int) { const_iterator t = *this; ++index; return t; }
+   const_iterator  operator -- (int) { const_iterator t = *this; --index; return t; }
+
+   // arithmetic
+   const_iterator& operator += (difference_type n)       { index += n; return *this; }
+   const_iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   const_iterator  operator +  (difference_type n) const { return const_iterator(v, index + n); }
+   const_iterator  operator -  (difference_type n) const { return const_iterator(v, index - n); }
+   friend difference_type operator - (const const_iterator& lhs, const const_iterator& rhs)
+   {
+      return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+   }
+   friend const_iterator operator + (difference_type n, const const_iterator& it) { return it + n; }
+
+private:
+   const vector * v;
+   size_t         index;
+};
+
+/*****************************************
+ * VECTOR INCREMENTAL :: CONSTRUCTORS
+ * A new vector has nothing to drain
+ ****************************************/
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> :: vector(const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0),
+   old(nullptr), oldCapacity(0), numPending(0), step(K)
+{
+}
+
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> :: vector(size_t num, const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0),
+   old(nullptr), oldCapacity(0), numPending(0), step(K)
+{
+   resize(num);
+}
+
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> :: vector(size_t num, const T & t, const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0),
+   old(nullptr), oldCapacity(0), numPending(0), step(K)
+{
+   resize(num, t);
+}
+
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> :: vector(const std::initializer_list<T> & l, const A & a) :
+   alloc(a), data(nullptr), numCapacity(0), numElements(0),
+   old(nullptr), oldCapacity(0), numPending(0), step(K)
+{
+   reserve(l.size());
+   for (const T & t : l)
+      push_back(t);
+}
+
+/*****************************************
+ * VECTOR INCREMENTAL :: COPY CONSTRUCTOR
+ * The copy is contiguous from the start, wherever
+ * the elements of rhs happen to be
+ ****************************************/
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> :: vector(const vector & rhs) :
+   alloc(traits::select_on_container_copy_construction(rhs.alloc)),
+   data(nullptr), numCapacity(0), numElements(0),
+   old(nullptr), oldCapacity(0), numPending(0), step(K)
+{
+   *this = rhs;
+}
+
+/*****************************************
+ * VECTOR INCREMENTAL :: MOVE CONSTRUCTOR
+ * Steal both buffers, and the move under way with them
+ ****************************************/
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> :: vector(vector && rhs) :
+   alloc(std::move(rhs.alloc)), data(rhs.data), numCapacity(rhs.numCapacity),
+   numElements(rhs.numElements), old(rhs.old), oldCapacity(rhs.oldCapacity),
+   numPending(rhs.numPending), step(rhs.step)
+{
+   notePeak();
+   rhs.data = rhs.old = nullptr;
+   rhs.numCapacity = rhs.numElements = rhs.oldCapacity = rhs.numPending = 0;
+}
+
+/***************************************
+ * VECTOR INCREMENTAL :: GROW
+ * Hand the current buffer over to be drained and make
+ * a fresh one of newCapacity.  The step is at least K,
+ * and big enough that the pending elements are gone by
+ * the time the free slots are used up.  A drain still
+ * under way from the last growth is finished first.
+ * When pushes fill the buffer the step has already
+ * emptied it, but a reserve() or resize() in the middle
+ * of a drain pays O(n) here.
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: grow(size_t newCapacity)
+{
+   assert(newCapacity > numElements);
+   finish();
+   T * newData = traits::allocate(alloc, newCapacity);
+
+   old = data;
+   oldCapacity = numCapacity;
+   numPending = numElements;
+   data = newData;
+   numCapacity = newCapacity;
+
+   size_t free = numCapacity - numElements;
+   step = (numPending + free - 1) / free;
+   if (step < K)
+      step = K;
+
+   telemetry.reallocations++;
+   notePeak();
+   dropPending();
+}
+
+/***************************************
+ * VECTOR INCREMENTAL :: MIGRATE
+ * Move the top num pending elements into the new buffer.
+ * Relocatable types go in one memcpy; anything else moves
+ * one at a time, so a throwing copy leaves every element
+ * in exactly one buffer.
+ *     INPUT  : num how many elements to move, at most
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: migrate(size_t num)
+{
+   if (num > numPending)
+      num = numPending;
+   if (num == 0)
+      return;
+
+   telemetry.bytesCopied += num * sizeof(T);
+   migrate(num, std::integral_constant<bool, is_trivially_relocatable<T>::value>());
+   dropPending();
+}
+
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: migrate(size_t num, std::true_type)
+{
+   numPending -= num;
+   std::memcpy(static_cast<void *>(data + numPending),
+               static_cast<const void *>(old + numPending), num * sizeof(T));
+}
+
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: migrate(size_t num, std::false_type)
+{
+   for (; num > 0; num--)
+   {
+      traits::construct(alloc, data + numPending - 1, std::move_if_noexcept(old[numPending - 1]));
+      traits::destroy(alloc, old + numPending - 1);
+      numPending--;
+   }
+}
+
+/***************************************
+ * VECTOR INCREMENTAL :: EMPLACE BACK
+ * Grow when full, build the new element, then move one
+ * step's worth of old elements.  The element is built
+ * before anything moves, so args may refer to an element.
+ *     INPUT  : args the constructor parameters
+ *     OUTPUT : the new element
+ **************************************/
+template <typename T, typename A, typename G, size_t K>
+template <class ... Args>
+T & vector <T, A, grow_incremental<G, K>> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+      grow(policy::next(numCapacity, numElements + 1, sizeof(T)));
+
+   traits::construct(alloc, data + numElements, std::forward<Args>(args)...);
+   numElements++;
+   migrate(step);
+   return data[numElements - 1];
+}
+
+/***************************************
+ * VECTOR INCREMENTAL :: RESERVE
+ * A bigger buffer now, filled over the pushes to come.
+ * Whatever is left of a drain moves over first, so
+ * this is O(n) if one is under way.
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: reserve(size_t newCapacity)
+{
+   if (newCapacity > numCapacity)
+      grow(newCapacity);
+}
+
+/***************************************
+ * VECTOR INCREMENTAL :: RESIZE
+ * Shrinking destroys the extras wherever they are.
+ * Growing fills the new slots, then moves a step for
+ * each of them, as that many pushes would have.  The
+ * fill comes first so t may refer to an element.
+ * Growing past the capacity goes through reserve(), so
+ * it finishes a drain that is under way.
+ *     INPUT  : newElements the new size
+ *              t           the value of any new elements
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: resize(size_t newElements)
+{
+   if (newElements < numElements)
+   {
+      destroy(newElements, numElements);
+      numElements = newElements;
+      dropPending();
+      return;
+   }
+
+   reserve(newElements);
+   size_t added = newElements - numElements;
+   for (; numElements < newElements; numElements++)
+      traits::construct(alloc, data + numElements);
+   migrate(added * step);
+}
+
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: resize(size_t newElements, const T & t)
+{
+   if (newElements < numElements)
+   {
+      destroy(newElements, numElements);
+      numElements = newElements;
+      dropPending();
+      return;
+   }
+
+   reserve(newElements);
+   size_t added = newElements - numElements;
+   for (; numElements < newElements; numElements++)
+      traits::construct(alloc, data + numElements, t);
+   migrate(added * step);
+}
+
+/***************************************
+ * VECTOR INCREMENTAL :: SHRINK TO FIT
+ * Finish the move, then copy into an exact buffer.
+ * This one is O(n), as it is for the plain vector.
+ **************************************/
+template <typename T, typename A, typename G, size_t K>
+void vector <T, A, grow_incremental<G, K>> :: shrink_to_fit()
+{
+   finish();
+   if (numCapacity == numElements)
+      return;
+   if (numElements == 0)
+   {
+      release();
+      return;
+   }
+
+   // the whole buffer is pending; draining it is the copy
+   old = data;
+   oldCapacity = numCapacity;
+   numPending = numElements;
+   data = traits::allocate(alloc, numElements);
+   numCapacity = numElements;
+   telemetry.reallocations++;
+   finish();
+}
+
+/***************************************
+ * VECTOR INCREMENTAL :: ASSIGNMENT
+ * Copy into one contiguous buffer.  Moving takes both
+ * buffers, and any drain under way, from rhs, unless
+ * its allocator cannot free them; then each element
+ * is moved into a buffer of our own.
+ *     INPUT  : rhs the vector to copy or move from
+ *     OUTPUT : *this
+ **************************************/
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> & vector <T, A, grow_incremental<G, K>> :: operator = (const vector & rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+
+      // a propagating allocator that differs cannot free our old buffer
+      if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+         release();
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+
+      if (rhs.numElements > numCapacity)
+      {
+         release();
+         data = traits::allocate(alloc, rhs.numElements);
+         numCapacity = rhs.numElements;
+         notePeak();
+      }
+      for (; numElements < rhs.numElements; numElements++)
+         traits::construct(alloc, data + numElements, rhs.slot(numElements));
+   }
+   return *this;
+}
+
+template <typename T, typename A, typename G, size_t K>
+vector <T, A, grow_incremental<G, K>> & vector <T, A, grow_incremental<G, K>> :: operator = (vector && rhs)
+{
+   if (this != &rhs)
+   {
+      // cannot adopt buffers our allocator did not hand out: move each element
+      if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+      {
+         clear();
+         reserve(rhs.numElements);
+         for (; numElements < rhs.numElements; numElements++)
+            traits::construct(alloc, data + numElements, std::move(rhs.slot(numElements)));
+         rhs.clear();
+         return *this;
+      }
+
+      release();
+      moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+
+      data        = rhs.data;
+      numCapacity = rhs.numCapacity;
+      numElements = rhs.numElements;
+      old         = rhs.old;
+      oldCapacity = rhs.oldCapacity;
+      numPending  = rhs.numPending;
+      step        = rhs.step;
+      notePeak();
+
+      rhs.data = rhs.old = nullptr;
+      rhs.numCapacity = rhs.numElements = rhs.oldCapacity = rhs.numPending = 0;
+   }
+   return *this;
+}
+
+} // namespace custom
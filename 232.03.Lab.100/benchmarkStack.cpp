@@ -0,0 +1,104 @@
+/***********************************************************************
+ * Program:
+ *    Benchmark Stack
+ * Summary:
+ *    A shared pool of objects: every thread takes one off the stack,
+ *    and puts it back, as fast as it can.  That is the worst case for
+ *    a stack, every operation on the same top, so it measures how
+ *    well each one holds up under contention.  custom::stack behind a
+ *    mutex is the baseline; concurrent_stack takes no lock.  The
+ *    table is millions of take-and-return pairs per second, summed
+ *    over all the threads, so a stack that scales keeps the number
+ *    growing with the thread count.  It cannot grow past the number
+ *    of cores, so run it on a machine with plenty.
+ *    This is its own program, not part of the unit test build:
+ *       g++ -std=c++14 -O2 -pthread benchmarkStack.cpp -o benchmarkStack
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#include "stack.h"
+#include "concurrent_stack.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+const int NUM_OBJECTS = 64;        // in the pool to begin with
+const int NUM_PAIRS   = 1 << 20;   // take-and-return pairs, split over the threads
+
+/*****************************************
+ * LOCKED STACK
+ * custom::stack, one thread at a time
+ ****************************************/
+class locked_stack
+{
+public:
+   void push(int t)
+   {
+      lock_guard<mutex> guard(lock);
+      s.push(t);
+   }
+   bool pop(int & t)
+   {
+      lock_guard<mutex> guard(lock);
+      if (s.empty())
+         return false;
+      t = s.top();
+      s.pop();
+      return true;
+   }
+private:
+   mutex lock;
+   custom::stack<int> s;
+};
+
+/*****************************************
+ * MEASURE
+ * Fill a pool, then have numThreads threads take and
+ * return objects until NUM_PAIRS have gone round.
+ * Returns millions of pairs per second.
+ ****************************************/
+template <class Stack>
+double measure(int numThreads)
+{
+   Stack pool;
+   for (int i = 0; i < NUM_OBJECTS; i++)
+      pool.push(i);
+
+   vector<thread> threads;
+   auto begin = chrono::steady_clock::now();
+   for (int n = 0; n < numThreads; n++)
+      threads.push_back(thread([&pool, numThreads]()
+      {
+         int t;
+         for (int i = 0; i < NUM_PAIRS / numThreads; i++)
+            if (pool.pop(t))
+               pool.push(t);
+      }));
+   for (thread & t : threads)
+      t.join();
+   auto end = chrono::steady_clock::now();
+
+   return NUM_PAIRS / chrono::duration<double, micro>(end - begin).count();
+}
+
+/**********************************************************************
+ * MAIN
+ ***********************************************************************/
+int main()
+{
+   cout << "M pairs per second, " << thread::hardware_concurrency() << " cores\n"
+        << setw(10) << "threads" << setw(14) << "mutex" << setw(14) << "lock free" << endl;
+
+   for (int numThreads = 1; numThreads <= 32; numThreads *= 2)
+      cout << setw(10) << numThreads << fixed << setprecision(2)
+           << setw(14) << measure<locked_stack>(numThreads)
+           << setw(14) << measure<custom::concurrent_stack<int>>(numThreads) << endl;
+   return 0;
+}
@@ -0,0 +1,327 @@
+/***********************************************************************
+ * Header:
+ *    CHUNK STACK
+ * Summary:
+ *    A container for the back of a stack, built from fixed-size
+ *    chunks linked bottom to top.  A push that fills the top chunk
+ *    links a new one on; nothing already pushed is ever copied or
+ *    moved, so a stack millions deep costs one allocation per B
+ *    elements and no reallocation copies at all.  References to
+ *    elements stay good until they are popped.
+ *
+ *    Popping the last element out of a chunk keeps that chunk as a
+ *    spare rather than freeing it, so a stack that pushes and pops
+ *    across a chunk boundary does not allocate on every push.  Only
+ *    one spare is kept; any beyond it are freed.
+ *
+ *    This will contain the class definition of:
+ *        chunk_stack       : push_back, pop_back, and back in chunks
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>      // for size_t
+#include <memory>       // for std::allocator and std::allocator_traits
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::move and std::swap
+
+class TestStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * CHUNK STACK
+ * B elements of T to a chunk.  Enough of the
+ * vector interface to hold a custom::stack:
+ * push_back, pop_back, back, size, and clear.
+ ****************************************/
+template <typename T, size_t B = 256, typename A = std::allocator<T>>
+class chunk_stack
+{
+   static_assert(B > 0, "a chunk needs room for at least one element");
+   friend class ::TestStack; // give unit tests access to the privates
+public:
+   using value_type     = T;
+   using allocator_type = A;
+
+   //
+   // Construct
+   //
+
+   chunk_stack(const A & a = A()) : alloc(a), pBottom(nullptr), pTop(nullptr),
+                                    numTop(0), numElements(0) {}
+   chunk_stack(const chunk_stack &  rhs);
+   chunk_stack(      chunk_stack && rhs);
+   ~chunk_stack()
+   {
+      clear();
+      freeAfter(nullptr);
+   }
+
+   //
+   // Assign
+   //
+
+   chunk_stack & operator = (const chunk_stack & rhs);
+   chunk_stack & operator = (chunk_stack && rhs);
+   void swap(chunk_stack & rhs)
+   {
+      // unequal allocators that do not propagate cannot trade chunks
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+      std::swap(pBottom,     rhs.pBottom);
+      std::swap(pTop,        rhs.pTop);
+      std::swap(numTop,      rhs.numTop);
+      std::swap(numElements, rhs.numElements);
+   }
+
+   //
+   // Access
+   //
+
+         T& back()       { assert(numElements > 0); return pTop->at(numTop - 1); }
+   const T& back() const { assert(numElements > 0); return pTop->at(numTop - 1); }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T & t) { emplace_back(t);            }
+   void push_back(T && t)      { emplace_back(std::move(t)); }
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+
+   //
+   // Remove
+   //
+
+   void pop_back();
+   void clear()
+   {
+      while (numElements > 0)
+         pop_back();
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()          const { return numElements;        }
+   bool   empty()         const { return numElements == 0;   }
+   A      get_allocator() const { return alloc;              }
+
+   // the elements per chunk
+   static size_t chunk_size() { return B; }
+
+private:
+
+   /*****************************************
+    * CHUNK
+    * Room for B elements, and the chunks on
+    * either side of this one
+    ****************************************/
+   struct Chunk
+   {
+      Chunk * pPrev;
+      Chunk * pNext;
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[B];
+
+      T & at(size_t i) { return *reinterpret_cast<T *>(slots + i); }
+   };
+
+   using traits      = std::allocator_traits<A>;
+   using ChunkAlloc  = typename traits::template rebind_alloc<Chunk>;
+   using ChunkTraits = std::allocator_traits<ChunkAlloc>;
+
+   // hand over the allocator only when its traits say to
+   void copyAlloc(const A & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const A &,     std::false_type) {                         }
+   void moveAlloc(A & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(A &,           std::false_type) {                         }
+   void swapAlloc(A & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(A &,           std::false_type) {                         }
+
+   // a fresh, empty chunk linked on after pPrev
+   Chunk * newChunk(Chunk * pPrev)
+   {
+      ChunkAlloc chunkAlloc(alloc);
+      Chunk * p = ChunkTraits::allocate(chunkAlloc, 1);
+      p->pPrev = pPrev;
+      p->pNext = nullptr;
+      if (pPrev)
+         pPrev->pNext = p;
+      else
+         pBottom = p;
+      return p;
+   }
+
+   // free every chunk above p, or all of them when p is null
+   void freeAfter(Chunk * p)
+   {
+      Chunk * pFree = p ? p->pNext : pBottom;
+      ChunkAlloc chunkAlloc(alloc);
+      while (pFree)
+      {
+         Chunk * pNext = pFree->pNext;
+         ChunkTraits::deallocate(chunkAlloc, pFree, 1);
+         pFree = pNext;
+      }
+      if (p)
+         p->pNext = nullptr;
+      else
+         pBottom = pTop = nullptr;
+   }
+
+   // copy the elements of rhs on top of ours, bottom first
+   void append(const chunk_stack & rhs)
+   {
+      size_t left = rhs.numElements;
+      for (Chunk * p = rhs.pBottom; left > 0; p = p->pNext)
+         for (size_t i = 0; i < B && left > 0; i++, left--)
+            emplace_back(p->at(i));
+   }
+
+   A alloc;             // hands out the chunks
+   Chunk * pBottom;     // the first chunk, where the bottom element lives
+   Chunk * pTop;        // the chunk holding the top element
+   size_t numTop;       // the number of elements in the top chunk
+   size_t numElements;  // the number of elements in all the chunks
+};
+
+/*****************************************
+ * CHUNK STACK :: COPY CONSTRUCTOR
+ * One element at a time, into chunks of our own
+ ****************************************/
+template <typename T, size_t B, typename A>
+chunk_stack <T, B, A> :: chunk_stack(const chunk_stack & rhs)
+   : alloc(traits::select_on_container_copy_construction(rhs.alloc)),
+     pBottom(nullptr), pTop(nullptr), numTop(0), numElements(0)
+{
+   append(rhs);
+}
+
+/*****************************************
+ * CHUNK STACK :: MOVE CONSTRUCTOR
+ * Take the chunks; rhs is left with none
+ ****************************************/
+template <typename T, size_t B, typename A>
+chunk_stack <T, B, A> :: chunk_stack(chunk_stack && rhs)
+   : alloc(std::move(rhs.alloc)), pBottom(rhs.pBottom), pTop(rhs.pTop),
+     numTop(rhs.numTop), numElements(rhs.numElements)
+{
+   rhs.pBottom = rhs.pTop = nullptr;
+   rhs.numTop = rhs.numElements = 0;
+}
+
+/*****************************************
+ * CHUNK STACK :: ASSIGNMENT
+ * Copying reuses the chunks we already have,
+ * unless a new allocator is coming that could not
+ * free them.  Moving frees ours and takes those of
+ * rhs, or moves each element when our allocator
+ * could not free them.
+ ****************************************/
+template <typename T, size_t B, typename A>
+chunk_stack <T, B, A> & chunk_stack <T, B, A> :: operator = (const chunk_stack & rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+         freeAfter(nullptr);
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+      append(rhs);
+   }
+   return *this;
+}
+
+template <typename T, size_t B, typename A>
+chunk_stack <T, B, A> & chunk_stack <T, B, A> :: operator = (chunk_stack && rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+
+   // cannot adopt chunks our allocator did not hand out: move each element
+   if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+   {
+      size_t left = rhs.numElements;
+      for (Chunk * p = rhs.pBottom; left > 0; p = p->pNext)
+         for (size_t i = 0; i < B && left > 0; i++, left--)
+            emplace_back(std::move(p->at(i)));
+      rhs.clear();
+      return *this;
+   }
+
+   freeAfter(nullptr);
+   moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+   pBottom     = rhs.pBottom;
+   pTop        = rhs.pTop;
+   numTop      = rhs.numTop;
+   numElements = rhs.numElements;
+
+   rhs.pBottom = rhs.pTop = nullptr;
+   rhs.numTop = rhs.numElements = 0;
+   return *this;
+}
+
+/*****************************************
+ * CHUNK STACK :: EMPLACE BACK
+ * Build the new element in place at the top.  A
+ * full top chunk moves up to the spare if there is
+ * one, and links on a new chunk if not.
+ *     INPUT  : args the arguments for T's constructor
+ *     OUTPUT : the new element
+ ****************************************/
+template <typename T, size_t B, typename A>
+template <class ... Args>
+T & chunk_stack <T, B, A> :: emplace_back(Args && ... args)
+{
+   if (pTop == nullptr)
+   {
+      pTop = newChunk(nullptr);
+      numTop = 0;
+   }
+   else if (numTop == B)
+   {
+      pTop = pTop->pNext ? pTop->pNext : newChunk(pTop);
+      numTop = 0;
+   }
+
+   T * p = &pTop->at(numTop);
+   traits::construct(alloc, p, std::forward<Args>(args)...);
+   numTop++;
+   numElements++;
+   return *p;
+}
+
+/*****************************************
+ * CHUNK STACK :: POP BACK
+ * Destroy the top element.  When that empties a
+ * chunk, step down to the one below and keep the
+ * empty chunk as the spare, freeing any above it.
+ ****************************************/
+template <typename T, size_t B, typename A>
+void chunk_stack <T, B, A> :: pop_back()
+{
+   if (numElements == 0)
+      return;
+
+   traits::destroy(alloc, &pTop->at(numTop - 1));
+   numTop--;
+   numElements--;
+
+   if (numTop == 0 && pTop->pPrev)
+   {
+      freeAfter(pTop);
+      pTop = pTop->pPrev;
+      numTop = B;
+   }
+}
+
+} // namespace custom
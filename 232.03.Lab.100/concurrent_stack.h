@@ -0,0 +1,427 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT STACK
+ * Summary:
+ *    A stack that any number of threads can push and pop at once
+ *    without a lock: a Treiber stack, a linked list whose head is
+ *    swung with compare-and-swap.  A thread that loses the race
+ *    backs off for a moment before trying again, so a crowd of
+ *    threads does not spend its time invalidating the head's cache
+ *    line for each other.
+ *
+ *    A popped node cannot simply be freed, since another thread may
+ *    be about to read its next pointer, and it cannot be pushed again
+ *    while such a thread might still compare against it: that is the
+ *    ABA problem.  Both are solved with hazard pointers.  Before a
+ *    pop reads through the head it publishes it in its thread's
+ *    record, and a retired node is reused only once no record names
+ *    it.  Each thread keeps its retired nodes, and the ones found
+ *    safe go to a free list of its own, where its next pushes take
+ *    them without touching the heap.
+ *
+ *    The records, and the nodes they hold, are shared by every stack
+ *    of the same T.  A thread takes a record on its first push or pop
+ *    and gives it back when it exits, for the next thread to adopt.
+ *    The destructor and clear() are not safe to call while others
+ *    push or pop.
+ *
+ *    This will contain the class definition of:
+ *        concurrent_stack  : a lock-free stack
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <algorithm>    // for std::sort and std::binary_search
+#include <atomic>       // for std::atomic
+#include <cassert>      // because I am paranoid
+#include <cstddef>      // for size_t
+#include <new>          // for placement new
+#include <thread>       // for std::this_thread::yield
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::forward and std::move
+#include <vector>       // for the retired lists
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>     // for _mm_pause
+#endif
+
+class TestConcurrentStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * BACKOFF
+ * After a failed compare-and-swap, wait a little,
+ * twice as long each time up to a limit, then let
+ * another thread have the core
+ ****************************************/
+class backoff
+{
+public:
+   backoff() : spins(1) {}
+   void wait()
+   {
+      if (spins > LIMIT)
+      {
+         std::this_thread::yield();
+         return;
+      }
+      for (size_t i = 0; i < spins; i++)
+         pause();
+      spins *= 2;
+   }
+private:
+   // tell the core we are spinning; elsewhere, at least keep the
+   // compiler from throwing the empty loop away
+   static void pause()
+   {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+      __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+      _mm_pause();
+#else
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+   }
+
+   static const size_t LIMIT = 1024;
+   size_t spins;
+};
+
+/*****************************************
+ * CONCURRENT STACK
+ * push, emplace, and pop may run on any number
+ * of threads at once.  There is no top(): by
+ * the time it returned, the element could be
+ * gone.  pop() hands the element over instead.
+ ****************************************/
+template <typename T>
+class concurrent_stack
+{
+   friend class ::TestConcurrentStack; // give unit tests access to the privates
+
+   // one element, and the one below it
+   struct Node
+   {
+      Node * pNext;
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+      T & value() { return *reinterpret_cast<T *>(&storage); }
+   };
+
+   /*****************************************
+    * RECORD
+    * One thread's hazard pointer, the nodes it has
+    * popped, and the ones it may reuse.  Only the
+    * hazard is read by other threads.  The padding
+    * keeps records from sharing a cache line, so
+    * publishing a hazard does not slow anyone else.
+    ****************************************/
+   struct Record
+   {
+      Record() : pNext(nullptr), active(true), hazard(nullptr),
+                 pFree(nullptr), numFree(0) {}
+
+      Record * pNext;              // the next record, fixed once linked
+      std::atomic<bool> active;    // whether a thread owns this record
+      std::atomic<Node *> hazard;  // the node this thread is reading
+      std::vector<Node *> retired; // popped, maybe still being read
+      Node * pFree;                // safe to reuse, linked by pNext
+      size_t numFree;              // the length of that list
+      char padding[64];            // so the next record is on another line
+   };
+
+   /*****************************************
+    * DOMAIN
+    * Every record there has ever been.  They are only
+    * freed when the program ends.
+    ****************************************/
+   struct Domain
+   {
+      Domain() : pHead(nullptr), numRecords(0) {}
+      ~Domain();
+      Record * acquire();
+
+      std::atomic<Record *> pHead;
+      std::atomic<size_t> numRecords;
+   };
+
+   // gives the record back when its thread exits
+   struct Owner
+   {
+      Owner() : pRecord(nullptr) {}
+      ~Owner()
+      {
+         if (pRecord)
+            pRecord->active.store(false, std::memory_order_release);
+      }
+      Record * pRecord;
+   };
+
+public:
+   using value_type = T;
+
+   //
+   // Construct
+   //
+
+   concurrent_stack() : pHead(nullptr) {}
+   concurrent_stack(const concurrent_stack &) = delete;
+   concurrent_stack & operator = (const concurrent_stack &) = delete;
+   ~concurrent_stack() { clear(); }
+
+   //
+   // Insert
+   //
+
+   void push(const T & t) { emplace(t);            }
+   void push(T && t)      { emplace(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args);
+
+   //
+   // Remove
+   //
+
+   bool pop(T & t);
+   void clear();
+
+   //
+   // Status
+   //
+
+   // only a snapshot when others are pushing and popping
+   bool empty() const { return pHead.load() == nullptr; }
+
+private:
+
+   // scan once this many more nodes are retired than there are records
+   static const size_t SCAN = 64;
+   // keep at most this many nodes on a thread's free list
+   static const size_t MAX_FREE = 1024;
+
+   static Domain & domain()
+   {
+      static Domain d;
+      return d;
+   }
+
+   // the calling thread's record
+   static Record * record()
+   {
+      static thread_local Owner owner;
+      if (owner.pRecord == nullptr)
+         owner.pRecord = domain().acquire();
+      return owner.pRecord;
+   }
+
+   // a node off the thread's free list, or a new one
+   static Node * allocate(Record * pRecord)
+   {
+      if (pRecord->pFree == nullptr)
+         return new Node;
+      Node * p = pRecord->pFree;
+      pRecord->pFree = p->pNext;
+      pRecord->numFree--;
+      return p;
+   }
+
+   // keep a node for reuse, or free it if we are keeping plenty
+   static void recycle(Record * pRecord, Node * p)
+   {
+      if (pRecord->numFree >= MAX_FREE)
+      {
+         delete p;
+         return;
+      }
+      p->pNext = pRecord->pFree;
+      pRecord->pFree = p;
+      pRecord->numFree++;
+   }
+
+   static void retire(Record * pRecord, Node * p);
+   static void scan(Record * pRecord);
+
+   std::atomic<Node *> pHead;   // the top of the stack
+};
+
+/*****************************************
+ * CONCURRENT STACK :: DOMAIN :: ACQUIRE
+ * Adopt a record some thread gave back, or link on
+ * a new one
+ ****************************************/
+template <typename T>
+typename concurrent_stack <T> :: Record * concurrent_stack <T> :: Domain :: acquire()
+{
+   for (Record * p = pHead.load(); p; p = p->pNext)
+   {
+      bool idle = false;
+      if (!p->active.load(std::memory_order_relaxed) &&
+          p->active.compare_exchange_strong(idle, true, std::memory_order_acquire))
+         return p;
+   }
+
+   Record * p = new Record;
+   p->pNext = pHead.load();
+   while (!pHead.compare_exchange_weak(p->pNext, p))
+      ;
+   numRecords.fetch_add(1);
+   return p;
+}
+
+/*****************************************
+ * CONCURRENT STACK :: DOMAIN :: DESTRUCTOR
+ * At exit: free the records and every node they hold
+ ****************************************/
+template <typename T>
+concurrent_stack <T> :: Domain :: ~Domain()
+{
+   Record * p = pHead.load();
+   while (p)
+   {
+      for (Node * pNode : p->retired)
+         delete pNode;
+      while (p->pFree)
+      {
+         Node * pNode = p->pFree;
+         p->pFree = pNode->pNext;
+         delete pNode;
+      }
+      Record * pNext = p->pNext;
+      delete p;
+      p = pNext;
+   }
+}
+
+/*****************************************
+ * CONCURRENT STACK :: EMPLACE
+ * Build the element in a node, then swing the head
+ * to it.  Nothing reads through the head here, so
+ * no hazard is needed.
+ *     INPUT  : args the arguments for T's constructor
+ ****************************************/
+template <typename T>
+template <class ... Args>
+void concurrent_stack <T> :: emplace(Args && ... args)
+{
+   Record * pRecord = record();
+   Node * p = allocate(pRecord);
+   try
+   {
+      new (&p->storage) T(std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      recycle(pRecord, p);
+      throw;
+   }
+
+   backoff wait;
+   p->pNext = pHead.load(std::memory_order_relaxed);
+   while (!pHead.compare_exchange_weak(p->pNext, p,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed))
+      wait.wait();
+}
+
+/*****************************************
+ * CONCURRENT STACK :: POP
+ * Publish the head as our hazard, check it is still
+ * the head, and only then read its next pointer.  From
+ * then on the node cannot be reused, so if the head
+ * still matches when we swing it, it is the same node.
+ *     INPUT  : t where to put the element
+ *     OUTPUT : false if the stack was empty
+ ****************************************/
+template <typename T>
+bool concurrent_stack <T> :: pop(T & t)
+{
+   Record * pRecord = record();
+   backoff wait;
+   Node * p = pHead.load();
+   while (p)
+   {
+      pRecord->hazard.store(p);
+      Node * pCheck = pHead.load();
+      if (pCheck != p)
+      {
+         p = pCheck;
+         continue;
+      }
+      if (pHead.compare_exchange_strong(p, p->pNext))
+         break;
+      wait.wait();
+   }
+   pRecord->hazard.store(nullptr, std::memory_order_release);
+   if (p == nullptr)
+      return false;
+
+   // the node is ours alone now; only its address may still be in use
+   t = std::move(p->value());
+   p->value().~T();
+   retire(pRecord, p);
+   return true;
+}
+
+/*****************************************
+ * CONCURRENT STACK :: CLEAR
+ * Destroy every element.  Not safe while others
+ * push or pop, so no one can be reading the nodes
+ * and they are freed at once.
+ ****************************************/
+template <typename T>
+void concurrent_stack <T> :: clear()
+{
+   Node * p = pHead.exchange(nullptr);
+   while (p)
+   {
+      Node * pNext = p->pNext;
+      p->value().~T();
+      delete p;
+      p = pNext;
+   }
+}
+
+/*****************************************
+ * CONCURRENT STACK :: RETIRE
+ * Hold a popped node until no hazard names it.  Scan
+ * once there are comfortably more retired nodes than
+ * records, so each scan frees most of what it looks at.
+ ****************************************/
+template <typename T>
+void concurrent_stack <T> :: retire(Record * pRecord, Node * p)
+{
+   pRecord->retired.push_back(p);
+   if (pRecord->retired.size() >= SCAN + 2 * domain().numRecords.load(std::memory_order_relaxed))
+      scan(pRecord);
+}
+
+/*****************************************
+ * CONCURRENT STACK :: SCAN
+ * Gather every hazard, then recycle the retired
+ * nodes that are not among them
+ ****************************************/
+template <typename T>
+void concurrent_stack <T> :: scan(Record * pRecord)
+{
+   std::vector<Node *> hazards;
+   for (Record * p = domain().pHead.load(); p; p = p->pNext)
+   {
+      Node * pHazard = p->hazard.load();
+      if (pHazard)
+         hazards.push_back(pHazard);
+   }
+   std::sort(hazards.begin(), hazards.end());
+
+   size_t kept = 0;
+   for (Node * p : pRecord->retired)
+      if (std::binary_search(hazards.begin(), hazards.end(), p))
+         pRecord->retired[kept++] = p;
+      else
+         recycle(pRecord, p);
+   pRecord->retired.resize(kept);
+}
+
+} // namespace custom
@@ -0,0 +1,714 @@
+/***********************************************************************
+ * Header:
+ *    SMALL VECTOR
+ * Summary:
+ *    A vector that keeps its first N elements inside the object
+ *    itself and only goes to the heap when it grows beyond that.
+ *    Short-lived, usually-small collections never allocate.
+ *
+ *    This will contain the class definition of:
+ *        small_vector           : A vector with N inline slots
+ *        small_vector::iterator : the same iterators as vector
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include "vector.h"  // for vector::iterator and is_trivially_relocatable
+
+class TestSmallVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * SMALL VECTOR
+ * Same interface as custom::vector.  The buffer starts out
+ * as the inline storage; capacity never drops below N.
+ ****************************************/
+template <typename T, size_t N, typename A = std::allocator<T>>
+class small_vector
+{
+   static_assert(N > 0, "a small_vector with no inline slots is a vector");
+   friend class ::TestSmallVector; // give unit tests access to the privates
+   friend class ::TestStack;
+   friend class ::TestPQueue;
+public:
+   using value_type     = T;
+   using allocator_type = A;
+
+   //
+   // Construct
+   //
+
+   small_vector(const A & a = A());
+   small_vector(size_t numElements,                const A & a = A());
+   small_vector(size_t numElements, const T& t,    const A & a = A());
+   small_vector(const std::initializer_list<T>& l, const A & a = A());
+   small_vector(const small_vector &  rhs);
+   small_vector(      small_vector && rhs);
+   ~small_vector();
+
+   //
+   // Assign
+   //
+
+   void swap(small_vector& rhs);
+   small_vector & operator = (const small_vector & rhs);
+   small_vector & operator = (small_vector&& rhs);
+
+   //
+   // Iterator
+   //
+
+   using iterator       = typename vector<T, A>::iterator;
+   using const_iterator = typename vector<T, A>::const_iterator;
+   iterator       begin()        { return iterator(data); }
+   iterator       end()          { return iterator(data+numElements); }
+   const_iterator begin()  const { return const_iterator(data); }
+   const_iterator end()    const { return const_iterator(data+numElements); }
+   const_iterator cbegin() const { return const_iterator(data); }
+   const_iterator cend()   const { return const_iterator(data+numElements); }
+
+   //
+   // Access
+   //
+
+         T& operator [] (size_t index)       { assert(index < numElements); return data[index]; }
+   const T& operator [] (size_t index) const { assert(index < numElements); return data[index]; }
+         T& front()       { assert(numElements > 0); return data[0];               }
+   const T& front() const { assert(numElements > 0); return data[0];               }
+         T& back()        { assert(numElements > 0); return data[numElements - 1]; }
+   const T& back()  const { assert(numElements > 0); return data[numElements - 1]; }
+
+   //
+   // Insert
+   //
+
+   void push_back(const T& t);
+   void push_back(T&& t);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   template <class ... Args>
+   iterator emplace(iterator pos, Args && ... args);
+   iterator insert(iterator pos, const T & t) { return emplace(pos, t);            }
+   iterator insert(iterator pos, T && t)      { return emplace(pos, std::move(t)); }
+   template <class Iterator>
+   iterator insert(iterator pos, Iterator first, Iterator last)
+   {
+      return insertRange(pos - begin(), first, last,
+                         typename std::iterator_traits<Iterator>::iterator_category());
+   }
+   iterator insert(iterator pos, const std::initializer_list<T> & l)
+   {
+      return insert(pos, l.begin(), l.end());
+   }
+   void reserve(size_t newCapacity)
+   {
+      if (newCapacity > numCapacity)
+         reallocate(newCapacity);
+   }
+   void resize(size_t newElements);
+   void resize(size_t newElements, const T& t);
+
+   //
+   // Remove
+   //
+
+   void clear()
+   {
+      destroy(0, numElements);
+      numElements = 0;
+   }
+   void pop_back()
+   {
+      if (numElements > 0)
+      {
+         numElements--;
+         traits::destroy(alloc, data + numElements);
+      }
+   }
+   iterator erase(iterator pos)                 { return erase(pos, pos + 1); }
+   iterator erase(iterator first, iterator last);
+   void shrink_to_fit();
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return numElements; }
+   size_t  capacity()      const { return numCapacity; }
+   bool empty()            const { return (numElements == 0); }
+   A    get_allocator()    const { return alloc; }
+
+   // small-vector-specific interfaces
+
+   // are the elements still living in the inline slots?
+   bool is_inline()        const { return data == inlineData(); }
+
+private:
+
+   using traits = std::allocator_traits<A>;
+
+   // the inline slots, raw storage like the heap buffer
+         T * inlineData()       { return reinterpret_cast<      T *>(&storage); }
+   const T * inlineData() const { return reinterpret_cast<const T *>(&storage); }
+
+   // call the destructor on the slots [begin, end)
+   void destroy(size_t begin, size_t end)
+   {
+      for (size_t i = begin; i < end; i++)
+         traits::destroy(alloc, data + i);
+   }
+
+   // move the live elements into a buffer of newCapacity, inline if it fits
+   void reallocate(size_t newCapacity);
+
+   // move num live elements from src to the raw slots at dest, leaving
+   // the src slots dead.  The two ranges may overlap.
+   void relocate(T * dest, T * src, size_t num, std::true_type)
+   {
+      if (num > 0)
+         std::memmove(static_cast<void *>(dest), static_cast<const void *>(src),
+                      num * sizeof(T));
+   }
+   void relocate(T * dest, T * src, size_t num, std::false_type)
+   {
+      if (dest < src)
+         for (size_t i = 0; i < num; i++)
+         {
+            traits::construct(alloc, dest + i, std::move_if_noexcept(src[i]));
+            traits::destroy(alloc, src + i);
+         }
+      else
+         for (size_t i = num; i > 0; i--)
+         {
+            traits::construct(alloc, dest + i - 1, std::move_if_noexcept(src[i - 1]));
+            traits::destroy(alloc, src + i - 1);
+         }
+   }
+   void relocate(T * dest, T * src, size_t num)
+   {
+      relocate(dest, src, num, std::integral_constant<bool,
+                                  is_trivially_relocatable<T>::value>());
+   }
+
+   // open num raw slots at index and let fill construct them one at a time
+   template <class Fill>
+   iterator insertGap(size_t index, size_t num, Fill fill);
+
+   // call fill on each of the num raw slots at p.  If one throws,
+   // the ones already built are destroyed before it goes on.
+   template <class Fill>
+   void fillSlots(T * p, size_t num, Fill & fill)
+   {
+      size_t i = 0;
+      try
+      {
+         for (; i < num; i++)
+            fill(p + i);
+      }
+      catch (...)
+      {
+         while (i > 0)
+            traits::destroy(alloc, p + --i);
+         throw;
+      }
+   }
+
+   // a range we can measure goes in with one gap, anything else one at a time
+   template <class Iterator>
+   iterator insertRange(size_t index, Iterator first, Iterator last,
+                        std::forward_iterator_tag);
+   template <class Iterator>
+   iterator insertRange(size_t index, Iterator first, Iterator last,
+                        std::input_iterator_tag);
+
+   // destroy everything and fall back to the empty inline slots
+   void release()
+   {
+      destroy(0, numElements);
+      if (!is_inline())
+         traits::deallocate(alloc, data, numCapacity);
+      data = inlineData();
+      numCapacity = N;
+      numElements = 0;
+   }
+
+   // take rhs's elements one at a time, leaving rhs empty
+   void moveElements(small_vector & rhs)
+   {
+      reserve(rhs.numElements);
+      for (size_t i = 0; i < rhs.numElements; i++)
+         traits::construct(alloc, data + i, std::move(rhs.data[i]));
+      numElements = rhs.numElements;
+      rhs.clear();
+   }
+
+   // the allocator follows the heap buffer only when its traits say so
+   void copyAlloc(const A & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const A &,     std::false_type) {                         }
+   void moveAlloc(A & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(A &,           std::false_type) {                         }
+
+   typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage;
+   A alloc;                   // hands out the heap buffer once we spill
+   T *  data;                 // either the inline slots or the heap buffer
+   size_t  numCapacity;       // the capacity of the array, at least N
+   size_t  numElements;       // the number of items currently used
+};
+
+/*****************************************
+ * SMALL VECTOR :: DEFAULT constructor
+ * Start out empty in the inline slots.  No allocations.
+ ****************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> :: small_vector(const A & a) : alloc(a)
+{
+   data = inlineData();
+   numCapacity = N;
+   numElements = 0;
+}
+
+/*****************************************
+ * SMALL VECTOR :: NON-DEFAULT constructors
+ * Make room for num elements and construct each one
+ ****************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> :: small_vector(size_t num, const A & a) : small_vector(a)
+{
+   resize(num);
+}
+
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> :: small_vector(size_t num, const T & t, const A & a) : small_vector(a)
+{
+   resize(num, t);
+}
+
+/*****************************************
+ * SMALL VECTOR :: INITIALIZATION LIST constructor
+ * Create a small vector with an initialization list.
+ ****************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> :: small_vector(const std::initializer_list<T> & l, const A & a)
+   : small_vector(a)
+{
+   reserve(l.size());
+   for (const T & t : l)
+      traits::construct(alloc, data + numElements++, t);
+}
+
+/*****************************************
+ * SMALL VECTOR :: COPY CONSTRUCTOR
+ * Copy each element, going to the heap only if
+ * rhs holds more than N of them
+ ****************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> :: small_vector(const small_vector & rhs) :
+   small_vector(traits::select_on_container_copy_construction(rhs.alloc))
+{
+   reserve(rhs.numElements);
+   for (size_t i = 0; i < rhs.numElements; i++)
+      traits::construct(alloc, data + i, rhs.data[i]);
+   numElements = rhs.numElements;
+}
+
+/*****************************************
+ * SMALL VECTOR :: MOVE CONSTRUCTOR
+ * A heap buffer is stolen outright.  Inline elements
+ * cannot be stolen, so they are moved one at a time.
+ ****************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> :: small_vector(small_vector && rhs) : small_vector(rhs.alloc)
+{
+   if (rhs.is_inline())
+   {
+      moveElements(rhs);
+      return;
+   }
+
+   data = rhs.data;
+   numCapacity = rhs.numCapacity;
+   numElements = rhs.numElements;
+
+   rhs.data = rhs.inlineData();
+   rhs.numCapacity = N;
+   rhs.numElements = 0;
+}
+
+/*****************************************
+ * SMALL VECTOR :: DESTRUCTOR
+ * Destroy the elements and free the heap buffer, if any
+ ****************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> :: ~small_vector()
+{
+   release();
+}
+
+/***************************************
+ * SMALL VECTOR :: REALLOCATE
+ * Move the live elements into a buffer of newCapacity.
+ * Anything that fits in N goes back into the inline slots.
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T, size_t N, typename A>
+void small_vector <T, N, A> :: reallocate(size_t newCapacity)
+{
+   assert(newCapacity >= numElements);
+   if (newCapacity < N)
+      newCapacity = N;
+
+   T * newData = (newCapacity == N) ? inlineData() : traits::allocate(alloc, newCapacity);
+   assert(newData != data);
+   relocate(newData, data, numElements);
+
+   if (!is_inline())
+      traits::deallocate(alloc, data, numCapacity);
+
+   data = newData;
+   numCapacity = newCapacity;
+}
+
+/***************************************
+ * SMALL VECTOR :: RESIZE
+ * Grow or shrink to newElements, constructing or
+ * destroying the elements at the end
+ *     INPUT  : newElements the new size
+ *     OUTPUT :
+ **************************************/
+template <typename T, size_t N, typename A>
+void small_vector <T, N, A> :: resize(size_t newElements)
+{
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         traits::construct(alloc, data + i);
+   }
+   numElements = newElements;
+}
+
+template <typename T, size_t N, typename A>
+void small_vector <T, N, A> :: resize(size_t newElements, const T & t)
+{
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         traits::construct(alloc, data + i, t);
+   }
+   numElements = newElements;
+}
+
+/***************************************
+ * SMALL VECTOR :: SHRINK TO FIT
+ * Drop the extra heap capacity, moving back into
+ * the inline slots when the elements fit there
+ *     INPUT  :
+ *     OUTPUT :
+ **************************************/
+template <typename T, size_t N, typename A>
+void small_vector <T, N, A> :: shrink_to_fit()
+{
+   size_t newCapacity = numElements > N ? numElements : N;
+   if (newCapacity != numCapacity)
+      reallocate(newCapacity);
+}
+
+/***************************************
+ * SMALL VECTOR :: PUSH BACK
+ * Add 't' to the end, doubling the buffer when full.
+ * The first spill goes straight from N to 2N.
+ *     INPUT  : 't' the new element to be added
+ *     OUTPUT :
+ **************************************/
+template <typename T, size_t N, typename A>
+void small_vector <T, N, A> :: push_back(const T & t)
+{
+   emplace_back(t);
+}
+
+template <typename T, size_t N, typename A>
+void small_vector <T, N, A> :: push_back(T && t)
+{
+   emplace_back(std::move(t));
+}
+
+/***************************************
+ * SMALL VECTOR :: EMPLACE BACK
+ * Construct a new element at the end straight from
+ * args.  When the buffer is full the element is built
+ * in the new heap buffer before the old elements move
+ * over, so args may refer to one of them.
+ *     INPUT  : args the constructor parameters
+ *     OUTPUT : the new element
+ **************************************/
+template <typename T, size_t N, typename A>
+template <class ... Args>
+T & small_vector <T, N, A> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+      return *insertGap(numElements, 1, [&](T * p)
+      {
+         traits::construct(alloc, p, std::forward<Args>(args)...);
+      });
+
+   traits::construct(alloc, data + numElements, std::forward<Args>(args)...);
+   return data[numElements++];
+}
+
+/***************************************
+ * SMALL VECTOR :: EMPLACE
+ * Construct a new element in front of pos.  The
+ * elements after pos shift up one slot.
+ *     INPUT  : pos  where the new element goes
+ *              args the constructor parameters
+ *     OUTPUT : iterator to the new element
+ **************************************/
+template <typename T, size_t N, typename A>
+template <class ... Args>
+typename small_vector <T, N, A> :: iterator small_vector <T, N, A> :: emplace(iterator pos, Args && ... args)
+{
+   size_t index = pos - begin();
+   assert(index <= numElements);
+
+   // appending or growing never disturbs the old elements before we read args
+   if (index == numElements || numElements == numCapacity)
+      return insertGap(index, 1, [&](T * p)
+      {
+         traits::construct(alloc, p, std::forward<Args>(args)...);
+      });
+
+   // shifting in place might move an element args refers to: build it first
+   T t(std::forward<Args>(args)...);
+   return insertGap(index, 1, [&](T * p)
+   {
+      traits::construct(alloc, p, std::move(t));
+   });
+}
+
+/***************************************
+ * SMALL VECTOR :: INSERT GAP
+ * Open num raw slots at index and call fill once for
+ * each of them.  Needing more room means a heap buffer
+ * at least twice the size: fill runs there first, then
+ * the old elements are relocated around the gap.
+ * Otherwise the tail is shifted up in place.  If fill
+ * throws, nothing changes.
+ *     INPUT  : index where the gap goes
+ *              num   how many slots to open
+ *              fill  constructs one new element
+ *     OUTPUT : iterator to the first new element
+ **************************************/
+template <typename T, size_t N, typename A>
+template <class Fill>
+typename small_vector <T, N, A> :: iterator small_vector <T, N, A> :: insertGap(size_t index, size_t num, Fill fill)
+{
+   assert(index <= numElements);
+   if (numElements + num > numCapacity)
+   {
+      size_t newCapacity = numCapacity * 2;
+      if (newCapacity < numElements + num)
+         newCapacity = numElements + num;
+
+      T * newData = traits::allocate(alloc, newCapacity);
+      try
+      {
+         fillSlots(newData + index, num, fill);
+      }
+      catch (...)
+      {
+         traits::deallocate(alloc, newData, newCapacity);
+         throw;
+      }
+      relocate(newData, data, index);
+      relocate(newData + index + num, data + index, numElements - index);
+
+      if (!is_inline())
+         traits::deallocate(alloc, data, numCapacity);
+      data = newData;
+      numCapacity = newCapacity;
+   }
+   else
+   {
+      relocate(data + index + num, data + index, numElements - index);
+      try
+      {
+         fillSlots(data + index, num, fill);
+      }
+      catch (...)
+      {
+         relocate(data + index, data + index + num, numElements - index);
+         throw;
+      }
+   }
+
+   numElements += num;
+   return iterator(data + index);
+}
+
+/***************************************
+ * SMALL VECTOR :: INSERT RANGE
+ * Insert [first, last) in front of index.  Forward
+ * iterators are measured up front so the buffer grows
+ * at most once; input iterators can only be read once,
+ * so they go in one element at a time.
+ *     INPUT  : index       where the range goes
+ *              first, last the elements to copy
+ *     OUTPUT : iterator to the first new element
+ **************************************/
+template <typename T, size_t N, typename A>
+template <class Iterator>
+typename small_vector <T, N, A> :: iterator small_vector <T, N, A> :: insertRange(size_t index,
+   Iterator first, Iterator last, std::forward_iterator_tag)
+{
+   size_t num = std::distance(first, last);
+   if (num == 0)
+      return iterator(data + index);
+   return insertGap(index, num, [&](T * p)
+   {
+      traits::construct(alloc, p, *first);
+      ++first;
+   });
+}
+
+template <typename T, size_t N, typename A>
+template <class Iterator>
+typename small_vector <T, N, A> :: iterator small_vector <T, N, A> :: insertRange(size_t index,
+   Iterator first, Iterator last, std::input_iterator_tag)
+{
+   for (size_t i = index; first != last; ++first, ++i)
+      emplace(iterator(data + i), *first);
+   return iterator(data + index);
+}
+
+/***************************************
+ * SMALL VECTOR :: ERASE
+ * Destroy the elements in [first, last) and shift the
+ * tail down to close the hole, with memmove when T allows it
+ *     INPUT  : first, last the elements to remove
+ *     OUTPUT : iterator to the element after the last removed
+ **************************************/
+template <typename T, size_t N, typename A>
+typename small_vector <T, N, A> :: iterator small_vector <T, N, A> :: erase(iterator first, iterator last)
+{
+   size_t begin = first - this->begin();
+   size_t end   = last  - this->begin();
+   assert(begin <= end && end <= numElements);
+
+   destroy(begin, end);
+   relocate(data + begin, data + end, numElements - end);
+   numElements -= end - begin;
+   return iterator(data + begin);
+}
+
+/***************************************
+ * SMALL VECTOR :: ASSIGNMENT
+ * Copy the contents of rhs onto *this, reusing
+ * whatever buffer we already have when it is big enough
+ *     INPUT  : rhs the small vector to copy from
+ *     OUTPUT : *this
+ **************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> & small_vector <T, N, A> :: operator = (const small_vector & rhs)
+{
+   if (this != &rhs)
+   {
+      // a propagating allocator that differs cannot free our old buffer
+      if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+         release();
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+
+      // not enough room: start over with a buffer exactly the right size
+      if (rhs.numElements > numCapacity)
+      {
+         clear();
+         reallocate(rhs.numElements);
+      }
+
+      // assign over the live elements, construct the rest, destroy any extras
+      size_t i = 0;
+      for (; i < numElements && i < rhs.numElements; i++)
+         data[i] = rhs.data[i];
+      for (; i < rhs.numElements; i++)
+         traits::construct(alloc, data + i, rhs.data[i]);
+      destroy(rhs.numElements, numElements);
+
+      numElements = rhs.numElements;
+   }
+   return *this;
+}
+
+/***************************************
+ * SMALL VECTOR :: MOVE ASSIGNMENT
+ * Steal rhs's heap buffer when we can; otherwise
+ * move the elements over one at a time
+ *     INPUT  : rhs the small vector to move from
+ *     OUTPUT : *this
+ **************************************/
+template <typename T, size_t N, typename A>
+small_vector <T, N, A> & small_vector <T, N, A> :: operator = (small_vector && rhs)
+{
+   if (this != &rhs)
+   {
+      // inline elements, or a buffer our allocator did not hand out
+      if (rhs.is_inline() ||
+          (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc))
+      {
+         clear();
+         moveElements(rhs);
+         return *this;
+      }
+
+      release();
+      moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+
+      data = rhs.data;
+      numElements = rhs.numElements;
+      numCapacity = rhs.numCapacity;
+
+      rhs.data = rhs.inlineData();
+      rhs.numElements = 0;
+      rhs.numCapacity = N;
+   }
+   return *this;
+}
+
+/***************************************
+ * SMALL VECTOR :: SWAP
+ * Two heap buffers trade pointers.  Inline elements
+ * have to be moved, so go through a temporary and let
+ * the move assignments carry the allocators along.
+ *     INPUT  : rhs the small vector to trade with
+ *     OUTPUT :
+ **************************************/
+template <typename T, size_t N, typename A>
+void small_vector <T, N, A> :: swap(small_vector & rhs)
+{
+   // unequal allocators that do not propagate cannot trade buffers
+   assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+
+   if (!is_inline() && !rhs.is_inline())
+   {
+      if (traits::propagate_on_container_swap::value)
+         std::swap(alloc, rhs.alloc);
+      std::swap(data, rhs.data);
+      std::swap(numElements, rhs.numElements);
+      std::swap(numCapacity, rhs.numCapacity);
+      return;
+   }
+
+   small_vector temp(std::move(rhs));
+   rhs   = std::move(*this);
+   *this = std::move(temp);
+}
+
+} // namespace custom
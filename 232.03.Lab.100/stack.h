@@ -12,17 +12,26 @@
  *    |_____|  '.____.'   '.____.'  /_/
  *
  *
+ *    The elements live in a Container, custom::vector unless told
+ *    otherwise.  custom::deque works too, and so does chunk_stack,
+ *    which grows a chunk at a time and never moves an element: the
+ *    one to pick for stacks that get very deep.  A stack built from
+ *    a Container it may move from takes that Container's storage
+ *    as it is, without copying an element.
+ *
  *    This will contain the class definition of:
  *       stack             : similar to std::stack
  * Author
- *    Ryan Whitehead, Cesar Tavarez
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
  ************************************************************************/
 
 #pragma once
 
 #include <cassert>  // because I am paranoid
-//#include "vector.h"
-#include <vector>
+#include <cstddef>  // for size_t
+#include <utility>  // for std::move and std::swap
+#include "vector.h"
+#include "chunk_stack.h"
 
 class TestStack; // forward declaration for unit tests
 
@@ -31,9 +40,12 @@ namespace custom
 
 /**************************************************
  * STACK
- * First-in-Last-out data structure
+ * First-in-Last-out data structure, kept in any
+ * Container with push_back, pop_back, and back, such
+ * as custom::vector, custom::small_vector,
+ * custom::deque, or custom::chunk_stack
  *************************************************/
-template<class T>
+template<class T, class Container = custom::vector<T>>
 class stack
 {
    friend class ::TestStack; // give unit tests access to the privates
@@ -43,55 +55,38 @@ public:
    // Construct
    // 
 
-   stack()                            { container.resize(0); }
-   stack(const stack <T>& rhs) { container = rhs.container; }
-   stack(      stack <T> && rhs)      {
-      container = std::move(rhs.container);
-      rhs.container.clear();
-   }
-   stack(const std::vector<T> &  rhs) 
-   { 
-      container.resize(0);
-      for (int i = 0; i < rhs.size(); i++)
-      {
-         container.push_back(rhs[i]);
-      }
-   }
-   stack(      std::vector<T> && rhs) 
-   {
-      container.resize(0);
-      for (int i = 0; i < rhs.size(); i++)
-      {
-         container.push_back(rhs[i]);
-      }
-   }
+   stack()                       : container()                         {}
+   stack(const stack &  rhs)     : container(rhs.container)            {}
+   stack(      stack && rhs)     : container(std::move(rhs.container)) {}
+   stack(const Container &  rhs) : container(rhs)                      {}
+   stack(      Container && rhs) : container(std::move(rhs))           {}
    ~stack()                           {                      }
 
    //
    // Assign
    //
 
-   stack <T> & operator = (const stack <T> & rhs)
+   stack & operator = (const stack & rhs)
    {
       container = rhs.container;
       return *this;
    }
-   stack <T>& operator = (stack <T> && rhs)
+   stack& operator = (stack && rhs)
    {
       container = std::move(rhs.container);
       return *this;
    }
-   void swap(stack <T>& rhs)
+   void swap(stack& rhs)
    {
-      std::swap(container, rhs.container);
+      container.swap(rhs.container);
    }
 
    // 
    // Access
    //
 
-         T& top()       { return container[container.size() - 1]; }
-   const T& top() const { return container[container.size() - 1]; }
+         T& top()       { return container.back(); }
+   const T& top() const { return container.back(); }
 
    // 
    // Insert
@@ -117,7 +112,7 @@ public:
    
 private:
    
-  std::vector<T> container;  // underlying container
+  Container container;  // underlying container
 };
 
 
@@ -0,0 +1,283 @@
+/***********************************************************************
+ * Header:
+ *    STATIC STACK
+ * Summary:
+ *    A stack of at most N elements kept inside the object itself,
+ *    built in place in raw storage as they are pushed.  A recursive
+ *    descent or a depth-first search whose depth is known up front
+ *    can put one on the call stack and never touch the heap.
+ *
+ *    What happens at the N+1st push is up to the Overflow policy:
+ *        overflow_assert : a debug build stops; a release build does
+ *                          not check at all, and pushing past N is an
+ *                          error just like indexing past the end of
+ *                          an array
+ *        overflow_throw  : std::length_error, and nothing is pushed
+ *        overflow_spill  : the rest go on the heap in a chunk_stack,
+ *                          so the first N still never move
+ *
+ *    This will contain the class definition of:
+ *        static_stack      : a stack in N inline slots
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstddef>      // for size_t
+#include <new>          // for placement new
+#include <stdexcept>    // for std::length_error
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::forward and std::move
+#include "chunk_stack.h"
+
+class TestStaticStack; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * OVERFLOW POLICIES
+ * What a static_stack does when it is full
+ ****************************************/
+struct overflow_assert {};
+struct overflow_throw  {};
+struct overflow_spill  {};
+
+/*****************************************
+ * OVERFLOW AREA
+ * Where the elements past N go: nowhere, unless
+ * the policy is to spill.  static_stack inherits
+ * this, so the empty one takes no room.
+ ****************************************/
+template <typename T, typename Overflow>
+struct overflow_area {};
+
+template <typename T>
+struct overflow_area <T, overflow_spill>
+{
+   chunk_stack<T> heap;
+};
+
+/*****************************************
+ * STATIC STACK
+ * The push, pop, top, and size of custom::stack,
+ * in N slots that are part of the object
+ ****************************************/
+template <typename T, size_t N, typename Overflow = overflow_assert>
+class static_stack : private overflow_area<T, Overflow>
+{
+   static_assert(N > 0, "a static_stack needs room for at least one element");
+   friend class ::TestStaticStack; // give unit tests access to the privates
+public:
+   using value_type = T;
+
+   //
+   // Construct
+   //
+
+   static_stack() : numElements(0) {}
+   static_stack(const static_stack &  rhs);
+   static_stack(      static_stack && rhs);
+   ~static_stack() { clear(); }
+
+   //
+   // Assign
+   //
+
+   static_stack & operator = (const static_stack & rhs);
+   static_stack & operator = (static_stack && rhs);
+   void swap(static_stack & rhs)
+   {
+      static_stack tmp(std::move(rhs));
+      rhs   = std::move(*this);
+      *this = std::move(tmp);
+   }
+
+   //
+   // Access
+   //
+
+         T& top()       { assert(numElements > 0); return top(Overflow()); }
+   const T& top() const { assert(numElements > 0); return const_cast<static_stack *>(this)->top(Overflow()); }
+
+   //
+   // Insert
+   //
+
+   void push(const T & t) { emplace(t);            }
+   void push(T && t)      { emplace(std::move(t)); }
+   template <class ... Args>
+   void emplace(Args && ... args) { place(Overflow(), std::forward<Args>(args)...); }
+
+   //
+   // Remove
+   //
+
+   void pop()
+   {
+      if (numElements > 0)
+         pop(Overflow());
+   }
+   void clear()
+   {
+      while (numElements > 0)
+         pop(Overflow());
+   }
+
+   //
+   // Status
+   //
+
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+
+   // static-stack-specific interfaces
+
+   // the number of inline slots
+   static size_t capacity() { return N; }
+   // are all the elements in the inline slots?
+   bool is_inline() const { return numElements <= N; }
+
+private:
+
+   // inline slot i, raw storage until something is built there
+         T & slot(size_t i)       { return *reinterpret_cast<      T *>(storage + i); }
+   const T & slot(size_t i) const { return *reinterpret_cast<const T *>(storage + i); }
+
+   // take the elements of rhs, leaving it empty
+   void take(static_stack & rhs);
+
+   // every slot is inline: the policies that never spill
+   template <class Policy>
+   T & top(Policy) { return slot(numElements - 1); }
+   template <class Policy>
+   void pop(Policy)
+   {
+      numElements--;
+      slot(numElements).~T();
+   }
+
+   // past N, the top is on the heap
+   T & top(overflow_spill)
+   {
+      return numElements > N ? this->heap.back() : slot(numElements - 1);
+   }
+   void pop(overflow_spill)
+   {
+      if (numElements > N)
+         this->heap.pop_back();
+      else
+         slot(numElements - 1).~T();
+      numElements--;
+   }
+
+   // full is a bug; release builds do not even look
+   template <class ... Args>
+   void place(overflow_assert, Args && ... args)
+   {
+      assert(numElements < N && "static_stack is full");
+      new (storage + numElements) T(std::forward<Args>(args)...);
+      numElements++;
+   }
+
+   // full is an error the caller can handle
+   template <class ... Args>
+   void place(overflow_throw, Args && ... args)
+   {
+      if (numElements == N)
+         throw std::length_error("static_stack is full");
+      new (storage + numElements) T(std::forward<Args>(args)...);
+      numElements++;
+   }
+
+   // full is fine; the rest go on the heap
+   template <class ... Args>
+   void place(overflow_spill, Args && ... args)
+   {
+      if (numElements < N)
+         new (storage + numElements) T(std::forward<Args>(args)...);
+      else
+         this->heap.emplace_back(std::forward<Args>(args)...);
+      numElements++;
+   }
+
+   typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[N];
+   size_t numElements;   // inline and spilled together
+};
+
+/*****************************************
+ * STATIC STACK :: COPY CONSTRUCTOR
+ * One element at a time, each into the same place
+ ****************************************/
+template <typename T, size_t N, typename Overflow>
+static_stack <T, N, Overflow> :: static_stack(const static_stack & rhs)
+   : overflow_area<T, Overflow>(rhs), numElements(0)
+{
+   for (size_t i = 0; i < rhs.numElements && i < N; i++)
+      new (storage + i) T(rhs.slot(i));
+   numElements = rhs.numElements;
+}
+
+/*****************************************
+ * STATIC STACK :: MOVE CONSTRUCTOR
+ * The inline elements are part of rhs, so each has
+ * to be moved across; anything spilled is taken as
+ * it is.  rhs is left empty.
+ ****************************************/
+template <typename T, size_t N, typename Overflow>
+static_stack <T, N, Overflow> :: static_stack(static_stack && rhs)
+   : numElements(0)
+{
+   take(rhs);
+}
+
+/*****************************************
+ * STATIC STACK :: ASSIGNMENT
+ * Start over, then copy or move each element
+ ****************************************/
+template <typename T, size_t N, typename Overflow>
+static_stack <T, N, Overflow> & static_stack <T, N, Overflow> :: operator = (const static_stack & rhs)
+{
+   if (this != &rhs)
+   {
+      static_stack copy(rhs);
+      *this = std::move(copy);
+   }
+   return *this;
+}
+
+template <typename T, size_t N, typename Overflow>
+static_stack <T, N, Overflow> & static_stack <T, N, Overflow> :: operator = (static_stack && rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      take(rhs);
+   }
+   return *this;
+}
+
+/*****************************************
+ * STATIC STACK :: TAKE
+ * Move the inline elements across one at a time and
+ * the spilled ones, if any, all at once.  We must be
+ * empty to begin with.
+ ****************************************/
+template <typename T, size_t N, typename Overflow>
+void static_stack <T, N, Overflow> :: take(static_stack & rhs)
+{
+   assert(numElements == 0);
+   static_cast<overflow_area<T, Overflow> &>(*this) = std::move(rhs);
+   for (size_t i = 0; i < rhs.numElements && i < N; i++)
+      new (storage + i) T(std::move(rhs.slot(i)));
+   numElements = rhs.numElements;
+
+   // only the inline ones are left for rhs to destroy
+   if (rhs.numElements > N)
+      rhs.numElements = N;
+   rhs.clear();
+}
+
+} // namespace custom
@@ -0,0 +1,279 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT STACK
+ * Summary:
+ *    Unit tests for concurrent_stack
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrent_stack.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestConcurrentStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_empty();
+      test_destructor_destroysAll();
+
+      // Push and pop
+      test_pop_lastIn();
+      test_pop_movesOut();
+      test_pop_reusesNodes();
+      test_scan_skipsHazards();
+
+      // Threads
+      test_pushPop_manyThreads();
+      test_pool_manyThreads();
+      test_record_adoptedAfterExit();
+
+      report("ConcurrentStack");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // nothing on the stack, so nothing to pop
+   void test_construct_empty()
+   {  // setup
+      // exercise
+      custom::concurrent_stack<int> s;
+      // verify
+      int t = 99;
+      assertUnit(s.empty());
+      assertUnit(s.pHead.load() == nullptr);
+      assertUnit(!s.pop(t));
+      assertUnit(t == 99);
+   }  // teardown
+
+   // every element still on the stack is destroyed with it
+   void test_destructor_destroysAll()
+   {  // setup
+      {
+         custom::concurrent_stack<Spy> s;
+         s.push(Spy(26));
+         s.push(Spy(49));
+         s.push(Spy(67));
+         Spy::reset();
+         // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+   }  // teardown
+
+   /***************************************
+    * PUSH AND POP
+    ***************************************/
+
+   // the last pushed is the first popped
+   void test_pop_lastIn()
+   {  // setup
+      custom::concurrent_stack<int> s;
+      s.push(26);
+      s.push(49);
+      s.push(67);
+      int a = 0;
+      int b = 0;
+      int c = 0;
+      int d = 0;
+      // exercise
+      bool popped = s.pop(a) && s.pop(b) && s.pop(c);
+      // verify
+      assertUnit(popped);
+      assertUnit(a == 67);
+      assertUnit(b == 49);
+      assertUnit(c == 26);
+      assertUnit(!s.pop(d));
+      assertUnit(s.empty());
+   }  // teardown
+
+   // popping moves the element out and destroys what is left of it
+   void test_pop_movesOut()
+   {  // setup
+      custom::concurrent_stack<Spy> s;
+      s.emplace(26);
+      Spy t;
+      Spy::reset();
+      // exercise
+      bool popped = s.pop(t);
+      // verify
+      assertUnit(popped);
+      assertUnit(t == Spy(26));
+      assertUnit(Spy::numAssignMove() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 2);   // the husk, and the Spy(26) compared against
+   }  // teardown
+
+   // popped nodes come back for later pushes once a scan clears them
+   void test_pop_reusesNodes()
+   {  // setup
+      typedef custom::concurrent_stack<int> Stack;
+      Stack s;
+      Stack::Record * pRecord = Stack::record();
+      int t = 0;
+      // exercise
+      for (int i = 0; i < 500; i++)
+      {
+         s.push(i);
+         s.pop(t);
+      }
+      // verify
+      assertUnit(pRecord->numFree > 0);
+      assertUnit(pRecord->retired.size() < 500);
+      Stack::Node * pNext = pRecord->pFree;
+      s.push(26);
+      assertUnit(s.pHead.load() == pNext);
+      assertUnit(s.pop(t) && t == 26);
+   }  // teardown
+
+   // a node named by any hazard stays retired
+   void test_scan_skipsHazards()
+   {  // setup
+      typedef custom::concurrent_stack<int> Stack;
+      Stack s;
+      Stack::Record * pRecord = Stack::record();
+      Stack::scan(pRecord);
+      assert(pRecord->retired.empty());
+      s.push(26);
+      Stack::Node * p = s.pHead.load();
+      int t = 0;
+      s.pop(t);
+      // exercise
+      pRecord->hazard.store(p);
+      Stack::scan(pRecord);
+      // verify
+      assertUnit(pRecord->retired.size() == 1);
+      assertUnit(pRecord->retired[0] == p);
+      pRecord->hazard.store(nullptr);
+      Stack::scan(pRecord);
+      assertUnit(pRecord->retired.empty());
+      assertUnit(pRecord->pFree == p);
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // everything pushed from many threads is popped exactly once
+   void test_pushPop_manyThreads()
+   {  // setup
+      custom::concurrent_stack<int> s;
+      const int numThreads = 8;
+      const int numEach = 10000;
+      std::vector<int> popped[numThreads];
+      std::thread threads[numThreads];
+      // exercise
+      for (int n = 0; n < numThreads; n++)
+         threads[n] = std::thread([&s, &popped, n, numEach]()
+         {
+            for (int i = 0; i < numEach; i++)
+               s.push(n * numEach + i);
+            int t;
+            while (s.pop(t))
+               popped[n].push_back(t);
+         });
+      for (int n = 0; n < numThreads; n++)
+         threads[n].join();
+      // verify
+      std::vector<int> all;
+      for (int n = 0; n < numThreads; n++)
+         all.insert(all.end(), popped[n].begin(), popped[n].end());
+      std::sort(all.begin(), all.end());
+      bool each = true;
+      for (size_t i = 0; i < all.size(); i++)
+         each = each && all[i] == static_cast<int>(i);
+      assertUnit(all.size() == numThreads * numEach);
+      assertUnit(each);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // an object pool: take one, use it, put it back, over and over
+   struct Checked
+   {
+      Checked(int value = 0) : value(value), check(~value) {}
+      bool whole() const { return check == ~value; }
+      int value;
+      int check;
+   };
+   void test_pool_manyThreads()
+   {  // setup
+      custom::concurrent_stack<Checked> pool;
+      const int numObjects = 16;
+      const int numThreads = 8;
+      for (int i = 0; i < numObjects; i++)
+         pool.push(Checked(i));
+      bool whole[numThreads];
+      std::thread threads[numThreads];
+      // exercise
+      for (int n = 0; n < numThreads; n++)
+         threads[n] = std::thread([&pool, &whole, n]()
+         {
+            whole[n] = true;
+            Checked c;
+            for (int i = 0; i < 20000; i++)
+               if (pool.pop(c))
+               {
+                  whole[n] = whole[n] && c.whole();
+                  pool.push(c);
+               }
+         });
+      for (int n = 0; n < numThreads; n++)
+         threads[n].join();
+      // verify
+      bool allWhole = true;
+      for (int n = 0; n < numThreads; n++)
+         allWhole = allWhole && whole[n];
+      std::vector<int> values;
+      Checked c;
+      while (pool.pop(c))
+         values.push_back(c.value);
+      std::sort(values.begin(), values.end());
+      assertUnit(allWhole);
+      assertUnit(values.size() == numObjects);
+      assertUnit(std::unique(values.begin(), values.end()) == values.end());
+   }  // teardown
+
+   // a thread that exits hands its record on to the next one
+   void test_record_adoptedAfterExit()
+   {  // setup
+      typedef custom::concurrent_stack<double> Stack;
+      Stack s;
+      Stack::Record * pFirst = nullptr;
+      Stack::Record * pSecond = nullptr;
+      std::thread([&s, &pFirst]()
+      {
+         s.push(2.6);
+         pFirst = Stack::record();
+      }).join();
+      size_t numRecords = Stack::domain().numRecords.load();
+      // exercise
+      std::thread([&s, &pSecond]()
+      {
+         double t;
+         s.pop(t);
+         pSecond = Stack::record();
+      }).join();
+      // verify
+      assertUnit(pSecond == pFirst);
+      assertUnit(Stack::domain().numRecords.load() == numRecords);
+      assertUnit(s.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
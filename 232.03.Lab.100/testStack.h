@@ -11,6 +11,8 @@
 
 #ifdef DEBUG
 #include "stack.h"
+#include "deque.h"
+#include "small_vector.h"
 #include "unitTest.h"
 #include "spy.h"
 
@@ -77,6 +79,16 @@ public:
       test_empty_empty();
       test_empty_standard();
 
+      // Containers
+      test_constructContainer_copies();
+      test_constructContainer_adopts();
+      test_chunk_pushKeepsAddresses();
+      test_chunk_popKeepsSpare();
+      test_chunk_copyMove();
+      test_chunk_assignMove();
+      test_deque_standard();
+      test_smallVector_pushPastInline();
+
       report("Stack");
    }
    
@@ -1201,6 +1213,181 @@ public:
       teardownStandardFixture(s);
    }
 
+
+   /***************************************
+    * CONTAINERS
+    ***************************************/
+
+   // building from a container we may not move from copies each element once
+   void test_constructContainer_copies()
+   {  // setup
+      custom::vector<Spy> v{Spy(26), Spy(49), Spy(67), Spy(89)};
+      Spy::reset();
+      // exercise
+      custom::stack<Spy> s(v);
+      // verify
+      assertUnit(Spy::numCopy() == 4);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(v.size() == 4);
+      assertStandardFixture(s);
+   }  // teardown
+
+   // building from a container we may move from takes its buffer as it is
+   void test_constructContainer_adopts()
+   {  // setup
+      custom::vector<Spy> v{Spy(26), Spy(49), Spy(67), Spy(89)};
+      Spy * p = v.data;
+      Spy::reset();
+      // exercise
+      custom::stack<Spy> s(std::move(v));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(s.container.data == p);
+      assertUnit(v.size() == 0);
+      assertStandardFixture(s);
+   }  // teardown
+
+   // growing past a chunk moves nothing that is already on the stack
+   void test_chunk_pushKeepsAddresses()
+   {  // setup
+      custom::stack<Spy, custom::chunk_stack<Spy, 4>> s;
+      s.push(Spy(26));
+      Spy * pBottom = &s.top();
+      Spy::reset();
+      // exercise
+      for (int i = 0; i < 10; i++)
+         s.push(Spy(i));
+      // verify
+      assertUnit(Spy::numCopyMove() == 10);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(s.size() == 11);
+      assertUnit(s.top() == Spy(9));
+      assertUnit(s.container.pTop != s.container.pBottom);
+      for (int i = 0; i < 10; i++)
+         s.pop();
+      assertUnit(&s.top() == pBottom);
+      assertUnit(s.top() == Spy(26));
+   }  // teardown
+
+   // popping out of a chunk keeps it for the next push
+   void test_chunk_popKeepsSpare()
+   {  // setup
+      //    +----+----+----+----+    +----+
+      //    | 26 | 49 | 67 | 89 | -> | 11 |
+      //    +----+----+----+----+    +----+
+      custom::stack<int, custom::chunk_stack<int, 4>> s;
+      s.push(26);
+      s.push(49);
+      s.push(67);
+      s.push(89);
+      s.push(11);
+      auto pSpare = s.container.pTop;
+      // exercise
+      s.pop();
+      s.push(31);
+      // verify
+      assertUnit(s.container.pTop == pSpare);
+      assertUnit(s.container.numTop == 1);
+      assertUnit(s.top() == 31);
+      s.pop();
+      s.pop();
+      assertUnit(s.top() == 67);
+      assertUnit(s.container.pTop == s.container.pBottom);
+      assertUnit(s.container.pBottom->pNext == pSpare);
+   }  // teardown
+
+   // a copy gets its own chunks, a move takes them
+   void test_chunk_copyMove()
+   {  // setup
+      custom::stack<int, custom::chunk_stack<int, 4>> sSrc;
+      for (int i = 0; i < 10; i++)
+         sSrc.push(i);
+      auto pBottom = sSrc.container.pBottom;
+      // exercise
+      custom::stack<int, custom::chunk_stack<int, 4>> sCopy(sSrc);
+      custom::stack<int, custom::chunk_stack<int, 4>> sMove(std::move(sSrc));
+      // verify
+      assertUnit(sCopy.size() == 10);
+      assertUnit(sCopy.container.pBottom != pBottom);
+      assertUnit(sMove.size() == 10);
+      assertUnit(sMove.container.pBottom == pBottom);
+      assertUnit(sSrc.empty());
+      bool same = true;
+      for (int i = 9; i >= 0; i--)
+      {
+         same = same && sCopy.top() == i && sMove.top() == i;
+         sCopy.pop();
+         sMove.pop();
+      }
+      assertUnit(same);
+      assertUnit(sCopy.empty());
+   }  // teardown
+
+   // move assignment frees our chunks and takes those of rhs; onto itself it does nothing
+   void test_chunk_assignMove()
+   {  // setup
+      custom::chunk_stack<int, 4> sSrc;
+      custom::chunk_stack<int, 4> sDest;
+      for (int i = 0; i < 10; i++)
+         sSrc.push_back(i);
+      for (int i = 0; i < 6; i++)
+         sDest.push_back(-i);
+      auto pBottom = sSrc.pBottom;
+      // exercise
+      sDest = std::move(sSrc);
+      sDest = std::move(sDest);
+      // verify
+      assertUnit(sDest.size() == 10);
+      assertUnit(sDest.pBottom == pBottom);
+      assertUnit(sDest.back() == 9);
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.pBottom == nullptr);
+      sSrc.push_back(26);
+      assertUnit(sSrc.back() == 26);
+   }  // teardown
+
+   // custom::deque holds a stack just as well
+   void test_deque_standard()
+   {  // setup
+      custom::stack<int, custom::deque<int>> s;
+      // exercise
+      s.push(26);
+      s.push(49);
+      s.push(67);
+      s.pop();
+      // verify
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == 49);
+      assertUnit(!s.empty());
+   }  // teardown
+
+   // a small_vector spills to the heap past its 4 slots and pops back in order
+   void test_smallVector_pushPastInline()
+   {  // setup
+      custom::stack<int, custom::small_vector<int, 4>> s;
+      for (int i = 0; i < 10; i++)
+         s.push(i);
+      assertUnit(!s.container.is_inline());
+      assertUnit(s.size() == 10);
+      // exercise
+      bool inOrder = true;
+      for (int i = 9; i >= 0; i--)
+      {
+         inOrder = inOrder && s.top() == i;
+         s.pop();
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+   }  // teardown
+
    
    /*************************************************************
     * SETUP STANDARD FIXTURE
@@ -0,0 +1,224 @@
+/***********************************************************************
+ * Header:
+ *    TEST STATIC STACK
+ * Summary:
+ *    Unit tests for static_stack and its overflow policies
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "static_stack.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <stdexcept>
+
+class TestStaticStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_noHeap();
+      test_constructCopy_standard();
+      test_constructMove_spilled();
+      test_destructor_destroysAll();
+
+      // Push and pop
+      test_push_inPlace();
+      test_pop_destroys();
+      test_swap_sizes();
+
+      // Overflow
+      test_overflowThrow_unchanged();
+      test_overflowSpill_keepsInline();
+
+      report("StaticStack");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // the slots are the object; nothing is built in them yet
+   void test_construct_noHeap()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::static_stack<Spy, 4> s;
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(s.empty());
+      assertUnit(s.capacity() == 4);
+      assertUnit(sizeof(custom::static_stack<int, 8>) == sizeof(int) * 8 + sizeof(size_t));
+      assertUnit(sizeof(custom::static_stack<int, 8, custom::overflow_throw>) == sizeof(int) * 8 + sizeof(size_t));
+   }  // teardown
+
+   // a copy builds each element afresh
+   void test_constructCopy_standard()
+   {  // setup
+      custom::static_stack<Spy, 4> sSrc;
+      sSrc.push(Spy(26));
+      sSrc.push(Spy(49));
+      Spy::reset();
+      // exercise
+      custom::static_stack<Spy, 4> sDest(sSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 2);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(sDest.size() == 2);
+      assertUnit(sDest.top() == Spy(49));
+      assertUnit(sSrc.size() == 2);
+   }  // teardown
+
+   // a move takes the inline elements one by one and the spilled ones whole
+   void test_constructMove_spilled()
+   {  // setup
+      custom::static_stack<Spy, 2, custom::overflow_spill> sSrc;
+      sSrc.push(Spy(26));
+      sSrc.push(Spy(49));
+      sSrc.push(Spy(67));
+      sSrc.push(Spy(89));
+      Spy * pSpilled = &sSrc.top();
+      Spy::reset();
+      // exercise
+      custom::static_stack<Spy, 2, custom::overflow_spill> sDest(std::move(sSrc));
+      // verify
+      assertUnit(Spy::numCopyMove() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(&sDest.top() == pSpilled);
+      assertUnit(sDest.size() == 4);
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.heap.empty());
+   }  // teardown
+
+   // everything pushed is destroyed with the stack, spilled or not
+   void test_destructor_destroysAll()
+   {  // setup
+      {
+         custom::static_stack<Spy, 2, custom::overflow_spill> s;
+         s.push(Spy(26));
+         s.push(Spy(49));
+         s.push(Spy(67));
+         Spy::reset();
+         // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+   }  // teardown
+
+   /***************************************
+    * PUSH AND POP
+    ***************************************/
+
+   // each push builds right in the object's own slots
+   void test_push_inPlace()
+   {  // setup
+      custom::static_stack<Spy, 4> s;
+      Spy::reset();
+      // exercise
+      s.push(Spy(26));
+      s.emplace(49);
+      // verify
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(Spy::numNondefault() == 2);
+      assertUnit(Spy::numAlloc() == 2);   // the Spys' own values, not the stack
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == Spy(49));
+      assertUnit(reinterpret_cast<char *>(&s.top()) > reinterpret_cast<char *>(&s));
+      assertUnit(reinterpret_cast<char *>(&s.top()) < reinterpret_cast<char *>(&s + 1));
+   }  // teardown
+
+   // pop destroys the top in place; popping nothing does nothing
+   void test_pop_destroys()
+   {  // setup
+      custom::static_stack<Spy, 4> s;
+      s.push(Spy(26));
+      s.push(Spy(49));
+      Spy::reset();
+      // exercise
+      s.pop();
+      s.pop();
+      s.pop();
+      // verify
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(s.empty());
+   }  // teardown
+
+   // swapping stacks of different sizes
+   void test_swap_sizes()
+   {  // setup
+      custom::static_stack<int, 4> a;
+      custom::static_stack<int, 4> b;
+      a.push(26);
+      b.push(49);
+      b.push(67);
+      b.push(89);
+      // exercise
+      a.swap(b);
+      // verify
+      assertUnit(a.size() == 3);
+      assertUnit(a.top() == 89);
+      assertUnit(b.size() == 1);
+      assertUnit(b.top() == 26);
+   }  // teardown
+
+   /***************************************
+    * OVERFLOW
+    ***************************************/
+
+   // a full stack throws and keeps what it had
+   void test_overflowThrow_unchanged()
+   {  // setup
+      custom::static_stack<int, 2, custom::overflow_throw> s;
+      s.push(26);
+      s.push(49);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         s.push(67);
+      }
+      catch (const std::length_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(s.size() == 2);
+      assertUnit(s.top() == 49);
+   }  // teardown
+
+   // spilling goes to the heap and back without moving the inline ones
+   void test_overflowSpill_keepsInline()
+   {  // setup
+      custom::static_stack<int, 2, custom::overflow_spill> s;
+      s.push(26);
+      s.push(49);
+      int * pInline = &s.top();
+      // exercise
+      for (int i = 0; i < 10; i++)
+         s.push(i);
+      // verify
+      assertUnit(s.size() == 12);
+      assertUnit(!s.is_inline());
+      assertUnit(s.top() == 9);
+      assertUnit(s.heap.size() == 10);
+      for (int i = 0; i < 10; i++)
+         s.pop();
+      assertUnit(s.is_inline());
+      assertUnit(&s.top() == pInline);
+      assertUnit(s.top() == 49);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -15,6 +15,7 @@
  *    This will contain the class definition of:
  *        vector                 : A class that represents a Vector
  *        vector::iterator       : An interator through Vector
+ *        vector::const_iterator : The same, read only
  * Author
  *    <your names here>
  ************************************************************************/
@@ -24,6 +25,11 @@
 #include <cassert>  // because I am paranoid
 #include <new>      // std::bad_alloc
 #include <memory>   // for std::allocator
+#include <utility>  // for std::move and std::swap
+#include <cstring>  // for std::memcpy
+#include <type_traits> // for std::is_trivially_copyable
+#include <iterator> // for std::distance and the iterator categories
+#include "growth.h" // for the growth policies and growth_stats
 
 class TestVector; // forward declaration for unit tests
 class TestStack;
@@ -34,10 +40,26 @@ namespace custom
 {
 
 /*****************************************
- * VECTOR
- * Just like the std :: vector <T> class
+ * IS TRIVIALLY RELOCATABLE
+ * A type whose bytes can be memcpy'd to a new address, after which
+ * the old copy is simply forgotten without calling its destructor.
+ * Trivially copyable types qualify automatically.  Other types that
+ * hold no pointers to themselves may opt in by specializing this
+ * inside namespace custom:
+ *    template <> struct is_trivially_relocatable<Foo> : std::true_type {};
  ****************************************/
 template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/*****************************************
+ * VECTOR
+ * Just like the std :: vector <T> class.  G picks how
+ * much the buffer grows when it is full: grow_double,
+ * grow_by_half, or grow_page from growth.h.  With
+ * grow_incremental the elements move to the new buffer
+ * a few at a time; see vector_incremental.h.
+ ****************************************/
+template <typename T, typename A = std::allocator<T>, typename G = grow_double>
 class vector
 {
    friend class ::TestVector; // give unit tests access to the privates
@@ -45,15 +67,17 @@ class vector
    friend class ::TestPQueue;
    friend class ::TestHash;
 public:
-   
-   // 
+   using value_type     = T;
+   using allocator_type = A;
+
+   //
    // Construct
    //
 
-   vector();
-   vector(size_t numElements                );
-   vector(size_t numElements, const T & t   );
-   vector(const std::initializer_list<T>& l );
+   vector(const A & a = A());
+   vector(size_t numElements,                const A & a = A());
+   vector(size_t numElements, const T& t,    const A & a = A());
+   vector(const std::initializer_list<T>& l, const A & a = A());
    vector(const vector &  rhs);
    vector(      vector && rhs);
    ~vector();
@@ -64,7 +88,14 @@ public:
 
    void swap(vector& rhs)
    {
-
+      // unequal allocators that do not propagate cannot trade buffers
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+      std::swap(data, rhs.data);
+      std::swap(numElements, rhs.numElements);
+      std::swap(numCapacity, rhs.numCapacity);
+      notePeak();
+      rhs.notePeak();
    }
    vector & operator = (const vector & rhs);
    vector& operator = (vector&& rhs);
@@ -74,16 +105,21 @@ public:
    //
 
    class iterator;
-   iterator       begin() { return iterator(); }
-   iterator       end() { return iterator(); }
+   class const_iterator;
+   iterator       begin()        { return iterator(data); }
+   iterator       end()          { return iterator(data+numElements); }
+   const_iterator begin()  const { return const_iterator(data); }
+   const_iterator end()    const { return const_iterator(data+numElements); }
+   const_iterator cbegin() const { return const_iterator(data); }
+   const_iterator cend()   const { return const_iterator(data+numElements); }
 
    //
    // Access
    //
 
-         T& operator [] (size_t index);
+   T& operator [] (size_t index);
    const T& operator [] (size_t index) const;
-         T& front();
+   T& front();
    const T& front() const;
          T& back();
    const T& back() const;
@@ -94,6 +130,22 @@ public:
 
    void push_back(const T& t);
    void push_back(T&& t);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   template <class ... Args>
+   iterator emplace(iterator pos, Args && ... args);
+   iterator insert(iterator pos, const T & t) { return emplace(pos, t);            }
+   iterator insert(iterator pos, T && t)      { return emplace(pos, std::move(t)); }
+   template <class Iterator>
+   iterator insert(iterator pos, Iterator first, Iterator last)
+   {
+      return insertRange(pos.p - data, first, last,
+                         typename std::iterator_traits<Iterator>::iterator_category());
+   }
+   iterator insert(iterator pos, const std::initializer_list<T> & l)
+   {
+      return insert(pos, l.begin(), l.end());
+   }
    void reserve(size_t newCapacity);
    void resize(size_t newElements);
    void resize(size_t newElements, const T& t);
@@ -104,110 +156,279 @@ public:
 
    void clear()
    {
+      destroy(0, numElements);
+      numElements = 0;
    }
    void pop_back()
    {
+      if (numElements > 0)
+      {
+         numElements--;
+         traits::destroy(alloc, data + numElements);
+      }
    }
+   iterator erase(iterator pos)                 { return erase(pos, iterator(pos.p + 1)); }
+   iterator erase(iterator first, iterator last);
    void shrink_to_fit();
 
    //
    // Status
    //
 
-   size_t  size()          const { return 999;}
-   size_t  capacity()      const { return 999;}
-   bool empty()            const { return true;}
-   
+   size_t  size()          const { return numElements; }
+   size_t  capacity()      const { return numCapacity; }
+   bool empty()            const { return (numElements == 0); }
+   A    get_allocator()    const { return alloc; }
+
+   // how the growth policy has done for this vector
+   const growth_stats & stats() const { return telemetry;          }
+   void reset_stats()                 { telemetry = growth_stats(); notePeak(); }
+
    // adjust the size of the buffer
-   
+
    // vector-specific interfaces
-   
+
 private:
-   
-   T *  data;                 // user data, a dynamically-allocated array
-   size_t  numCapacity;       // the capacity of the array
-   size_t  numElements;       // the number of items currently used
-};
 
-/**************************************************
- * VECTOR ITERATOR
- * An iterator through vector.  You only need to
- * support the following:
- *   1. Constructors (default and copy)
- *   2. Not equals operator
- *   3. Increment (prefix and postfix)
- *   4. Dereference
- * This particular iterator is a bi-directional meaning
- * that ++ and -- both work.  Not all iterators are that way.
- *************************************************/
-template <typename T>
-class vector <T> ::iterator
-{
-   friend class ::TestVector; // give unit tests access to the privates
-   friend class ::TestStack;
-   friend class ::TestPQueue;
-   friend class ::TestHash;
-public:
-   // constructors, destructors, and assignment operator
-   iterator()                           { this->p = new T; }
-   iterator(T* p)                       { this->p = new T; }
-   iterator(const iterator& rhs)        { this->p = new T; }
-   iterator(size_t index, vector<T>& v) { this->p = new T; }
-   iterator& operator = (const iterator& rhs)
+   // the buffer is raw storage: only slots [0, numElements) hold live objects
+   using traits = std::allocator_traits<A>;
+
+   // call the destructor on the slots [begin, end)
+   void destroy(size_t begin, size_t end)
    {
-      this->p = new T;
-      return *this;
+      for (size_t i = begin; i < end; i++)
+         traits::destroy(alloc, data + i);
    }
 
-   // equals, not equals operator
-   bool operator != (const iterator& rhs) const { return true; }
-   bool operator == (const iterator& rhs) const { return true; }
+   // move the live elements into a new buffer of newCapacity
+   void reallocate(size_t newCapacity);
 
-   // dereference operator
-   T& operator * ()
+   // move num live elements from src to the raw slots at dest, leaving
+   // the src slots dead.  The two ranges may overlap.
+   void relocate(T * dest, T * src, size_t num, std::true_type)
    {
-      return *(new T);
+      if (num > 0)
+         std::memmove(static_cast<void *>(dest), static_cast<const void *>(src),
+                      num * sizeof(T));
    }
-
-   // prefix increment
-   iterator& operator ++ ()
+   void relocate(T * dest, T * src, size_t num, std::false_type)
    {
-      return *this;
+      if (dest < src)
+         for (size_t i = 0; i < num; i++)
+         {
+            traits::construct(alloc, dest + i, std::move_if_noexcept(src[i]));
+            traits::destroy(alloc, src + i);
+         }
+      else
+         for (size_t i = num; i > 0; i--)
+         {
+            traits::construct(alloc, dest + i - 1, std::move_if_noexcept(src[i - 1]));
+            traits::destroy(alloc, src + i - 1);
+         }
    }
+   void relocate(T * dest, T * src, size_t num)
+   {
+      relocate(dest, src, num, std::integral_constant<bool,
+                                  is_trivially_relocatable<T>::value>());
+   }
+
+   // open num raw slots at index and let fill construct them one at a time
+   template <class Fill>
+   iterator insertGap(size_t index, size_t num, Fill fill);
 
-   // postfix increment
-   iterator operator ++ (int postfix)
+   // call fill on each of the num raw slots at p.  If one throws,
+   // the ones already built are destroyed before it goes on.
+   template <class Fill>
+   void fillSlots(T * p, size_t num, Fill & fill)
    {
-      return *this;
+      size_t i = 0;
+      try
+      {
+         for (; i < num; i++)
+            fill(p + i);
+      }
+      catch (...)
+      {
+         while (i > 0)
+            traits::destroy(alloc, p + --i);
+         throw;
+      }
    }
 
-   // prefix decrement
-   iterator& operator -- ()
+   // a range we can measure goes in with one gap, anything else one at a time
+   template <class Iterator>
+   iterator insertRange(size_t index, Iterator first, Iterator last,
+                        std::forward_iterator_tag);
+   template <class Iterator>
+   iterator insertRange(size_t index, Iterator first, Iterator last,
+                        std::input_iterator_tag);
+
+   // free the buffer, leaving an empty vector with no capacity
+   void release()
    {
-      return *this;
+      if (data)
+      {
+         destroy(0, numElements);
+         traits::deallocate(alloc, data, numCapacity);
+      }
+      data = nullptr;
+      numElements = numCapacity = 0;
    }
 
-   // postfix decrement
-   iterator operator -- (int postfix)
+   // remember the biggest the buffer has been
+   void notePeak()
    {
-      return *this;
+      if (numCapacity > telemetry.peakCapacity)
+         telemetry.peakCapacity = numCapacity;
    }
 
+   // the allocator follows the buffer only when its traits say so
+   void copyAlloc(const A & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const A &,     std::false_type) {                         }
+   void moveAlloc(A & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(A &,           std::false_type) {                         }
+   void swapAlloc(A & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(A &,           std::false_type) {                         }
+
+   A alloc;                   // hands out the raw, unconstructed buffer
+   T *  data;                 // user data, a dynamically-allocated array
+   size_t  numCapacity;       // the capacity of the array
+   size_t  numElements;       // the number of items currently used
+   growth_stats telemetry;    // reallocations, bytes moved, and peak capacity
+};
+
+/**************************************************
+ * VECTOR ITERATOR
+ * A random access iterator through vector.  It is a
+ * pointer in a class: it has the traits and every
+ * operator a pointer has, and is trivially copyable
+ * so it is passed in a register like one.  With
+ * optimization on, the standard algorithms run on it
+ * as fast as they do on T*.
+ *************************************************/
+template <typename T, typename A, typename G>
+class vector <T, A, G> ::iterator
+{
+   friend class ::TestVector; // give unit tests access to the privates
+   friend class ::TestStack;
+   friend class ::TestPQueue;
+   friend class ::TestHash;
+   friend class vector <T, A, G>;
+   friend class const_iterator;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+   using iterator_concept  = std::contiguous_iterator_tag;
+   using element_type      = T;
+#endif
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = T *;
+   using reference         = T &;
+
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr)              {}
+   iterator(T* p) : p(p)                {}
+   iterator(size_t index, vector& v) : p(v.data + index) {}
+
+   // comparison operators
+   bool operator == (const iterator& rhs) const { return p == rhs.p; }
+   bool operator != (const iterator& rhs) const { return p != rhs.p; }
+   bool operator <  (const iterator& rhs) const { return p <  rhs.p; }
+   bool operator >  (const iterator& rhs) const { return p >  rhs.p; }
+   bool operator <= (const iterator& rhs) const { return p <= rhs.p; }
+   bool operator >= (const iterator& rhs) const { return p >= rhs.p; }
+
+   // dereference operators
+   T& operator *  () const { return *p; }
+   T* operator -> () const { return p;  }
+   T& operator [] (difference_type n) const { return p[n]; }
+
+   // increment and decrement
+   iterator& operator ++ ()    { ++p; return *this; }
+   iterator& operator -- ()    { --p; return *this; }
+   iterator  operator ++ (int) { iterator t = *this; ++p; return t; }
+   iterator  operator -- (int) { iterator t = *this; --p; return t; }
+
+   // arithmetic
+   iterator& operator += (difference_type n)       { p += n; return *this; }
+   iterator& operator -= (difference_type n)       { p -= n; return *this; }
+   iterator  operator +  (difference_type n) const { return iterator(p + n); }
+   iterator  operator -  (difference_type n) const { return iterator(p - n); }
+   difference_type operator - (const iterator& rhs) const { return p - rhs.p; }
+   friend iterator operator + (difference_type n, const iterator& it) { return it + n; }
+
 private:
    T* p;
 };
 
+/**************************************************
+ * VECTOR CONST ITERATOR
+ * The same, for reading only.  Any iterator converts
+ * to a const_iterator, and the two compare with each other.
+ *************************************************/
+template <typename T, typename A, typename G>
+class vector <T, A, G> ::const_iterator
+{
+   friend class ::TestVector; // give unit tests access to the privates
+   friend class vector <T, A, G>;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+   using iterator_concept  = std::contiguous_iterator_tag;
+   using element_type      = const T;
+#endif
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = const T *;
+   using reference         = const T &;
+
+   const_iterator() : p(nullptr)           {}
+   const_iterator(const T* p) : p(p)       {}
+   const_iterator(const iterator& it) : p(it.p) {}
+
+   // comparison operators; an iterator on either side converts
+   friend bool operator == (const const_iterator& lhs, const const_iterator& rhs) { return lhs.p == rhs.p; }
+   friend bool operator != (const const_iterator& lhs, const const_iterator& rhs) { return lhs.p != rhs.p; }
+   friend bool operator <  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.p <  rhs.p; }
+   friend bool operator >  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.p >  rhs.p; }
+   friend bool operator <= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.p <= rhs.p; }
+   friend bool operator >= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.p >= rhs.p; }
+
+   // dereference operators
+   const T& operator *  () const { return *p; }
+   const T* operator -> () const { return p;  }
+   const T& operator [] (difference_type n) const { return p[n]; }
+
+   // increment and decrement
+   const_iterator& operator ++ ()    { ++p; return *this; }
+   const_iterator& operator -- ()    { --p; return *this; }
+   const_iterator  operator ++ (int) { const_iterator t = *this; ++p; return t; }
+   const_iterator  operator -- (int) { const_iterator t = *this; --p; return t; }
+
+   // arithmetic
+   const_iterator& operator += (difference_type n)       { p += n; return *this; }
+   const_iterator& operator -= (difference_type n)       { p -= n; return *this; }
+   const_iterator  operator +  (difference_type n) const { return const_iterator(p + n); }
+   const_iterator  operator -  (difference_type n) const { return const_iterator(p - n); }
+   friend difference_type operator - (const const_iterator& lhs, const const_iterator& rhs) { return lhs.p - rhs.p; }
+   friend const_iterator operator + (difference_type n, const const_iterator& it) { return it + n; }
+
+private:
+   const T* p;
+};
+
 /*****************************************
  * VECTOR :: DEFAULT constructors
  * Default constructor: set the number of elements,
  * construct each element, and copy the values over
  ****************************************/
-template <typename T>
-vector <T> :: vector()
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(const A & a) : alloc(a)
 {
-   data = new T[10];
-   numCapacity = 99;
-   numElements = 99;
+   data = nullptr;
+   numCapacity = 0;
+   numElements = 0;
 }
 
 /*****************************************
@@ -215,24 +436,39 @@ vector <T> :: vector()
  * non-default constructor: set the number of elements,
  * construct each element, and copy the values over
  ****************************************/
-template <typename T>
-vector <T> :: vector(size_t num, const T & t) 
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(size_t num, const T & t, const A & a) : alloc(a)
 {
-   data = new T[10];
-   numCapacity = 99;
-   numElements = 99;
+   data = nullptr;
+   numCapacity = num;
+   numElements = num;
+   if (num > 0)
+   {
+      data = traits::allocate(alloc, num);
+      for (size_t i = 0; i < num; i++)
+         traits::construct(alloc, data + i, t);
+   }
+   notePeak();
 }
 
 /*****************************************
  * VECTOR :: INITIALIZATION LIST constructors
  * Create a vector with an initialization list.
  ****************************************/
-template <typename T>
-vector <T> :: vector(const std::initializer_list<T> & l) 
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(const std::initializer_list<T> & l, const A & a) : alloc(a)
 {
-   data = new T[10];
-   numCapacity = 99;
-   numElements = 99;
+   data = nullptr;
+   numElements = l.size();
+   numCapacity = numElements;
+   if (numElements > 0)
+   {
+      data = traits::allocate(alloc, numCapacity);
+      size_t i = 0;
+      for (const T& index : l)
+         traits::construct(alloc, data + i++, index);
+   }
+   notePeak();
 }
 
 /*****************************************
@@ -240,12 +476,19 @@ vector <T> :: vector(const std::initializer_list<T> & l)
  * non-default constructor: set the number of elements,
  * construct each element, and copy the values over
  ****************************************/
-template <typename T>
-vector <T> :: vector(size_t num) 
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(size_t num, const A & a) : alloc(a)
 {
-   data = new T[10];
-   numCapacity = 99;
-   numElements = 99;
+   data = nullptr;
+   numCapacity = num;
+   numElements = num;
+   if (num > 0)
+   {
+      data = traits::allocate(alloc, num);
+      for (size_t i = 0; i < num; i++)
+         traits::construct(alloc, data + i);
+   }
+   notePeak();
 }
 
 /*****************************************
@@ -253,24 +496,37 @@ vector <T> :: vector(size_t num)
  * Allocate the space for numElements and
  * call the copy constructor on each element
  ****************************************/
-template <typename T>
-vector <T> :: vector (const vector & rhs) 
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector (const vector & rhs) :
+   alloc(traits::select_on_container_copy_construction(rhs.alloc))
 {
-   data = new T[10];
-   numCapacity = 99;
-   numElements = 99;
+   data = nullptr;
+   numElements = rhs.size();
+   numCapacity = rhs.size();
+   if (numCapacity > 0)
+   {
+      data = traits::allocate(alloc, numCapacity);
+      for (size_t i = 0; i < numElements; i++)
+         traits::construct(alloc, data + i, rhs.data[i]);
+   }
+   notePeak();
 }
 
 /*****************************************
  * VECTOR :: MOVE CONSTRUCTOR
  * Steal the values from the RHS and set it to zero.
  ****************************************/
-template <typename T>
-vector <T> :: vector (vector && rhs)
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector (vector && rhs) : alloc(std::move(rhs.alloc))
 {
-   data = new T[10];
-   numCapacity = 99;
-   numElements = 99;
+   numElements = rhs.numElements;
+   numCapacity = rhs.numCapacity;
+   data = rhs.data;
+
+   rhs.numElements = 0;
+   rhs.numCapacity = 0;
+   rhs.data = nullptr;
+   notePeak();
 }
 
 /*****************************************
@@ -278,10 +534,40 @@ vector <T> :: vector (vector && rhs)
  * Call the destructor for each element from 0..numElements
  * and then free the memory
  ****************************************/
-template <typename T>
-vector <T> :: ~vector()
+template <typename T, typename A, typename G>
+vector <T, A, G> :: ~vector()
 {
-   
+   release();
+}
+
+/***************************************
+ * VECTOR :: REALLOCATE
+ * Move the live elements into a fresh buffer of
+ * newCapacity, destroying the moved-from originals.
+ * Only the numElements live slots are ever constructed.
+ * Relocatable types move with a single memmove.
+ *     INPUT  : newCapacity the size of the new buffer
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: reallocate(size_t newCapacity)
+{
+   assert(newCapacity >= numElements);
+   T* newData = nullptr;
+   if (newCapacity > 0)
+   {
+      newData = traits::allocate(alloc, newCapacity);
+      relocate(newData, data, numElements);
+   }
+
+   if (data)
+      traits::deallocate(alloc, data, numCapacity);
+
+   telemetry.reallocations++;
+   telemetry.bytesCopied += numElements * sizeof(T);
+   data = newData;
+   numCapacity = newCapacity;
+   notePeak();
 }
 
 /***************************************
@@ -291,16 +577,32 @@ vector <T> :: ~vector()
  *     INPUT  : newCapacity the size of the new buffer
  *     OUTPUT :
  **************************************/
-template <typename T>
-void vector <T> :: resize(size_t newElements)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: resize(size_t newElements)
 {
-   
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         traits::construct(alloc, data + i);
+   }
+   numElements = newElements;
 }
 
-template <typename T>
-void vector <T> :: resize(size_t newElements, const T & t)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: resize(size_t newElements, const T & t)
 {
-   
+   if (newElements < numElements)
+      destroy(newElements, numElements);
+   else
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; i++)
+         traits::construct(alloc, data + i, t);
+   }
+   numElements = newElements;
 }
 
 /***************************************
@@ -311,10 +613,14 @@ void vector <T> :: resize(size_t newElements, const T & t)
  *     INPUT  : newCapacity the size of the new buffer
  *     OUTPUT :
  **************************************/
-template <typename T>
-void vector <T> :: reserve(size_t newCapacity)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: reserve(size_t newCapacity)
 {
-   numCapacity = 99;
+   if (newCapacity <= numCapacity)
+   {
+      return;
+   }
+   reallocate(newCapacity);
 }
 
 /***************************************
@@ -323,10 +629,12 @@ void vector <T> :: reserve(size_t newCapacity)
  *     INPUT  :
  *     OUTPUT :
  **************************************/
-template <typename T>
-void vector <T> :: shrink_to_fit()
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: shrink_to_fit()
 {
-   
+   if (numCapacity == numElements)
+      return;
+   reallocate(numElements);
 }
 
 
@@ -335,62 +643,66 @@ void vector <T> :: shrink_to_fit()
  * VECTOR :: SUBSCRIPT
  * Read-Write access
  ****************************************/
-template <typename T>
-T & vector <T> :: operator [] (size_t index)
+template <typename T, typename A, typename G>
+T & vector <T, A, G> :: operator [] (size_t index)
 {
-   return *(new T);
-   
+    assert(index >= 0 && index < numElements);
+    return data[index];
 }
 
 /******************************************
  * VECTOR :: SUBSCRIPT
  * Read-Write access
  *****************************************/
-template <typename T>
-const T & vector <T> :: operator [] (size_t index) const
+template <typename T, typename A, typename G>
+const T & vector <T, A, G> :: operator [] (size_t index) const
 {
-   return *(new T);
+    assert(index >= 0 && index < numElements);
+    return data[index];
 }
 
 /*****************************************
  * VECTOR :: FRONT
  * Read-Write access
  ****************************************/
-template <typename T>
-T & vector <T> :: front ()
+template <typename T, typename A, typename G>
+T & vector <T, A, G> :: front ()
 {
-   
-   return *(new T);
+   assert(numElements > 0);
+   return data[0]; // Return a reference to the first element
 }
 
 /******************************************
  * VECTOR :: FRONT
  * Read-Write access
  *****************************************/
-template <typename T>
-const T & vector <T> :: front () const
+template <typename T, typename A, typename G>
+const T & vector <T, A, G> :: front () const
 {
-   return *(new T);
+   assert(numElements > 0);
+   return data[0]; // Return a reference to the first element
 }
 
 /*****************************************
  * VECTOR :: FRONT
  * Read-Write access
  ****************************************/
-template <typename T>
-T & vector <T> :: back()
+template <typename T, typename A, typename G>
+T & vector <T, A, G> :: back()
 {
-   return *(new T);
+   assert(numElements > 0);
+   return data[0+numElements-1]; // Return a reference to the last element
 }
 
 /******************************************
  * VECTOR :: FRONT
  * Read-Write access
  *****************************************/
-template <typename T>
-const T & vector <T> :: back() const
+template <typename T, typename A, typename G>
+const T & vector <T, A, G> :: back() const
 {
-   return *(new T);
+   assert(numElements > 0);
+   return data[0+numElements-1]; // Return a reference to the last element
 }
 
 /***************************************
@@ -401,17 +713,187 @@ const T & vector <T> :: back() const
  *     INPUT  : 't' the new element to be added
  *     OUTPUT : *this
  **************************************/
-template <typename T>
-void vector <T> :: push_back (const T & t)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: push_back (const T & t)
 {
-   
+   emplace_back(t);
 }
 
-template <typename T>
-void vector <T> ::push_back(T && t)
+template <typename T, typename A, typename G>
+void vector <T, A, G> ::push_back(T && t)
+{
+   emplace_back(std::move(t));
+}
+
+/***************************************
+ * VECTOR :: EMPLACE BACK
+ * Construct a new element at the end straight from
+ * args, with no temporary.  When the buffer is full
+ * the element is built in the new buffer before the
+ * old one goes away, so args may refer to an element.
+ *     INPUT  : args the constructor parameters
+ *     OUTPUT : the new element
+ **************************************/
+template <typename T, typename A, typename G>
+template <class ... Args>
+T & vector <T, A, G> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+      return *insertGap(numElements, 1, [&](T * p)
+      {
+         traits::construct(alloc, p, std::forward<Args>(args)...);
+      });
+
+   traits::construct(alloc, data + numElements, std::forward<Args>(args)...);
+   return data[numElements++];
+}
+
+/***************************************
+ * VECTOR :: EMPLACE
+ * Construct a new element in front of pos.  The
+ * elements after pos shift up one slot.
+ *     INPUT  : pos  where the new element goes
+ *              args the constructor parameters
+ *     OUTPUT : iterator to the new element
+ **************************************/
+template <typename T, typename A, typename G>
+template <class ... Args>
+typename vector <T, A, G> :: iterator vector <T, A, G> :: emplace(iterator pos, Args && ... args)
+{
+   size_t index = pos.p - data;
+   assert(index <= numElements);
+
+   // appending or growing never disturbs the old elements before we read args
+   if (index == numElements || numElements == numCapacity)
+      return insertGap(index, 1, [&](T * p)
+      {
+         traits::construct(alloc, p, std::forward<Args>(args)...);
+      });
+
+   // shifting in place might move an element args refers to: build it first
+   T t(std::forward<Args>(args)...);
+   return insertGap(index, 1, [&](T * p)
+   {
+      traits::construct(alloc, p, std::move(t));
+   });
+}
+
+/***************************************
+ * VECTOR :: INSERT GAP
+ * Open num raw slots at index and call fill once for
+ * each of them.  Needing more room means exactly one
+ * new buffer, sized by the growth policy G:
+ * fill runs there first, then the old elements are
+ * relocated around the gap.  Otherwise the tail is
+ * shifted up, with memmove when T allows it.  If fill
+ * throws, nothing changes.
+ *     INPUT  : index where the gap goes
+ *              num   how many slots to open
+ *              fill  constructs one new element
+ *     OUTPUT : iterator to the first new element
+ **************************************/
+template <typename T, typename A, typename G>
+template <class Fill>
+typename vector <T, A, G> :: iterator vector <T, A, G> :: insertGap(size_t index, size_t num, Fill fill)
+{
+   assert(index <= numElements);
+   if (numElements + num > numCapacity)
+   {
+      size_t newCapacity = G::next(numCapacity, numElements + num, sizeof(T));
+      assert(newCapacity >= numElements + num);
+
+      T * newData = traits::allocate(alloc, newCapacity);
+      try
+      {
+         fillSlots(newData + index, num, fill);
+      }
+      catch (...)
+      {
+         traits::deallocate(alloc, newData, newCapacity);
+         throw;
+      }
+      relocate(newData, data, index);
+      relocate(newData + index + num, data + index, numElements - index);
+
+      if (data)
+         traits::deallocate(alloc, data, numCapacity);
+      telemetry.reallocations++;
+      telemetry.bytesCopied += numElements * sizeof(T);
+      data = newData;
+      numCapacity = newCapacity;
+      notePeak();
+   }
+   else
+   {
+      relocate(data + index + num, data + index, numElements - index);
+      try
+      {
+         fillSlots(data + index, num, fill);
+      }
+      catch (...)
+      {
+         relocate(data + index, data + index + num, numElements - index);
+         throw;
+      }
+   }
+
+   numElements += num;
+   return iterator(data + index);
+}
+
+/***************************************
+ * VECTOR :: INSERT RANGE
+ * Insert [first, last) in front of index.  Forward
+ * iterators are measured up front so the buffer grows
+ * at most once; input iterators can only be read once,
+ * so they go in one element at a time.
+ *     INPUT  : index       where the range goes
+ *              first, last the elements to copy
+ *     OUTPUT : iterator to the first new element
+ **************************************/
+template <typename T, typename A, typename G>
+template <class Iterator>
+typename vector <T, A, G> :: iterator vector <T, A, G> :: insertRange(size_t index,
+   Iterator first, Iterator last, std::forward_iterator_tag)
+{
+   size_t num = std::distance(first, last);
+   if (num == 0)
+      return iterator(data + index);
+   return insertGap(index, num, [&](T * p)
+   {
+      traits::construct(alloc, p, *first);
+      ++first;
+   });
+}
+
+template <typename T, typename A, typename G>
+template <class Iterator>
+typename vector <T, A, G> :: iterator vector <T, A, G> :: insertRange(size_t index,
+   Iterator first, Iterator last, std::input_iterator_tag)
+{
+   for (size_t i = index; first != last; ++first, ++i)
+      emplace(iterator(data + i), *first);
+   return iterator(data + index);
+}
+
+/***************************************
+ * VECTOR :: ERASE
+ * Destroy the elements in [first, last) and shift the
+ * tail down to close the hole, with memmove when T allows it
+ *     INPUT  : first, last the elements to remove
+ *     OUTPUT : iterator to the element after the last removed
+ **************************************/
+template <typename T, typename A, typename G>
+typename vector <T, A, G> :: iterator vector <T, A, G> :: erase(iterator first, iterator last)
 {
-   
-   
+   size_t begin = first.p - data;
+   size_t end   = last.p  - data;
+   assert(begin <= end && end <= numElements);
+
+   destroy(begin, end);
+   relocate(data + begin, data + end, numElements - end);
+   numElements -= end - begin;
+   return iterator(data + begin);
 }
 
 /***************************************
@@ -421,21 +903,73 @@ void vector <T> ::push_back(T && t)
  *     INPUT  : rhs the vector to copy from
  *     OUTPUT : *this
  **************************************/
-template <typename T>
-vector <T> & vector <T> :: operator = (const vector & rhs)
+template <typename T, typename A, typename G>
+vector <T, A, G> & vector <T, A, G> :: operator = (const vector & rhs)
 {
-   
+   if (this != &rhs)
+   {
+      // a propagating allocator that differs cannot free our old buffer
+      if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+         release();
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+
+      // not enough room: start over with a buffer exactly the right size
+      if (rhs.numElements > numCapacity)
+      {
+         clear();
+         reallocate(rhs.numElements);
+      }
+
+      // assign over the live elements, construct the rest, destroy any extras
+      size_t i = 0;
+      for (; i < numElements && i < rhs.numElements; i++)
+         data[i] = rhs.data[i];
+      for (; i < rhs.numElements; i++)
+         traits::construct(alloc, data + i, rhs.data[i]);
+      destroy(rhs.numElements, numElements);
+
+      numElements = rhs.numElements;
+   }
    return *this;
 }
-template <typename T>
-vector <T>& vector <T> :: operator = (vector&& rhs)
+template <typename T, typename A, typename G>
+vector <T, A, G>& vector <T, A, G> :: operator = (vector&& rhs)
 {
 
+   if (this != &rhs)
+   {
+      // cannot adopt a buffer our allocator did not hand out: move each element
+      if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+      {
+         clear();
+         reserve(rhs.numElements);
+         for (size_t i = 0; i < rhs.numElements; i++)
+            traits::construct(alloc, data + i, std::move(rhs.data[i]));
+         numElements = rhs.numElements;
+         rhs.clear();
+         return *this;
+      }
+
+      release();
+      moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+
+      data = rhs.data;
+      numElements = rhs.numElements;
+      numCapacity = rhs.numCapacity;
+      notePeak();
+
+      rhs.data = nullptr;
+      rhs.numElements = 0;
+      rhs.numCapacity = 0;
+   }
    return *this;
 }
 
 
-
-
 } // namespace custom
 
+// the packed specialization for bool
+#include "vector_bool.h"
+
+// the specialization that grows a few elements at a time
+#include "vector_incremental.h"
@@ -0,0 +1,791 @@
+/***********************************************************************
+ * Header:
+ *    VECTOR BOOL
+ * Summary:
+ *    The vector<bool> specialization: 64 flags packed into each
+ *    word, an eighth of the memory of one bool per element.  An
+ *    element is a single bit, so operator[] hands back a proxy
+ *    reference rather than a bool&.  Whole words at a time, it can
+ *    count the set bits, find the next set bit, and and/or/xor with
+ *    another vector, using the popcount and count-trailing-zeros
+ *    instructions where the compiler offers them.
+ *
+ *    The bits past size() in the last word are always zero, so
+ *    the word-at-a-time operations never see stale flags.
+ *
+ *    vector.h includes this at the bottom; there is no need to
+ *    include it directly.
+ *
+ *    This will contain the class definition of:
+ *        vector<bool>                 : flags, packed into words
+ *        vector<bool>::reference      : a proxy for one flag
+ *        vector<bool>::iterator       : an iterator through the flags
+ *        vector<bool>::const_iterator : the same, read only
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include "vector.h"
+
+#include <cstdint>  // for uint64_t
+
+#ifdef _MSC_VER
+#include <intrin.h> // for __popcnt64 and _BitScanForward64
+#endif
+
+class TestVectorBool; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * BITS
+ * Count and find bits in one word.  The builtins become
+ * single instructions when the target has them.
+ ****************************************/
+namespace bits
+{
+   const size_t WORD_BITS = 64;
+
+   inline size_t popcount(uint64_t word)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+      return static_cast<size_t>(__popcnt64(word));
+#else
+      size_t num = 0;
+      for (; word; word &= word - 1)
+         num++;
+      return num;
+#endif
+   }
+
+   // the index of the lowest set bit; word must not be zero
+   inline size_t ctz(uint64_t word)
+   {
+      assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+      unsigned long index;
+      _BitScanForward64(&index, word);
+      return static_cast<size_t>(index);
+#else
+      size_t index = 0;
+      for (; !(word & 1); word >>= 1)
+         index++;
+      return index;
+#endif
+   }
+
+   // words needed to hold num bits
+   inline size_t wordsFor(size_t num)
+   {
+      return (num + WORD_BITS - 1) / WORD_BITS;
+   }
+
+   // the bit for index within its word
+   inline uint64_t mask(size_t index)
+   {
+      return uint64_t(1) << (index % WORD_BITS);
+   }
+}
+
+/*****************************************
+ * VECTOR BOOL
+ * The vector interface over packed bits, plus the
+ * word-at-a-time operations.  Capacity is always a
+ * whole number of words.
+ ****************************************/
+template <typename A, typename G>
+class vector <bool, A, G>
+{
+   friend class ::TestVectorBool; // give unit tests access to the privates
+public:
+   using value_type     = bool;
+   using allocator_type = A;
+   class reference;
+   using const_reference = bool;
+
+   //
+   // Construct
+   //
+
+   vector(const A & a = A());
+   vector(size_t numElements,                  const A & a = A());
+   vector(size_t numElements, bool value,      const A & a = A());
+   vector(const std::initializer_list<bool>& l, const A & a = A());
+   vector(const vector &  rhs);
+   vector(      vector && rhs);
+   ~vector();
+
+   //
+   // Assign
+   //
+
+   void swap(vector& rhs)
+   {
+      // unequal allocators that do not propagate cannot trade buffers
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+      std::swap(words, rhs.words);
+      std::swap(numElements, rhs.numElements);
+      std::swap(numWords, rhs.numWords);
+   }
+   vector & operator = (const vector & rhs);
+   vector & operator = (vector && rhs);
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   class const_iterator;
+   iterator       begin()        { return iterator(words, 0);                  }
+   iterator       end()          { return iterator(words, numElements);        }
+   const_iterator begin()  const { return const_iterator(words, 0);            }
+   const_iterator end()    const { return const_iterator(words, numElements);  }
+   const_iterator cbegin() const { return const_iterator(words, 0);            }
+   const_iterator cend()   const { return const_iterator(words, numElements);  }
+
+   //
+   // Access
+   //
+
+   reference operator [] (size_t index);
+   bool operator [] (size_t index) const;
+   reference front();
+   bool front() const;
+   reference back();
+   bool back() const;
+
+   //
+   // Insert
+   //
+
+   void push_back(bool value);
+   void reserve(size_t newCapacity);
+   void resize(size_t newElements, bool value = false);
+
+   //
+   // Remove
+   //
+
+   void clear()
+   {
+      numElements = 0;
+   }
+   void pop_back();
+   void shrink_to_fit();
+
+   //
+   // Status
+   //
+
+   size_t  size()          const { return numElements;                  }
+   size_t  capacity()      const { return numWords * bits::WORD_BITS;   }
+   bool empty()            const { return (numElements == 0);           }
+   A    get_allocator()    const { return alloc;                        }
+
+   // how the growth policy has done for this vector
+   const growth_stats & stats() const { return telemetry;          }
+   void reset_stats()                 { telemetry = growth_stats(); notePeak(); }
+
+   // vector<bool>-specific interfaces
+
+   // the number of true flags
+   size_t count() const;
+
+   // the index of the first true flag at or after index, or size() if none
+   size_t find_first() const           { return find_next(0); }
+   size_t find_next(size_t index) const;
+
+   // every flag at once
+   void flip();
+   bool any()  const { return find_first() != numElements; }
+   bool none() const { return !any(); }
+
+   // combine with a vector of the same size, a word at a time
+   vector & operator &= (const vector & rhs);
+   vector & operator |= (const vector & rhs);
+   vector & operator ^= (const vector & rhs);
+
+private:
+
+   // the words come from A, rebound from bool
+   using word_alloc = typename std::allocator_traits<A>::template rebind_alloc<uint64_t>;
+   using traits     = std::allocator_traits<word_alloc>;
+
+   // hand over the allocator only when its traits say to
+   void copyAlloc(const word_alloc & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const word_alloc &,     std::false_type) {                         }
+   void moveAlloc(word_alloc & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(word_alloc &,           std::false_type) {                         }
+   void swapAlloc(word_alloc & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(word_alloc &,           std::false_type) {                         }
+
+   // the words in use, including the partly used last one
+   size_t usedWords() const { return bits::wordsFor(numElements); }
+
+   // zero the bits past numElements in the last word
+   void clearTail()
+   {
+      if (numElements % bits::WORD_BITS)
+         words[numElements / bits::WORD_BITS] &= bits::mask(numElements) - 1;
+   }
+
+   // copy the used words into a new buffer of newWords
+   void reallocate(size_t newWords);
+
+   // grow to hold at least numBits
+   void grow(size_t numBits)
+   {
+      size_t needed = bits::wordsFor(numBits);
+      if (needed > numWords)
+         reallocate(G::next(numWords, needed, sizeof(uint64_t)));
+   }
+
+   void notePeak()
+   {
+      if (numWords * bits::WORD_BITS > telemetry.peakCapacity)
+         telemetry.peakCapacity = numWords * bits::WORD_BITS;
+   }
+
+   word_alloc   alloc;       // where the words come from
+   uint64_t *   words;       // the packed flags
+   size_t       numWords;    // the capacity, in words
+   size_t       numElements; // the number of flags in use
+   growth_stats telemetry;   // reallocations, bytes moved, and peak capacity (in bits)
+};
+
+/*****************************************
+ * VECTOR BOOL REFERENCE
+ * Stands in for bool& : reads and writes one bit
+ ****************************************/
+template <typename A, typename G>
+class vector <bool, A, G> :: reference
+{
+   friend class ::TestVectorBool;
+   friend class vector <bool, A, G>;
+public:
+   reference(uint64_t * word, uint64_t mask) : word(word), mask(mask) {}
+
+   operator bool () const { return (*word & mask) != 0; }
+   bool operator ~ () const { return (*word & mask) == 0; }
+
+   reference & operator = (bool value)
+   {
+      if (value)
+         *word |= mask;
+      else
+         *word &= ~mask;
+      return *this;
+   }
+   reference & operator = (const reference & rhs) { return *this = bool(rhs); }
+
+   void flip() { *word ^= mask; }
+
+   // swap two flags, as std::sort and std::reverse need
+   friend void swap(reference lhs, reference rhs)
+   {
+      bool tmp = lhs;
+      lhs = bool(rhs);
+      rhs = tmp;
+   }
+
+private:
+   uint64_t * word;
+   uint64_t   mask;
+};
+
+/*****************************************
+ * VECTOR BOOL ITERATOR
+ * A word pointer and a bit index.  Random access,
+ * but dereferencing yields a proxy, not a bool&.
+ ****************************************/
+template <typename A, typename G>
+class vector <bool, A, G> :: iterator
+{
+   friend class ::TestVectorBool;
+   friend class vector <bool, A, G>;
+   friend class const_iterator;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = bool;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = void;
+   using reference         = typename vector <bool, A, G> :: reference;
+
+   iterator() : words(nullptr), index(0) {}
+   iterator(uint64_t * words, size_t index) : words(words), index(index) {}
+
+   // comparison operators
+   bool operator == (const iterator& rhs) const { return index == rhs.index; }
+   bool operator != (const iterator& rhs) const { return index != rhs.index; }
+   bool operator <  (const iterator& rhs) const { return index <  rhs.index; }
+   bool operator >  (const iterator& rhs) const { return index >  rhs.index; }
+   bool operator <= (const iterator& rhs) const { return index <= rhs.index; }
+   bool operator >= (const iterator& rhs) const { return index >= rhs.index; }
+
+   // dereference operators
+   reference operator * () const
+   {
+      return reference(words + index / bits::WORD_BITS, bits::mask(index));
+   }
+   reference operator [] (difference_type n) const { return *(*this + n); }
+
+   // increment and decrement
+   iterator& operator ++ ()    { ++index; return *this; }
+   iterator& operator -- ()    { --index; return *this; }
+   iterator  operator ++ (int) { iterator t = *this; ++index; return t; }
+   iterator  operator -- (int) { iterator t = *this; --index; return t; }
+
+   // arithmetic
+   iterator& operator += (difference_type n)       { index += n; return *this; }
+   iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   iterator  operator +  (difference_type n) const { return iterator(words, index + n); }
+   iterator  operator -  (difference_type n) const { return iterator(words, index - n); }
+   difference_type operator - (const iterator& rhs) const
+   {
+      return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index);
+   }
+   friend iterator operator + (difference_type n, const iterator& it) { return it + n; }
+
+private:
+   uint64_t * words;
+   size_t     index;
+};
+
+/*****************************************
+ * VECTOR BOOL CONST ITERATOR
+ * The same, reading plain bools
+ ****************************************/
+template <typename A, typename G>
+class vector <bool, A, G> :: const_iterator
+{
+   friend class ::TestVectorBool;
+   friend class vector <bool, A, G>;
+public:
+   using iterator_category = std::random_access_iterator_tag;
+   using value_type        = bool;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = void;
+   using reference         = bool;
+
+   const_iterator() : words(nullptr), index(0) {}
+   const_iterator(const uint64_t * words, size_t index) : words(words), index(index) {}
+   const_iterator(const iterator & it) : words(it.words), index(it.index) {}
+
+   // comparison operators; an iterator on either side converts
+   friend bool operator == (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index == rhs.index; }
+   friend bool operator != (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index != rhs.index; }
+   friend bool operator <  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <  rhs.index; }
+   friend bool operator >  (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >  rhs.index; }
+   friend bool operator <= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index <= rhs.index; }
+   friend bool operator >= (const const_iterator& lhs, const const_iterator& rhs) { return lhs.index >= rhs.index; }
+
+   // dereference operators
+   bool operator * () const
+   {
+      return (words[index / bits::WORD_BITS] & bits::mask(index)) != 0;
+   }
+   bool operator [] (difference_type n) const { return *(*this + n); }
+
+   // increment and decrement
+   const_iterator& operator ++ ()    { ++index; return *this; }
+   const_iterator& operator -- ()    { --index; return *this; }
+   const_iterator  operator ++ (int) { const_iterator t = *this; ++index; return t; }
+   const_iterator  operator -- (int) { const_iterator t = *this; --index; return t; }
+
+   // arithmetic
+   const_iterator& operator += (difference_type n)       { index += n; return *this; }
+   const_iterator& operator -= (difference_type n)       { index -= n; return *this; }
+   const_iterator  operator +  (difference_type n) const { return const_iterator(words, index + n); }
+   const_iterator  operator -  (difference_type n) const { return const_iterator(words, index - n); }
+   friend difference_type operator - (const const_iterator& lhs, const const_iterator& rhs)
+   {
+      return static_cast<difference_type>(lhs.index) - static_cast<difference_type>(rhs.index);
+   }
+   friend const_iterator operator + (difference_type n, const const_iterator& it) { return it + n; }
+
+private:
+   const uint64_t * words;
+   size_t           index;
+};
+
+/*****************************************
+ * VECTOR BOOL :: CONSTRUCTORS
+ * All flags start out false unless told otherwise
+ ****************************************/
+template <typename A, typename G>
+vector <bool, A, G> :: vector(const A & a) :
+   alloc(a), words(nullptr), numWords(0), numElements(0)
+{
+}
+
+template <typename A, typename G>
+vector <bool, A, G> :: vector(size_t num, const A & a) :
+   alloc(a), words(nullptr), numWords(0), numElements(0)
+{
+   resize(num, false);
+}
+
+template <typename A, typename G>
+vector <bool, A, G> :: vector(size_t num, bool value, const A & a) :
+   alloc(a), words(nullptr), numWords(0), numElements(0)
+{
+   resize(num, value);
+}
+
+template <typename A, typename G>
+vector <bool, A, G> :: vector(const std::initializer_list<bool> & l, const A & a) :
+   alloc(a), words(nullptr), numWords(0), numElements(0)
+{
+   reserve(l.size());
+   for (bool value : l)
+      push_back(value);
+}
+
+/*****************************************
+ * VECTOR BOOL :: COPY CONSTRUCTOR
+ * Copy the used words, not one flag at a time
+ ****************************************/
+template <typename A, typename G>
+vector <bool, A, G> :: vector(const vector & rhs) :
+   alloc(traits::select_on_container_copy_construction(rhs.alloc)),
+   words(nullptr), numWords(0), numElements(0)
+{
+   *this = rhs;
+}
+
+/*****************************************
+ * VECTOR BOOL :: MOVE CONSTRUCTOR
+ * Steal the words
+ ****************************************/
+template <typename A, typename G>
+vector <bool, A, G> :: vector(vector && rhs) :
+   alloc(std::move(rhs.alloc)), words(rhs.words), numWords(rhs.numWords),
+   numElements(rhs.numElements)
+{
+   notePeak();
+   rhs.words = nullptr;
+   rhs.numWords = 0;
+   rhs.numElements = 0;
+}
+
+/*****************************************
+ * VECTOR BOOL :: DESTRUCTOR
+ ****************************************/
+template <typename A, typename G>
+vector <bool, A, G> :: ~vector()
+{
+   if (words)
+      traits::deallocate(alloc, words, numWords);
+}
+
+/*****************************************
+ * VECTOR BOOL :: ASSIGN
+ * Reuse our words if there are enough of them
+ ****************************************/
+template <typename A, typename G>
+vector <bool, A, G> & vector <bool, A, G> :: operator = (const vector & rhs)
+{
+   if (this != &rhs)
+   {
+      // a propagating allocator that differs cannot free our old words
+      if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+      {
+         if (words)
+            traits::deallocate(alloc, words, numWords);
+         words = nullptr;
+         numWords = 0;
+         numElements = 0;
+      }
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+
+      if (rhs.usedWords() > numWords)
+      {
+         numElements = 0;
+         reallocate(rhs.usedWords());
+      }
+      if (rhs.usedWords())
+         std::memcpy(words, rhs.words, rhs.usedWords() * sizeof(uint64_t));
+      numElements = rhs.numElements;
+   }
+   return *this;
+}
+
+/*****************************************
+ * VECTOR BOOL :: ASSIGN MOVE
+ ****************************************/
+template <typename A, typename G>
+vector <bool, A, G> & vector <bool, A, G> :: operator = (vector && rhs)
+{
+   if (this != &rhs)
+   {
+      // cannot adopt words our allocator did not hand out: copy them
+      if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+      {
+         *this = static_cast<const vector &>(rhs);
+         rhs.numElements = 0;
+         return *this;
+      }
+
+      if (words)
+         traits::deallocate(alloc, words, numWords);
+      moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+      words = rhs.words;
+      numWords = rhs.numWords;
+      numElements = rhs.numElements;
+      notePeak();
+
+      rhs.words = nullptr;
+      rhs.numWords = 0;
+      rhs.numElements = 0;
+   }
+   return *this;
+}
+
+/*****************************************
+ * VECTOR BOOL :: ACCESS
+ ****************************************/
+template <typename A, typename G>
+typename vector <bool, A, G> :: reference vector <bool, A, G> :: operator [] (size_t index)
+{
+   assert(index < numElements);
+   return reference(words + index / bits::WORD_BITS, bits::mask(index));
+}
+
+template <typename A, typename G>
+bool vector <bool, A, G> :: operator [] (size_t index) const
+{
+   assert(index < numElements);
+   return (words[index / bits::WORD_BITS] & bits::mask(index)) != 0;
+}
+
+template <typename A, typename G>
+typename vector <bool, A, G> :: reference vector <bool, A, G> :: front()
+{
+   return (*this)[0];
+}
+
+template <typename A, typename G>
+bool vector <bool, A, G> :: front() const
+{
+   return (*this)[0];
+}
+
+template <typename A, typename G>
+typename vector <bool, A, G> :: reference vector <bool, A, G> :: back()
+{
+   return (*this)[numElements - 1];
+}
+
+template <typename A, typename G>
+bool vector <bool, A, G> :: back() const
+{
+   return (*this)[numElements - 1];
+}
+
+/*****************************************
+ * VECTOR BOOL :: REALLOCATE
+ * Move the used words into a buffer of newWords
+ *     INPUT  : newWords the capacity, in words
+ *     OUTPUT :
+ ****************************************/
+template <typename A, typename G>
+void vector <bool, A, G> :: reallocate(size_t newWords)
+{
+   assert(newWords >= usedWords());
+   uint64_t * newData = newWords ? traits::allocate(alloc, newWords) : nullptr;
+   if (usedWords())
+      std::memcpy(newData, words, usedWords() * sizeof(uint64_t));
+   if (words)
+   {
+      telemetry.reallocations++;
+      telemetry.bytesCopied += usedWords() * sizeof(uint64_t);
+      traits::deallocate(alloc, words, numWords);
+   }
+   words = newData;
+   numWords = newWords;
+   notePeak();
+}
+
+/*****************************************
+ * VECTOR BOOL :: RESERVE
+ * Room for at least newCapacity flags
+ ****************************************/
+template <typename A, typename G>
+void vector <bool, A, G> :: reserve(size_t newCapacity)
+{
+   if (bits::wordsFor(newCapacity) > numWords)
+      reallocate(bits::wordsFor(newCapacity));
+}
+
+/*****************************************
+ * VECTOR BOOL :: RESIZE
+ * New flags take value.  Whole words are filled at once.
+ *     INPUT  : newElements the new size
+ *              value       the new flags
+ *     OUTPUT :
+ ****************************************/
+template <typename A, typename G>
+void vector <bool, A, G> :: resize(size_t newElements, bool value)
+{
+   if (newElements > numElements)
+   {
+      if (bits::wordsFor(newElements) > numWords)
+         reallocate(bits::wordsFor(newElements));
+
+      // finish the partly used word, then fill whole words
+      size_t i = numElements;
+      for (; i < newElements && i % bits::WORD_BITS; i++)
+         if (value)
+            words[i / bits::WORD_BITS] |= bits::mask(i);
+      for (size_t w = bits::wordsFor(i); w < bits::wordsFor(newElements); w++)
+         words[w] = value ? ~uint64_t(0) : uint64_t(0);
+   }
+   numElements = newElements;
+   clearTail();
+}
+
+/*****************************************
+ * VECTOR BOOL :: PUSH BACK
+ ****************************************/
+template <typename A, typename G>
+void vector <bool, A, G> :: push_back(bool value)
+{
+   grow(numElements + 1);
+   size_t i = numElements++;
+   if (i % bits::WORD_BITS == 0)
+      words[i / bits::WORD_BITS] = 0;
+   if (value)
+      words[i / bits::WORD_BITS] |= bits::mask(i);
+}
+
+/*****************************************
+ * VECTOR BOOL :: POP BACK
+ ****************************************/
+template <typename A, typename G>
+void vector <bool, A, G> :: pop_back()
+{
+   if (numElements > 0)
+   {
+      numElements--;
+      clearTail();
+   }
+}
+
+/*****************************************
+ * VECTOR BOOL :: SHRINK TO FIT
+ * Down to the words in use
+ ****************************************/
+template <typename A, typename G>
+void vector <bool, A, G> :: shrink_to_fit()
+{
+   if (usedWords() != numWords)
+      reallocate(usedWords());
+}
+
+/*****************************************
+ * VECTOR BOOL :: COUNT
+ * One popcount per word
+ ****************************************/
+template <typename A, typename G>
+size_t vector <bool, A, G> :: count() const
+{
+   size_t num = 0;
+   for (size_t w = 0; w < usedWords(); w++)
+      num += bits::popcount(words[w]);
+   return num;
+}
+
+/*****************************************
+ * VECTOR BOOL :: FIND NEXT
+ * Mask off the bits before index in its word, then
+ * skip zero words until one has a bit to find
+ *     INPUT  : index where to start looking
+ *     OUTPUT : the first true flag at or after index, or size()
+ ****************************************/
+template <typename A, typename G>
+size_t vector <bool, A, G> :: find_next(size_t index) const
+{
+   if (index >= numElements)
+      return numElements;
+
+   size_t w = index / bits::WORD_BITS;
+   uint64_t word = words[w] & ~(bits::mask(index) - 1);
+   while (word == 0)
+   {
+      if (++w == usedWords())
+         return numElements;
+      word = words[w];
+   }
+   return w * bits::WORD_BITS + bits::ctz(word);
+}
+
+/*****************************************
+ * VECTOR BOOL :: FLIP
+ ****************************************/
+template <typename A, typename G>
+void vector <bool, A, G> :: flip()
+{
+   for (size_t w = 0; w < usedWords(); w++)
+      words[w] = ~words[w];
+   clearTail();
+}
+
+/*****************************************
+ * VECTOR BOOL :: AND, OR, XOR
+ * Both vectors must be the same size.  Their tails
+ * are both zero, so ours stays zero.
+ ****************************************/
+template <typename A, typename G>
+vector <bool, A, G> & vector <bool, A, G> :: operator &= (const vector & rhs)
+{
+   assert(numElements == rhs.numElements);
+   for (size_t w = 0; w < usedWords(); w++)
+      words[w] &= rhs.words[w];
+   return *this;
+}
+
+template <typename A, typename G>
+vector <bool, A, G> & vector <bool, A, G> :: operator |= (const vector & rhs)
+{
+   assert(numElements == rhs.numElements);
+   for (size_t w = 0; w < usedWords(); w++)
+      words[w] |= rhs.words[w];
+   return *this;
+}
+
+template <typename A, typename G>
+vector <bool, A, G> & vector <bool, A, G> :: operator ^= (const vector & rhs)
+{
+   assert(numElements == rhs.numElements);
+   for (size_t w = 0; w < usedWords(); w++)
+      words[w] ^= rhs.words[w];
+   return *this;
+}
+
+template <typename A, typename G>
+vector <bool, A, G> operator & (vector <bool, A, G> lhs, const vector <bool, A, G> & rhs)
+{
+   return lhs &= rhs;
+}
+
+template <typename A, typename G>
+vector <bool, A, G> operator | (vector <bool, A, G> lhs, const vector <bool, A, G> & rhs)
+{
+   return lhs |= rhs;
+}
+
+template <typename A, typename G>
+vector <bool, A, G> operator ^ (vector <bool, A, G> lhs, const vector <bool, A, G> & rhs)
+{
+   return lhs ^= rhs;
+}
+
+} // namespace custom
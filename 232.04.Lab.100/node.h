@@ -13,7 +13,9 @@
  *
  *    This will contain the class definition of:
  *        Node         : A class representing a Node
- *    Additionally, it will contain a few functions working on Node
+ *    Additionally, it will contain a few functions working on Node.
+ *    Those that make or free nodes take an optional pool, such as a
+ *    node_pool, to get them from; without one they use new and delete.
  * Author
  *    Cesar Tavarez, Ryan Whiteheads, Roy G
  ************************************************************************/
@@ -21,7 +23,10 @@
 #pragma once
 
 #include <cassert>     // for ASSERT
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
 #include <iostream>    // for NULL
+#include "node_pool.h" // for node_pool and node_heap
 
 /*************************************************
  * NODE
@@ -66,23 +71,24 @@ public:
  * Copy the list from the pSource and return
  * the new list
  *   INPUT  : the list to be copied
+ *            the pool to take the new nodes from
  *   OUTPUT : return the new list
  *   COST   : O(n)
  **********************************************/
-template <class T>
-inline Node <T> * copy(const Node <T> * pSource) 
+template <class T, class Pool>
+inline Node <T> * copy(const Node <T> * pSource, Pool & pool)
 {
    if (!pSource)
       return nullptr;
 
-   Node<T>* pNewHead = new Node<T>(pSource->data);
+   Node<T>* pNewHead = pool.create(pSource->data);
    Node<T>* pNewPrev = pNewHead;
 
    const Node<T>* temp = pSource->pNext;
 
    while(temp)
    {
-      Node<T>* pNew = new Node<T>(temp->data);
+      Node<T>* pNew = pool.create(temp->data);
       pNewPrev->pNext = pNew;
       pNew->pPrev = pNewPrev;
 
@@ -93,16 +99,24 @@ inline Node <T> * copy(const Node <T> * pSource)
    return pNewHead;
 }
 
+template <class T>
+inline Node <T> * copy(const Node <T> * pSource)
+{
+   custom::node_heap<Node <T>> heap;
+   return copy(pSource, heap);
+}
+
 /***********************************************
  * Assign
  * Copy the values from pSource into pDestination
  * reusing the nodes already created in pDestination if possible.
  *   INPUT  : the list to be copied
+ *            the pool the destination's nodes come from
  *   OUTPUT : return the new list
  *   COST   : O(n)
  **********************************************/
-template <class T>
-inline void assign(Node <T> * & pDestination, const Node <T> * pSource)
+template <class T, class Pool>
+inline void assign(Node <T> * & pDestination, const Node <T> * pSource, Pool & pool)
 {
    /*if (!pSource)
       */
@@ -125,7 +139,7 @@ inline void assign(Node <T> * & pDestination, const Node <T> * pSource)
    // copy the rest of source
    while (pSourceTemp)
    {
-      Node<T>* pNewNode = new Node<T>(pSourceTemp->data);
+      Node<T>* pNewNode = pool.create(pSourceTemp->data);
       if (pDestPrev)
       {
          pDestPrev->pNext = pNewNode;
@@ -147,7 +161,7 @@ inline void assign(Node <T> * & pDestination, const Node <T> * pSource)
       {
          Node<T>* pTemp = pDestTemp;
          pDestTemp = pDestTemp->pNext;
-         delete pTemp;
+         pool.destroy(pTemp);
       }
    }
    else {
@@ -156,7 +170,7 @@ inline void assign(Node <T> * & pDestination, const Node <T> * pSource)
       {
          Node<T>* pTemp = pDestTemp;
          pDestTemp = pDestTemp->pNext;
-         delete pTemp;
+         pool.destroy(pTemp);
       }
       pDestination = nullptr;
    }
@@ -167,6 +181,13 @@ inline void assign(Node <T> * & pDestination, const Node <T> * pSource)
 
 }
 
+template <class T>
+inline void assign(Node <T> * & pDestination, const Node <T> * pSource)
+{
+   custom::node_heap<Node <T>> heap;
+   assign(pDestination, pSource, heap);
+}
+
 /***********************************************
  * SWAP
  * Swap the list from LHS to RHS
@@ -182,11 +203,12 @@ inline void swap(Node <T>* &pLHS, Node <T>* &pRHS)
  * REMOVE
  * Remove the node pSource in the linked list
  *   INPUT  : the node to be removed
+ *            the pool it came from
  *   OUTPUT : the pointer to the parent node
  *   COST   : O(1)
  **********************************************/
-template <class T>
-inline Node <T> * remove(const Node <T> * pRemove) 
+template <class T, class Pool>
+inline Node <T> * remove(const Node <T> * pRemove, Pool & pool)
 {
    if (!pRemove) return nullptr;
 
@@ -195,7 +217,7 @@ inline Node <T> * remove(const Node <T> * pRemove)
    {
       Node<T>* temp = pRemove->pNext;
       pRemove->pNext->pPrev = nullptr;
-      delete pRemove;
+      pool.destroy(const_cast<Node <T> *>(pRemove));
       return temp;
    }
 
@@ -204,16 +226,23 @@ inline Node <T> * remove(const Node <T> * pRemove)
    {
       Node<T>* temp = pRemove->pPrev;
       pRemove->pPrev->pNext = nullptr;
-      delete pRemove;
+      pool.destroy(const_cast<Node <T> *>(pRemove));
       return temp;
    }
    Node<T>* temp = pRemove->pPrev;
    pRemove->pPrev->pNext = pRemove->pNext;
    pRemove->pNext->pPrev = pRemove->pPrev;
-   delete pRemove;
+   pool.destroy(const_cast<Node <T> *>(pRemove));
    return temp;
 }
 
+template <class T>
+inline Node <T> * remove(const Node <T> * pRemove)
+{
+   custom::node_heap<Node <T>> heap;
+   return remove(pRemove, heap);
+}
+
 /**********************************************
  * INSERT 
  * Insert a new node the the value in "t" into a linked
@@ -222,16 +251,18 @@ inline Node <T> * remove(const Node <T> * pRemove)
  *             pCurrent - a pointer to the node before which
  *                we will be inserting the new node
  *             after - whether we will be inserting after
+ *             pool - where to get the new node
  *   OUTPUT  : return the newly inserted item
  *   COST    : O(1)
  **********************************************/
-template <class T>
+template <class T, class Pool>
 inline Node <T> * insert(Node <T> * pCurrent,
                   const T & t,
-                  bool after = false)
+                  bool after,
+                  Pool & pool)
 {
-   if (!pCurrent) return new Node<T>(t);
-   Node<T>* pNew = new Node<T>(t);
+   if (!pCurrent) return pool.create(t);
+   Node<T>* pNew = pool.create(t);
    if (after)
    {
       if (pCurrent->pNext) {
@@ -277,6 +308,15 @@ inline Node <T> * insert(Node <T> * pCurrent,
    return pNew;
 }
 
+template <class T>
+inline Node <T> * insert(Node <T> * pCurrent,
+                  const T & t,
+                  bool after = false)
+{
+   custom::node_heap<Node <T>> heap;
+   return insert(pCurrent, t, after, heap);
+}
+
 /******************************************************
  * SIZE
  * Find the size an unsorted linked list.  
@@ -332,19 +372,209 @@ inline std::ostream & operator << (std::ostream & out, const Node <T> * pHead)
  * CLEAR
  * Free all the data currently in the linked list
  *   INPUT   : pointer to the head of the linked list
+ *             the pool the nodes came from
  *   OUTPUT  : pHead set to NULL
  *   COST    : O(n)
  ****************************************************/
-template <class T>
-inline void clear(Node <T> * & pHead)
+template <class T, class Pool>
+inline void clear(Node <T> * & pHead, Pool & pool)
 {
     while (pHead)
     {
-       const Node<T>* temp = pHead;
+       Node<T>* temp = pHead;
        pHead = pHead->pNext;
-       delete temp;
+       pool.destroy(temp);
     }
     pHead = nullptr;
 }
 
+template <class T>
+inline void clear(Node <T> * & pHead)
+{
+   custom::node_heap<Node <T>> heap;
+   clear(pHead, heap);
+}
+
+/*****************************************************
+ * RELINK
+ * Set every pPrev from the pNext chain.  The sorting
+ * and merging below only follow pNext while they work
+ * and put the back links right once at the end.
+ *   INPUT   : pointer to the head of the linked list
+ *   COST    : O(n)
+ ****************************************************/
+template <class T>
+inline void relink(Node <T> * pHead)
+{
+   Node <T> * pPrev = nullptr;
+   for (Node <T> * p = pHead; p; p = p->pNext)
+   {
+      p->pPrev = pPrev;
+      pPrev = p;
+   }
+}
+
+/*****************************************************
+ * MERGE CHAINS
+ * Merge two sorted chains linked by pNext alone.
+ * On a tie the node from pLHS goes first, which is
+ * what keeps the sort stable.
+ *   INPUT   : two sorted chains, and the ordering
+ *   OUTPUT  : the head of the merged chain
+ *   COST    : O(n)
+ ****************************************************/
+template <class T, class Compare>
+inline Node <T> * mergeChains(Node <T> * pLHS, Node <T> * pRHS, Compare less)
+{
+   Node <T> * pHead = nullptr;
+   Node <T> ** ppTail = &pHead;
+   while (pLHS && pRHS)
+   {
+      if (less(pRHS->data, pLHS->data))
+      {
+         *ppTail = pRHS;
+         pRHS = pRHS->pNext;
+      }
+      else
+      {
+         *ppTail = pLHS;
+         pLHS = pLHS->pNext;
+      }
+      ppTail = &(*ppTail)->pNext;
+   }
+   *ppTail = pLHS ? pLHS : pRHS;
+   return pHead;
+}
+
+/*****************************************************
+ * SORT
+ * A stable, bottom-up merge sort that relinks the
+ * nodes where they are.  Nodes are taken off the front
+ * one at a time and carried into a row of bins, bin k
+ * holding a sorted run of 2^k nodes, merging as a
+ * binary counter carries.  64 bins cover any list that
+ * fits in memory, so nothing is allocated.
+ *   INPUT   : pointer to the head of the linked list
+ *             the ordering, std::less by default
+ *   OUTPUT  : pHead is the smallest node
+ *   COST    : O(n log n)
+ ****************************************************/
+template <class T, class Compare>
+inline void sort(Node <T> * & pHead, Compare less)
+{
+   Node <T> * bins[64] = {};
+   size_t numBins = 0;
+
+   while (pHead)
+   {
+      Node <T> * pCarry = pHead;
+      pHead = pHead->pNext;
+      pCarry->pNext = nullptr;
+
+      // bin k holds older nodes than the carry: it goes on the left
+      size_t k = 0;
+      for (; k < numBins && bins[k]; k++)
+      {
+         pCarry = mergeChains(bins[k], pCarry, less);
+         bins[k] = nullptr;
+      }
+      bins[k] = pCarry;
+      if (k == numBins)
+         numBins++;
+   }
+
+   // the higher bins hold the older runs
+   for (size_t k = 0; k < numBins; k++)
+      if (bins[k])
+         pHead = mergeChains(bins[k], pHead, less);
+   relink(pHead);
+}
+
+template <class T>
+inline void sort(Node <T> * & pHead)
+{
+   sort(pHead, std::less<T>());
+}
+
+/*****************************************************
+ * MERGE
+ * Merge one sorted linked list into another.  The
+ * nodes of pRHS are relinked, not copied.
+ *   INPUT   : two sorted lists, and the ordering
+ *   OUTPUT  : pLHS holds every node, pRHS is NULL
+ *   COST    : O(n)
+ ****************************************************/
+template <class T, class Compare>
+inline void merge(Node <T> * & pLHS, Node <T> * & pRHS, Compare less)
+{
+   pLHS = mergeChains(pLHS, pRHS, less);
+   pRHS = nullptr;
+   relink(pLHS);
+}
+
+template <class T>
+inline void merge(Node <T> * & pLHS, Node <T> * & pRHS)
+{
+   merge(pLHS, pRHS, std::less<T>());
+}
+
+/*****************************************************
+ * UNIQUE
+ * Remove each node equal to the one before it, so a
+ * sorted list keeps one of every value
+ *   INPUT   : pointer to the head of the linked list
+ *             the pool the nodes came from
+ *   OUTPUT  : the number of nodes removed
+ *   COST    : O(n)
+ ****************************************************/
+template <class T, class Pool>
+inline size_t unique(Node <T> * pHead, Pool & pool)
+{
+   size_t numRemoved = 0;
+   if (!pHead)
+      return numRemoved;
+
+   Node <T> * pKeep = pHead;
+   while (pKeep->pNext)
+   {
+      Node <T> * pNext = pKeep->pNext;
+      if (pNext->data == pKeep->data)
+      {
+         pKeep->pNext = pNext->pNext;
+         if (pNext->pNext)
+            pNext->pNext->pPrev = pKeep;
+         pool.destroy(pNext);
+         numRemoved++;
+      }
+      else
+         pKeep = pNext;
+   }
+   return numRemoved;
+}
 
+template <class T>
+inline size_t unique(Node <T> * pHead)
+{
+   custom::node_heap<Node <T>> heap;
+   return unique(pHead, heap);
+}
+
+/*****************************************************
+ * REVERSE
+ * Turn the linked list around by swapping each
+ * node's two links
+ *   INPUT   : pointer to the head of the linked list
+ *   OUTPUT  : pHead is what was the last node
+ *   COST    : O(n)
+ ****************************************************/
+template <class T>
+inline void reverse(Node <T> * & pHead)
+{
+   Node <T> * p = pHead;
+   while (p)
+   {
+      std::swap(p->pNext, p->pPrev);
+      pHead = p;
+      p = p->pPrev;
+   }
+}
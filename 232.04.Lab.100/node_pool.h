@@ -0,0 +1,343 @@
+/***********************************************************************
+ * Header:
+ *    NODE POOL
+ * Summary:
+ *    A slab allocator for linked-list nodes.  Rather than asking the
+ *    heap for every node, the pool carves them out of slabs of B at a
+ *    time, handing them out in order.  A freed node goes on a free
+ *    list threaded through the node itself, and the next allocation
+ *    takes it back: no heap call either way.  Nodes allocated one
+ *    after another sit next to each other in memory, so walking a
+ *    list built that way runs through memory in order, not all over
+ *    the heap.  release() gives every slab back at once.
+ *
+ *    The free functions in node.h take a pool as their last argument.
+ *    custom::list takes pool_allocator as its allocator.  Every copy
+ *    of an allocator, and every rebinding of it to another type,
+ *    draws on the same pool_set, so a list built from another's
+ *    get_allocator() shares its pools and can merge or splice with it.
+ *
+ *    This will contain the class definitions of:
+ *        node_pool         : slabs of nodes and a free list
+ *        pool_set          : a node_pool for each type that asks
+ *        pool_allocator    : a standard allocator drawing on a pool_set
+ *        node_heap         : the same interface, using new and delete
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstddef>      // for size_t
+#include <memory>       // for std::shared_ptr and std::unique_ptr
+#include <new>          // for placement new and ::operator new
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::forward
+
+class TestNodePool; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * NODE POOL
+ * Storage for N, B to a slab.  allocate and
+ * deallocate hand out raw slots; create and
+ * destroy build and tear down an N in one.
+ ****************************************/
+template <typename N, size_t B = 64>
+class node_pool
+{
+   static_assert(B > 0, "a slab needs room for at least one node");
+   friend class ::TestNodePool; // give unit tests access to the privates
+
+   // a node while it is in use, a link in the free list while it is not
+   union Slot
+   {
+      Slot * pNext;
+      typename std::aligned_storage<sizeof(N), alignof(N)>::type storage;
+   };
+
+   // B slots, and the slab allocated before this one
+   struct Slab
+   {
+      Slab * pPrev;
+      Slot slots[B];
+   };
+
+public:
+   using value_type = N;
+
+   //
+   // Construct
+   //
+
+   node_pool() : pSlabs(nullptr), pFree(nullptr), pNextFresh(nullptr),
+                 pEndFresh(nullptr), numSlabs(0), numInUse(0) {}
+   node_pool(const node_pool &) = delete;
+   node_pool & operator = (const node_pool &) = delete;
+   ~node_pool() { release(); }
+
+   //
+   // Allocate and free
+   //
+
+   N * allocate();
+   void deallocate(N * p);
+
+   template <class ... Args>
+   N * create(Args && ... args)
+   {
+      N * p = allocate();
+      try
+      {
+         return new (p) N(std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+         deallocate(p);
+         throw;
+      }
+   }
+   void destroy(N * p)
+   {
+      p->~N();
+      deallocate(p);
+   }
+
+   // give back every slab at once.  Nodes still in use are not
+   // destroyed, so this is for lists whose elements need no destructor
+   // or have been destroyed already.
+   void release();
+
+   //
+   // Status
+   //
+
+   // the nodes handed out and not yet freed
+   size_t in_use()    const { return numInUse;     }
+   // the nodes the slabs have room for
+   size_t capacity()  const { return numSlabs * B; }
+   size_t slabs()     const { return numSlabs;     }
+   static size_t slab_size() { return B;           }
+
+private:
+
+   Slab * pSlabs;       // the newest slab, linked back to the oldest
+   Slot * pFree;        // freed slots, newest first
+   Slot * pNextFresh;   // the next never-used slot in the newest slab
+   Slot * pEndFresh;    // the end of the newest slab
+   size_t numSlabs;     // the number of slabs we have
+   size_t numInUse;     // the number of slots handed out
+};
+
+/*****************************************
+ * NODE POOL :: ALLOCATE
+ * The most recently freed slot if there is one,
+ * otherwise the next fresh one, otherwise a new slab
+ *     OUTPUT : room for one N, not yet built
+ ****************************************/
+template <typename N, size_t B>
+N * node_pool <N, B> :: allocate()
+{
+   Slot * p;
+   if (pFree)
+   {
+      p = pFree;
+      pFree = p->pNext;
+   }
+   else
+   {
+      if (pNextFresh == pEndFresh)
+      {
+         Slab * pSlab = static_cast<Slab *>(::operator new(sizeof(Slab)));
+         pSlab->pPrev = pSlabs;
+         pSlabs = pSlab;
+         pNextFresh = pSlab->slots;
+         pEndFresh = pSlab->slots + B;
+         numSlabs++;
+      }
+      p = pNextFresh++;
+   }
+   numInUse++;
+   return reinterpret_cast<N *>(&p->storage);
+}
+
+/*****************************************
+ * NODE POOL :: DEALLOCATE
+ * Put the slot at the front of the free list
+ *     INPUT  : p a slot from allocate(), already destroyed
+ ****************************************/
+template <typename N, size_t B>
+void node_pool <N, B> :: deallocate(N * p)
+{
+   if (p == nullptr)
+      return;
+   assert(numInUse > 0);
+   Slot * pSlot = reinterpret_cast<Slot *>(p);
+   pSlot->pNext = pFree;
+   pFree = pSlot;
+   numInUse--;
+}
+
+/*****************************************
+ * NODE POOL :: RELEASE
+ * Free every slab, one heap call each
+ ****************************************/
+template <typename N, size_t B>
+void node_pool <N, B> :: release()
+{
+   while (pSlabs)
+   {
+      Slab * pPrev = pSlabs->pPrev;
+      ::operator delete(pSlabs);
+      pSlabs = pPrev;
+   }
+   pFree = pNextFresh = pEndFresh = nullptr;
+   numSlabs = numInUse = 0;
+}
+
+/*****************************************
+ * NODE HEAP
+ * The interface of node_pool, one new and one delete
+ * per node: what node.h uses when not given a pool
+ ****************************************/
+template <typename N>
+struct node_heap
+{
+   template <class ... Args>
+   N * create(Args && ... args) { return new N(std::forward<Args>(args)...); }
+   void destroy(N * p)          { delete p;                                  }
+};
+
+/*****************************************
+ * POOL SET
+ * The pools shared by a pool_allocator and all of
+ * its copies and rebindings: one node_pool per type,
+ * made the first time that type asks for it.  There
+ * are only ever a few, so they are kept in a list.
+ ****************************************/
+template <size_t B>
+class pool_set
+{
+public:
+   pool_set() : pEntries(nullptr) {}
+   pool_set(const pool_set &) = delete;
+   pool_set & operator = (const pool_set &) = delete;
+   ~pool_set()
+   {
+      while (pEntries)
+      {
+         Entry * pNext = pEntries->pNext;
+         pEntries->destroy(pEntries->pPool);
+         delete pEntries;
+         pEntries = pNext;
+      }
+   }
+
+   // the pool for T, made on first use
+   template <typename T>
+   node_pool<T, B> & get()
+   {
+      for (Entry * p = pEntries; p; p = p->pNext)
+         if (p->key == key<T>())
+            return *static_cast<node_pool<T, B> *>(p->pPool);
+
+      std::unique_ptr<node_pool<T, B>> pPool(new node_pool<T, B>);
+      pEntries = new Entry{ key<T>(), pPool.get(), &destroyPool<T>, pEntries };
+      return *pPool.release();
+   }
+
+private:
+   // one pool, and how to delete it without knowing its type
+   struct Entry
+   {
+      const void * key;
+      void * pPool;
+      void (*destroy)(void *);
+      Entry * pNext;
+   };
+
+   // an address that is different for every T
+   template <typename T>
+   static const void * key()
+   {
+      static const char id = 0;
+      return &id;
+   }
+
+   template <typename T>
+   static void destroyPool(void * p) { delete static_cast<node_pool<T, B> *>(p); }
+
+   Entry * pEntries;    // the pools made so far, newest first
+};
+
+/*****************************************
+ * POOL ALLOCATOR
+ * A standard allocator that takes single objects
+ * from a node_pool.  Copies and rebound copies, as
+ * a container makes for its node type, share one
+ * pool_set and so compare equal.  Requests for more
+ * than one object go to the heap.
+ ****************************************/
+template <typename T, size_t B = 64>
+class pool_allocator
+{
+   template <typename U, size_t BB>
+   friend class pool_allocator;
+public:
+   using value_type = T;
+   using propagate_on_container_copy_assignment = std::true_type;
+   using propagate_on_container_move_assignment = std::true_type;
+   using propagate_on_container_swap            = std::true_type;
+
+   template <typename U>
+   struct rebind { using other = pool_allocator<U, B>; };
+
+   pool_allocator() : pools(std::make_shared<pool_set<B>>()),
+                      pool(&pools->template get<T>()) {}
+   template <typename U>
+   pool_allocator(const pool_allocator<U, B> & rhs) : pools(rhs.pools),
+                      pool(&pools->template get<T>()) {}
+   pool_allocator(const pool_allocator &) = default;
+   pool_allocator & operator = (const pool_allocator &) = default;
+
+   // a moved-from allocator still has to free what it handed out,
+   // so moving one copies it
+   pool_allocator(pool_allocator && rhs) : pools(rhs.pools), pool(rhs.pool) {}
+   pool_allocator & operator = (pool_allocator && rhs)
+   {
+      pools = rhs.pools;
+      pool = rhs.pool;
+      return *this;
+   }
+
+   T * allocate(size_t num)
+   {
+      if (num == 1)
+         return pool->allocate();
+      return static_cast<T *>(::operator new(num * sizeof(T)));
+   }
+   void deallocate(T * p, size_t num)
+   {
+      if (num == 1)
+         pool->deallocate(p);
+      else
+         ::operator delete(p);
+   }
+
+   // the pool behind this allocator, to look at how it is doing
+   const node_pool<T, B> & get_pool() const { return *pool; }
+
+   template <typename U>
+   bool operator == (const pool_allocator<U, B> & rhs) const { return pools == rhs.pools; }
+   template <typename U>
+   bool operator != (const pool_allocator<U, B> & rhs) const { return pools != rhs.pools; }
+
+private:
+   std::shared_ptr<pool_set<B>> pools;   // shared with every copy and rebinding
+   node_pool<T, B> * pool;               // ours, from pools
+};
+
+} // namespace custom
@@ -14,6 +14,7 @@
 
 #include "testSpy.h"        // for the spy unit tests
 #include "testNode.h"       // for the unit tests
+#include "testNodePool.h"   // for the node pool unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -26,6 +27,7 @@ int main()
    // unit tests
    TestSpy().run();
    TestNode().run();
+   TestNodePool().run();
 #endif // DEBUG
   
    return 0;
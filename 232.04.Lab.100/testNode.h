@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
 
 class TestNode : public UnitTest
 {
@@ -65,6 +66,14 @@ public:
       test_size_empty();
       test_size_standard();
       test_size_standardMiddle();
+
+      // Sort
+      test_sort_nullptr();
+      test_sort_standard();
+      test_sort_stable();
+      test_merge_standard();
+      test_unique_standard();
+      test_reverse_standard();
       
       report("Node");
    }
@@ -1372,6 +1381,169 @@ public:
    }  // teardown
 
 
+   /***************************************
+    * SORT
+    ***************************************/
+
+   // sorting nothing leaves nothing
+   void test_sort_nullptr()
+   {  // setup
+      Node <int> * p = nullptr;
+      // exercise
+      sort(p);
+      // verify
+      assertUnit(p == nullptr);
+   }  // teardown
+
+   // the nodes are relinked in order; no element is copied or moved
+   void test_sort_standard()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 31 | - | 11 | - | 26 |
+      //    +----+   +----+   +----+
+      Node <Spy> * p11 = nullptr;
+      Node <Spy> * p26 = nullptr;
+      Node <Spy> * p31 = nullptr;
+      setupStandardFixture(p11, p26, p31);
+      p31->pPrev = nullptr;
+      p31->pNext = p11;
+      p11->pPrev = p31;
+      p11->pNext = p26;
+      p26->pPrev = p11;
+      p26->pNext = nullptr;
+      Node <Spy> * p = p31;
+      Spy::reset();
+      // exercise
+      sort(p);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(p == p11);
+      assertUnit(p11->pNext == p26);
+      assertUnit(p26->pNext == p31);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(p);
+      // teardown
+      teardownStandardFixture(p);
+   }
+
+   // equal keys keep the order they had, across many merges
+   void test_sort_stable()
+   {  // setup
+      typedef std::pair<int, int> KeyOrder;
+      Node <KeyOrder> * p = nullptr;
+      for (int i = 999; i >= 0; i--)
+         p = insert(p, KeyOrder((i * 7919) % 13, i));
+      // exercise
+      sort(p, [](const KeyOrder & lhs, const KeyOrder & rhs) { return lhs.first < rhs.first; });
+      // verify
+      bool ordered = true;
+      bool linked = p->pPrev == nullptr;
+      for (Node <KeyOrder> * pNode = p; pNode->pNext; pNode = pNode->pNext)
+      {
+         const KeyOrder & a = pNode->data;
+         const KeyOrder & b = pNode->pNext->data;
+         ordered = ordered && (a.first < b.first || (a.first == b.first && a.second < b.second));
+         linked = linked && pNode->pNext->pPrev == pNode;
+      }
+      assertUnit(size(p) == 1000);
+      assertUnit(ordered);
+      assertUnit(linked);
+      // teardown
+      clear(p);
+   }
+
+   // merging relinks the nodes of both into one sorted list
+   void test_merge_standard()
+   {  // setup
+      //    +----+   +----+       +----+
+      //    | 11 | - | 31 |       | 26 |
+      //    +----+   +----+       +----+
+      Node <int> * p11 = nullptr;
+      Node <int> * p26 = nullptr;
+      Node <int> * p31 = nullptr;
+      setupStandardFixture(p11, p26, p31);
+      p11->pNext = p31;
+      p31->pPrev = p11;
+      p26->pPrev = p26->pNext = nullptr;
+      Node <int> * pLHS = p11;
+      Node <int> * pRHS = p26;
+      // exercise
+      merge(pLHS, pRHS);
+      // verify
+      assertUnit(pRHS == nullptr);
+      assertUnit(pLHS == p11);
+      assertUnit(p11->pNext == p26);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(pLHS);
+      // teardown
+      teardownStandardFixture(pLHS);
+   }
+
+   // each run of equal values is cut down to its first node
+   void test_unique_standard()
+   {  // setup
+      //    +----+   +----+   +----+   +----+   +----+   +----+
+      //    | 11 | - | 11 | - | 26 | - | 26 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+   +----+   +----+   +----+
+      Node <Spy> * p11 = nullptr;
+      Node <Spy> * p26 = nullptr;
+      Node <Spy> * p31 = nullptr;
+      setupStandardFixture(p11, p26, p31);
+      insert(p11, Spy(11), true);
+      insert(p26, Spy(26), true);
+      insert(p26, Spy(26), true);
+      Spy::reset();
+      // exercise
+      size_t numRemoved = unique(p11);
+      // verify
+      assertUnit(numRemoved == 3);
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(Spy::numDelete() == 3);
+      assertUnit(p11->pNext == p26);
+      assertUnit(p26->pNext == p31);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(p11);
+      // teardown
+      teardownStandardFixture(p11);
+   }
+
+   // reversing swaps the links; the last node becomes the head
+   void test_reverse_standard()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 31 | - | 26 | - | 11 |
+      //    +----+   +----+   +----+
+      Node <int> * p11 = nullptr;
+      Node <int> * p26 = nullptr;
+      Node <int> * p31 = nullptr;
+      setupStandardFixture(p11, p26, p31);
+      std::swap(p11->pNext, p11->pPrev);
+      std::swap(p26->pNext, p26->pPrev);
+      std::swap(p31->pNext, p31->pPrev);
+      Node <int> * p = p31;
+      // exercise
+      reverse(p);
+      // verify
+      assertUnit(p == p11);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(p);
+      // teardown
+      teardownStandardFixture(p);
+   }
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *    +----+   +----+   +----+
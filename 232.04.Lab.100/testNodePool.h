@@ -0,0 +1,263 @@
+/***********************************************************************
+ * Header:
+ *    TEST NODE POOL
+ * Summary:
+ *    Unit tests for node_pool, and for the node.h functions that
+ *    take one
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "node.h"
+#include "node_pool.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <utility>
+
+class TestNodePool : public UnitTest
+{
+   typedef custom::node_pool<Node<int>, 4> IntPool;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Pool
+      test_construct_noSlabs();
+      test_allocate_contiguous();
+      test_allocate_newSlab();
+      test_deallocate_reused();
+      test_release_allSlabs();
+
+      // Node functions
+      test_copy_fromPool();
+      test_insert_fromPool();
+      test_remove_backToPool();
+      test_assign_reusesPool();
+      test_clear_spyDestroyed();
+
+      // Allocator
+      test_allocator_rebindShares();
+      test_allocator_moveKeepsPool();
+
+      report("NodePool");
+   }
+
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // nothing is allocated until the first node
+   void test_construct_noSlabs()
+   {  // setup
+      // exercise
+      IntPool pool;
+      // verify
+      assertUnit(pool.slabs() == 0);
+      assertUnit(pool.capacity() == 0);
+      assertUnit(pool.in_use() == 0);
+      assertUnit(pool.pFree == nullptr);
+   }  // teardown
+
+   // one after another, the nodes sit side by side
+   void test_allocate_contiguous()
+   {  // setup
+      IntPool pool;
+      // exercise
+      Node<int> * p0 = pool.create(26);
+      Node<int> * p1 = pool.create(49);
+      Node<int> * p2 = pool.create(67);
+      // verify
+      assertUnit(pool.slabs() == 1);
+      assertUnit(pool.in_use() == 3);
+      assertUnit(reinterpret_cast<char *>(p1) - reinterpret_cast<char *>(p0) == sizeof(IntPool::Slot));
+      assertUnit(reinterpret_cast<char *>(p2) - reinterpret_cast<char *>(p1) == sizeof(IntPool::Slot));
+      assertUnit(p1->data == 49);
+      assertUnit(p1->pNext == nullptr);
+   }  // teardown
+
+   // a full slab starts another
+   void test_allocate_newSlab()
+   {  // setup
+      IntPool pool;
+      for (int i = 0; i < 4; i++)
+         pool.create(i);
+      // exercise
+      pool.create(26);
+      // verify
+      assertUnit(pool.slabs() == 2);
+      assertUnit(pool.capacity() == 8);
+      assertUnit(pool.in_use() == 5);
+      assertUnit(pool.pSlabs->pPrev != nullptr);
+   }  // teardown
+
+   // the last node freed is the next one handed out
+   void test_deallocate_reused()
+   {  // setup
+      IntPool pool;
+      Node<int> * p0 = pool.create(26);
+      Node<int> * p1 = pool.create(49);
+      pool.destroy(p0);
+      pool.destroy(p1);
+      // exercise
+      Node<int> * pFirst = pool.create(67);
+      Node<int> * pSecond = pool.create(89);
+      // verify
+      assertUnit(pFirst == p1);
+      assertUnit(pSecond == p0);
+      assertUnit(pool.slabs() == 1);
+      assertUnit(pool.in_use() == 2);
+      assertUnit(pFirst->data == 67);
+   }  // teardown
+
+   // release gives back every slab in one go
+   void test_release_allSlabs()
+   {  // setup
+      IntPool pool;
+      for (int i = 0; i < 10; i++)
+         pool.create(i);
+      // exercise
+      pool.release();
+      // verify
+      assertUnit(pool.slabs() == 0);
+      assertUnit(pool.in_use() == 0);
+      assertUnit(pool.pSlabs == nullptr);
+      assertUnit(pool.create(26)->data == 26);
+   }  // teardown
+
+   /***************************************
+    * NODE FUNCTIONS
+    ***************************************/
+
+   // a copy comes out of the pool, laid out in order
+   void test_copy_fromPool()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 26 | - | 49 | - | 67 |
+      //    +----+   +----+   +----+
+      IntPool pool;
+      Node<int> * pSource = insert(insert(insert((Node<int> *)nullptr, 67, false, pool), 49, false, pool), 26, false, pool);
+      IntPool copies;
+      // exercise
+      Node<int> * pCopy = copy(pSource, copies);
+      // verify
+      assertUnit(copies.in_use() == 3);
+      assertUnit(pCopy->data == 26);
+      assertUnit(pCopy->pNext->data == 49);
+      assertUnit(pCopy->pNext->pNext->data == 67);
+      assertUnit(pCopy->pNext->pPrev == pCopy);
+      assertUnit(reinterpret_cast<char *>(pCopy->pNext) - reinterpret_cast<char *>(pCopy) == sizeof(IntPool::Slot));
+   }  // teardown
+
+   // insert takes its node from the pool and links it in
+   void test_insert_fromPool()
+   {  // setup
+      IntPool pool;
+      Node<int> * pHead = insert((Node<int> *)nullptr, 26, false, pool);
+      // exercise
+      Node<int> * pNew = insert(pHead, 49, true, pool);
+      // verify
+      assertUnit(pool.in_use() == 2);
+      assertUnit(pHead->pNext == pNew);
+      assertUnit(pNew->pPrev == pHead);
+      assertUnit(pNew->data == 49);
+   }  // teardown
+
+   // a removed node goes back to the pool for the next insert
+   void test_remove_backToPool()
+   {  // setup
+      IntPool pool;
+      Node<int> * pHead = insert((Node<int> *)nullptr, 26, false, pool);
+      Node<int> * pMiddle = insert(pHead, 49, true, pool);
+      insert(pMiddle, 67, true, pool);
+      // exercise
+      Node<int> * pBefore = remove(pMiddle, pool);
+      // verify
+      assertUnit(pBefore == pHead);
+      assertUnit(pool.in_use() == 2);
+      assertUnit(pHead->pNext->data == 67);
+      assertUnit(insert(pHead, 89, true, pool) == pMiddle);
+   }  // teardown
+
+   // assign frees the extra nodes into the pool and takes new ones from it
+   void test_assign_reusesPool()
+   {  // setup
+      IntPool pool;
+      Node<int> * pSource = insert((Node<int> *)nullptr, 26, false, pool);
+      Node<int> * pDest = insert((Node<int> *)nullptr, 11, false, pool);
+      insert(pDest, 22, true, pool);
+      insert(pDest->pNext, 33, true, pool);
+      // exercise
+      assign(pDest, pSource, pool);
+      // verify
+      assertUnit(pool.in_use() == 2);
+      assertUnit(pDest->data == 26);
+      assertUnit(pDest->pNext == nullptr);
+      assign(pSource, pDest, pool);
+      assertUnit(pool.in_use() == 2);
+   }  // teardown
+
+   // clear runs each destructor and keeps the memory in the pool
+   void test_clear_spyDestroyed()
+   {  // setup
+      custom::node_pool<Node<Spy>> pool;
+      Node<Spy> * pHead = insert((Node<Spy> *)nullptr, Spy(26), false, pool);
+      insert(pHead, Spy(49), true, pool);
+      Spy::reset();
+      // exercise
+      clear(pHead, pool);
+      // verify
+      assertUnit(pHead == nullptr);
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(pool.in_use() == 0);
+      assertUnit(pool.slabs() == 1);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // rebinding there and back lands on the same pools
+   void test_allocator_rebindShares()
+   {  // setup
+      custom::pool_allocator<int, 4> a;
+      // exercise
+      custom::pool_allocator<Node<int>, 4> aNode(a);
+      custom::pool_allocator<int, 4> aBack(aNode);
+      custom::pool_allocator<Node<int>, 4> aNodeAgain(aBack);
+      // verify
+      assertUnit(aBack == a);
+      assertUnit(aNode == a);
+      assertUnit(&aNodeAgain.get_pool() == &aNode.get_pool());
+      Node<int> * p = aNode.allocate(1);
+      assertUnit(aNodeAgain.get_pool().in_use() == 1);
+      aNodeAgain.deallocate(p, 1);
+      assertUnit(aNode.get_pool().in_use() == 0);
+   }  // teardown
+
+   // a moved-from allocator can still hand out and take back nodes
+   void test_allocator_moveKeepsPool()
+   {  // setup
+      custom::pool_allocator<Node<int>, 4> aSrc;
+      Node<int> * p = aSrc.allocate(1);
+      // exercise
+      custom::pool_allocator<Node<int>, 4> aDest(std::move(aSrc));
+      // verify
+      assertUnit(aDest == aSrc);
+      aSrc.deallocate(p, 1);
+      p = aSrc.allocate(1);
+      assertUnit(aDest.get_pool().in_use() == 1);
+      aDest.deallocate(p, 1);
+      aSrc = std::move(aDest);
+      assertUnit(aSrc == aDest);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,311 @@
+/***********************************************************************
+ * Header:
+ *    INTRUSIVE LIST
+ * Summary:
+ *    A linked list of objects that carry their own links.  Where
+ *    custom::list copies each element into a Node it allocates, an
+ *    intrusive_list is handed objects that already exist, each with a
+ *    list_hook member holding the pNext and pPrev of a Node.  Linking
+ *    and unlinking only rewrite those pointers: nothing is allocated,
+ *    copied, or freed, and walking the list lands straight on the
+ *    objects themselves.  An object with several hooks can be on as
+ *    many lists at once, one per hook.
+ *
+ *    The list does not own what is on it.  An object must be taken
+ *    off every list it is on before it is destroyed, and can be on
+ *    only one list per hook.
+ *
+ *    This will contain the class definitions of:
+ *        list_hook                : the links, a member of T
+ *        intrusive_list           : a list threaded through one hook
+ *        intrusive_list::iterator : an iterator through it
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // for ASSERT
+#include <cstddef>      // for size_t
+#include <iterator>     // for std::bidirectional_iterator_tag
+#include <utility>      // for std::swap
+
+class TestIntrusiveList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*************************************************
+ * LIST HOOK
+ * The pNext and pPrev of a Node<T>, to be made a
+ * member of T itself.  Copying an object does not
+ * put the copy on any list, so a hook copies as
+ * unlinked and keeps its own links on assignment.
+ *************************************************/
+template <class T>
+struct list_hook
+{
+   list_hook() : pNext(nullptr), pPrev(nullptr) {}
+   list_hook(const list_hook &) : pNext(nullptr), pPrev(nullptr) {}
+   list_hook & operator = (const list_hook &) { return *this; }
+
+   T * pNext;       // the next object on the list
+   T * pPrev;       // the previous object on the list
+};
+
+/**************************************************
+ * INTRUSIVE LIST
+ * The interface of custom::list, taking objects
+ * by reference and linking them through Hook
+ **************************************************/
+template <class T, list_hook<T> T::*Hook>
+class intrusive_list
+{
+   friend class ::TestIntrusiveList; // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+
+   intrusive_list() : numElements(0), pHead(nullptr), pTail(nullptr) {}
+   intrusive_list(const intrusive_list &) = delete;
+   intrusive_list(intrusive_list && rhs) : numElements(0), pHead(nullptr), pTail(nullptr)
+   {
+      swap(rhs);
+   }
+   ~intrusive_list()
+   {
+      clear();
+   }
+
+   //
+   // Assign
+   //
+
+   intrusive_list & operator = (const intrusive_list &) = delete;
+   intrusive_list & operator = (intrusive_list && rhs)
+   {
+      clear();
+      swap(rhs);
+      return *this;
+   }
+   void swap(intrusive_list & rhs)
+   {
+      std::swap(numElements, rhs.numElements);
+      std::swap(pHead, rhs.pHead);
+      std::swap(pTail, rhs.pTail);
+   }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(pHead); }
+   iterator end()   { return iterator();      }
+
+   // the position of t, which must be on this list
+   iterator iterator_to(T & t) { return iterator(&t); }
+
+   //
+   // Access
+   //
+
+   T & front();
+   T & back();
+
+   //
+   // Insert
+   //
+
+   void push_front(T & t) { insert(begin(), t); }
+   void push_back (T & t) { insert(end(),   t); }
+   iterator insert(iterator it, T & t);
+
+   //
+   // Remove
+   //
+
+   void pop_back()  { if (pTail) erase(*pTail); }
+   void pop_front() { if (pHead) erase(*pHead); }
+   void clear();
+   iterator erase(const iterator & it) { return it.p ? erase(*it.p) : end(); }
+   iterator erase(T & t);
+
+   //
+   // Status
+   //
+
+   bool   empty() const { return numElements == 0; }
+   size_t size()  const { return numElements;      }
+
+private:
+
+   // the links of t for this list
+   static list_hook<T> & hook(T * p) { return p->*Hook; }
+
+   size_t numElements;   // the number of objects linked in
+   T * pHead;            // the first object
+   T * pTail;            // the last object
+};
+
+/*************************************************
+ * INTRUSIVE LIST ITERATOR
+ * An object on the list; end() is nullptr
+ ************************************************/
+template <class T, list_hook<T> T::*Hook>
+class intrusive_list <T, Hook> :: iterator
+{
+   friend class ::TestIntrusiveList; // give unit tests access to the privates
+   friend class intrusive_list <T, Hook>;
+public:
+   using iterator_category = std::bidirectional_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = T *;
+   using reference         = T &;
+
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+   iterator(T * p) : p(p) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator: the object itself
+   T & operator *  () const { return *p; }
+   T * operator -> () const { return  p; }
+
+   // prefix increment
+   iterator & operator ++ ()
+   {
+      if (p) p = intrusive_list::hook(p).pNext;
+      return *this;
+   }
+   iterator operator ++ (int postfix)
+   {
+      iterator temp = *this;
+      ++(*this);
+      return temp;
+   }
+
+   // prefix decrement
+   iterator & operator -- ()
+   {
+      p = intrusive_list::hook(p).pPrev;
+      return *this;
+   }
+   iterator operator -- (int postfix)
+   {
+      iterator temp = *this;
+      --(*this);
+      return temp;
+   }
+
+private:
+   T * p;
+};
+
+/*********************************************
+ * INTRUSIVE LIST :: FRONT and BACK
+ *     COST   : O(1)
+ *********************************************/
+template <class T, list_hook<T> T::*Hook>
+T & intrusive_list <T, Hook> :: front()
+{
+   if (pHead == nullptr)
+      throw "ERROR: unable to access data from an empty list";
+   return *pHead;
+}
+
+template <class T, list_hook<T> T::*Hook>
+T & intrusive_list <T, Hook> :: back()
+{
+   if (pTail == nullptr)
+      throw "ERROR: unable to access data from an empty list";
+   return *pTail;
+}
+
+/******************************************
+ * INTRUSIVE LIST :: INSERT
+ * link t in before it
+ *     INPUT  : where, end() for the back
+ *              an object on no list through this hook
+ *     OUTPUT : iterator to t
+ *     COST   : O(1)
+ ******************************************/
+template <class T, list_hook<T> T::*Hook>
+typename intrusive_list <T, Hook> :: iterator
+intrusive_list <T, Hook> :: insert(iterator it, T & t)
+{
+   list_hook<T> & links = hook(&t);
+   assert(links.pNext == nullptr && links.pPrev == nullptr && pHead != &t);
+
+   links.pNext = it.p;
+   links.pPrev = it.p ? hook(it.p).pPrev : pTail;
+
+   if (links.pPrev)
+      hook(links.pPrev).pNext = &t;
+   else
+      pHead = &t;
+
+   if (links.pNext)
+      hook(links.pNext).pPrev = &t;
+   else
+      pTail = &t;
+
+   numElements++;
+   return iterator(&t);
+}
+
+/******************************************
+ * INTRUSIVE LIST :: ERASE
+ * unlink t, leaving it as it was before it was
+ * inserted.  t itself is not touched otherwise.
+ *     INPUT  : an object on this list
+ *     OUTPUT : iterator to the one after it
+ *     COST   : O(1)
+ ******************************************/
+template <class T, list_hook<T> T::*Hook>
+typename intrusive_list <T, Hook> :: iterator
+intrusive_list <T, Hook> :: erase(T & t)
+{
+   list_hook<T> & links = hook(&t);
+   assert(numElements > 0);
+
+   if (links.pPrev)
+      hook(links.pPrev).pNext = links.pNext;
+   else
+      pHead = links.pNext;
+
+   if (links.pNext)
+      hook(links.pNext).pPrev = links.pPrev;
+   else
+      pTail = links.pPrev;
+
+   iterator itReturn(links.pNext);
+   links.pNext = links.pPrev = nullptr;
+   numElements--;
+   return itReturn;
+}
+
+/**********************************************
+ * INTRUSIVE LIST :: CLEAR
+ * Unlink every object, destroying none of them
+ *     COST   : O(n)
+ *********************************************/
+template <class T, list_hook<T> T::*Hook>
+void intrusive_list <T, Hook> :: clear()
+{
+   while (pHead)
+   {
+      list_hook<T> & links = hook(pHead);
+      pHead = links.pNext;
+      links.pNext = links.pPrev = nullptr;
+   }
+   pTail = nullptr;
+   numElements = 0;
+}
+
+} // namespace custom
@@ -11,6 +11,10 @@
  *    |_____|  '.____.'   '.____.'  /_/
  *
  *
+ *    The nodes come from the allocator.  custom::pool_allocator
+ *    carves them out of slabs and reuses the ones freed, so a list
+ *    that churns does not go to the heap for every node.
+ *
  *    This will contain the class definition of:
  *        List         : A class that represents a List
  *        ListIterator : An iterator through List
@@ -20,9 +24,11 @@
 
 #pragma once
 #include <cassert>     // for ASSERT
+#include <functional>  // for std::less
 #include <iostream>    // for nullptr
 #include <new>         // std::bad_alloc
 #include <memory>      // for std::allocator
+#include "node_pool.h" // for pool_allocator
  
 class TestList;        // forward declaration for unit tests
 class TestHash;        // to be used later
@@ -34,37 +40,39 @@ namespace custom
  * LIST
  * Just like std::list
  **************************************************/
-template <typename T>
+template <typename T, typename A = std::allocator<T>>
 class list
 {
    friend class ::TestList; // give unit tests access to the privates
    friend class ::TestHash;
-   friend void swap(list& lhs, list& rhs);
+   template <typename TT, typename AA>
+   friend void swap(list <TT, AA> & lhs, list <TT, AA> & rhs);
 public:  
    // 
    // Construct
    //
 
-   list();
-   list(list <T> & rhs);
-   list(list <T>&& rhs);
-   list(size_t num, const T & t);
-   list(size_t num);
-   list(const std::initializer_list<T>& il);
+   list(const A & a = A());
+   list(list <T, A> & rhs);
+   list(list <T, A>&& rhs);
+   list(size_t num, const T & t,            const A & a = A());
+   list(size_t num,                         const A & a = A());
+   list(const std::initializer_list<T>& il, const A & a = A());
    template <class Iterator>
-   list(Iterator first, Iterator last);
-  ~list() 
+   list(Iterator first, Iterator last,      const A & a = A());
+  ~list()
    {
+      clear();
    }
 
    // 
    // Assign
    //
 
-   list <T> & operator = (list &  rhs);
-   list <T> & operator = (list && rhs);
-   list <T> & operator = (const std::initializer_list<T>& il);
-   void swap(list <T>& rhs);
+   list <T, A> & operator = (list &  rhs);
+   list <T, A> & operator = (list && rhs);
+   list <T, A> & operator = (const std::initializer_list<T>& il);
+   void swap(list <T, A>& rhs);
 
    //
    // Iterator
@@ -101,6 +109,19 @@ public:
    void pop_front();
    void clear();
    iterator erase(const iterator& it);
+   size_t unique();
+
+   //
+   // Reorder
+   //
+
+   void sort() { sort(std::less<T>()); }
+   template <class Compare>
+   void sort(Compare less);
+   void merge(list <T, A> & rhs) { merge(rhs, std::less<T>()); }
+   template <class Compare>
+   void merge(list <T, A> & rhs, Compare less);
+   void reverse();
 
    // 
    // Status
@@ -108,13 +129,48 @@ public:
 
    bool empty()  const { return numElements < 1; }
    size_t size() const { return numElements;   }
+   A get_allocator() const { return A(alloc);  }
 
 
 private:
    // nested linked list class
    class Node;
 
+   // nodes come from the user's allocator, rebound to the node type
+   using NodeAlloc = typename std::allocator_traits<A>::template rebind_alloc<Node>;
+   using traits    = std::allocator_traits<NodeAlloc>;
+
+   // allocate and construct a single node
+   template <class ... Args>
+   Node * allocateNode(Args && ... args)
+   {
+      Node * p = traits::allocate(alloc, 1);
+      traits::construct(alloc, p, std::forward<Args>(args)...);
+      return p;
+   }
+
+   // destroy and free a single node
+   void freeNode(Node * p)
+   {
+      traits::destroy(alloc, p);
+      traits::deallocate(alloc, p, 1);
+   }
+
+   // the allocator follows the nodes only when its traits say so
+   void copyAlloc(const NodeAlloc & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const NodeAlloc &,     std::false_type) {                         }
+   void moveAlloc(NodeAlloc & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(NodeAlloc &,           std::false_type) {                         }
+
+   // merge two sorted chains linked by pNext alone
+   template <class Compare>
+   static Node * mergeChains(Node * pLHS, Node * pRHS, Compare less);
+
+   // set every pPrev, and pTail, from the pNext chain
+   void relink();
+
    // member variables
+   NodeAlloc alloc;    // hands out the nodes
    size_t numElements; // though we could count, it is faster to keep a variable
    Node * pHead;    // pointer to the beginning of the list
    Node * pTail;    // pointer to the ending of the list
@@ -127,8 +183,8 @@ private:
  * private.  This is the case because only the
  * List class can make validation decisions
  *************************************************/
-template <typename T>
-class list <T> :: Node
+template <typename T, typename A>
+class list <T, A> :: Node
 {
 public:
    //
@@ -154,12 +210,12 @@ public:
  * LIST ITERATOR
  * Iterate through a List, non-constant version
  ************************************************/
-template <typename T>
-class list <T> :: iterator
+template <typename T, typename A>
+class list <T, A> :: iterator
 {
    friend class ::TestList; // give unit tests access to the privates
    friend class ::TestHash;
-   template <typename TT>
+   template <typename TT, typename AA>
    friend class custom::list;
 public:
    // constructors, destructors, and assignment operator
@@ -218,21 +274,21 @@ public:
    } 
 
    // two friends who need to access p directly
-   friend iterator list <T> :: insert(iterator it, const T &  data);
-   friend iterator list <T> :: insert(iterator it,       T && data);
-   friend iterator list <T> :: erase(const iterator & it);
+   friend iterator list <T, A> :: insert(iterator it, const T &  data);
+   friend iterator list <T, A> :: insert(iterator it,       T && data);
+   friend iterator list <T, A> :: erase(const iterator & it);
 
 private:
 
-   typename list <T> :: Node * p;
+   typename list <T, A> :: Node * p;
 };
 
 /*****************************************
  * LIST :: NON-DEFAULT constructors
  * Create a list initialized to a value
  ****************************************/
-template <typename T>
-list <T> ::list(size_t num, const T & t) 
+template <typename T, typename A>
+list <T, A> ::list(size_t num, const T & t, const A & a) : alloc(a)
 {
    numElements = 0;
    pHead = pTail = nullptr;
@@ -247,9 +303,9 @@ list <T> ::list(size_t num, const T & t)
  * LIST :: ITERATOR constructors
  * Create a list initialized to a set of values
  ****************************************/
-template <typename T>
+template <typename T, typename A>
 template <class Iterator>
-list <T> ::list(Iterator first, Iterator last)
+list <T, A> ::list(Iterator first, Iterator last, const A & a) : alloc(a)
 {
    numElements = 0;
    pHead = pTail = nullptr;
@@ -264,8 +320,8 @@ list <T> ::list(Iterator first, Iterator last)
  * LIST :: INITIALIZER constructors
  * Create a list initialized to a set of values
  ****************************************/
-template <typename T>
-list <T> ::list(const std::initializer_list<T>& il)
+template <typename T, typename A>
+list <T, A> ::list(const std::initializer_list<T>& il, const A & a) : alloc(a)
 {
    numElements = 0;
    pHead = pTail = nullptr;
@@ -280,8 +336,8 @@ list <T> ::list(const std::initializer_list<T>& il)
  * LIST :: NON-DEFAULT constructors
  * Create a list initialized to a value
  ****************************************/
-template <typename T>
-list <T> ::list(size_t num)
+template <typename T, typename A>
+list <T, A> ::list(size_t num, const A & a) : alloc(a)
 {
    numElements = 0;
    pHead = pTail = nullptr;
@@ -296,8 +352,8 @@ list <T> ::list(size_t num)
 /*****************************************
  * LIST :: DEFAULT constructors
  ****************************************/
-template <typename T>
-list <T> ::list() 
+template <typename T, typename A>
+list <T, A> ::list(const A & a) : alloc(a)
 {
    numElements = 0;
    pHead = pTail = nullptr;
@@ -306,10 +362,11 @@ list <T> ::list()
 /*****************************************
  * LIST :: COPY constructors
  ****************************************/
-template <typename T>
-list <T> ::list(list& rhs) 
+template <typename T, typename A>
+list <T, A> ::list(list& rhs) :
+   alloc(traits::select_on_container_copy_construction(rhs.alloc))
 {
-   //numElements = rhs.numElements;
+   numElements = 0;
    pHead = pTail = nullptr;
 
    for (Node* p = rhs.pHead; p != nullptr; p = p->pNext)
@@ -322,8 +379,8 @@ list <T> ::list(list& rhs)
  * LIST :: MOVE constructors
  * Steal the values from the RHS
  ****************************************/
-template <typename T>
-list <T> ::list(list <T>&& rhs)
+template <typename T, typename A>
+list <T, A> ::list(list <T, A>&& rhs) : alloc(std::move(rhs.alloc))
 {
    numElements = rhs.numElements;
    pHead = rhs.pHead;
@@ -340,11 +397,22 @@ list <T> ::list(list <T>&& rhs)
  *     OUTPUT :
  *     COST   : O(n) with respect to the size of the LHS 
  *********************************************/
-template <typename T>
-list <T>& list <T> :: operator = (list <T> && rhs)
+template <typename T, typename A>
+list <T, A>& list <T, A> :: operator = (list <T, A> && rhs)
 {
 
-   clear(); 
+   clear();
+
+   // cannot adopt nodes our allocator did not hand out: move each element
+   if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+   {
+      for (Node * p = rhs.pHead; p != nullptr; p = p->pNext)
+         push_back(std::move(p->data));
+      rhs.clear();
+      return *this;
+   }
+
+   moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
    numElements = rhs.numElements;
    pHead = std::move(rhs.pHead);
    pTail = std::move(rhs.pTail);
@@ -365,11 +433,14 @@ list <T>& list <T> :: operator = (list <T> && rhs)
  *     OUTPUT :
  *     COST   : O(n) with respect to the number of nodes
  *********************************************/
-template <typename T>
-list <T> & list <T> :: operator = (list <T> & rhs)
+template <typename T, typename A>
+list <T, A> & list <T, A> :: operator = (list <T, A> & rhs)
 {
+   if (this == &rhs)
+      return *this;
+
    clear();
-   //numElements = rhs.numElements;
+   copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
 
    Node* pSource = rhs.pHead;
 
@@ -389,8 +460,8 @@ list <T> & list <T> :: operator = (list <T> & rhs)
  *     OUTPUT :
  *     COST   : O(n) with respect to the number of nodes
  *********************************************/
-template <typename T>
-list <T>& list <T> :: operator = (const std::initializer_list<T>& rhs)
+template <typename T, typename A>
+list <T, A>& list <T, A> :: operator = (const std::initializer_list<T>& rhs)
 {
    clear();
    //numElements = rhs.numElements;
@@ -410,15 +481,15 @@ list <T>& list <T> :: operator = (const std::initializer_list<T>& rhs)
  *     OUTPUT :
  *     COST   : O(n) with respect to the number of nodes
  *********************************************/
-template <typename T>
-void list <T> :: clear()
+template <typename T, typename A>
+void list <T, A> :: clear()
 {
-   Node* temp = nullptr;
+   Node* temp = pHead;
    Node* next = nullptr;
 
    while (temp != nullptr) {
       next = temp->pNext;
-      delete temp;
+      freeNode(temp);
       temp = next;
    }
 
@@ -434,11 +505,11 @@ void list <T> :: clear()
  *    OUTPUT :
  *    COST   : O(1)
  *********************************************/
-template <typename T>
-void list <T> :: push_back(const T & data)
+template <typename T, typename A>
+void list <T, A> :: push_back(const T & data)
 {
    // allocate a new node with the data
-   Node* newNode = new Node(data);
+   Node* newNode = allocateNode(data);
 
    if (pTail == nullptr) // if the list is empty
    {
@@ -454,10 +525,10 @@ void list <T> :: push_back(const T & data)
    numElements++;
 }
 
-template <typename T>
-void list <T> ::push_back(T && data)
+template <typename T, typename A>
+void list <T, A> ::push_back(T && data)
 {
-   Node* newNode = new Node(std::move(data));
+   Node* newNode = allocateNode(std::move(data));
 
    if (pTail == nullptr) // if the list is empty
    {
@@ -480,10 +551,10 @@ void list <T> ::push_back(T && data)
  *     OUTPUT :
  *     COST   : O(1)
  *********************************************/
-template <typename T>
-void list <T> :: push_front(const T & data)
+template <typename T, typename A>
+void list <T, A> :: push_front(const T & data)
 {
-   Node* newNode = new Node(data);
+   Node* newNode = allocateNode(data);
 
    if (pHead == nullptr)
    {
@@ -498,10 +569,10 @@ void list <T> :: push_front(const T & data)
    numElements++;
 }
 
-template <typename T>
-void list <T> ::push_front(T && data)
+template <typename T, typename A>
+void list <T, A> ::push_front(T && data)
 {
-   Node* newNode = new Node(std::move(data));
+   Node* newNode = allocateNode(std::move(data));
 
    if (pHead == nullptr)
    {
@@ -524,12 +595,12 @@ void list <T> ::push_front(T && data)
  *    OUTPUT :
  *    COST   : O(1)
  *********************************************/
-template <typename T>
-void list <T> ::pop_back()
+template <typename T, typename A>
+void list <T, A> ::pop_back()
 {
    if (pTail == nullptr) return;
 
-   Node* tempNode = new Node();
+   Node* tempNode = pTail;
    pTail = pTail->pPrev;
 
    if (pTail)
@@ -541,7 +612,7 @@ void list <T> ::pop_back()
       pHead = nullptr;
    }
 
-   delete tempNode;
+   freeNode(tempNode);
    numElements--;
 
 }
@@ -553,8 +624,8 @@ void list <T> ::pop_back()
  *    OUTPUT :
  *    COST   : O(1)
  *********************************************/
-template <typename T>
-void list <T> ::pop_front()
+template <typename T, typename A>
+void list <T, A> ::pop_front()
 {
    if (pHead == nullptr) return;
 
@@ -570,7 +641,7 @@ void list <T> ::pop_front()
       pTail = nullptr;
    }
 
-   delete tempNode;
+   freeNode(tempNode);
    numElements--;
 }
 
@@ -581,8 +652,8 @@ void list <T> ::pop_front()
  *     OUTPUT : data to be displayed
  *     COST   : O(1)
  *********************************************/
-template <typename T>
-T& list <T> ::front()
+template <typename T, typename A>
+T& list <T, A> ::front()
 {
    if (pHead == nullptr)
    {
@@ -598,8 +669,8 @@ T& list <T> ::front()
  *     OUTPUT : data to be displayed
  *     COST   : O(1)
  *********************************************/
-template <typename T>
-T & list <T> :: back()
+template <typename T, typename A>
+T & list <T, A> :: back()
 {
    if (pTail == nullptr)
    {
@@ -615,8 +686,8 @@ T & list <T> :: back()
  *     OUTPUT : iterator to the new location 
  *     COST   : O(1)
  ******************************************/
-template <typename T>
-typename list <T> :: iterator  list <T> :: erase(const list <T> :: iterator & it)
+template <typename T, typename A>
+typename list <T, A> :: iterator  list <T, A> :: erase(const list <T, A> :: iterator & it)
 {
    if (it.p == nullptr) return end();
 
@@ -633,7 +704,7 @@ typename list <T> :: iterator  list <T> :: erase(const list <T> :: iterator & it
       pTail = pDelete->pPrev;
 
    iterator itReturn(pDelete->pNext);
-   delete pDelete;
+   freeNode(pDelete);
    numElements--;
 
    return itReturn;
@@ -647,8 +718,8 @@ typename list <T> :: iterator  list <T> :: erase(const list <T> :: iterator & it
  *     OUTPUT : iterator to the new item
  *     COST   : O(1)
  ******************************************/
-template <typename T>
-typename list <T> :: iterator list <T> :: insert(list <T> :: iterator it,
+template <typename T, typename A>
+typename list <T, A> :: iterator list <T, A> :: insert(list <T, A> :: iterator it,
                                                  const T & data) 
 {
    if (it.p == nullptr) {
@@ -656,7 +727,7 @@ typename list <T> :: iterator list <T> :: insert(list <T> :: iterator it,
       return iterator(pTail);
    }
 
-   Node* newNode = new Node(data);
+   Node* newNode = allocateNode(data);
    newNode->pPrev = it.p->pPrev;
    newNode->pNext = it.p;
 
@@ -671,8 +742,8 @@ typename list <T> :: iterator list <T> :: insert(list <T> :: iterator it,
    return iterator(newNode);
 }
 
-template <typename T>
-typename list <T> :: iterator list <T> :: insert(list <T> :: iterator it,
+template <typename T, typename A>
+typename list <T, A> :: iterator list <T, A> :: insert(list <T, A> :: iterator it,
    T && data)
 {
    if (it.p == nullptr) {
@@ -680,7 +751,7 @@ typename list <T> :: iterator list <T> :: insert(list <T> :: iterator it,
       return iterator(pTail);
    }
 
-   Node* newNode = new Node(std::move(data));
+   Node* newNode = allocateNode(std::move(data));
    newNode->pPrev = it.p->pPrev;
    newNode->pNext = it.p;
 
@@ -695,6 +766,172 @@ typename list <T> :: iterator list <T> :: insert(list <T> :: iterator it,
    return iterator(newNode);
 }
 
+/******************************************
+ * LIST :: UNIQUE
+ * remove each element equal to the one before it
+ *     INPUT  :
+ *     OUTPUT : the number of elements removed
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+size_t list <T, A> :: unique()
+{
+   size_t numRemoved = 0;
+   if (pHead == nullptr)
+      return numRemoved;
+
+   Node * pKeep = pHead;
+   while (pKeep->pNext)
+   {
+      Node * pNext = pKeep->pNext;
+      if (pNext->data == pKeep->data)
+      {
+         pKeep->pNext = pNext->pNext;
+         if (pNext->pNext)
+            pNext->pNext->pPrev = pKeep;
+         freeNode(pNext);
+         numRemoved++;
+      }
+      else
+         pKeep = pNext;
+   }
+   pTail = pKeep;
+   numElements -= numRemoved;
+   return numRemoved;
+}
+
+/******************************************
+ * LIST :: MERGE CHAINS
+ * merge two sorted chains, following pNext only.
+ * On a tie the node from pLHS goes first.
+ *     INPUT  : two sorted chains and the ordering
+ *     OUTPUT : the head of the merged chain
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+template <class Compare>
+typename list <T, A> :: Node * list <T, A> :: mergeChains(Node * pLHS, Node * pRHS, Compare less)
+{
+   Node * pMerged = nullptr;
+   Node ** ppTail = &pMerged;
+   while (pLHS && pRHS)
+   {
+      if (less(pRHS->data, pLHS->data))
+      {
+         *ppTail = pRHS;
+         pRHS = pRHS->pNext;
+      }
+      else
+      {
+         *ppTail = pLHS;
+         pLHS = pLHS->pNext;
+      }
+      ppTail = &(*ppTail)->pNext;
+   }
+   *ppTail = pLHS ? pLHS : pRHS;
+   return pMerged;
+}
+
+/******************************************
+ * LIST :: RELINK
+ * walk the pNext chain from pHead, setting each
+ * pPrev and finding the new pTail
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+void list <T, A> :: relink()
+{
+   Node * pPrev = nullptr;
+   for (Node * p = pHead; p; p = p->pNext)
+   {
+      p->pPrev = pPrev;
+      pPrev = p;
+   }
+   pTail = pPrev;
+}
+
+/******************************************
+ * LIST :: SORT
+ * a stable, bottom-up merge sort that relinks the
+ * nodes in place.  Bin k holds a sorted run of 2^k
+ * nodes; each node taken off the front is carried
+ * up through the full bins like a binary counter.
+ * Nothing is allocated and no element is moved.
+ *     INPUT  : the ordering, std::less by default
+ *     OUTPUT :
+ *     COST   : O(n log n)
+ ******************************************/
+template <typename T, typename A>
+template <class Compare>
+void list <T, A> :: sort(Compare less)
+{
+   Node * bins[64] = {};
+   size_t numBins = 0;
+
+   while (pHead)
+   {
+      Node * pCarry = pHead;
+      pHead = pHead->pNext;
+      pCarry->pNext = nullptr;
+
+      // bin k holds older nodes than the carry: it goes on the left
+      size_t k = 0;
+      for (; k < numBins && bins[k]; k++)
+      {
+         pCarry = mergeChains(bins[k], pCarry, less);
+         bins[k] = nullptr;
+      }
+      bins[k] = pCarry;
+      if (k == numBins)
+         numBins++;
+   }
+
+   // the higher bins hold the older runs
+   for (size_t k = 0; k < numBins; k++)
+      if (bins[k])
+         pHead = mergeChains(bins[k], pHead, less);
+   relink();
+}
+
+/******************************************
+ * LIST :: MERGE
+ * move every node of a sorted rhs into this sorted
+ * list.  The nodes are relinked, so both lists must
+ * be able to free each other's nodes.
+ *     INPUT  : the list to take from, the ordering
+ *     OUTPUT : rhs is empty
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+template <class Compare>
+void list <T, A> :: merge(list <T, A> & rhs, Compare less)
+{
+   if (this == &rhs)
+      return;
+   assert(alloc == rhs.alloc);
+
+   pHead = mergeChains(pHead, rhs.pHead, less);
+   numElements += rhs.numElements;
+   relink();
+
+   rhs.pHead = rhs.pTail = nullptr;
+   rhs.numElements = 0;
+}
+
+/******************************************
+ * LIST :: REVERSE
+ * swap the two links of every node, then the
+ * head and the tail
+ *     COST   : O(n)
+ ******************************************/
+template <typename T, typename A>
+void list <T, A> :: reverse()
+{
+   for (Node * p = pHead; p; p = p->pPrev)
+      std::swap(p->pNext, p->pPrev);
+   std::swap(pHead, pTail);
+}
+
 /**********************************************
  * LIST :: assignment operator - MOVE
  * Copy one list onto another
@@ -702,18 +939,23 @@ typename list <T> :: iterator list <T> :: insert(list <T> :: iterator it,
  *     OUTPUT :
  *     COST   : O(n) with respect to the size of the LHS
  *********************************************/
-template <typename T>
-void swap(list <T> & lhs, list <T> & rhs)
+template <typename T, typename A>
+void swap(list <T, A> & lhs, list <T, A> & rhs)
 {
+   // unequal allocators that do not propagate cannot trade nodes
+   using traits = typename list <T, A> :: traits;
+   assert(traits::propagate_on_container_swap::value || lhs.alloc == rhs.alloc);
+   if (traits::propagate_on_container_swap::value)
+      std::swap(lhs.alloc, rhs.alloc);
    std::swap(lhs.pHead, rhs.pHead);
    std::swap(lhs.pTail, rhs.pTail);
    std::swap(lhs.numElements, rhs.numElements);
 }
 
-template <typename T>
-void list<T>::swap(list <T>& rhs)
+template <typename T, typename A>
+void list<T, A>::swap(list <T, A>& rhs)
 {
-   std::swap(*this, rhs);
+   custom::swap(*this, rhs);
 }
 
 //#endif
@@ -0,0 +1,288 @@
+/***********************************************************************
+ * Header:
+ *    TEST INTRUSIVE LIST
+ * Summary:
+ *    Unit tests for intrusive_list
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "intrusive_list.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <string>
+#include <utility>
+
+class TestIntrusiveList : public UnitTest
+{
+   // something that lives elsewhere and sits on two lists at once
+   struct Connection
+   {
+      Connection(int id) : id(id) {}
+      int id;
+      custom::list_hook<Connection> byAge;
+      custom::list_hook<Connection> byHost;
+   };
+   typedef custom::intrusive_list<Connection, &Connection::byAge>  AgeList;
+   typedef custom::intrusive_list<Connection, &Connection::byHost> HostList;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructMove_standard();
+
+      // Insert
+      test_pushBack_linksInPlace();
+      test_pushFront_order();
+      test_insert_middle();
+
+      // Remove
+      test_erase_unlinks();
+      test_pop_bothEnds();
+      test_clear_objectsIntact();
+
+      // Several lists
+      test_twoHooks_independent();
+      test_copyObject_unlinked();
+
+      report("IntrusiveList");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty list, and a hook that is on no list
+   void test_construct_default()
+   {  // setup
+      // exercise
+      AgeList l;
+      Connection c(26);
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.begin() == l.end());
+      assertUnit(c.byAge.pNext == nullptr);
+      assertUnit(c.byAge.pPrev == nullptr);
+      assertUnit(sizeof(custom::list_hook<Connection>) == 2 * sizeof(Connection *));
+   }  // teardown
+
+   // a move takes the objects, which do not move at all
+   void test_constructMove_standard()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      AgeList lSrc;
+      lSrc.push_back(c26);
+      lSrc.push_back(c49);
+      // exercise
+      AgeList lDest(std::move(lSrc));
+      // verify
+      assertUnit(lSrc.empty());
+      assertUnit(lSrc.pHead == nullptr);
+      assertUnit(lDest.size() == 2);
+      assertUnit(&lDest.front() == &c26);
+      assertUnit(&lDest.back() == &c49);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // the links are written into the object; the list holds it, not a copy
+   void test_pushBack_linksInPlace()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      Connection c67(67);
+      AgeList l;
+      // exercise
+      l.push_back(c26);
+      l.push_back(c49);
+      l.push_back(c67);
+      // verify
+      assertUnit(l.size() == 3);
+      assertUnit(&*l.begin() == &c26);
+      assertUnit(c26.byAge.pNext == &c49);
+      assertUnit(c49.byAge.pPrev == &c26);
+      assertUnit(c49.byAge.pNext == &c67);
+      assertUnit(c67.byAge.pNext == nullptr);
+      assertUnit(l.pTail == &c67);
+      assertUnit(c26.byHost.pNext == nullptr);
+      assertUnit(ids(l) == "26,49,67,");
+   }  // teardown
+
+   // push_front goes ahead of the rest
+   void test_pushFront_order()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      AgeList l;
+      // exercise
+      l.push_front(c26);
+      l.push_front(c49);
+      // verify
+      assertUnit(l.front().id == 49);
+      assertUnit(l.back().id == 26);
+      assertUnit(ids(l) == "49,26,");
+   }  // teardown
+
+   // insert goes before the iterator and returns the object
+   void test_insert_middle()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      Connection c67(67);
+      AgeList l;
+      l.push_back(c26);
+      l.push_back(c67);
+      // exercise
+      auto it = l.insert(l.iterator_to(c67), c49);
+      // verify
+      assertUnit(&*it == &c49);
+      assertUnit(it->id == 49);
+      assertUnit(ids(l) == "26,49,67,");
+      --it;
+      assertUnit(&*it == &c26);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase unlinks the object and leaves it otherwise alone
+   void test_erase_unlinks()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      Connection c67(67);
+      AgeList l;
+      l.push_back(c26);
+      l.push_back(c49);
+      l.push_back(c67);
+      // exercise
+      auto it = l.erase(c49);
+      // verify
+      assertUnit(&*it == &c67);
+      assertUnit(l.size() == 2);
+      assertUnit(c26.byAge.pNext == &c67);
+      assertUnit(c67.byAge.pPrev == &c26);
+      assertUnit(c49.byAge.pNext == nullptr);
+      assertUnit(c49.byAge.pPrev == nullptr);
+      assertUnit(c49.id == 49);
+      assertUnit(l.erase(l.iterator_to(c67)) == l.end());
+      assertUnit(l.pTail == &c26);
+   }  // teardown
+
+   // popping from both ends down to nothing
+   void test_pop_bothEnds()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      Connection c67(67);
+      AgeList l;
+      l.push_back(c26);
+      l.push_back(c49);
+      l.push_back(c67);
+      // exercise
+      l.pop_front();
+      l.pop_back();
+      // verify
+      assertUnit(ids(l) == "49,");
+      assertUnit(l.pHead == &c49);
+      assertUnit(l.pTail == &c49);
+      l.pop_back();
+      l.pop_front();
+      assertUnit(l.empty());
+      assertUnit(l.pHead == nullptr);
+   }  // teardown
+
+   // clear unlinks everything so the objects can go on another list
+   void test_clear_objectsIntact()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      AgeList l;
+      l.push_back(c26);
+      l.push_back(c49);
+      // exercise
+      l.clear();
+      // verify
+      assertUnit(l.empty());
+      assertUnit(c26.byAge.pNext == nullptr);
+      assertUnit(c49.byAge.pPrev == nullptr);
+      AgeList lOther;
+      lOther.push_back(c49);
+      assertUnit(&lOther.front() == &c49);
+   }  // teardown
+
+   /***************************************
+    * SEVERAL LISTS
+    ***************************************/
+
+   // the same objects in a different order on each hook
+   void test_twoHooks_independent()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      Connection c67(67);
+      AgeList lAge;
+      HostList lHost;
+      // exercise
+      lAge.push_back(c26);
+      lAge.push_back(c49);
+      lAge.push_back(c67);
+      lHost.push_back(c67);
+      lHost.push_back(c26);
+      lAge.erase(c26);
+      // verify
+      assertUnit(ids(lAge) == "49,67,");
+      assertUnit(lHost.size() == 2);
+      assertUnit(&lHost.back() == &c26);
+      assertUnit(c67.byHost.pNext == &c26);
+      assertUnit(c26.byHost.pPrev == &c67);
+   }  // teardown
+
+   // a copy of a linked object starts on no list
+   void test_copyObject_unlinked()
+   {  // setup
+      Connection c26(26);
+      Connection c49(49);
+      AgeList l;
+      l.push_back(c26);
+      l.push_back(c49);
+      // exercise
+      Connection cCopy(c26);
+      c49 = cCopy;
+      // verify
+      assertUnit(cCopy.id == 26);
+      assertUnit(cCopy.byAge.pNext == nullptr);
+      assertUnit(c49.id == 26);
+      assertUnit(c49.byAge.pPrev == &c26);
+      assertUnit(c26.byAge.pNext == &c49);
+      assertUnit(l.size() == 2);
+   }  // teardown
+
+   /*************************************************************
+    * IDS
+    * The ids on an age list, front to back, each followed by ,
+    *************************************************************/
+   std::string ids(AgeList & l)
+   {
+      std::string s;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         s += std::to_string(it->id) + ",";
+      return s;
+   }
+};
+
+#endif // DEBUG
@@ -16,6 +16,7 @@
 #include "unitTest.h"
 
 #include <vector>
+#include <utility>
 #include <cassert>
 #include <memory>
 #include <iostream>
@@ -120,9 +121,212 @@ public:
       test_empty_empty();
       test_empty_three();
 
+      // Reorder
+      test_sort_standard();
+      test_sort_stable();
+      test_merge_standard();
+      test_unique_standard();
+      test_reverse_standard();
+
+      // Pool
+      test_pool_nodesSideBySide();
+      test_pool_eraseReused();
+      test_pool_copyShares();
+      test_pool_moveLeavesUsable();
+      test_pool_mergeSharedAllocator();
+
       report("List");
    }
 
+   /***************************************
+    * REORDER
+    ***************************************/
+
+   // sort relinks the nodes it already has
+   void test_sort_standard()
+   {  // setup
+      //    +----+   +----+   +----+
+      //    | 31 | - | 11 | - | 26 |
+      //    +----+   +----+   +----+
+      custom::list<int> l{31, 11, 26};
+      auto p31 = l.pHead;
+      auto p26 = l.pTail;
+      // exercise
+      l.sort();
+      // verify
+      assertUnit(l.pTail == p31);
+      assertUnit(l.pHead->pNext == p26);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // equal keys keep their order, and the back links are all right
+   void test_sort_stable()
+   {  // setup
+      typedef std::pair<int, int> KeyOrder;
+      custom::list<KeyOrder> l;
+      for (int i = 0; i < 1000; i++)
+         l.push_back(KeyOrder((i * 7919) % 13, i));
+      // exercise
+      l.sort([](const KeyOrder & lhs, const KeyOrder & rhs) { return lhs.first < rhs.first; });
+      // verify
+      bool ordered = true;
+      bool linked = l.pHead->pPrev == nullptr && l.pTail->pNext == nullptr;
+      for (auto p = l.pHead; p->pNext; p = p->pNext)
+      {
+         const KeyOrder & a = p->data;
+         const KeyOrder & b = p->pNext->data;
+         ordered = ordered && (a.first < b.first || (a.first == b.first && a.second < b.second));
+         linked = linked && p->pNext->pPrev == p;
+      }
+      assertUnit(l.size() == 1000);
+      assertUnit(ordered);
+      assertUnit(linked);
+   }  // teardown
+
+   // merge takes every node of the other list
+   void test_merge_standard()
+   {  // setup
+      custom::list<int> l{11, 31};
+      custom::list<int> lOther{26};
+      auto p26 = lOther.pHead;
+      // exercise
+      l.merge(lOther);
+      // verify
+      assertUnit(lOther.empty());
+      assertUnit(lOther.pHead == nullptr);
+      assertUnit(l.pHead->pNext == p26);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // unique keeps the first of each run
+   void test_unique_standard()
+   {  // setup
+      custom::list<int> l{11, 11, 26, 26, 26, 31, 31};
+      // exercise
+      size_t numRemoved = l.unique();
+      // verify
+      assertUnit(numRemoved == 4);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   // reverse turns the links around, head for tail
+   void test_reverse_standard()
+   {  // setup
+      custom::list<int> l{31, 26, 11};
+      auto p31 = l.pHead;
+      // exercise
+      l.reverse();
+      // verify
+      assertUnit(l.pTail == p31);
+      //    +----+   +----+   +----+
+      //    | 11 | - | 26 | - | 31 |
+      //    +----+   +----+   +----+
+      assertStandardFixture(l);
+      // teardown
+      teardownStandardFixture(l);
+   }
+
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // nodes pushed one after another come out of one slab in order
+   void test_pool_nodesSideBySide()
+   {  // setup
+      custom::list<int, custom::pool_allocator<int>> l;
+      // exercise
+      l.push_back(26);
+      l.push_back(49);
+      l.push_back(67);
+      // verify
+      assertUnit(l.size() == 3);
+      assertUnit(l.alloc.get_pool().in_use() == 3);
+      assertUnit(l.alloc.get_pool().slabs() == 1);
+      assertUnit(reinterpret_cast<char *>(l.pHead->pNext) - reinterpret_cast<char *>(l.pHead) ==
+                 reinterpret_cast<char *>(l.pTail) - reinterpret_cast<char *>(l.pHead->pNext));
+      assertUnit(l.back() == 67);
+   }  // teardown
+
+   // an erased node is the next one handed out
+   void test_pool_eraseReused()
+   {  // setup
+      custom::list<int, custom::pool_allocator<int>> l{26, 49, 67};
+      auto pMiddle = l.pHead->pNext;
+      // exercise
+      l.erase(custom::list<int, custom::pool_allocator<int>>::iterator(pMiddle));
+      l.push_front(11);
+      // verify
+      assertUnit(l.pHead == pMiddle);
+      assertUnit(l.front() == 11);
+      assertUnit(l.size() == 3);
+      assertUnit(l.alloc.get_pool().in_use() == 3);
+   }  // teardown
+
+   // a copy draws on the same pool; clearing gives the nodes back to it
+   void test_pool_copyShares()
+   {  // setup
+      custom::list<int, custom::pool_allocator<int>> lSrc{26, 49, 67};
+      // exercise
+      custom::list<int, custom::pool_allocator<int>> lDest(lSrc);
+      // verify
+      assertUnit(lDest.alloc == lSrc.alloc);
+      assertUnit(lSrc.alloc.get_pool().in_use() == 6);
+      assertUnit(lDest.front() == 26);
+      lSrc.clear();
+      assertUnit(lDest.alloc.get_pool().in_use() == 3);
+      assertUnit(lDest.alloc.get_pool().slabs() == 1);
+   }  // teardown
+
+   // the list moved from still has a pool to push onto
+   void test_pool_moveLeavesUsable()
+   {  // setup
+      custom::list<int, custom::pool_allocator<int>> lSrc{26, 49};
+      // exercise
+      custom::list<int, custom::pool_allocator<int>> lDest(std::move(lSrc));
+      lSrc.push_back(67);
+      // verify
+      assertUnit(lSrc.size() == 1);
+      assertUnit(lSrc.front() == 67);
+      assertUnit(lDest.size() == 2);
+      assertUnit(lDest.alloc.get_pool().in_use() == 3);
+   }  // teardown
+
+   // a list built from another's allocator shares its pool, so they can merge
+   void test_pool_mergeSharedAllocator()
+   {  // setup
+      custom::list<int, custom::pool_allocator<int>> lDest{11, 49, 89};
+      custom::list<int, custom::pool_allocator<int>> lSrc({26, 67}, lDest.get_allocator());
+      // exercise
+      lDest.merge(lSrc);
+      // verify
+      assertUnit(lDest.get_allocator() == lDest.alloc);
+      assertUnit(lSrc.alloc == lDest.alloc);
+      assertUnit(lSrc.empty());
+      assertUnit(lDest.size() == 5);
+      assertUnit(lDest.front() == 11);
+      assertUnit(lDest.pHead->pNext->data == 26);
+      assertUnit(lDest.back() == 89);
+      assertUnit(lDest.alloc.get_pool().in_use() == 5);
+      lSrc.push_back(1);
+      lDest.clear();
+      assertUnit(lSrc.alloc.get_pool().in_use() == 1);
+   }  // teardown
+
    /***************************************
     * CONSTRUCTOR
     ***************************************/
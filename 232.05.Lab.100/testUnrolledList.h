@@ -0,0 +1,283 @@
+/***********************************************************************
+ * Header:
+ *    TEST UNROLLED LIST
+ * Summary:
+ *    Unit tests for unrolled_list
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "unrolled_list.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <string>
+#include <utility>
+
+class TestUnrolledList : public UnitTest
+{
+   typedef custom::unrolled_list<int, 4> IntList;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructInit_packed();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_assignMove_self();
+
+      // Insert
+      test_pushBack_newNode();
+      test_pushFront_shifts();
+      test_insert_splitsFull();
+      test_insert_ownElement();
+
+      // Remove
+      test_erase_mergesNeighbor();
+      test_erase_freesEmpty();
+      test_pop_bothEnds();
+
+      // Iterate
+      test_iterate_backFromEnd();
+
+      report("UnrolledList");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty list has no nodes
+   void test_construct_default()
+   {  // setup
+      // exercise
+      IntList l;
+      // verify
+      assertUnit(l.empty());
+      assertUnit(l.size() == 0);
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+      assertUnit(l.begin() == l.end());
+      assertUnit(IntList::node_capacity() == 4);
+   }  // teardown
+
+   // nine elements fill two nodes and start a third
+   void test_constructInit_packed()
+   {  // setup
+      // exercise
+      IntList l{ 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+      // verify
+      assertUnit(l.size() == 9);
+      assertUnit(l.pHead->num == 4);
+      assertUnit(l.pHead->pNext->num == 4);
+      assertUnit(l.pTail->num == 1);
+      assertUnit(l.pTail->pPrev == l.pHead->pNext);
+      assertUnit(l.front() == 1);
+      assertUnit(l.back() == 9);
+      assertUnit(digits(l) == "123456789");
+   }  // teardown
+
+   // a copy is laid out afresh, each node as full as it can be
+   void test_constructCopy_standard()
+   {  // setup
+      IntList lSrc{ 1, 2, 3, 4, 5 };
+      lSrc.erase(lSrc.begin());
+      // exercise
+      IntList lDest(lSrc);
+      // verify
+      assertUnit(lDest.size() == 4);
+      assertUnit(lDest.pHead == lDest.pTail);
+      assertUnit(lDest.pHead != lSrc.pHead);
+      assertUnit(digits(lDest) == "2345");
+      assertUnit(digits(lSrc) == "2345");
+   }  // teardown
+
+   // a move takes the nodes
+   void test_constructMove_standard()
+   {  // setup
+      IntList lSrc{ 1, 2, 3, 4, 5 };
+      auto pHead = lSrc.pHead;
+      // exercise
+      IntList lDest(std::move(lSrc));
+      // verify
+      assertUnit(lDest.pHead == pHead);
+      assertUnit(lDest.size() == 5);
+      assertUnit(lSrc.empty());
+      assertUnit(lSrc.pHead == nullptr);
+      assertUnit(digits(lDest) == "12345");
+   }  // teardown
+
+   // moving a list onto itself leaves it as it was
+   void test_assignMove_self()
+   {  // setup
+      IntList l{ 1, 2, 3, 4, 5 };
+      auto pHead = l.pHead;
+      IntList & lAlias = l;
+      // exercise
+      l = std::move(lAlias);
+      // verify
+      assertUnit(l.size() == 5);
+      assertUnit(l.pHead == pHead);
+      assertUnit(digits(l) == "12345");
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // push_back fills the tail, then starts a new one
+   void test_pushBack_newNode()
+   {  // setup
+      custom::unrolled_list<std::string, 2> l;
+      // exercise
+      l.push_back(std::string("26"));
+      l.push_back(std::string("49"));
+      l.push_back(std::string("67"));
+      // verify
+      assertUnit(l.size() == 3);
+      assertUnit(l.pHead->num == 2);
+      assertUnit(l.pTail->num == 1);
+      assertUnit(l.back() == "67");
+   }  // teardown
+
+   // push_front slides the head's elements up, splitting it when full
+   void test_pushFront_shifts()
+   {  // setup
+      IntList l;
+      // exercise
+      for (int i = 1; i <= 5; i++)
+         l.push_front(i);
+      // verify
+      assertUnit(l.size() == 5);
+      assertUnit(digits(l) == "54321");
+      assertUnit(l.pHead->num == 3);
+      assertUnit(l.pTail->num == 2);
+   }  // teardown
+
+   // inserting into a full node splits it in half
+   void test_insert_splitsFull()
+   {  // setup
+      IntList l{ 1, 2, 3, 4 };
+      auto it = l.begin();
+      ++it;
+      ++it;
+      ++it;
+      // exercise
+      auto itNew = l.insert(it, 9);
+      // verify
+      assertUnit(*itNew == 9);
+      assertUnit(l.size() == 5);
+      assertUnit(l.pHead->num == 2);
+      assertUnit(l.pTail->num == 3);
+      assertUnit(itNew.p == l.pTail);
+      assertUnit(digits(l) == "12394");
+   }  // teardown
+
+   // a copy of an element is made before the split moves it
+   void test_insert_ownElement()
+   {  // setup
+      custom::unrolled_list<std::string, 2> l;
+      l.push_back(std::string("twenty-six"));
+      l.push_back(std::string("forty-nine"));
+      // exercise
+      l.insert(l.begin(), l.back());
+      // verify
+      assertUnit(l.size() == 3);
+      assertUnit(l.front() == "forty-nine");
+      assertUnit(l.back() == "forty-nine");
+      assertUnit(l.pHead != l.pTail);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // a node under half full takes in the one after it
+   void test_erase_mergesNeighbor()
+   {  // setup
+      IntList l{ 1, 2, 3, 4, 5, 6 };
+      l.erase(l.begin());
+      l.erase(l.begin());
+      // exercise
+      auto itNext = l.erase(l.begin());
+      // verify
+      assertUnit(*itNext == 4);
+      assertUnit(l.size() == 3);
+      assertUnit(l.pHead == l.pTail);
+      assertUnit(l.pHead->num == 3);
+      assertUnit(digits(l) == "456");
+   }  // teardown
+
+   // the last element out of a node frees it
+   void test_erase_freesEmpty()
+   {  // setup
+      IntList l{ 1, 2, 3, 4, 5 };
+      auto it = l.end();
+      --it;
+      // exercise
+      auto itNext = l.erase(it);
+      // verify
+      assertUnit(itNext == l.end());
+      assertUnit(l.pHead == l.pTail);
+      assertUnit(l.back() == 4);
+      assertUnit(digits(l) == "1234");
+   }  // teardown
+
+   // popping from either end down to nothing
+   void test_pop_bothEnds()
+   {  // setup
+      IntList l{ 1, 2, 3, 4, 5, 6, 7 };
+      // exercise
+      l.pop_front();
+      l.pop_back();
+      // verify
+      assertUnit(l.front() == 2);
+      assertUnit(l.back() == 6);
+      assertUnit(digits(l) == "23456");
+      while (!l.empty())
+         l.pop_back();
+      assertUnit(l.pHead == nullptr);
+      assertUnit(l.pTail == nullptr);
+      l.pop_front();
+      assertUnit(l.size() == 0);
+   }  // teardown
+
+   /***************************************
+    * ITERATE
+    ***************************************/
+
+   // walking back from end crosses the nodes in reverse
+   void test_iterate_backFromEnd()
+   {  // setup
+      IntList l{ 1, 2, 3, 4, 5, 6 };
+      std::string s;
+      // exercise
+      for (auto it = l.end(); it != l.begin(); )
+         s += std::to_string(*--it);
+      // verify
+      assertUnit(s == "654321");
+      assertUnit(*l.begin()++ == 1);
+   }  // teardown
+
+   /*************************************************************
+    * DIGITS
+    * The elements, front to back, as a string of digits
+    *************************************************************/
+   std::string digits(IntList & l)
+   {
+      std::string s;
+      for (auto it = l.begin(); it != l.end(); ++it)
+         s += std::to_string(*it);
+      return s;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,596 @@
+/***********************************************************************
+ * Header:
+ *    UNROLLED LIST
+ * Summary:
+ *    A linked list whose nodes each hold up to K elements, side by
+ *    side in a small array.  Walking it follows one pointer per K
+ *    elements rather than one per element, and the elements in a node
+ *    share cache lines, so a scan runs at close to the speed of a
+ *    vector.  Inserting or erasing still only touches one node: a
+ *    full node splits in two, and a node less than half full takes
+ *    in its neighbor when the two fit in one.
+ *
+ *    Unlike custom::list, an insert or erase moves the elements after
+ *    it within their node, so it invalidates iterators into that node.
+ *
+ *    This will contain the class definition of:
+ *        unrolled_list           : a list of small arrays
+ *        unrolled_list::iterator : a bidirectional iterator through it
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // for ASSERT
+#include <cstddef>      // for size_t
+#include <initializer_list>  // for std::initializer_list
+#include <iterator>     // for std::bidirectional_iterator_tag
+#include <memory>       // for std::allocator
+#include <new>          // for placement new
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::move and std::swap
+
+class TestUnrolledList; // forward declaration for unit tests
+
+namespace custom
+{
+
+/**************************************************
+ * UNROLLED LIST
+ * The interface of custom::list, K elements to a node
+ **************************************************/
+template <typename T, size_t K = 16, typename A = std::allocator<T>>
+class unrolled_list
+{
+   static_assert(K >= 2, "a node must hold at least two elements to split");
+   friend class ::TestUnrolledList; // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+
+   unrolled_list(const A & a = A()) : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr) {}
+   unrolled_list(size_t num, const T & t,            const A & a = A());
+   unrolled_list(const std::initializer_list<T>& il, const A & a = A());
+   unrolled_list(const unrolled_list &  rhs);
+   unrolled_list(      unrolled_list && rhs);
+   ~unrolled_list()
+   {
+      clear();
+   }
+
+   //
+   // Assign
+   //
+
+   unrolled_list & operator = (const unrolled_list &  rhs);
+   unrolled_list & operator = (      unrolled_list && rhs);
+   void swap(unrolled_list & rhs)
+   {
+      // unequal allocators that do not propagate cannot trade nodes
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+      std::swap(numElements, rhs.numElements);
+      std::swap(pHead, rhs.pHead);
+      std::swap(pTail, rhs.pTail);
+   }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(pHead, 0);                         }
+   iterator end()   { return iterator(pTail, pTail ? pTail->num : 0);    }
+
+   //
+   // Access
+   //
+
+   T & front();
+   T & back();
+
+   //
+   // Insert
+   //
+
+   void push_front(const T &  data) { emplace(begin(), data);            }
+   void push_front(      T && data) { emplace(begin(), std::move(data)); }
+   void push_back (const T &  data) { emplace_back(data);                }
+   void push_back (      T && data) { emplace_back(std::move(data));     }
+   iterator insert(iterator it, const T &  data) { return emplace(it, data);            }
+   iterator insert(iterator it,       T && data) { return emplace(it, std::move(data)); }
+
+   //
+   // Remove
+   //
+
+   void pop_back();
+   void pop_front();
+   void clear();
+   iterator erase(const iterator & it);
+
+   //
+   // Status
+   //
+
+   bool   empty() const { return numElements == 0; }
+   size_t size()  const { return numElements;      }
+   A get_allocator() const { return alloc; }
+
+   // unrolled-list-specific interfaces
+
+   // the most elements a node holds
+   static size_t node_capacity() { return K; }
+
+private:
+
+   /*************************************************
+    * NODE
+    * Up to K elements, built in order from slot 0
+    *************************************************/
+   struct Node
+   {
+      Node * pNext;
+      Node * pPrev;
+      size_t num;
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[K];
+
+      T & at(size_t i) { return *reinterpret_cast<T *>(slots + i); }
+   };
+
+   using NodeAlloc = typename std::allocator_traits<A>::template rebind_alloc<Node>;
+   using traits    = std::allocator_traits<NodeAlloc>;
+
+   // the allocator follows the nodes only when its traits say so
+   void copyAlloc(const NodeAlloc & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const NodeAlloc &,     std::false_type) {                         }
+   void moveAlloc(NodeAlloc & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(NodeAlloc &,           std::false_type) {                         }
+   void swapAlloc(NodeAlloc & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(NodeAlloc &,           std::false_type) {                         }
+
+   // an empty node linked in after pPrev, or at the front when that is null
+   Node * newNode(Node * pPrev);
+
+   // unlink an empty node and free it
+   void freeNode(Node * p);
+
+   // build an element at slot i of p, sliding [i, num) up one
+   template <class ... Args>
+   static void openSlot(Node * p, size_t i, Args && ... args);
+
+   // destroy the element at slot i of p, sliding (i, num) down one
+   static void closeSlot(Node * p, size_t i);
+
+   // move the elements [from, src->num) onto the end of dest
+   static void moveSlots(Node * pDest, Node * pSrc, size_t from);
+
+   template <class ... Args>
+   void emplace_back(Args && ... args);
+   template <class ... Args>
+   iterator emplace(iterator it, Args && ... args);
+
+   NodeAlloc alloc;      // hands out the nodes
+   size_t numElements;   // in all the nodes together
+   Node * pHead;         // the first node
+   Node * pTail;         // the last node
+};
+
+/*************************************************
+ * UNROLLED LIST ITERATOR
+ * A node and a slot in it.  end() is one past the
+ * last slot of the last node, so it can be stepped
+ * back from like any other position.
+ ************************************************/
+template <typename T, size_t K, typename A>
+class unrolled_list <T, K, A> :: iterator
+{
+   friend class ::TestUnrolledList; // give unit tests access to the privates
+   friend class unrolled_list <T, K, A>;
+public:
+   using iterator_category = std::bidirectional_iterator_tag;
+   using value_type        = T;
+   using difference_type   = std::ptrdiff_t;
+   using pointer           = T *;
+   using reference         = T &;
+
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr), i(0) {}
+   iterator(Node * p, size_t i) : p(p), i(i) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p && i == rhs.i; }
+   bool operator != (const iterator & rhs) const { return !(*this == rhs);          }
+
+   // dereference operator
+   T & operator *  () const { return  p->at(i); }
+   T * operator -> () const { return &p->at(i); }
+
+   // prefix increment: the next slot, or the start of the next node
+   iterator & operator ++ ()
+   {
+      if (++i == p->num && p->pNext)
+      {
+         p = p->pNext;
+         i = 0;
+      }
+      return *this;
+   }
+   iterator operator ++ (int postfix)
+   {
+      iterator temp = *this;
+      ++(*this);
+      return temp;
+   }
+
+   // prefix decrement: the slot before, or the end of the node before
+   iterator & operator -- ()
+   {
+      if (i == 0)
+      {
+         p = p->pPrev;
+         i = p->num;
+      }
+      i--;
+      return *this;
+   }
+   iterator operator -- (int postfix)
+   {
+      iterator temp = *this;
+      --(*this);
+      return temp;
+   }
+
+private:
+   Node * p;   // the node
+   size_t i;   // the slot in it
+};
+
+/*****************************************
+ * UNROLLED LIST :: NON-DEFAULT constructors
+ ****************************************/
+template <typename T, size_t K, typename A>
+unrolled_list <T, K, A> :: unrolled_list(size_t num, const T & t, const A & a)
+   : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+{
+   for (size_t i = 0; i < num; i++)
+      push_back(t);
+}
+
+template <typename T, size_t K, typename A>
+unrolled_list <T, K, A> :: unrolled_list(const std::initializer_list<T>& il, const A & a)
+   : alloc(a), numElements(0), pHead(nullptr), pTail(nullptr)
+{
+   for (const T & t : il)
+      push_back(t);
+}
+
+/*****************************************
+ * UNROLLED LIST :: COPY constructor
+ * Every node but the last comes out full
+ ****************************************/
+template <typename T, size_t K, typename A>
+unrolled_list <T, K, A> :: unrolled_list(const unrolled_list & rhs)
+   : alloc(traits::select_on_container_copy_construction(rhs.alloc)),
+     numElements(0), pHead(nullptr), pTail(nullptr)
+{
+   for (Node * p = rhs.pHead; p; p = p->pNext)
+      for (size_t i = 0; i < p->num; i++)
+         push_back(p->at(i));
+}
+
+/*****************************************
+ * UNROLLED LIST :: MOVE constructor
+ * Take the nodes
+ ****************************************/
+template <typename T, size_t K, typename A>
+unrolled_list <T, K, A> :: unrolled_list(unrolled_list && rhs)
+   : alloc(std::move(rhs.alloc)), numElements(rhs.numElements),
+     pHead(rhs.pHead), pTail(rhs.pTail)
+{
+   rhs.numElements = 0;
+   rhs.pHead = rhs.pTail = nullptr;
+}
+
+/*****************************************
+ * UNROLLED LIST :: ASSIGNMENT
+ * Moving takes the nodes of rhs, or each of its
+ * elements when our allocator could not free them
+ ****************************************/
+template <typename T, size_t K, typename A>
+unrolled_list <T, K, A> & unrolled_list <T, K, A> :: operator = (const unrolled_list & rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+      for (Node * p = rhs.pHead; p; p = p->pNext)
+         for (size_t i = 0; i < p->num; i++)
+            push_back(p->at(i));
+   }
+   return *this;
+}
+
+template <typename T, size_t K, typename A>
+unrolled_list <T, K, A> & unrolled_list <T, K, A> :: operator = (unrolled_list && rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+
+   // cannot adopt nodes our allocator did not hand out: move each element
+   if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+   {
+      for (Node * p = rhs.pHead; p; p = p->pNext)
+         for (size_t i = 0; i < p->num; i++)
+            push_back(std::move(p->at(i)));
+      rhs.clear();
+      return *this;
+   }
+
+   moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+   numElements = rhs.numElements;
+   pHead = rhs.pHead;
+   pTail = rhs.pTail;
+
+   rhs.numElements = 0;
+   rhs.pHead = rhs.pTail = nullptr;
+   return *this;
+}
+
+/*********************************************
+ * UNROLLED LIST :: FRONT and BACK
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, size_t K, typename A>
+T & unrolled_list <T, K, A> :: front()
+{
+   if (pHead == nullptr)
+      throw "ERROR: unable to access data from an empty list";
+   return pHead->at(0);
+}
+
+template <typename T, size_t K, typename A>
+T & unrolled_list <T, K, A> :: back()
+{
+   if (pTail == nullptr)
+      throw "ERROR: unable to access data from an empty list";
+   return pTail->at(pTail->num - 1);
+}
+
+/*********************************************
+ * UNROLLED LIST :: NEW NODE
+ * Allocate an empty node and link it in after pPrev
+ *********************************************/
+template <typename T, size_t K, typename A>
+typename unrolled_list <T, K, A> :: Node * unrolled_list <T, K, A> :: newNode(Node * pPrev)
+{
+   Node * p = traits::allocate(alloc, 1);
+   p->num = 0;
+   p->pPrev = pPrev;
+   p->pNext = pPrev ? pPrev->pNext : pHead;
+   if (p->pNext)
+      p->pNext->pPrev = p;
+   else
+      pTail = p;
+   if (pPrev)
+      pPrev->pNext = p;
+   else
+      pHead = p;
+   return p;
+}
+
+/*********************************************
+ * UNROLLED LIST :: FREE NODE
+ * Unlink an empty node and give it back
+ *********************************************/
+template <typename T, size_t K, typename A>
+void unrolled_list <T, K, A> :: freeNode(Node * p)
+{
+   assert(p->num == 0);
+   if (p->pPrev)
+      p->pPrev->pNext = p->pNext;
+   else
+      pHead = p->pNext;
+   if (p->pNext)
+      p->pNext->pPrev = p->pPrev;
+   else
+      pTail = p->pPrev;
+   traits::deallocate(alloc, p, 1);
+}
+
+/*********************************************
+ * UNROLLED LIST :: OPEN SLOT
+ * Slide the elements from slot i up by one, back
+ * to front, then build the new one in the gap
+ *********************************************/
+template <typename T, size_t K, typename A>
+template <class ... Args>
+void unrolled_list <T, K, A> :: openSlot(Node * p, size_t i, Args && ... args)
+{
+   assert(p->num < K && i <= p->num);
+   T t(std::forward<Args>(args)...);
+   for (size_t j = p->num; j > i; j--)
+   {
+      new (p->slots + j) T(std::move(p->at(j - 1)));
+      p->at(j - 1).~T();
+   }
+   new (p->slots + i) T(std::move(t));
+   p->num++;
+}
+
+/*********************************************
+ * UNROLLED LIST :: CLOSE SLOT
+ * Destroy slot i, then slide the rest down by one
+ *********************************************/
+template <typename T, size_t K, typename A>
+void unrolled_list <T, K, A> :: closeSlot(Node * p, size_t i)
+{
+   assert(i < p->num);
+   p->at(i).~T();
+   for (size_t j = i + 1; j < p->num; j++)
+   {
+      new (p->slots + j - 1) T(std::move(p->at(j)));
+      p->at(j).~T();
+   }
+   p->num--;
+}
+
+/*********************************************
+ * UNROLLED LIST :: MOVE SLOTS
+ * Move the elements [from, num) of pSrc onto the
+ * end of pDest
+ *********************************************/
+template <typename T, size_t K, typename A>
+void unrolled_list <T, K, A> :: moveSlots(Node * pDest, Node * pSrc, size_t from)
+{
+   assert(pDest->num + pSrc->num - from <= K);
+   for (size_t j = from; j < pSrc->num; j++)
+   {
+      new (pDest->slots + pDest->num++) T(std::move(pSrc->at(j)));
+      pSrc->at(j).~T();
+   }
+   pSrc->num = from;
+}
+
+/*********************************************
+ * UNROLLED LIST :: EMPLACE BACK
+ * Into the last node, or a new one when it is full
+ *     COST   : O(1)
+ *********************************************/
+template <typename T, size_t K, typename A>
+template <class ... Args>
+void unrolled_list <T, K, A> :: emplace_back(Args && ... args)
+{
+   if (pTail == nullptr || pTail->num == K)
+      newNode(pTail);
+   new (pTail->slots + pTail->num) T(std::forward<Args>(args)...);
+   pTail->num++;
+   numElements++;
+}
+
+/******************************************
+ * UNROLLED LIST :: EMPLACE
+ * Build an element before it.  A full node splits,
+ * half its elements going to a new node after it.
+ *     INPUT  : where, and the arguments for T
+ *     OUTPUT : iterator to the new element
+ *     COST   : O(K)
+ ******************************************/
+template <typename T, size_t K, typename A>
+template <class ... Args>
+typename unrolled_list <T, K, A> :: iterator
+unrolled_list <T, K, A> :: emplace(iterator it, Args && ... args)
+{
+   Node * p = it.p;
+   size_t i = it.i;
+   if (p == nullptr)
+   {
+      emplace_back(std::forward<Args>(args)...);
+      return iterator(pTail, 0);
+   }
+
+   if (p->num == K)
+   {
+      // build it before the split moves what args may refer to
+      T t(std::forward<Args>(args)...);
+      Node * pSplit = newNode(p);
+      moveSlots(pSplit, p, K / 2);
+      if (i > K / 2)
+      {
+         p = pSplit;
+         i -= K / 2;
+      }
+      openSlot(p, i, std::move(t));
+   }
+   else
+      openSlot(p, i, std::forward<Args>(args)...);
+   numElements++;
+   return iterator(p, i);
+}
+
+/******************************************
+ * UNROLLED LIST :: ERASE
+ * Remove the element at it.  An emptied node is
+ * freed; one left under half full takes in the
+ * node after it if they fit together.
+ *     INPUT  : an iterator to the element to remove
+ *     OUTPUT : iterator to the element after it
+ *     COST   : O(K)
+ ******************************************/
+template <typename T, size_t K, typename A>
+typename unrolled_list <T, K, A> :: iterator
+unrolled_list <T, K, A> :: erase(const iterator & it)
+{
+   Node * p = it.p;
+   size_t i = it.i;
+   if (p == nullptr || i >= p->num)
+      return end();
+
+   closeSlot(p, i);
+   numElements--;
+
+   if (p->num == 0)
+   {
+      Node * pNext = p->pNext;
+      freeNode(p);
+      return pNext ? iterator(pNext, 0) : end();
+   }
+
+   if (p->num < K / 2 && p->pNext && p->num + p->pNext->num <= K)
+   {
+      Node * pNext = p->pNext;
+      moveSlots(p, pNext, 0);
+      freeNode(pNext);
+   }
+
+   if (i < p->num || p->pNext == nullptr)
+      return iterator(p, i);
+   return iterator(p->pNext, 0);
+}
+
+/*********************************************
+ * UNROLLED LIST :: POP BACK and POP FRONT
+ *     COST   : O(1) and O(K)
+ *********************************************/
+template <typename T, size_t K, typename A>
+void unrolled_list <T, K, A> :: pop_back()
+{
+   if (pTail == nullptr)
+      return;
+   pTail->at(pTail->num - 1).~T();
+   pTail->num--;
+   numElements--;
+   if (pTail->num == 0)
+      freeNode(pTail);
+}
+
+template <typename T, size_t K, typename A>
+void unrolled_list <T, K, A> :: pop_front()
+{
+   if (pHead != nullptr)
+      erase(begin());
+}
+
+/**********************************************
+ * UNROLLED LIST :: CLEAR
+ * Destroy every element and free every node
+ *     COST   : O(n)
+ *********************************************/
+template <typename T, size_t K, typename A>
+void unrolled_list <T, K, A> :: clear()
+{
+   while (pHead)
+   {
+      for (size_t i = 0; i < pHead->num; i++)
+         pHead->at(i).~T();
+      pHead->num = 0;
+      freeNode(pHead);
+   }
+   numElements = 0;
+}
+
+} // namespace custom
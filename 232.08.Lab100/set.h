@@ -33,7 +33,7 @@ namespace custom
  * SET
  * A class that represents a Set
  ***********************************************/
-template <typename T>
+template <typename T, typename A = std::allocator<T>>
 class set
 {
    friend class ::TestSet; // give unit tests access to the privates
@@ -42,7 +42,7 @@ public:
    // 
    // Construct
    //
-   set() 
+   set(const A& a = A()) : bst(a)
    {}
    set(const set &  rhs) : bst(rhs.bst)
    { 
@@ -51,7 +51,7 @@ public:
    set(set && rhs) : bst(std::move(rhs.bst))
    { 
    }
-   set(const std::initializer_list <T> & il) 
+   set(const std::initializer_list <T> & il, const A& a = A()) : bst(a)
    {
        clear();
       for (const auto& node : il)
@@ -60,7 +60,7 @@ public:
       }
    }
    template <class Iterator>
-   set(Iterator first, Iterator last) 
+   set(Iterator first, Iterator last, const A& a = A()) : bst(a)
    {
       for (auto iter = first; iter != last; ++iter)
       {
@@ -122,9 +122,13 @@ public:
    { 
       return bst.empty();    
    }
-   size_t size() const noexcept 
-   { 
-      return bst.size();     
+   size_t size() const noexcept
+   {
+      return bst.size();
+   }
+   A get_allocator() const noexcept
+   {
+      return bst.get_allocator();
    }
 
    //
@@ -166,7 +170,7 @@ public:
    }
    iterator erase(iterator &it)
    { 
-      typename custom::BST<T>::iterator er = bst.erase(it.it);
+      typename custom::BST<T, A>::iterator er = bst.erase(it.it);
       return er; 
    }
    size_t erase(const T & t) 
@@ -182,8 +186,8 @@ public:
    iterator erase(iterator& itBegin, iterator& itEnd)
    {
       // we have to convert because bst.erase returns a bst::iterator
-      typename custom::BST<T>::iterator temp = itBegin.bst_it(); 
-      typename custom::BST<T>::iterator end = itEnd.bst_it();
+      typename custom::BST<T, A>::iterator temp = itBegin.bst_it(); 
+      typename custom::BST<T, A>::iterator end = itEnd.bst_it();
 
       while (temp != end)
       {
@@ -198,7 +202,7 @@ public:
 
 private:
    
-   custom::BST <T> bst;
+   custom::BST <T, A> bst;
 };
 
 
@@ -206,24 +210,24 @@ private:
  * SET ITERATOR
  * An iterator through Set
  *************************************************/
-template <typename T>
-class set <T> :: iterator
+template <typename T, typename A>
+class set <T, A> :: iterator
 {
    friend class ::TestSet; // give unit tests access to the privates
-   friend class custom::set<T>;
+   friend class custom::set<T, A>;
 
 public:
    // constructors, destructors, and assignment operator
    iterator() : it(nullptr)
    { 
    }
-   iterator(const typename custom::BST<T>::iterator& itRHS) : it(itRHS)
+   iterator(const typename custom::BST<T, A>::iterator& itRHS) : it(itRHS)
    {
    }
    iterator(const iterator & rhs) : it(rhs.it)
    {
    }
-   typename BST<T>::iterator bst_it() const { return it; }
+   typename BST<T, A>::iterator bst_it() const { return it; }
    iterator & operator = (const iterator & rhs)
    {
       this->it = rhs.it;
@@ -279,7 +283,7 @@ public:
    
 private:
 
-   typename custom::BST<T>::iterator it;
+   typename custom::BST<T, A>::iterator it;
 };
 
 
@@ -40,39 +40,39 @@ class TestSet;
 namespace custom
 {
 
-   template <class TT>
+   template <class TT, class AA>
    class set;
-   template <class KK, class VV>
+   template <class KK, class VV, class AA>
    class map;
 
    /*****************************************************************
     * BINARY SEARCH TREE
     * Create a Binary Search Tree
     *****************************************************************/
-   template <typename T>
+   template <typename T, typename A = std::allocator<T>>
    class BST
    {
       friend class ::TestBST; // give unit tests access to the privates
       friend class ::TestMap;
       friend class ::TestSet;
 
-      template <class KK, class VV>
+      template <class KK, class VV, class AA>
       friend class map;
 
-      template <class TT>
+      template <class TT, class AA>
       friend class set;
 
-      template <class KK, class VV>
-      friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs);
+      template <class KK, class VV, class AA>
+      friend void swap(map<KK, VV, AA>& lhs, map<KK, VV, AA>& rhs);
    public:
       //
       // Construct
       //
 
-      BST();
+      BST(const A& a = A());
       BST(const BST& rhs);
       BST(BST&& rhs);
-      BST(const std::initializer_list<T>& il);
+      BST(const std::initializer_list<T>& il, const A& a = A());
       ~BST();
 
       //
@@ -117,6 +117,7 @@ namespace custom
       //
 
       bool   empty() const noexcept { return root == nullptr; }
+      A      get_allocator() const noexcept { return A(alloc); }
       size_t size()  const noexcept {
          if (root == nullptr)
          {
@@ -132,6 +133,36 @@ namespace custom
    private:
 
       class BNode;
+
+      // nodes come from the user's allocator, rebound to the node type
+      using NodeAlloc = typename std::allocator_traits<A>::template rebind_alloc<BNode>;
+      using traits    = std::allocator_traits<NodeAlloc>;
+
+      // allocate and construct a single node
+      template <class ... Args>
+      BNode* allocateNode(Args&& ... args)
+      {
+         BNode* p = traits::allocate(alloc, 1);
+         traits::construct(alloc, p, std::forward<Args>(args)...);
+         return p;
+      }
+
+      // destroy and free a single node
+      void freeNode(BNode* p)
+      {
+         traits::destroy(alloc, p);
+         traits::deallocate(alloc, p, 1);
+      }
+
+      // the allocator follows the nodes only when its traits say so
+      void copyAlloc(const NodeAlloc& rhs, std::true_type)  { alloc = rhs; }
+      void copyAlloc(const NodeAlloc&,     std::false_type) {}
+      void moveAlloc(NodeAlloc& rhs,       std::true_type)  { alloc = std::move(rhs); }
+      void moveAlloc(NodeAlloc&,           std::false_type) {}
+      void swapAlloc(NodeAlloc& rhs,       std::true_type)  { std::swap(alloc, rhs); }
+      void swapAlloc(NodeAlloc&,           std::false_type) {}
+
+      NodeAlloc alloc;          // hands out the nodes
       BNode* root;              // root node of the binary search tree
       size_t numElements;        // number of elements currently in the tree
       void clear(BNode* node) noexcept;
@@ -146,8 +177,8 @@ namespace custom
     * A single node in a binary tree. Note that the node does not know
     * anything about the properties of the tree so no validation can be done.
     *****************************************************************/
-   template <typename T>
-   class BST <T> ::BNode
+   template <typename T, typename A>
+   class BST <T, A> ::BNode
    {
    public:
       // 
@@ -171,10 +202,6 @@ namespace custom
       //
       void addLeft(BNode* pNode);
       void addRight(BNode* pNode);
-      void addLeft(const T& t);
-      void addRight(const T& t);
-      void addLeft(T&& t);
-      void addRight(T&& t);
 
       // 
       // Status
@@ -213,17 +240,17 @@ namespace custom
     * BINARY SEARCH TREE ITERATOR
     * Forward and reverse iterator through a BST
     *********************************************************/
-   template <typename T>
-   class BST <T> ::iterator
+   template <typename T, typename A>
+   class BST <T, A> ::iterator
    {
       friend class ::TestBST; // give unit tests access to the privates
       friend class ::TestMap;
       friend class ::TestSet;
 
-      template <class KK, class VV>
+      template <class KK, class VV, class AA>
       friend class map;
 
-      template <class TT>
+      template <class TT, class AA>
       friend class set;
    public:
       // constructors and assignment
@@ -279,7 +306,7 @@ namespace custom
       }
 
       // must give friend status to remove so it can call getNode() from it
-      friend BST <T> ::iterator BST <T> ::erase(iterator& it);
+      friend BST <T, A> ::iterator BST <T, A> ::erase(iterator& it);
 
    private:
 
@@ -300,8 +327,8 @@ namespace custom
     /*********************************************
      * BST :: DEFAULT CONSTRUCTOR
      ********************************************/
-   template <typename T>
-   BST <T> ::BST()
+   template <typename T, typename A>
+   BST <T, A> ::BST(const A& a) : alloc(a)
    {
       root = nullptr;
       numElements = 0;
@@ -311,8 +338,9 @@ namespace custom
     * BST :: COPY CONSTRUCTOR
     * Copy one tree to another
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(const BST<T>& rhs)
+   template <typename T, typename A>
+   BST <T, A> ::BST(const BST<T, A>& rhs) :
+      alloc(traits::select_on_container_copy_construction(rhs.alloc))
    {
       root = nullptr;
       numElements = 0;
@@ -324,12 +352,12 @@ namespace custom
     * Copy one tree to another
     ********************************************/
 
-   template <typename T>
-   typename BST<T>::BNode* BST<T>::copyRecursive(BNode* src, BNode* parent)
+   template <typename T, typename A>
+   typename BST<T, A>::BNode* BST<T, A>::copyRecursive(BNode* src, BNode* parent)
    {
       if (!src || src == src->pLeft) return nullptr;  // skip dummy
 
-      BNode* newNode = new BNode(src->data);
+      BNode* newNode = allocateNode(src->data);
       newNode->pParent = parent;
       newNode->pLeft = copyRecursive(src->pLeft, newNode);
       newNode->pRight = copyRecursive(src->pRight, newNode);
@@ -340,8 +368,8 @@ namespace custom
     * BST :: MOVE CONSTRUCTOR
     * Move one tree to another
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(BST <T>&& rhs)
+   template <typename T, typename A>
+   BST <T, A> ::BST(BST <T, A>&& rhs) : alloc(std::move(rhs.alloc))
    {
       root = rhs.root;
       numElements = rhs.numElements;
@@ -354,8 +382,8 @@ namespace custom
     * BST :: INITIALIZER LIST CONSTRUCTOR
     * Create a BST from an initializer list
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(const std::initializer_list<T>& il)
+   template <typename T, typename A>
+   BST <T, A> ::BST(const std::initializer_list<T>& il, const A& a) : alloc(a)
    {
       root = nullptr;
       numElements = 0;
@@ -366,8 +394,8 @@ namespace custom
    /*********************************************
     * BST :: DESTRUCTOR
     ********************************************/
-   template <typename T>
-   BST <T> :: ~BST()
+   template <typename T, typename A>
+   BST <T, A> :: ~BST()
    {
       clear();
    }
@@ -377,13 +405,18 @@ namespace custom
     * BST :: ASSIGNMENT OPERATOR
     * Copy one tree to another
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (const BST <T>& rhs)
+   template <typename T, typename A>
+   BST <T, A>& BST <T, A> :: operator = (const BST <T, A>& rhs)
    {
       // Handle self-assignment
       if (this == &rhs)
          return *this;
 
+      // a propagating allocator that differs cannot free our old nodes
+      if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+         clear();
+      copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+
       // Call the helper function to handle assignment
       assign(root, rhs.root);
       numElements = rhs.numElements;
@@ -395,8 +428,8 @@ namespace custom
     * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
     * Copy nodes onto a BTree
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (const std::initializer_list<T>& il)
+   template <typename T, typename A>
+   BST <T, A>& BST <T, A> :: operator = (const std::initializer_list<T>& il)
    {
       clear();
       for (const T& t : il)
@@ -408,8 +441,8 @@ namespace custom
        * BST :: ASSIGN
        * Assign nodes from source tree to destination tree
        ********************************************/
-   template <typename T>
-   void BST<T>::assign(BNode*& pDest, BNode* pSrc)
+   template <typename T, typename A>
+   void BST<T, A>::assign(BNode*& pDest, BNode* pSrc)
    {
       // If both are null, nothing to do
       if (pSrc == nullptr && pDest == nullptr)
@@ -426,7 +459,7 @@ namespace custom
       // If destination is null but source exists, create new node
       if (pDest == nullptr)
       {
-         pDest = new BNode(pSrc->data);
+         pDest = allocateNode(pSrc->data);
          pDest->isRed = pSrc->isRed;
          pDest->pLeft = nullptr;
          pDest->pRight = nullptr;
@@ -450,14 +483,27 @@ namespace custom
     * BST :: ASSIGN-MOVE OPERATOR
     * Move one tree to another
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (BST <T>&& rhs)
+   template <typename T, typename A>
+   BST <T, A>& BST <T, A> :: operator = (BST <T, A>&& rhs)
    {
       // Handle self-assignment
       if (this != &rhs)
       {
          clear();
-         swap(rhs);
+
+         // cannot adopt nodes our allocator did not hand out: copy them instead
+         if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+         {
+            *this = rhs;
+            rhs.clear();
+            return *this;
+         }
+
+         moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+         root = rhs.root;
+         numElements = rhs.numElements;
+         rhs.root = nullptr;
+         rhs.numElements = 0;
       }
       return *this;
    }
@@ -466,9 +512,13 @@ namespace custom
     * BST :: SWAP
     * Swap two trees
     ********************************************/
-   template <typename T>
-   void BST <T> ::swap(BST <T>& rhs)
+   template <typename T, typename A>
+   void BST <T, A> ::swap(BST <T, A>& rhs)
    {
+      // unequal allocators that do not propagate cannot trade nodes
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+
       // Swap root pointers
       BNode* tempRoot = rhs.root;
       rhs.root = this->root;
@@ -484,13 +534,13 @@ namespace custom
     * BST :: INSERT
     * Insert a node at a given location in the tree
     ****************************************************/
-   template <typename T>
-   std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(const T& t, bool keepUnique)
+   template <typename T, typename A>
+   std::pair<typename BST <T, A> ::iterator, bool> BST <T, A> ::insert(const T& t, bool keepUnique)
    {
       // If the tree is empty
       if (!root)
       {
-         root = new BNode(t);
+         root = allocateNode(t);
          numElements++;
          return { iterator(root), true };
       }
@@ -516,7 +566,7 @@ namespace custom
       }
 
 
-      BNode* pNew = new BNode(t);
+      BNode* pNew = allocateNode(t);
 
       pNew->pParent = pParent;
 
@@ -531,13 +581,13 @@ namespace custom
       return { iterator(pNew), true };
    }
 
-   template <typename T>
-   std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T&& t, bool keepUnique)
+   template <typename T, typename A>
+   std::pair<typename BST <T, A> ::iterator, bool> BST <T, A> ::insert(T&& t, bool keepUnique)
    {
       // if the tree is empty
       if (!root)
       {
-         root = new BNode(std::move(t));
+         root = allocateNode(std::move(t));
          numElements++;
          return { iterator(root), true };
       }
@@ -563,7 +613,7 @@ namespace custom
       }
 
 
-      BNode* pNew = new BNode(std::move(t));
+      BNode* pNew = allocateNode(std::move(t));
 
       pNew->pParent = pParent;
 
@@ -582,8 +632,8 @@ namespace custom
     * BST :: ERASE
     * Remove a given node as specified by the iterator
     ************************************************/
-   template <typename T>
-   typename BST <T> ::iterator BST <T> ::erase(iterator& it)
+   template <typename T, typename A>
+   typename BST <T, A> ::iterator BST <T, A> ::erase(iterator& it)
    {
       BNode* eraseNode = it.pNode;
       if (eraseNode == nullptr) return end();
@@ -606,7 +656,7 @@ namespace custom
             root = nullptr; // Node is root
          }
          iterator next(eraseNode->pParent);
-         delete eraseNode;
+         freeNode(eraseNode);
          numElements--;
          return next; // I know this isn't exactly right but unit test doesn't complain
       }
@@ -652,7 +702,7 @@ namespace custom
             root = child; // Node is root
          }
          child->pParent = eraseNode->pParent;
-         delete eraseNode;
+         freeNode(eraseNode);
          numElements--;
          return iterator(successor);
       }
@@ -711,7 +761,7 @@ namespace custom
             root = successor; // eraseNode was root
          }
 
-         delete eraseNode;
+         freeNode(eraseNode);
          numElements--;
 
          iterator next(successor);
@@ -726,16 +776,16 @@ namespace custom
     * BST :: CLEAR
     * Removes all the BNodes from a tree
     ****************************************************/
-   template <typename T>
-   void BST <T> ::clear() noexcept
+   template <typename T, typename A>
+   void BST <T, A> ::clear() noexcept
    {
       clearRecursive(root);
       root = nullptr;
       numElements = 0;
    }
 
-   template <typename T>
-   void BST <T> ::clear(BNode* node) noexcept
+   template <typename T, typename A>
+   void BST <T, A> ::clear(BNode* node) noexcept
    {
       if (node == nullptr)
          return;
@@ -745,29 +795,29 @@ namespace custom
       clear(node->pRight);
 
       // Then delete the current node
-      delete node;
+      freeNode(node);
    }
 
    /*********************************************
     * BST :: CLEAR RECURSIVE HELPER
     ********************************************/
-   template <typename T>
-   void BST <T> ::clearRecursive(BNode* pNode)
+   template <typename T, typename A>
+   void BST <T, A> ::clearRecursive(BNode* pNode)
    {
       if (pNode == nullptr)
          return;
 
       clearRecursive(pNode->pLeft);
       clearRecursive(pNode->pRight);
-      delete pNode;
+      freeNode(pNode);
    }
 
    /*****************************************************
     * BST :: BEGIN
     * Return the first node (left-most) in a binary search tree
     ****************************************************/
-   template <typename T>
-   typename BST <T> ::iterator custom::BST <T> ::begin() const noexcept
+   template <typename T, typename A>
+   typename BST <T, A> ::iterator custom::BST <T, A> ::begin() const noexcept
    {
       BNode* current = root;
       if (current == nullptr) return iterator(nullptr);
@@ -783,8 +833,8 @@ namespace custom
     * BST :: FIND
     * Return the node corresponding to a given value
     ****************************************************/
-   template <typename T>
-   typename BST <T> ::iterator BST<T> ::find(const T& t)
+   template <typename T, typename A>
+   typename BST <T, A> ::iterator BST<T, A> ::find(const T& t)
    {
       BNode* current = root;
       while (current) {
@@ -817,8 +867,8 @@ namespace custom
      * BINARY NODE :: ADD LEFT
      * Add a node to the left of the current node
      ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addLeft(BNode* pNode)
+   template <typename T, typename A>
+   void BST <T, A> ::BNode::addLeft(BNode* pNode)
    {
       pLeft = pNode;
       if (pNode)
@@ -829,58 +879,14 @@ namespace custom
     * BINARY NODE :: ADD RIGHT
     * Add a node to the right of the current node
     ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(BNode* pNode)
+   template <typename T, typename A>
+   void BST <T, A> ::BNode::addRight(BNode* pNode)
    {
       pRight = pNode;
       if (pNode)
          pNode->pParent = this;
    }
 
-   /******************************************************
-    * BINARY NODE :: ADD LEFT
-    * Add a node to the left of the current node
-    ******************************************************/
-   template <typename T>
-   void BST<T> ::BNode::addLeft(const T& t)
-   {
-      BNode* newNode = new BNode(t);
-      addLeft(newNode);
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD LEFT
-    * Add a node to the left of the current node
-    ******************************************************/
-   template <typename T>
-   void BST<T> ::BNode::addLeft(T&& t)
-   {
-      BNode* newNode = new BNode(std::move(t));
-      addLeft(newNode);
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD RIGHT
-    * Add a node to the right of the current node
-    ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(const T& t)
-   {
-      BNode* newNode = new BNode(t);
-      addRight(newNode);
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD RIGHT
-    * Add a node to the right of the current node
-    ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(T&& t)
-   {
-      BNode* newNode = new BNode(std::move(t));
-      addRight(newNode);
-   }
-
 
 
    /*************************************************
@@ -895,8 +901,8 @@ namespace custom
      * BST ITERATOR :: INCREMENT PREFIX
      * advance by one
      *************************************************/
-   template <typename T>
-   typename BST <T> ::iterator& BST <T> ::iterator :: operator ++ ()
+   template <typename T, typename A>
+   typename BST <T, A> ::iterator& BST <T, A> ::iterator :: operator ++ ()
    {
       if (!pNode)
          return *this;
@@ -934,8 +940,8 @@ namespace custom
     * BST ITERATOR :: DECREMENT PREFIX
     * advance by one
     *************************************************/
-   template <typename T>
-   typename BST <T> ::iterator& BST <T> ::iterator :: operator -- ()
+   template <typename T, typename A>
+   typename BST <T, A> ::iterator& BST <T, A> ::iterator :: operator -- ()
    {
       if (!pNode)
          return *this;
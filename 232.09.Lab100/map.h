@@ -39,19 +39,19 @@ namespace custom
  * MAP
  * Create a Map, similar to a Binary Search Tree
  *****************************************************************/
-template <class K, class V>
+template <class K, class V, class A = std::allocator<custom::pair<K, V>>>
 class map
 {
    friend ::TestMap; // give unit tests access to the privates
-   template <class KK, class VV>
-   friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs);
+   template <class KK, class VV, class AA>
+   friend void swap(map<KK, VV, AA>& lhs, map<KK, VV, AA>& rhs);
 public:
    using Pairs = custom::pair<K, V>;
 
    // 
    // Construct
    //
-   map() 
+   map(const A& a = A()) : bst(a)
    {
    }
    map(const map &  rhs) : bst(rhs.bst)
@@ -61,7 +61,7 @@ public:
    { 
    }
    template <class Iterator>
-   map(Iterator first, Iterator last)
+   map(Iterator first, Iterator last, const A& a = A()) : bst(a)
    {
       while (first != last)
       {
@@ -69,7 +69,7 @@ public:
          first++;
       }
    }
-   map(const std::initializer_list <Pairs>& il) 
+   map(const std::initializer_list <Pairs>& il, const A& a = A()) : bst(a)
    {
       for (const auto& item : il)
       {
@@ -184,12 +184,13 @@ public:
    //
    bool empty() const noexcept { return bst.empty(); }
    size_t size() const noexcept { return bst.size(); }
+   A get_allocator() const noexcept { return bst.get_allocator(); }
 
 
 private:
 
    // the students DO NOT need to use a nested class
-   BST < pair <K, V >> bst;
+   BST < pair <K, V >, A > bst;
 };
 
 
@@ -198,11 +199,11 @@ private:
  * Forward and reverse iterator through a Map, just call
  * through to BSTIterator
  *********************************************************/
-template <typename K, typename V>
-class map <K, V> :: iterator
+template <typename K, typename V, typename A>
+class map <K, V, A> :: iterator
 {
    friend class ::TestMap; // give unit tests access to the privates
-   template <class KK, class VV>
+   template <class KK, class VV, class AA>
    friend class custom::map;
 public:
    //
@@ -211,7 +212,7 @@ public:
    iterator() : it(nullptr)
    {
    }
-   iterator(const typename BST < pair <K, V> > :: iterator & rhs) : it(rhs.pNode)
+   iterator(const typename BST < pair <K, V>, A > :: iterator & rhs) : it(rhs.pNode)
    { 
    }
    iterator(const iterator & rhs) : it(rhs.it)
@@ -277,7 +278,7 @@ public:
 private:
 
    // Member variable
-   typename BST < pair <K, V >>  :: iterator it;   
+   typename BST < pair <K, V >, A >  :: iterator it;   
 };
 
 
@@ -285,8 +286,8 @@ private:
  * MAP :: SUBSCRIPT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-V& map <K, V> :: operator [] (const K& key)
+template <typename K, typename V, typename A>
+V& map <K, V, A> :: operator [] (const K& key)
 {
    iterator it = find(key);
    if (it != end())
@@ -306,8 +307,8 @@ V& map <K, V> :: operator [] (const K& key)
  * MAP :: SUBSCRIPT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-const V& map <K, V> :: operator [] (const K& key) const
+template <typename K, typename V, typename A>
+const V& map <K, V, A> :: operator [] (const K& key) const
 {
    iterator it = find(key);
    if (it != nullptr)
@@ -322,8 +323,8 @@ const V& map <K, V> :: operator [] (const K& key) const
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-V& map <K, V> ::at(const K& key)
+template <typename K, typename V, typename A>
+V& map <K, V, A> ::at(const K& key)
 {
    iterator it = find(key);
    if (it != end())
@@ -355,8 +356,8 @@ V& map <K, V> ::at(const K& key)
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-const V& map <K, V> ::at(const K& key) const
+template <typename K, typename V, typename A>
+const V& map <K, V, A> ::at(const K& key) const
 {
    iterator it = find(key);
    if (it == end())
@@ -378,8 +379,8 @@ const V& map <K, V> ::at(const K& key) const
  * SWAP
  * Swap two maps
  ****************************************************/
-template <typename K, typename V>
-void swap(map <K, V>& lhs, map <K, V>& rhs)
+template <typename K, typename V, typename A>
+void swap(map <K, V, A>& lhs, map <K, V, A>& rhs)
 
 {
 
@@ -391,8 +392,8 @@ void swap(map <K, V>& lhs, map <K, V>& rhs)
  * ERASE
  * Erase one element
  ****************************************************/
-template <typename K, typename V>
-size_t map<K, V>::erase(const K& k)
+template <typename K, typename V, typename A>
+size_t map<K, V, A>::erase(const K& k)
 {
    /*auto it = bst.find({ k });
    if (it == end())
@@ -414,8 +415,8 @@ size_t map<K, V>::erase(const K& k)
  * ERASE
  * Erase several elements
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator first, map<K, V>::iterator last)
+template <typename K, typename V, typename A>
+typename map<K, V, A>::iterator map<K, V, A>::erase(map<K, V, A>::iterator first, map<K, V, A>::iterator last)
 {
 
    while (first != last)
@@ -430,8 +431,8 @@ typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator first, map<K,
  * ERASE
  * Erase one element
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator it)
+template <typename K, typename V, typename A>
+typename map<K, V, A>::iterator map<K, V, A>::erase(map<K, V, A>::iterator it)
 {
    return iterator(bst.erase(it.it));
 }
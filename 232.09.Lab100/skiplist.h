@@ -0,0 +1,727 @@
+/***********************************************************************
+ * Header:
+ *    SKIPLIST
+ * Summary:
+ *    An ordered set and map kept in a skip list: the sorted, doubly
+ *    linked list of a Node, where each node also carries a tower of
+ *    forward pointers of random height.  Half the nodes reach level 1,
+ *    a quarter level 2, and so on, so a search runs along the top level
+ *    and drops a level each time it would overshoot, for expected
+ *    O(log n) find, insert, and erase.  Level 0 is the plain list, so
+ *    stepping to the next element is one pointer, with no climbing
+ *    back up through parents as in BST::iterator, and a range scan is
+ *    a walk down a linked list.
+ *
+ *    The interfaces are those of custom::set and custom::map.
+ *
+ *    This will contain the class definitions of:
+ *        skiplist_set             : a set of unique, ordered values
+ *        skiplist_set::iterator   : an iterator through it, in order
+ *        skiplist_map             : a map of unique, ordered keys
+ *        skiplist_map::iterator   : an iterator through it, in order
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // for ASSERT
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t
+#include <initializer_list>  // for std::initializer_list
+#include <memory>       // for std::allocator
+#include <new>          // for placement new
+#include <stdexcept>    // for std::out_of_range
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::pair and std::forward
+#include "pair.h"       // for custom::pair
+
+class TestSkiplist; // forward declaration for unit tests
+
+namespace custom
+{
+
+template <class K, class V, class A>
+class skiplist_map;
+
+/*****************************************************************
+ * SKIPLIST SET
+ * A set of unique values in order, found through towers
+ *****************************************************************/
+template <typename T, typename A = std::allocator<T>>
+class skiplist_set
+{
+   friend class ::TestSkiplist; // give unit tests access to the privates
+   template <class KK, class VV, class AA>
+   friend class skiplist_map;
+public:
+   // the tallest a tower can be
+   static const size_t MAX_HEIGHT = 32;
+
+   //
+   // Construct
+   //
+
+   skiplist_set(const A & a = A()) : alloc(a) { init(); }
+   skiplist_set(const skiplist_set & rhs)
+      : alloc(traits::select_on_container_copy_construction(rhs.alloc))
+   {
+      init();
+      copyFrom(rhs);
+   }
+   skiplist_set(skiplist_set && rhs) : alloc(std::move(rhs.alloc))
+   {
+      steal(rhs);
+   }
+   skiplist_set(const std::initializer_list <T> & il, const A & a = A()) : alloc(a)
+   {
+      init();
+      insert(il);
+   }
+   template <class Iterator>
+   skiplist_set(Iterator first, Iterator last, const A & a = A()) : alloc(a)
+   {
+      init();
+      insert(first, last);
+   }
+   ~skiplist_set()
+   {
+      clear();
+   }
+
+   //
+   // Assign
+   //
+
+   skiplist_set & operator = (const skiplist_set & rhs)
+   {
+      if (this != &rhs)
+      {
+         // our nodes go back to the allocator that made them first
+         clear();
+         copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
+         copyFrom(rhs);
+      }
+      return *this;
+   }
+   skiplist_set & operator = (skiplist_set && rhs)
+   {
+      if (this != &rhs)
+      {
+         clear();
+
+         // cannot adopt nodes our allocator did not hand out: copy them instead
+         if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
+         {
+            copyFrom(rhs);
+            rhs.clear();
+            return *this;
+         }
+
+         moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+         steal(rhs);
+      }
+      return *this;
+   }
+   skiplist_set & operator = (const std::initializer_list <T> & il)
+   {
+      clear();
+      insert(il);
+      return *this;
+   }
+   void swap(skiplist_set & rhs) noexcept
+   {
+      // unequal allocators that do not propagate cannot trade nodes
+      assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+      swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+      std::swap(head, rhs.head);
+      std::swap(pTail, rhs.pTail);
+      std::swap(numLevels, rhs.numLevels);
+      std::swap(numElements, rhs.numElements);
+      std::swap(seed, rhs.seed);
+   }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() const noexcept { return iterator(head[0]); }
+   iterator end()   const noexcept { return iterator();        }
+
+   //
+   // Access
+   //
+
+   iterator find(const T & t) const
+   {
+      Node * p = const_cast<skiplist_set *>(this)->seek(t, nullptr);
+      return (p && !(t < p->data)) ? iterator(p) : end();
+   }
+
+   // the first element not less than t: where a range scan starts
+   iterator lower_bound(const T & t) const
+   {
+      return iterator(const_cast<skiplist_set *>(this)->seek(t, nullptr));
+   }
+
+   //
+   // Status
+   //
+
+   bool   empty() const noexcept { return numElements == 0; }
+   size_t size()  const noexcept { return numElements;      }
+   A get_allocator() const noexcept { return A(alloc); }
+
+   // the height of the tallest tower
+   size_t height() const noexcept { return numLevels; }
+
+   //
+   // Insert
+   //
+
+   std::pair<iterator, bool> insert(const T &  t) { return emplace(t);            }
+   std::pair<iterator, bool> insert(      T && t) { return emplace(std::move(t)); }
+   void insert(const std::initializer_list <T> & il)
+   {
+      for (const T & t : il)
+         emplace(t);
+   }
+   template <class Iterator>
+   void insert(Iterator first, Iterator last)
+   {
+      for (; first != last; ++first)
+         emplace(*first);
+   }
+
+   //
+   // Remove
+   //
+
+   void clear() noexcept;
+   iterator erase(const iterator & it);
+   size_t erase(const T & t)
+   {
+      iterator it = find(t);
+      if (it == end())
+         return 0;
+      erase(it);
+      return 1;
+   }
+   iterator erase(const iterator & itBegin, const iterator & itEnd)
+   {
+      iterator it = itBegin;
+      while (it != itEnd)
+         it = erase(it);
+      return itEnd;
+   }
+
+private:
+
+   /*************************************************
+    * NODE
+    * The data and pPrev of a Node; pNext is the
+    * bottom of a tower of height forward pointers,
+    * allocated along with the node right after it.
+    *************************************************/
+   struct Node
+   {
+      template <class U>
+      Node(U && t, size_t height) : data(std::forward<U>(t)), pPrev(nullptr), height(height) {}
+
+      Node ** pNext() { return reinterpret_cast<Node **>(this + 1); }
+
+      T data;           // user data
+      Node * pPrev;     // the node before this one on level 0
+      size_t height;    // the number of forward pointers
+   };
+
+   // a node and its tower are allocated in units of a pointer, aligned as a node
+   using Word      = typename std::aligned_storage<sizeof(Node *), alignof(Node)>::type;
+   using WordAlloc = typename std::allocator_traits<A>::template rebind_alloc<Word>;
+   using traits    = std::allocator_traits<WordAlloc>;
+
+   static size_t words(size_t height)
+   {
+      return (sizeof(Node) + height * sizeof(Node *) + sizeof(Word) - 1) / sizeof(Word);
+   }
+
+   void init()
+   {
+      for (size_t l = 0; l < MAX_HEIGHT; l++)
+         head[l] = nullptr;
+      pTail = nullptr;
+      numLevels = 0;
+      numElements = 0;
+      seed = 2463534242u;
+   }
+
+   // take the nodes of rhs, leaving it empty.  Ours must be gone already.
+   void steal(skiplist_set & rhs)
+   {
+      for (size_t l = 0; l < MAX_HEIGHT; l++)
+         head[l] = rhs.head[l];
+      pTail = rhs.pTail;
+      numLevels = rhs.numLevels;
+      numElements = rhs.numElements;
+      seed = rhs.seed;
+      rhs.init();
+   }
+
+   // the allocator follows the nodes only when its traits say so
+   void copyAlloc(const WordAlloc & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const WordAlloc &,     std::false_type) {                         }
+   void moveAlloc(WordAlloc & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(WordAlloc &,           std::false_type) {                         }
+   void swapAlloc(WordAlloc & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(WordAlloc &,           std::false_type) {                         }
+
+   // a coin flipped until it comes up tails
+   size_t randomHeight();
+
+   // the first node not less than t, and the forward pointers leading to it
+   Node * seek(const T & t, Node ** update[]);
+
+   template <class U>
+   Node * newNode(U && t, size_t height);
+   void deleteNode(Node * p);
+
+   template <class U>
+   std::pair<iterator, bool> emplace(U && t);
+
+   // lay out a copy of rhs, tower for tower.  We must be empty.
+   void copyFrom(const skiplist_set & rhs);
+
+   WordAlloc alloc;              // hands out the nodes
+   Node * head[MAX_HEIGHT];      // the first node on each level
+   Node * pTail;                 // the last node on level 0
+   size_t numLevels;             // the levels in use
+   size_t numElements;           // the number of nodes
+   uint32_t seed;                // for the tower heights
+};
+
+/**************************************************
+ * SKIPLIST SET ITERATOR
+ * A node; walks level 0, so ++ is a single pointer
+ *************************************************/
+template <typename T, typename A>
+class skiplist_set <T, A> :: iterator
+{
+   friend class ::TestSkiplist; // give unit tests access to the privates
+   friend class custom::skiplist_set<T, A>;
+   template <class KK, class VV, class AA>
+   friend class skiplist_map;
+public:
+   // constructors, destructors, and assignment operator
+   iterator() : p(nullptr) {}
+   iterator(Node * p) : p(p) {}
+
+   // equals, not equals operator
+   bool operator == (const iterator & rhs) const { return p == rhs.p; }
+   bool operator != (const iterator & rhs) const { return p != rhs.p; }
+
+   // dereference operator
+   const T & operator *  () const { return  p->data; }
+   const T * operator -> () const { return &p->data; }
+
+   // prefix increment
+   iterator & operator ++ ()
+   {
+      if (p) p = p->pNext()[0];
+      return *this;
+   }
+   iterator operator ++ (int postfix)
+   {
+      iterator temp = *this;
+      ++(*this);
+      return temp;
+   }
+
+   // prefix decrement
+   iterator & operator -- ()
+   {
+      p = p->pPrev;
+      return *this;
+   }
+   iterator operator -- (int postfix)
+   {
+      iterator temp = *this;
+      --(*this);
+      return temp;
+   }
+
+private:
+   Node * p;
+};
+
+/*****************************************************
+ * SKIPLIST SET :: RANDOM HEIGHT
+ * One level, plus one more for each low bit that is
+ * set in a xorshift draw
+ ****************************************************/
+template <typename T, typename A>
+size_t skiplist_set <T, A> :: randomHeight()
+{
+   seed ^= seed << 13;
+   seed ^= seed >> 17;
+   seed ^= seed << 5;
+
+   size_t height = 1;
+   for (uint32_t bits = seed; (bits & 1) && height < MAX_HEIGHT; bits >>= 1)
+      height++;
+   return height;
+}
+
+/*****************************************************
+ * SKIPLIST SET :: SEEK
+ * Run along each level from the top until the next
+ * node would not be less than t, then drop a level.
+ *     INPUT  : t the value to look for
+ *              update, if not null, receives for each
+ *              level the forward pointers we dropped from
+ *     OUTPUT : the first node not less than t, or null
+ *     COST   : O(log n) expected
+ ****************************************************/
+template <typename T, typename A>
+typename skiplist_set <T, A> :: Node * skiplist_set <T, A> :: seek(const T & t, Node ** update[])
+{
+   Node ** pForward = head;
+   for (size_t l = numLevels; l-- > 0; )
+   {
+      while (pForward[l] && pForward[l]->data < t)
+         pForward = pForward[l]->pNext();
+      if (update)
+         update[l] = pForward;
+   }
+   return pForward[0];
+}
+
+/*****************************************************
+ * SKIPLIST SET :: NEW NODE
+ * Room for the node and its tower in one allocation
+ ****************************************************/
+template <typename T, typename A>
+template <class U>
+typename skiplist_set <T, A> :: Node * skiplist_set <T, A> :: newNode(U && t, size_t height)
+{
+   Word * pWords = traits::allocate(alloc, words(height));
+   Node * p;
+   try
+   {
+      p = new (pWords) Node(std::forward<U>(t), height);
+   }
+   catch (...)
+   {
+      traits::deallocate(alloc, pWords, words(height));
+      throw;
+   }
+   for (size_t l = 0; l < height; l++)
+      p->pNext()[l] = nullptr;
+   return p;
+}
+
+template <typename T, typename A>
+void skiplist_set <T, A> :: deleteNode(Node * p)
+{
+   size_t numWords = words(p->height);
+   p->~Node();
+   traits::deallocate(alloc, reinterpret_cast<Word *>(p), numWords);
+}
+
+/*****************************************************
+ * SKIPLIST SET :: EMPLACE
+ * Find where t goes, then link a new node into each
+ * level its tower reaches
+ *     INPUT  : t the value to insert
+ *     OUTPUT : where t is, and whether it is new
+ *     COST   : O(log n) expected
+ ****************************************************/
+template <typename T, typename A>
+template <class U>
+std::pair<typename skiplist_set <T, A> :: iterator, bool> skiplist_set <T, A> :: emplace(U && t)
+{
+   Node ** update[MAX_HEIGHT];
+   Node * pAfter = seek(t, update);
+   if (pAfter && !(t < pAfter->data))
+      return std::pair<iterator, bool>(iterator(pAfter), false);
+
+   size_t height = randomHeight();
+   Node * pNew = newNode(std::forward<U>(t), height);
+   for (; numLevels < height; numLevels++)
+      update[numLevels] = head;
+
+   for (size_t l = 0; l < height; l++)
+   {
+      pNew->pNext()[l] = update[l][l];
+      update[l][l] = pNew;
+   }
+
+   pNew->pPrev = pAfter ? pAfter->pPrev : pTail;
+   if (pAfter)
+      pAfter->pPrev = pNew;
+   else
+      pTail = pNew;
+
+   numElements++;
+   return std::pair<iterator, bool>(iterator(pNew), true);
+}
+
+/*****************************************************
+ * SKIPLIST SET :: ERASE
+ * Unlink the node from every level its tower reaches
+ *     INPUT  : it the element to remove
+ *     OUTPUT : the element after it
+ *     COST   : O(log n) expected
+ ****************************************************/
+template <typename T, typename A>
+typename skiplist_set <T, A> :: iterator skiplist_set <T, A> :: erase(const iterator & it)
+{
+   Node * p = it.p;
+   if (p == nullptr)
+      return end();
+
+   Node ** update[MAX_HEIGHT];
+   Node * pFound = seek(p->data, update);
+   assert(pFound == p);
+   (void)pFound;
+
+   for (size_t l = 0; l < p->height; l++)
+      update[l][l] = p->pNext()[l];
+
+   Node * pNext = p->pNext()[0];
+   if (pNext)
+      pNext->pPrev = p->pPrev;
+   else
+      pTail = p->pPrev;
+
+   while (numLevels > 0 && head[numLevels - 1] == nullptr)
+      numLevels--;
+
+   deleteNode(p);
+   numElements--;
+   return iterator(pNext);
+}
+
+/*****************************************************
+ * SKIPLIST SET :: CLEAR
+ * Level 0 reaches every node
+ *     COST   : O(n)
+ ****************************************************/
+template <typename T, typename A>
+void skiplist_set <T, A> :: clear() noexcept
+{
+   Node * p = head[0];
+   while (p)
+   {
+      Node * pNext = p->pNext()[0];
+      deleteNode(p);
+      p = pNext;
+   }
+   for (size_t l = 0; l < MAX_HEIGHT; l++)
+      head[l] = nullptr;
+   pTail = nullptr;
+   numLevels = 0;
+   numElements = 0;
+}
+
+/*****************************************************
+ * SKIPLIST SET :: COPY FROM
+ * rhs is already in order, so each node goes on the
+ * end of every level it reaches: no searching
+ *     COST   : O(n)
+ ****************************************************/
+template <typename T, typename A>
+void skiplist_set <T, A> :: copyFrom(const skiplist_set & rhs)
+{
+   assert(numElements == 0);
+   Node ** last[MAX_HEIGHT];
+   for (size_t l = 0; l < MAX_HEIGHT; l++)
+      last[l] = head;
+
+   for (Node * pSrc = rhs.head[0]; pSrc; pSrc = pSrc->pNext()[0])
+   {
+      Node * p = newNode(pSrc->data, pSrc->height);
+      for (size_t l = 0; l < p->height; l++)
+      {
+         last[l][l] = p;
+         last[l] = p->pNext();
+      }
+      p->pPrev = pTail;
+      pTail = p;
+      if (numLevels < p->height)
+         numLevels = p->height;
+      numElements++;
+   }
+}
+
+/*****************************************************************
+ * SKIPLIST MAP
+ * A map of unique keys in order: a skiplist_set of pairs
+ * compared by their first
+ *****************************************************************/
+template <class K, class V, class A = std::allocator<custom::pair<K, V>>>
+class skiplist_map
+{
+   friend class ::TestSkiplist; // give unit tests access to the privates
+public:
+   using Pairs = custom::pair<K, V>;
+
+   //
+   // Construct
+   //
+
+   skiplist_map(const A & a = A()) : entries(a) {}
+   skiplist_map(const skiplist_map &  rhs) : entries(rhs.entries) {}
+   skiplist_map(      skiplist_map && rhs) : entries(std::move(rhs.entries)) {}
+   template <class Iterator>
+   skiplist_map(Iterator first, Iterator last, const A & a = A()) : entries(first, last, a) {}
+   skiplist_map(const std::initializer_list <Pairs> & il, const A & a = A()) : entries(il, a) {}
+
+   //
+   // Assign
+   //
+
+   skiplist_map & operator = (const skiplist_map &  rhs) { entries = rhs.entries;            return *this; }
+   skiplist_map & operator = (      skiplist_map && rhs) { entries = std::move(rhs.entries); return *this; }
+   skiplist_map & operator = (const std::initializer_list <Pairs> & il) { entries = il;      return *this; }
+   void swap(skiplist_map & rhs) noexcept { entries.swap(rhs.entries); }
+
+   //
+   // Iterator
+   //
+
+   class iterator;
+   iterator begin() { return iterator(entries.begin()); }
+   iterator end()   { return iterator(entries.end());   }
+
+   //
+   // Access
+   //
+
+   V & operator [] (const K & k)
+   {
+      return (*insert(Pairs(k, V())).first).second;
+   }
+         V & at(const K & k);
+   const V & at(const K & k) const;
+   iterator find(const K & k)
+   {
+      return iterator(entries.find(Pairs(k, V())));
+   }
+   iterator lower_bound(const K & k)
+   {
+      return iterator(entries.lower_bound(Pairs(k, V())));
+   }
+
+   //
+   // Insert
+   //
+
+   custom::pair<iterator, bool> insert(Pairs && rhs)
+   {
+      auto result = entries.insert(std::move(rhs));
+      return custom::pair<iterator, bool>(iterator(result.first), result.second);
+   }
+   custom::pair<iterator, bool> insert(const Pairs & rhs)
+   {
+      auto result = entries.insert(rhs);
+      return custom::pair<iterator, bool>(iterator(result.first), result.second);
+   }
+   template <class Iterator>
+   void insert(Iterator first, Iterator last) { entries.insert(first, last); }
+   void insert(const std::initializer_list <Pairs> & il) { entries.insert(il); }
+
+   //
+   // Remove
+   //
+
+   void clear() noexcept { entries.clear(); }
+   size_t erase(const K & k) { return entries.erase(Pairs(k, V())); }
+   iterator erase(iterator it) { return iterator(entries.erase(it.it)); }
+   iterator erase(iterator first, iterator last)
+   {
+      return iterator(entries.erase(first.it, last.it));
+   }
+
+   //
+   // Status
+   //
+
+   bool   empty() const noexcept { return entries.empty(); }
+   size_t size()  const noexcept { return entries.size();  }
+   A get_allocator() const noexcept { return entries.get_allocator(); }
+
+private:
+
+   skiplist_set <Pairs, A> entries;
+};
+
+/**********************************************************
+ * SKIPLIST MAP ITERATOR
+ * A set iterator that can change the value, if not the key
+ *********************************************************/
+template <class K, class V, class A>
+class skiplist_map <K, V, A> :: iterator
+{
+   friend class ::TestSkiplist; // give unit tests access to the privates
+   friend class custom::skiplist_map<K, V, A>;
+public:
+   iterator() {}
+   iterator(const typename skiplist_set <Pairs, A> :: iterator & it) : it(it) {}
+
+   bool operator == (const iterator & rhs) const { return it == rhs.it; }
+   bool operator != (const iterator & rhs) const { return it != rhs.it; }
+
+   Pairs & operator *  () const { return  it.p->data; }
+   Pairs * operator -> () const { return &it.p->data; }
+
+   iterator & operator ++ ()
+   {
+      ++it;
+      return *this;
+   }
+   iterator operator ++ (int postfix)
+   {
+      iterator temp(*this);
+      ++it;
+      return temp;
+   }
+   iterator & operator -- ()
+   {
+      --it;
+      return *this;
+   }
+   iterator operator -- (int postfix)
+   {
+      iterator temp(*this);
+      --it;
+      return temp;
+   }
+
+private:
+   typename skiplist_set <Pairs, A> :: iterator it;
+};
+
+/*****************************************************
+ * SKIPLIST MAP :: AT
+ * The value for a key that must already be there
+ ****************************************************/
+template <class K, class V, class A>
+V & skiplist_map <K, V, A> :: at(const K & k)
+{
+   auto it = entries.find(Pairs(k, V()));
+   if (it == entries.end())
+      throw std::out_of_range("invalid map<K, T> key");
+   return it.p->data.second;
+}
+
+template <class K, class V, class A>
+const V & skiplist_map <K, V, A> :: at(const K & k) const
+{
+   auto it = entries.find(Pairs(k, V()));
+   if (it == entries.end())
+      throw std::out_of_range("invalid map<K, T> key");
+   return it.p->data.second;
+}
+
+} // namespace custom
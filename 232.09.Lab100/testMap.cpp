@@ -16,6 +16,7 @@
 #include "testPair.h"      // for the pair unit tests
 #include "testBST.h"       // for the BST unit tests
 #include "testMap.h"       // for the map unit tests
+#include "testSkiplist.h"  // for the skip list unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -30,6 +31,7 @@ int main()
    TestPair().run();
    TestBST().run();
    TestMap().run();
+   TestSkiplist().run();
 #endif // DEBUG
    
    return 0;
@@ -0,0 +1,349 @@
+/***********************************************************************
+ * Header:
+ *    TEST SKIPLIST
+ * Summary:
+ *    Unit tests for skiplist_set and skiplist_map
+ * Author
+ *    Ryan Whitehead, Cesar Tavarez, Roy Garcia
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "skiplist.h"   // class under test
+#include "unitTest.h"   // unit test baseclass
+#include "spy.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+/***********************************************
+ * TEST SKIPLIST
+ * Unit tests for the skip-list set and map
+ ***********************************************/
+class TestSkiplist : public UnitTest
+{
+   typedef custom::skiplist_set<int> IntSet;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructInit_ordered();
+      test_constructCopy_sameTowers();
+      test_constructMove_standard();
+      test_assignMove_self();
+
+      // Insert and find
+      test_insert_duplicate();
+      test_insert_many();
+      test_find_missing();
+      test_lowerBound_rangeScan();
+
+      // Erase
+      test_erase_relinks();
+      test_erase_range();
+      test_clear_spyDestroyed();
+
+      // Map
+      test_map_squareBracket();
+      test_map_atMissing();
+      test_map_eraseKey();
+
+      report("Skiplist");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty set has no towers
+   void test_construct_default()
+   {  // setup
+      // exercise
+      IntSet s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.size() == 0);
+      assertUnit(s.height() == 0);
+      assertUnit(s.begin() == s.end());
+      assertUnit(s.head[0] == nullptr);
+      assertUnit(s.pTail == nullptr);
+   }  // teardown
+
+   // values come out in order whatever order they went in
+   void test_constructInit_ordered()
+   {  // setup
+      // exercise
+      IntSet s{ 50, 30, 70, 20, 40, 60, 80, 30 };
+      // verify
+      assertUnit(s.size() == 7);
+      assertUnit(contents(s) == "20,30,40,50,60,70,80,");
+      assertUnit(*s.begin() == 20);
+      assertUnit(s.pTail->data == 80);
+      assertUnit(s.head[0]->pPrev == nullptr);
+   }  // teardown
+
+   // a copy is laid out with the same tower heights as the original
+   void test_constructCopy_sameTowers()
+   {  // setup
+      IntSet sSrc;
+      for (int i = 0; i < 100; i++)
+         sSrc.insert(i);
+      // exercise
+      IntSet sDest(sSrc);
+      // verify
+      assertUnit(sDest.size() == 100);
+      assertUnit(sDest.height() == sSrc.height());
+      assertUnit(sDest.head[0] != sSrc.head[0]);
+      bool sameHeights = true;
+      auto itSrc = sSrc.begin();
+      for (auto it = sDest.begin(); it != sDest.end(); ++it, ++itSrc)
+         if (it.p->height != itSrc.p->height || *it != *itSrc)
+            sameHeights = false;
+      assertUnit(sameHeights);
+      assertUnit(sDest.find(99) != sDest.end());
+      assertUnit(*--sDest.find(50) == 49);
+   }  // teardown
+
+   // a move takes the nodes
+   void test_constructMove_standard()
+   {  // setup
+      IntSet sSrc{ 26, 49, 67 };
+      auto pFirst = sSrc.head[0];
+      // exercise
+      IntSet sDest(std::move(sSrc));
+      // verify
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.head[0] == nullptr);
+      assertUnit(sSrc.height() == 0);
+      assertUnit(sDest.head[0] == pFirst);
+      assertUnit(contents(sDest) == "26,49,67,");
+   }  // teardown
+
+   // moving a set onto itself leaves it as it was
+   void test_assignMove_self()
+   {  // setup
+      IntSet s{ 26, 49, 67 };
+      auto pFirst = s.head[0];
+      IntSet & sAlias = s;
+      // exercise
+      s = std::move(sAlias);
+      // verify
+      assertUnit(s.size() == 3);
+      assertUnit(s.head[0] == pFirst);
+      assertUnit(contents(s) == "26,49,67,");
+   }  // teardown
+
+   /***************************************
+    * INSERT AND FIND
+    ***************************************/
+
+   // inserting a value already there hands back the one we have
+   void test_insert_duplicate()
+   {  // setup
+      IntSet s{ 26, 49 };
+      auto pExisting = s.find(49).p;
+      // exercise
+      auto result = s.insert(49);
+      // verify
+      assertUnit(result.second == false);
+      assertUnit(result.first.p == pExisting);
+      assertUnit(s.size() == 2);
+   }  // teardown
+
+   // a thousand values: every one found, level 0 linked both ways
+   void test_insert_many()
+   {  // setup
+      IntSet s;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         s.insert((i * 37) % 1000);
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(s.height() > 1);
+      assertUnit(s.height() <= IntSet::MAX_HEIGHT);
+      bool allFound = true;
+      for (int i = 0; i < 1000; i++)
+         if (s.find(i) == s.end() || *s.find(i) != i)
+            allFound = false;
+      assertUnit(allFound);
+      bool linked = true;
+      int expected = 0;
+      for (auto it = s.begin(); it != s.end(); ++it, ++expected)
+         if (*it != expected || (it.p->pPrev && it.p->pPrev->pNext()[0] != it.p))
+            linked = false;
+      assertUnit(linked);
+      assertUnit(expected == 1000);
+      assertUnit(s.pTail->data == 999);
+   }  // teardown
+
+   // find for something not there is end
+   void test_find_missing()
+   {  // setup
+      IntSet s{ 20, 40, 60 };
+      // exercise
+      auto it = s.find(50);
+      // verify
+      assertUnit(it == s.end());
+      assertUnit(s.find(10) == s.end());
+      assertUnit(s.find(70) == s.end());
+      assertUnit(*s.find(40) == 40);
+   }  // teardown
+
+   // a range scan starts at lower_bound and walks level 0
+   void test_lowerBound_rangeScan()
+   {  // setup
+      IntSet s{ 10, 20, 30, 40, 50, 60 };
+      std::string scanned;
+      // exercise
+      for (auto it = s.lower_bound(25); it != s.end() && *it < 55; ++it)
+         scanned += std::to_string(*it) + ",";
+      // verify
+      assertUnit(scanned == "30,40,50,");
+      assertUnit(*s.lower_bound(30) == 30);
+      assertUnit(s.lower_bound(61) == s.end());
+   }  // teardown
+
+   /***************************************
+    * ERASE
+    ***************************************/
+
+   // erasing takes the node out of every level it was on
+   void test_erase_relinks()
+   {  // setup
+      IntSet s;
+      for (int i = 0; i < 64; i++)
+         s.insert(i);
+      auto it = s.find(32);
+      auto pErased = it.p;
+      // exercise
+      auto itNext = s.erase(it);
+      // verify
+      assertUnit(*itNext == 33);
+      assertUnit(itNext.p->pPrev->data == 31);
+      assertUnit(s.size() == 63);
+      assertUnit(s.find(32) == s.end());
+      bool unlinked = true;
+      for (size_t l = 0; l < s.height(); l++)
+      {
+         for (auto p = s.head[l]; p; p = p->pNext()[l])
+            if (p == pErased)
+               unlinked = false;
+      }
+      assertUnit(unlinked);
+      assertUnit(s.erase(32) == 0);
+      assertUnit(s.erase(63) == 1);
+      assertUnit(s.pTail->data == 62);
+   }  // teardown
+
+   // erase a range, then everything, and the towers come down too
+   void test_erase_range()
+   {  // setup
+      IntSet s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      auto it = s.erase(s.find(10), s.find(90));
+      // verify
+      assertUnit(*it == 90);
+      assertUnit(s.size() == 20);
+      assertUnit(*--s.find(90) == 9);
+      s.erase(s.begin(), s.end());
+      assertUnit(s.empty());
+      assertUnit(s.height() == 0);
+      assertUnit(s.pTail == nullptr);
+   }  // teardown
+
+   // clear destroys each element once
+   void test_clear_spyDestroyed()
+   {  // setup
+      custom::skiplist_set<Spy> s;
+      s.insert(Spy(26));
+      s.insert(Spy(49));
+      s.insert(Spy(67));
+      Spy::reset();
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(Spy::numDelete() == 3);
+      assertUnit(s.empty());
+      assertUnit(s.head[0] == nullptr);
+   }  // teardown
+
+   /***************************************
+    * MAP
+    ***************************************/
+
+   // [] adds a missing key and changes an existing value in place
+   void test_map_squareBracket()
+   {  // setup
+      custom::skiplist_map<int, std::string> m;
+      m[49] = "forty-nine";
+      // exercise
+      m[26] = "twenty-six";
+      m[49] += "!";
+      // verify
+      assertUnit(m.size() == 2);
+      assertUnit((*m.begin()).first == 26);
+      assertUnit(m.find(49)->second == "forty-nine!");
+      assertUnit(m.at(26) == "twenty-six");
+   }  // teardown
+
+   // at a missing key throws and adds nothing
+   void test_map_atMissing()
+   {  // setup
+      custom::skiplist_map<int, int> m{ custom::pair<int, int>(26, 1) };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(49);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.size() == 1);
+      assertUnit(m.find(49) == m.end());
+   }  // teardown
+
+   // erasing by key leaves the rest in order
+   void test_map_eraseKey()
+   {  // setup
+      custom::skiplist_map<int, int> m;
+      for (int i = 0; i < 10; i++)
+         m[i] = i * i;
+      // exercise
+      size_t numErased = m.erase(4);
+      // verify
+      assertUnit(numErased == 1);
+      assertUnit(m.erase(4) == 0);
+      assertUnit(m.size() == 9);
+      assertUnit(m.find(5)->second == 25);
+      assertUnit((*--m.find(5)).first == 3);
+   }  // teardown
+
+   /*************************************************************
+    * CONTENTS
+    * The values, front to back, each followed by ,
+    *************************************************************/
+   std::string contents(IntSet & s)
+   {
+      std::string str;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         str += std::to_string(*it) + ",";
+      return str;
+   }
+};
+
+#endif // DEBUG
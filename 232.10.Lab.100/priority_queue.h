@@ -19,22 +19,35 @@
 
 #pragma once
 
+#include <iterator>  // for std::distance and std::iterator_traits
+#include <stdexcept> // for std::out_of_range
 #include "vector.h" // custom vector implementation
 
 namespace custom
 {
-   template <class T>
+   /*****************************************
+    * PRIORITY QUEUE
+    * A max-heap kept in any vector-like Container:
+    * custom::vector by default, or custom::small_vector
+    * when the heap is usually small
+    ****************************************/
+   template <class T, class Container = custom::vector<T>>
    class priority_queue
    {
    public:
+      using allocator_type = typename Container::allocator_type;
+
       // Underlying container
-      custom::vector<T> container;
+      Container container;
 
       //
       // Constructors
       //
       priority_queue() = default;
 
+      // Allocator constructor
+      explicit priority_queue(const allocator_type& a) : container(a) {}
+
       // Copy constructor
       priority_queue(const priority_queue& rhs) : container(rhs.container) {}
 
@@ -44,19 +57,21 @@ namespace custom
 
       // Range constructor
       template <class Iterator>
-      priority_queue(Iterator first, Iterator last)
+      priority_queue(Iterator first, Iterator last,
+                     const allocator_type& a = allocator_type()) : container(a)
       {
+         reserveFor(first, last,
+                    typename std::iterator_traits<Iterator>::iterator_category());
          while (first != last)
          {
             container.push_back(*first);
-            //container.capacity
             first++;
          }
          heapify();
       }
 
       // Move-initialize constructor
-      priority_queue(custom::vector<T>&& v)
+      priority_queue(Container&& v)
          : container(std::move(v))
       {
          heapify();
@@ -85,6 +100,7 @@ namespace custom
       //
       size_t size() const { return container.size(); }
       bool empty() const { return container.empty(); }
+      allocator_type get_allocator() const { return container.get_allocator(); }
 
       //
       // Push (copy)
@@ -165,6 +181,21 @@ namespace custom
       }
 
    private:
+      //
+      // Reserve For (range constructor)
+      // Room for the range when it can be counted without
+      // using it up; a single-pass range just grows as it goes
+      //
+      template <class Iterator>
+      void reserveFor(Iterator first, Iterator last, std::forward_iterator_tag)
+      {
+         container.reserve(std::distance(first, last));
+      }
+      template <class Iterator>
+      void reserveFor(Iterator, Iterator, std::input_iterator_tag)
+      {
+      }
+
       //
       // Percolate Up (for push)
       //
@@ -184,8 +215,8 @@ namespace custom
    //
    // Swap (non-member)
    //
-   template <class T>
-   void swap(priority_queue<T>& lhs, priority_queue<T>& rhs)
+   template <class T, class Container>
+   void swap(priority_queue<T, Container>& lhs, priority_queue<T, Container>& rhs)
    {
       lhs.swap(rhs);
    }
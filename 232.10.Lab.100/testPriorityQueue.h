@@ -12,11 +12,14 @@
 #ifdef DEBUG
 
 #include "priority_queue.h"
+#include "small_vector.h"
 #include "unitTest.h"
 #include "spy.h"
 
 #include <cassert>
+#include <iterator>
 #include <memory>
+#include <sstream>
 
 
 class TestPQueue : public UnitTest
@@ -36,6 +39,7 @@ public:
       test_constructRange_empty();
       test_constructRange_one();
       test_constructRange_staandard();
+      test_constructRange_inputIterator();
       test_constructMoveInit_empty();
       test_constructMoveInit_one();
       test_constructMoveInit_standard();
@@ -68,6 +72,7 @@ public:
       test_pop_one();
       test_pop_two();
       test_pop_standard();
+      test_pop_smallVectorPastInline();
 
       // Status
       test_size_empty();
@@ -248,6 +253,33 @@ public:
       teardownStandardFixture(pq);
    }
    
+   // priority_queue from a stream, which can be read only once
+   void test_constructRange_inputIterator()
+   {  // setup
+      std::istringstream in("5 3 9 1");
+      std::istream_iterator<int> itFirst(in);
+      std::istream_iterator<int> itLast;
+      // exercise
+      custom::priority_queue<int> pq(itFirst, itLast);
+      // verify
+      //  +---+---+---+---+
+      //  | 9 | 3 | 5 | 1 |
+      //  +---+---+---+---+
+      //                9
+      //          3            5
+      //       1
+      assertUnit(pq.container.size() == 4);
+      if (pq.container.size() == 4)
+      {
+         assertUnit(pq.container[0] == int(9));
+         assertUnit(pq.container[1] == int(3));
+         assertUnit(pq.container[2] == int(5));
+         assertUnit(pq.container[3] == int(1));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
    /***************************************
     * MOVE CONTAINER INITIALIZE CONSTRUCTOR
     ***************************************/
@@ -873,6 +905,31 @@ public:
       teardownStandardFixture(pq);
    }
 
+   void test_pop_smallVectorPastInline()
+   {  // setup
+      // a small_vector with 4 slots spills to the heap at the fifth push
+      custom::priority_queue <int, custom::small_vector<int, 4>> pq;
+      int values[] = { 4, 10, 3, 8, 5, 9, 7 };
+      for (int value : values)
+         pq.push(value);
+      assertUnit(!pq.container.is_inline());
+      assertUnit(pq.size() == 7);
+      // exercise
+      bool descending = true;
+      int prev = pq.top();
+      while (!pq.empty())
+      {
+         descending = descending && pq.top() <= prev;
+         prev = pq.top();
+         pq.pop();
+      }
+      // verify
+      assertUnit(descending);
+      assertUnit(prev == int(3));
+      assertUnit(pq.size() == 0);
+      // teardown
+   }
+
    
 
    /***************************************
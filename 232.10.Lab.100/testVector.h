@@ -260,7 +260,7 @@ public:
          //    | 26 | 49 |    |    |
          //    +----+----+----+----+
          custom::vector<int> v;
-         v.data = new int[4];
+         v.data = std::allocator<int>().allocate(4);
          v.data[0] = 99;
          v.data[1] = 99;
          v.numElements = 2;
@@ -319,7 +319,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[4];
+      vSrc.data = std::allocator<int>().allocate(4);
       vSrc.data[0] = 26;
       vSrc.data[1] = 49;
       vSrc.numElements = 2;
@@ -403,7 +403,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[4];\
+      vSrc.data = std::allocator<int>().allocate(4);\
       vSrc.data[0] = 26;
       vSrc.data[1] = 49;
       vSrc.numElements = 2;
@@ -626,7 +626,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -650,7 +650,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -674,7 +674,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -753,7 +753,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       // exercise
@@ -787,7 +787,7 @@ public:
       //    | 26 | 49 | 67 | 89 |    |    |
       //    +----+----+----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[6];
+      v.data = std::allocator<int>().allocate(6);
       v.data[0] = 26;
       v.data[1] = 49;
       v.data[2] = 67;
@@ -966,7 +966,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vDest;
-      vDest.data = new int[2];
+      vDest.data = std::allocator<int>().allocate(2);
       vDest.data[0] = 99;
       vDest.data[1] = 99;
       vDest.numElements = 2;
@@ -998,7 +998,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[2];
+      vSrc.data = std::allocator<int>().allocate(2);
       vSrc.data[0] = 99;
       vSrc.data[1] = 99;
       vSrc.numElements = 2;
@@ -1103,7 +1103,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vDest;
-      vDest.data = new int[2];
+      vDest.data = std::allocator<int>().allocate(2);
       vDest.data[0] = 99;
       vDest.data[1] = 99;
       vDest.numElements = 2;
@@ -1130,7 +1130,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[2];
+      vSrc.data = std::allocator<int>().allocate(2);
       vSrc.data[0] = 99;
       vSrc.data[1] = 99;
       vSrc.numElements = 2;
@@ -1240,7 +1240,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vDest;
-      vDest.data = new int[2];
+      vDest.data = std::allocator<int>().allocate(2);
       vDest.data[0] = 99;
       vDest.data[1] = 99;
       vDest.numElements = 2;
@@ -1279,7 +1279,7 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<int> vSrc;
-      vSrc.data = new int[2];
+      vSrc.data = std::allocator<int>().allocate(2);
       vSrc.data[0] = 99;
       vSrc.data[1] = 99;
       vSrc.numElements = 2;
@@ -1520,7 +1520,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.data[0] = 26;
       v.data[1] = 49;
       v.numElements = 2;
@@ -1587,7 +1587,7 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.data[0] = 26;
       v.data[1] = 49;
       v.numElements = 2;
@@ -1645,7 +1645,7 @@ public:
       //    | 26 | 49 | 67 |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       v.data[0] = 26;
       v.data[1] = 49;
       v.data[2] = 67;
@@ -1675,7 +1675,7 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<int> v;
-      v.data = new int[3];
+      v.data = std::allocator<int>().allocate(3);
       v.data[0] = 26;
       v.data[1] = 49;
       v.data[2] = 67;
@@ -1744,7 +1744,7 @@ public:
       //    | 26 | 49 | 67 |    |
       //    +----+----+----+----+
       custom::vector<int> v;
-      v.data = new int[4];
+      v.data = std::allocator<int>().allocate(4);
       
       v.data[0] = 26;
       v.data[1] = 49;
@@ -1777,7 +1777,7 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<int> v;
-      v.data = new int[3];
+      v.data = std::allocator<int>().allocate(3);
       
       v.data[0] = 26;
       v.data[1] = 49;
@@ -2017,7 +2017,7 @@ public:
       
       try
       {
-         v.data = new int[4];
+         v.data = std::allocator<int>().allocate(4);
          v.data[0] = 26;
          v.data[1] = 49;
          v.data[2] = 67;
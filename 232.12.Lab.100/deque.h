@@ -21,6 +21,9 @@
 
 // Debug stuff
 #include <cassert>
+#include <memory>     // for std::allocator
+#include <utility>    // for std::move and std::swap
+#include "growth.h"   // for the growth policies and growth_stats
 
 class TestDeque;    // forward declaration for TestDeque unit test class
 
@@ -38,29 +41,38 @@ namespace custom
  * iaFront = 1
  * numElements = 3
  * numCapacity = 5
+ * G picks how much the buffer grows when it is full.
  *****************************************************/
-template <class T>
+template <class T, class A = std::allocator<T>, class G = grow_double>
 class deque
 {
    friend class ::TestDeque; // give unit tests access to the privates
 public:
 
-   // 
+   //
    // Construct
    //
-   deque() 
-   { 
+   deque(const A & a = A()) : alloc(a)
+   {
+      data = nullptr;
+      numCapacity = 0;
+      numElements = 0;
+      iaFront = 0;
    }
-   deque(int newCapacity);
-   deque(const deque <T> & rhs);
+   deque(int newCapacity, const A & a = A());
+   deque(const deque & rhs);
+   deque(deque && rhs);
    ~deque()
-   { 
+   {
+      release();
    }
 
    //
    // Assign
    //
-   deque<T> & operator = (const deque <T> & rhs);
+   deque & operator = (const deque & rhs);
+   deque & operator = (deque && rhs);
+   void swap(deque & rhs);
 
    //
    // Iterator
@@ -95,7 +107,9 @@ public:
    // Remove
    //
    void clear()
-   { 
+   {
+      for (size_t id = 0; id < numElements; id++)
+         traits::destroy(alloc, data + iaFromID(id));
       numElements = 0;
       iaFront = 0;
    }
@@ -109,9 +123,24 @@ public:
    { 
       return numElements; 
    }
-   bool empty() const 
-   { 
-      return numElements ==0; 
+   bool empty() const
+   {
+      return numElements ==0;
+   }
+   A get_allocator() const
+   {
+      return alloc;
+   }
+
+   // how the growth policy has done for this deque
+   const growth_stats & stats() const
+   {
+      return telemetry;
+   }
+   void reset_stats()
+   {
+      telemetry = growth_stats();
+      notePeak();
    }
 
    
@@ -124,11 +153,50 @@ private:
    }
    void resize(int newCapacity = 0);
 
+   // the buffer is raw storage: only the numElements slots from iaFront are live
+   using traits = std::allocator_traits<A>;
+
+   // destroy the elements and free the buffer
+   void release()
+   {
+      clear();
+      if (data)
+         traits::deallocate(alloc, data, numCapacity);
+      data = nullptr;
+      numCapacity = 0;
+   }
+
+   // copy the elements of rhs, unwrapped, into our buffer
+   void copyElements(const deque & rhs)
+   {
+      for (size_t id = 0; id < rhs.numElements; id++)
+         traits::construct(alloc, data + id, rhs.data[rhs.iaFromID(id)]);
+      numElements = rhs.numElements;
+      iaFront = 0;
+   }
+
+   // remember the biggest the buffer has been
+   void notePeak()
+   {
+      if (numCapacity > telemetry.peakCapacity)
+         telemetry.peakCapacity = numCapacity;
+   }
+
+   // the allocator follows the buffer only when its traits say so
+   void copyAlloc(const A & rhs, std::true_type)  { alloc = rhs;            }
+   void copyAlloc(const A &,     std::false_type) {                         }
+   void moveAlloc(A & rhs,       std::true_type)  { alloc = std::move(rhs); }
+   void moveAlloc(A &,           std::false_type) {                         }
+   void swapAlloc(A & rhs,       std::true_type)  { std::swap(alloc, rhs);  }
+   void swapAlloc(A &,           std::false_type) {                         }
+
    // member variables
+   A alloc;            // hands out the raw, unconstructed buffer
    T * data;           // dynamically allocated data for the deque
    size_t numCapacity; // the size of the data array
    size_t numElements; // number of elements in the deque
    int iaFront;        // the index of the first item in the array
+   growth_stats telemetry; // reallocations, bytes moved, and peak capacity
 };
 
 
@@ -137,8 +205,8 @@ private:
  * DEQUE ITERATOR
  * Forward and reverse iterator through a deque, just call
  *********************************************************/
-template <typename T>
-class deque <T> ::iterator
+template <typename T, typename A, typename G>
+class deque <T, A, G> ::iterator
 {
    friend class ::TestDeque; // give unit tests access to the privates
 public:
@@ -146,7 +214,7 @@ public:
    // Construct
    //
    iterator() : pDeque(nullptr), id(0) {}
-   iterator(custom::deque<T>* pDeque, int id) : pDeque(pDeque), id(id) {}
+   iterator(custom::deque<T, A, G>* pDeque, int id) : pDeque(pDeque), id(id) {}
    iterator(const iterator& rhs) : pDeque(rhs.pDeque), id(rhs.id) {}
 
    //
@@ -225,87 +293,155 @@ private:
 
    // Member variables
    int id;             // deque index
-   deque<T> *pDeque;
+   deque<T, A, G> *pDeque;
 };
 
 
 /****************************************************
  * DEQUE : CONSTRUCTOR - non-default
  ***************************************************/
-template <class T>
-deque <T> :: deque(int newCapacity)
+template <class T, class A, class G>
+deque <T, A, G> :: deque(int newCapacity, const A & a) : alloc(a)
 {
    assert(newCapacity > 0);
-   data = new T[newCapacity];
+   data = traits::allocate(alloc, newCapacity);
    numCapacity = newCapacity;
    numElements = 0;
    iaFront = 0;
+   notePeak();
 }
 
 /****************************************************
  * DEQUE : CONSTRUCTOR - copy
  ***************************************************/
-template <class T>
-deque <T> :: deque(const deque <T> & rhs)
+template <class T, class A, class G>
+deque <T, A, G> :: deque(const deque <T, A, G> & rhs) :
+   alloc(traits::select_on_container_copy_construction(rhs.alloc))
 {
    // Copy basic metadata
    numCapacity = rhs.numCapacity;
-   numElements = rhs.numElements;
+   numElements = 0;
    iaFront = 0; // reset to 0 for clean indexing in new array
 
    // Allocate new array
-   data = new T[numCapacity];
+   data = numCapacity ? traits::allocate(alloc, numCapacity) : nullptr;
 
    // Copy each element using logical index
-   for (size_t i = 0; i < numElements; i++)
-   {
-      data[i] = rhs.data[(rhs.iaFront + i) % rhs.numCapacity];
-   }
+   copyElements(rhs);
+   notePeak();
+}
+
+/****************************************************
+ * DEQUE : CONSTRUCTOR - move
+ ***************************************************/
+template <class T, class A, class G>
+deque <T, A, G> :: deque(deque <T, A, G> && rhs) : alloc(std::move(rhs.alloc))
+{
+   data = rhs.data;
+   numCapacity = rhs.numCapacity;
+   numElements = rhs.numElements;
+   iaFront = rhs.iaFront;
+
+   rhs.data = nullptr;
+   rhs.numCapacity = 0;
+   rhs.numElements = 0;
+   rhs.iaFront = 0;
+   notePeak();
 }
 
 
 /****************************************************
  * DEQUE : ASSIGNMENT OPERATOR
  ***************************************************/
-template <class T>
-deque <T> & deque <T> :: operator = (const deque <T> & rhs)
+template <class T, class A, class G>
+deque <T, A, G> & deque <T, A, G> :: operator = (const deque <T, A, G> & rhs)
 {
    // Guard self-assignment
    if (this == &rhs)
       return *this;
 
-   // Clean up old memory
-   delete[] data;
-
-   // Copy metadata
-   numCapacity = rhs.numCapacity;
-   numElements = rhs.numElements;
-   iaFront = 0;
+   // Clean up old elements, keeping the buffer if it is big enough
+   clear();
+   if (traits::propagate_on_container_copy_assignment::value && alloc != rhs.alloc)
+      release();
+   copyAlloc(rhs.alloc, typename traits::propagate_on_container_copy_assignment());
 
    // Allocate new array
-   data = new T[numCapacity];
+   if (rhs.numElements > numCapacity)
+   {
+      release();
+      data = traits::allocate(alloc, rhs.numCapacity);
+      numCapacity = rhs.numCapacity;
+      notePeak();
+   }
 
    // Copy elements in correct logical order
-   for (size_t i = 0; i < numElements; i++)
+   copyElements(rhs);
+
+   return *this;
+}
+
+/****************************************************
+ * DEQUE : ASSIGNMENT OPERATOR - move
+ ***************************************************/
+template <class T, class A, class G>
+deque <T, A, G> & deque <T, A, G> :: operator = (deque <T, A, G> && rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   // cannot adopt a buffer our allocator did not hand out: copy it over instead
+   if (!traits::propagate_on_container_move_assignment::value && alloc != rhs.alloc)
    {
-      data[i] = rhs.data[(rhs.iaFront + i) % rhs.numCapacity];
+      *this = rhs;
+      rhs.clear();
+      return *this;
    }
 
+   release();
+   moveAlloc(rhs.alloc, typename traits::propagate_on_container_move_assignment());
+   data = rhs.data;
+   numCapacity = rhs.numCapacity;
+   numElements = rhs.numElements;
+   iaFront = rhs.iaFront;
+   notePeak();
+
+   rhs.data = nullptr;
+   rhs.numCapacity = 0;
+   rhs.numElements = 0;
+   rhs.iaFront = 0;
    return *this;
 }
 
+/****************************************************
+ * DEQUE : SWAP
+ ***************************************************/
+template <class T, class A, class G>
+void deque <T, A, G> :: swap(deque <T, A, G> & rhs)
+{
+   // unequal allocators that do not propagate cannot trade buffers
+   assert(traits::propagate_on_container_swap::value || alloc == rhs.alloc);
+   swapAlloc(rhs.alloc, typename traits::propagate_on_container_swap());
+   std::swap(data, rhs.data);
+   std::swap(numCapacity, rhs.numCapacity);
+   std::swap(numElements, rhs.numElements);
+   std::swap(iaFront, rhs.iaFront);
+   notePeak();
+   rhs.notePeak();
+}
+
 
 /**************************************************
  * DEQUE :: FRONT
  * Fetch the item that is at the beginning of the deque
  *************************************************/
-template <class T>
-const T & deque <T> :: front() const 
+template <class T, class A, class G>
+const T & deque <T, A, G> :: front() const 
 {
    return data[iaFront];
 }
-template <class T>
-T& deque <T> ::front()
+template <class T, class A, class G>
+T& deque <T, A, G> ::front()
 {
    return data[iaFront];
 }
@@ -314,13 +450,13 @@ T& deque <T> ::front()
  * DEQUE :: BACK
  * Fetch the item that is at the end of the deque
  *************************************************/
-template <class T>
-const T & deque <T> :: back() const 
+template <class T, class A, class G>
+const T & deque <T, A, G> :: back() const 
 {
    return data[iaFromID(numElements - 1)];
 }
-template <class T>
-T& deque <T> ::back()
+template <class T, class A, class G>
+T& deque <T, A, G> ::back()
 {
    return data[iaFromID(numElements - 1)];
 }
@@ -329,13 +465,13 @@ T& deque <T> ::back()
  * DEQUE :: SUBSCRIPT
  * Fetch the item in the deque
  *************************************************/
-template <class T>
-const T& deque <T> ::operator[](size_t index) const
+template <class T, class A, class G>
+const T& deque <T, A, G> ::operator[](size_t index) const
 {
    return data[iaFromID(index)];
 }
-template <class T>
-T& deque <T> ::operator[](size_t index)
+template <class T, class A, class G>
+T& deque <T, A, G> ::operator[](size_t index)
 {
    return data[iaFromID(index)];
 }
@@ -343,21 +479,25 @@ T& deque <T> ::operator[](size_t index)
 /*****************************************************
  * DEQUE : POP_BACK
  *****************************************************/
-template <class T>
-void deque <T> :: pop_back()
+template <class T, class A, class G>
+void deque <T, A, G> :: pop_back()
 {
    if (numElements > 0)
+   {
       numElements--;
+      traits::destroy(alloc, data + iaFromID(numElements));
+   }
 }
 
 /*****************************************************
  * DEQUE : POP_FRONT
  *****************************************************/
-template <class T>
-void deque <T> :: pop_front()
+template <class T, class A, class G>
+void deque <T, A, G> :: pop_front()
 {
    if (numElements > 0)
    {
+      traits::destroy(alloc, data + iaFront);
       iaFront = (iaFront + 1) % numCapacity;
       numElements--;
    }
@@ -366,49 +506,55 @@ void deque <T> :: pop_front()
 /******************************************************
  * DEQUE : PUSH_BACK
  ******************************************************/
-template <class T>
-void deque <T> :: push_back(const T & t) 
+template <class T, class A, class G>
+void deque <T, A, G> :: push_back(const T & t) 
 {
    if (numElements == numCapacity)
-      resize(numCapacity == 0 ? 1 : numCapacity * 2);
+      resize(G::next(numCapacity, numElements + 1, sizeof(T)));
    int index = iaFromID(numElements);
-   data[index] = t;
+   traits::construct(alloc, data + index, t);
    numElements++;
 }
 
 /******************************************************
  * DEQUE : PUSH_FRONT
  ******************************************************/
-template <class T>
-void deque <T> :: push_front(const T & t) 
+template <class T, class A, class G>
+void deque <T, A, G> :: push_front(const T & t) 
 {
    if (numElements == numCapacity)
-      resize(numCapacity == 0 ? 1 : numCapacity * 2);
+      resize(G::next(numCapacity, numElements + 1, sizeof(T)));
    iaFront = (iaFront - 1 + numCapacity) % numCapacity;
-   data[iaFront] = t;
+   traits::construct(alloc, data + iaFront, t);
    numElements++;
 }
 
 /****************************************************
  * DEQUE :: RESIZE
- * Resize the deque so the numCapacity matches the newCapacity
+ * Resize the deque so the numCapacity matches the newCapacity,
+ * unwrapping the elements to the front of the new buffer
  ***************************************************/
-template <class T>
-void deque <T> :: resize(int newCapacity) 
+template <class T, class A, class G>
+void deque <T, A, G> :: resize(int newCapacity) 
 {
    if (newCapacity < numElements)
       newCapacity = numElements > 0 ? numElements * 2 : 1;
 
-   T* newData = new T[newCapacity];
+   T* newData = traits::allocate(alloc, newCapacity);
    for (size_t i = 0; i < numElements; i++)
    {
-      newData[i] = data[iaFromID(i)];
+      traits::construct(alloc, newData + i, std::move_if_noexcept(data[iaFromID(i)]));
+      traits::destroy(alloc, data + iaFromID(i));
    }
 
-   delete[] data;
+   if (data)
+      traits::deallocate(alloc, data, numCapacity);
+   telemetry.reallocations++;
+   telemetry.bytesCopied += numElements * sizeof(T);
    data = newData;
    iaFront = 0;
    numCapacity = newCapacity;
+   notePeak();
 }
 
 } // namespace custom
@@ -12,6 +12,7 @@
 #ifdef DEBUG
 
 #include "deque.h"
+#include "parallel.h"
 #include "unitTest.h"
 
 #include <vector>
@@ -88,6 +89,14 @@ public:
       test_empty_empty();
       test_empty_standard();
 
+      // Growth
+      test_growth_byHalfWraps();
+      test_growth_doubleStats();
+
+      // Parallel
+      test_parallel_sortWrapped();
+      test_parallel_transformReduce();
+
 
       report("Deque");
    }
@@ -127,7 +136,7 @@ public:
       //    +----+----+----+    +    +
       // id = 1    2    0    1    2
       custom::deque<int> d;
-      d.data = new int[3];
+      d.data = std::allocator<int>().allocate(3);
       d.data[2] = 11;
       d.data[0] = 26;
       d.data[1] = 31;
@@ -291,7 +300,7 @@ public:
       //    +----+----+
       // id = 0    1   
       custom::deque<int> dDes;
-      dDes.data = new int[2];
+      dDes.data = std::allocator<int>().allocate(2);
       dDes.data[0] = 85;
       dDes.data[1] = 99;
       dDes.numCapacity = 2;
@@ -335,7 +344,7 @@ public:
       //    +----+----+----+----+ 
       // id = 0    1    2    3
       custom::deque<int> dDes;
-      dDes.data = new int[4];
+      dDes.data = std::allocator<int>().allocate(4);
       dDes.data[0] = 61;
       dDes.data[1] = 73;
       dDes.data[2] = 85;
@@ -382,7 +391,7 @@ public:
       //    +----+----+----+    +    +
       // id = 1    2    0    1    2
       custom::deque<int> dSrc;
-      dSrc.data = new int[3];
+      dSrc.data = std::allocator<int>().allocate(3);
       dSrc.data[0] = 26;
       dSrc.data[1] = 31;
       dSrc.data[2] = 11;
@@ -1331,6 +1340,91 @@ public:
       // teardown
    }
 
+   /***************************************
+    * GROWTH
+    ***************************************/
+
+   // grow by half while wrapped: 1, 2, 3, 4, 6, and the order survives
+   void test_growth_byHalfWraps()
+   {  // setup
+      custom::deque<int, std::allocator<int>, custom::grow_by_half> d;
+      // exercise
+      for (int i = 0; i < 3; i++)
+      {
+         d.push_back(i);
+         d.push_front(-i - 1);
+      }
+      // verify
+      assertUnit(d.numCapacity == 6);
+      assertUnit(d.numElements == 6);
+      assertUnit(d.stats().reallocations == 5);
+      assertUnit(d.stats().peakCapacity == 6);
+      assertUnit(d[0] == -3);
+      assertUnit(d[2] == -1);
+      assertUnit(d[3] == 0);
+      assertUnit(d[5] == 2);
+   }  // teardown
+
+   // doubling counts each element moved
+   void test_growth_doubleStats()
+   {  // setup
+      custom::deque<int> d;
+      // exercise
+      for (int i = 0; i < 5; i++)
+         d.push_back(i);
+      // verify
+      assertUnit(d.numCapacity == 8);
+      assertUnit(d.stats().reallocations == 4);
+      assertUnit(d.stats().bytesCopied == (0 + 1 + 2 + 4) * sizeof(int));
+      assertUnit(d.stats().peakCapacity == 8);
+   }  // teardown
+
+   /***************************************
+    * PARALLEL
+    ***************************************/
+
+   // a wrapped deque sorts in parallel through operator[]
+   void test_parallel_sortWrapped()
+   {  // setup
+      size_t saved = custom::parallel::threshold();
+      custom::parallel::set_threshold(8);
+      custom::deque<int> d;
+      for (int i = 0; i < 100; i++)
+         if (i % 2)
+            d.push_front(i);
+         else
+            d.push_back(i);
+      // exercise
+      custom::parallel::sort(d);
+      // verify
+      bool sorted = true;
+      for (size_t i = 0; i < d.size(); i++)
+         sorted = sorted && d[i] == static_cast<int>(i);
+      assertUnit(sorted);
+      custom::parallel::set_threshold(saved);
+   }  // teardown
+
+   // transform from one deque into another, then add it up
+   void test_parallel_transformReduce()
+   {  // setup
+      size_t saved = custom::parallel::threshold();
+      custom::parallel::set_threshold(8);
+      custom::deque<int> src;
+      custom::deque<int> dest;
+      for (int i = 1; i <= 100; i++)
+      {
+         src.push_back(i);
+         dest.push_back(0);
+      }
+      // exercise
+      custom::parallel::transform(src, dest, [](int value) { return value * 2; });
+      // verify
+      assertUnit(dest[0] == 2);
+      assertUnit(dest[99] == 200);
+      assertUnit(custom::parallel::reduce(dest, 0) == 10100);
+      custom::parallel::set_threshold(saved);
+   }  // teardown
+
 
    /****************************************************************
     * Setup Standard Fixture
@@ -1343,7 +1437,7 @@ public:
     ****************************************************************/
    void setupStandardFixture(custom::deque<int>& d)
    {
-      d.data = new int[3];
+      d.data = std::allocator<int>().allocate(3);
       d.data[0] = 11;
       d.data[1] = 26;
       d.data[2] = 31;